@@ -10,20 +10,30 @@
  #import <FBAEMKit/FBAEMAdvertiserMultiEntryRule.h>
  #import <FBAEMKit/FBAEMAdvertiserRuleFactory.h>
  #import <FBAEMKit/FBAEMAdvertiserRuleMatching.h>
+ #import <FBAEMKit/FBAEMAdvertiserRuleProgram.h>
  #import <FBAEMKit/FBAEMAdvertiserSingleEntryRule.h>
  #import <FBAEMKit/FBAEMConfiguration.h>
+ #import <FBAEMKit/FBAEMConfigurationIndex.h>
+ #import <FBAEMKit/FBAEMConversionRuleMatcher.h>
  #import <FBAEMKit/FBAEMEvent.h>
+ #import <FBAEMKit/FBAEMEventParameters.h>
  #import <FBAEMKit/FBAEMInvocation.h>
+ #import <FBAEMKit/FBAEMRecordStore.h>
  #import <FBAEMKit/FBAEMReporter.h>
  #import <FBAEMKit/FBAEMRule.h>
 #else
  #import "FBAEMAdvertiserMultiEntryRule.h"
  #import "FBAEMAdvertiserRuleFactory.h"
  #import "FBAEMAdvertiserRuleMatching.h"
+ #import "FBAEMAdvertiserRuleProgram.h"
  #import "FBAEMAdvertiserSingleEntryRule.h"
  #import "FBAEMConfiguration.h"
+ #import "FBAEMConfigurationIndex.h"
+ #import "FBAEMConversionRuleMatcher.h"
  #import "FBAEMEvent.h"
+ #import "FBAEMEventParameters.h"
  #import "FBAEMInvocation.h"
+ #import "FBAEMRecordStore.h"
  #import "FBAEMReporter.h"
  #import "FBAEMRule.h"
 #endif
@@ -112,8 +122,14 @@ NS_ASSUME_NONNULL_BEGIN
 @property (class, nonatomic) NSMutableArray<FBAEMInvocation *> *invocations;
 @property (class, nonatomic) NSMutableArray<FBAEMReporterBlock> *completionBlocks;
 @property (class, nonatomic) NSString *reportFilePath;
+@property (class, nullable, nonatomic) NSString *configFilePath;
 @property (class, nonatomic) id<FBAEMNetworking> networker;
 @property (class, nonatomic) id<FBSKAdNetworkReporting> reporter;
+@property (class, nonatomic) NSTimeInterval aggregationDebounceInterval;
+@property (class, nonatomic) NSTimeInterval minimumAggregationRequestInterval;
+@property (class, nonatomic) BOOL isAggregationRequestScheduled;
+@property (class, nonatomic) NSTimeInterval aggregationRetryInterval;
+@property (class, nullable, nonatomic) NSDate *aggregationRetryDate;
 
 + (void)enable;
 
@@ -135,6 +151,10 @@ NS_ASSUME_NONNULL_BEGIN
 
 + (NSDictionary<NSString *, id> *)_debuggingRequestParameters:(FBAEMInvocation *)invocation;
 
++ (void)_scheduleAggregationRequestForInvocation:(FBAEMInvocation *)invocation;
+
++ (nullable NSDate *)_nextAggregationRequestDate;
+
 + (void)_sendAggregationRequest;
 
 + (NSDictionary<NSString *, id> *)_requestParameters;
@@ -153,6 +173,12 @@ NS_ASSUME_NONNULL_BEGIN
 
 + (void)_saveReportData;
 
++ (void)_saveInvocations:(NSArray<FBAEMInvocation *> *)invocations;
+
++ (nullable FBAEMRecordStore *)_reportStore;
+
++ (nullable FBAEMRecordStore *)_configStore;
+
 + (void)_clearCache;
 
 @end
@@ -190,4 +216,11 @@ NS_ASSUME_NONNULL_BEGIN
 
 @end
 
+@interface FBAEMConversionRuleMatcher (Testing)
+
+/// The rules compared with recorded events, by every matcher
+@property (class, nonatomic, assign) NSUInteger evaluatedRuleCount;
+
+@end
+
 NS_ASSUME_NONNULL_END
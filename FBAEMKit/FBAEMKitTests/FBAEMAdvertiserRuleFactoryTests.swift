@@ -309,6 +309,47 @@ class FBAEMAdvertiserRuleFactoryTests: XCTestCase { // swiftlint:disable:this ty
       )
     }
   }
+
+  // MARK: - Benchmarks
+
+  func testPerformanceMatchingCreatedRule() throws {
+    guard #available(iOS 13.0, tvOS 13.0, *) else { return }
+
+    let productIDs = (0 ..< 200).map { "Product_\($0)" }
+    var conditions = [[String: Any]]()
+    for index in 0 ..< 15 {
+      conditions.append(["fb_content[*].id": ["regex_match": "^sku_\(index)_[0-9]+$"]])
+      conditions.append(["fb_content[*].id": ["i_is_any": productIDs]])
+      conditions.append(["fb_content[*].title": ["i_contains": "Coffee_\(index)"]])
+      conditions.append(["fb_content[*].quantity": ["gt": 100 + index]])
+    }
+    let json = try XCTUnwrap(
+      String(
+        data: JSONSerialization.data(withJSONObject: [
+          "and": [
+            ["event": ["eq": "fb_mobile_purchase"]],
+            ["or": conditions],
+          ],
+        ]),
+        encoding: .utf8
+      )
+    )
+    let rule = try XCTUnwrap(factory.createRule(withJson: json))
+    let parameters: [String: Any] = [
+      "event": "fb_mobile_purchase",
+      "fb_content": (0 ..< 10).map { ["id": "sku_99_\($0)", "title": "Tea \($0)", "quantity": $0] },
+    ]
+
+    XCTAssertTrue(rule is AEMAdvertiserRuleProgram, "Should benchmark the compiled rule the factory creates")
+    XCTAssertFalse(rule.isMatchedEventParameters(parameters), "Should evaluate every condition of the OR")
+
+    // CPU time and instructions per iteration of 100 purchase events, each matched against 60 conditions.
+    measure(metrics: [XCTCPUMetric(), XCTMemoryMetric()]) {
+      for _ in 0 ..< 100 {
+        _ = rule.isMatchedEventParameters(parameters)
+      }
+    }
+  }
 }
 
 extension AEMAdvertiserSingleEntryRule {
@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+import FBAEMKit
+import XCTest
+
+#if !os(tvOS)
+
+class FBAEMAdvertiserRuleProgramTests: XCTestCase {
+
+  let parameters: [[String: Any]] = [
+    ["card_type": "platium", "amount": NSNumber(value: 100)],
+    ["card_type": "platium", "amount": NSNumber(value: 1)],
+    ["card_type": "gold", "amount": NSNumber(value: 100)],
+    ["card_type": "gold", "amount": NSNumber(value: 1)],
+    ["card_type": "blue_credit", "content_name": "exit_page"],
+    ["URL": "www.abc.com/ThankYou.do", "amount": "100"],
+    [:],
+  ]
+
+  func testMatchingTheSameAsTheRuleTree() throws {
+    let rules = [
+      SampleAEMSingleEntryRules.cardTypeRule1,
+      SampleAEMSingleEntryRules.valueRule,
+      SampleAEMSingleEntryRules.urlRule,
+    ]
+    for ruleOperator in [
+      AEMAdvertiserRuleOperator.FBAEMAdvertiserRuleOperatorAnd,
+      AEMAdvertiserRuleOperator.FBAEMAdvertiserRuleOperatorOr,
+      AEMAdvertiserRuleOperator.FBAEMAdvertiserRuleOperatorNot,
+    ] {
+      let tree = AEMAdvertiserMultiEntryRule(
+        with: ruleOperator,
+        rules: [
+          AEMAdvertiserMultiEntryRule(
+            with: AEMAdvertiserRuleOperator.FBAEMAdvertiserRuleOperatorOr,
+            rules: [SampleAEMSingleEntryRules.cardTypeRule2, SampleAEMSingleEntryRules.contentNameRule]
+          ),
+        ] + rules
+      )
+      let program = try XCTUnwrap(AEMAdvertiserRuleProgram(rule: tree))
+      for parameter in parameters {
+        XCTAssertEqual(
+          program.isMatchedEventParameters(parameter),
+          tree.isMatchedEventParameters(parameter),
+          "Should match \(parameter) the same as the rule tree"
+        )
+      }
+    }
+  }
+
+  func testMatchingWithAsteriskPaths() throws {
+    let rule = AEMAdvertiserSingleEntryRule(
+      with: AEMAdvertiserRuleOperator.FBAEMAdvertiserRuleOperatorContains,
+      paramKey: "fb_content[*].id",
+      linguisticCondition: "coffee",
+      numericalCondition: nil,
+      arrayCondition: nil
+    )
+    let program = try XCTUnwrap(AEMAdvertiserRuleProgram(rule: rule))
+
+    XCTAssertTrue(
+      program.isMatchedEventParameters(["fb_content": [["id": "shop"], ["id": "coffeeshop"]]]),
+      "Should match when any item of the array matches"
+    )
+    XCTAssertFalse(
+      program.isMatchedEventParameters(["fb_content": ["id": "coffeeshop"]]),
+      "Should not match when the parameter is not an array"
+    )
+    XCTAssertFalse(
+      program.isMatchedEventParameters(["fb_content": [["id": "shop"]]]),
+      "Should not match when no item of the array matches"
+    )
+  }
+
+  func testMatchingIgnoringCase() throws {
+    let rule = AEMAdvertiserSingleEntryRule(
+      with: AEMAdvertiserRuleOperator.FBAEMAdvertiserRuleOperatorI_IsAny,
+      paramKey: "fb_content.title",
+      linguisticCondition: nil,
+      numericalCondition: nil,
+      arrayCondition: ["Hello", "World"]
+    )
+    let program = try XCTUnwrap(AEMAdvertiserRuleProgram(rule: rule))
+
+    XCTAssertTrue(
+      program.isMatchedEventParameters(["fb_content": ["title": "hELLO"]]),
+      "Should match any of the values ignoring their case"
+    )
+    XCTAssertFalse(
+      program.isMatchedEventParameters(["fb_content": ["title": "hello world"]]),
+      "Should not match a value that is not in the list"
+    )
+
+    rule.setOperator(AEMAdvertiserRuleOperator.FBAEMAdvertiserRuleOperatorIsAny)
+    let caseSensitiveProgram = try XCTUnwrap(AEMAdvertiserRuleProgram(rule: rule))
+    XCTAssertFalse(
+      caseSensitiveProgram.isMatchedEventParameters(["fb_content": ["title": "hELLO"]]),
+      "Should not ignore the case of the values for is_any"
+    )
+  }
+
+  func testMatchingRegex() throws {
+    let rule = AEMAdvertiserSingleEntryRule(
+      with: AEMAdvertiserRuleOperator.FBAEMAdvertiserRuleOperatorRegexMatch,
+      paramKey: "URL",
+      linguisticCondition: "eylea.us/support/?$|eylea.us/support/?",
+      numericalCondition: nil,
+      arrayCondition: nil
+    )
+    let program = try XCTUnwrap(AEMAdvertiserRuleProgram(rule: rule))
+
+    XCTAssertTrue(
+      program.isMatchedEventParameters(["URL": "eylea.us/support"]),
+      "Should match the regular expression"
+    )
+    XCTAssertFalse(
+      program.isMatchedEventParameters(["URL": "eylea.us.support"]),
+      "Should not match a value the regular expression does not match"
+    )
+  }
+
+  func testInstructionCount() throws {
+    let rules = [
+      SampleAEMSingleEntryRules.cardTypeRule1,
+      SampleAEMSingleEntryRules.valueRule,
+      SampleAEMSingleEntryRules.urlRule,
+    ]
+    let andRule = AEMAdvertiserMultiEntryRule(
+      with: AEMAdvertiserRuleOperator.FBAEMAdvertiserRuleOperatorAnd,
+      rules: rules
+    )
+    let notRule = AEMAdvertiserMultiEntryRule(
+      with: AEMAdvertiserRuleOperator.FBAEMAdvertiserRuleOperatorNot,
+      rules: rules
+    )
+
+    XCTAssertEqual(
+      AEMAdvertiserRuleProgram(rule: SampleAEMSingleEntryRules.urlRule)?.instructionCount,
+      1,
+      "Should compile a single entry rule into a single test"
+    )
+    XCTAssertEqual(
+      AEMAdvertiserRuleProgram(rule: andRule)?.instructionCount,
+      5,
+      "Should compile three subrules into three tests and two jumps"
+    )
+    XCTAssertEqual(
+      AEMAdvertiserRuleProgram(rule: notRule)?.instructionCount,
+      6,
+      "Should negate the result of a NOT rule"
+    )
+  }
+
+  func testCompilingInvalidRules() {
+    XCTAssertNil(
+      AEMAdvertiserRuleProgram(rule: nil),
+      "Should not compile a missing rule"
+    )
+    XCTAssertNil(
+      AEMAdvertiserRuleProgram(
+        rule: AEMAdvertiserMultiEntryRule(
+          with: AEMAdvertiserRuleOperator.FBAEMAdvertiserRuleOperatorAnd,
+          rules: []
+        )
+      ),
+      "Should not compile a rule without subrules"
+    )
+    XCTAssertNil(
+      AEMAdvertiserRuleProgram(
+        rule: AEMAdvertiserMultiEntryRule(
+          with: AEMAdvertiserRuleOperator.FBAEMAdvertiserRuleOperatorContains,
+          rules: [SampleAEMSingleEntryRules.urlRule]
+        )
+      ),
+      "Should not compile a rule group with an unknown operator"
+    )
+  }
+
+  func testCompilingAProgram() throws {
+    let program = try XCTUnwrap(AEMAdvertiserRuleProgram(rule: SampleAEMSingleEntryRules.urlRule))
+
+    XCTAssertTrue(
+      AEMAdvertiserRuleProgram(rule: program) === program,
+      "Should not compile a program again"
+    )
+  }
+
+  func testArchivingKeepsTheRuleTree() throws {
+    let tree = AEMAdvertiserMultiEntryRule(
+      with: AEMAdvertiserRuleOperator.FBAEMAdvertiserRuleOperatorAnd,
+      rules: [SampleAEMSingleEntryRules.cardTypeRule1, SampleAEMSingleEntryRules.valueRule]
+    )
+    let program = try XCTUnwrap(AEMAdvertiserRuleProgram(rule: tree))
+
+    let data = try NSKeyedArchiver.archivedData(withRootObject: program, requiringSecureCoding: true)
+    let unarchived = try NSKeyedUnarchiver.unarchivedObject(
+      ofClasses: [
+        AEMAdvertiserMultiEntryRule.self,
+        AEMAdvertiserSingleEntryRule.self,
+        NSArray.self,
+        NSString.self,
+        NSNumber.self,
+      ],
+      from: data
+    )
+    XCTAssertTrue(
+      unarchived is AEMAdvertiserMultiEntryRule,
+      "Should archive the rule tree the program was compiled from"
+    )
+  }
+
+  func testFactoryCompilesRules() {
+    let factory = AEMAdvertiserRuleFactory()
+    let rule = factory.createRule(
+      withJson: #"{"and": [{"value": {"gt": 10}}, {"card_type": {"eq": "platium"}}]}"#
+    )
+
+    XCTAssertTrue(
+      rule is AEMAdvertiserRuleProgram,
+      "Should compile the rules created from JSON"
+    )
+    XCTAssertTrue(
+      rule?.isMatchedEventParameters(["value": NSNumber(value: 100), "card_type": "platium"]) == true,
+      "Should match the compiled rule"
+    )
+  }
+}
+
+#endif
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+import FBAEMKit
+import XCTest
+
+#if !os(tvOS)
+
+class FBAEMConfigurationIndexTests: XCTestCase {
+
+  enum Values {
+    static let defaultMode = "DEFAULT"
+    static let brandMode = "BRAND"
+    static let businessID = "test_advertiserid_123"
+  }
+
+  override func setUp() {
+    super.setUp()
+
+    AEMConfiguration.configure(withRuleProvider: AEMAdvertiserRuleFactory())
+    AEMConfigurationIndex.invalidateCachedIndex()
+  }
+
+  func testFindingConfigWithValidFrom() {
+    let configs = [
+      Values.defaultMode: [config(validFrom: 30000), config(validFrom: 10000), config(validFrom: 20000)],
+    ]
+    let index = AEMConfigurationIndex(configs: configs)
+
+    XCTAssertEqual(
+      index.config(withMode: Values.defaultMode, businessID: nil, validFrom: 20000)?.validFrom,
+      20000,
+      "Should find the config with the expected validFrom"
+    )
+    XCTAssertNil(
+      index.config(withMode: Values.defaultMode, businessID: nil, validFrom: 15000),
+      "Should not find a config without the expected validFrom"
+    )
+    XCTAssertNil(
+      index.config(withMode: Values.brandMode, businessID: nil, validFrom: 20000),
+      "Should not find a config of another config mode"
+    )
+  }
+
+  func testFindingConfigValidBeforeTimestamp() {
+    let configs = [
+      Values.defaultMode: [config(validFrom: 10000), config(validFrom: 20000), config(validFrom: 30000)],
+    ]
+    let index = AEMConfigurationIndex(configs: configs)
+
+    XCTAssertEqual(
+      index.config(withMode: Values.defaultMode, businessID: nil, validBefore: 25000)?.validFrom,
+      20000,
+      "Should find the most recent config valid at the timestamp"
+    )
+    XCTAssertEqual(
+      index.config(withMode: Values.defaultMode, businessID: nil, validBefore: 30000)?.validFrom,
+      30000,
+      "Should find a config that became valid at the timestamp"
+    )
+    XCTAssertNil(
+      index.config(withMode: Values.defaultMode, businessID: nil, validBefore: 9999),
+      "Should not find a config before any is valid"
+    )
+  }
+
+  func testFindingConfigWithBusinessID() {
+    let configs = [
+      Values.brandMode: [
+        config(validFrom: 10000, mode: Values.brandMode, businessID: Values.businessID),
+        config(validFrom: 20000, mode: Values.brandMode),
+      ],
+    ]
+    let index = AEMConfigurationIndex(configs: configs)
+
+    XCTAssertEqual(
+      index.config(withMode: Values.brandMode, businessID: Values.businessID, validBefore: 30000)?.validFrom,
+      10000,
+      "Should only find configs of the same business ID"
+    )
+    XCTAssertNil(
+      index.config(withMode: Values.brandMode, businessID: "other_advertiser_id", validFrom: 10000),
+      "Should not find the configs of another business ID"
+    )
+  }
+
+  func testCachingIndex() throws {
+    // Backed by the dictionary, so that it bridges to the same object every time
+    let dictionary = NSDictionary(dictionary: [Values.defaultMode: [config(validFrom: 10000)]])
+    let configs = try XCTUnwrap(dictionary as? [String: [AEMConfiguration]])
+    let index = AEMConfigurationIndex.index(forConfigs: configs)
+
+    XCTAssertTrue(
+      AEMConfigurationIndex.index(forConfigs: configs) === index,
+      "Should reuse the index of the same configs"
+    )
+    AEMConfigurationIndex.invalidateCachedIndex()
+    XCTAssertFalse(
+      AEMConfigurationIndex.index(forConfigs: configs) === index,
+      "Should build the index again once invalidated"
+    )
+  }
+
+  func testInvocationLooksUpConfigAgainWhenConfigIDChanges() throws {
+    let invocation = try XCTUnwrap(
+      AEMInvocation(
+        campaignID: "test_campaign_1234",
+        acsToken: "test_token_12345",
+        acsSharedSecret: nil,
+        acsConfigID: nil,
+        businessID: nil,
+        isTestMode: false,
+        hasSKAN: false
+      )
+    )
+    let configs = [Values.defaultMode: [config(validFrom: 10000), config(validFrom: 20000)]]
+
+    XCTAssertEqual(
+      invocation._findConfig(configs)?.validFrom,
+      20000,
+      "Should find the most recent config"
+    )
+    invocation.setConfigID(10000)
+    XCTAssertEqual(
+      invocation._findConfig(configs)?.validFrom,
+      10000,
+      "Should not reuse the config found before the config ID changed"
+    )
+  }
+
+  // MARK: - Helpers
+
+  func config(
+    validFrom: Int,
+    mode: String = Values.defaultMode,
+    businessID: String? = nil
+  ) -> AEMConfiguration {
+    var json: [String: Any] = [
+      "default_currency": "USD",
+      "cutoff_time": 1,
+      "valid_from": validFrom,
+      "config_mode": mode,
+      "conversion_value_rules": [
+        [
+          "conversion_value": 2,
+          "priority": 10,
+          "events": [["event_name": "fb_mobile_purchase"]],
+        ],
+      ],
+    ]
+    json["advertiser_id"] = businessID
+    return AEMConfiguration(json: json)! // swiftlint:disable:this force_unwrapping
+  }
+}
+
+#endif
@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+import FBAEMKit
+import XCTest
+
+#if !os(tvOS)
+
+class FBAEMConversionRuleMatcherTests: XCTestCase {
+
+  enum Values {
+    static let purchase = "fb_mobile_purchase"
+    static let donate = "Donate"
+    static let activateApp = "fb_activate_app"
+    static let testEvent = "fb_test_event"
+    static let USD = "USD"
+    static let JPY = "JPY"
+  }
+
+  lazy var rules = [
+    rule(conversionValue: 4, priority: 30, events: [
+      event(Values.purchase, values: [Values.USD: 100, Values.JPY: 10000]),
+      event(Values.donate),
+    ]),
+    rule(conversionValue: 3, priority: 20, events: [event(Values.purchase, values: [Values.USD: 10])]),
+    rule(conversionValue: 2, priority: 10, events: [event(Values.activateApp), event(Values.testEvent)]),
+    rule(conversionValue: 1, priority: 5, events: [event(Values.activateApp)]),
+  ]
+
+  override func setUp() {
+    super.setUp()
+
+    AEMConfiguration.configure(withRuleProvider: AEMAdvertiserRuleFactory())
+  }
+
+  func testInterningEventsAndCurrencies() throws {
+    let matcher = try XCTUnwrap(AEMConversionRuleMatcher(rules: rules))
+
+    XCTAssertEqual(
+      Set(matcher.eventIDs.values.map { $0.intValue }),
+      Set(0 ..< 4),
+      "Should intern each event name to a distinct small ID"
+    )
+    XCTAssertEqual(
+      Set(matcher.currencyIDs.values.map { $0.intValue }),
+      Set(0 ..< 2),
+      "Should intern each currency to a distinct small ID"
+    )
+  }
+
+  func testMatchingRulesLikeTheRules() throws {
+    let matcher = try XCTUnwrap(AEMConversionRuleMatcher(rules: rules))
+    let recordedEventSets: [Set<String>] = [
+      [],
+      [Values.activateApp],
+      [Values.activateApp, Values.testEvent],
+      [Values.purchase],
+      [Values.purchase, Values.donate],
+      [Values.purchase, Values.donate, Values.activateApp, "unknown_event"],
+    ]
+    let recordedValueSets: [[String: [String: Any]]?] = [
+      nil,
+      [:],
+      [Values.purchase: [Values.USD: 5]],
+      [Values.purchase: [Values.USD: 10]],
+      [Values.purchase: [Values.USD: 100]],
+      [Values.purchase: [Values.JPY: 20000]],
+      [Values.purchase: ["EUR": 1000]],
+    ]
+    for recordedEvents in recordedEventSets {
+      for recordedValues in recordedValueSets {
+        for priority in [-1, 5, 15, 30] {
+          XCTAssertEqual(
+            matcher.ruleMatched(
+              withRecordedEvents: recordedEvents,
+              recordedValues: recordedValues,
+              abovePriority: priority
+            )?.conversionValue,
+            firstMatchedRule(recordedEvents: recordedEvents, recordedValues: recordedValues, priority: priority)?
+              .conversionValue,
+            "Should match the same rule as the rules for \(recordedEvents), \(String(describing: recordedValues))"
+          )
+        }
+      }
+    }
+  }
+
+  func testMatchingRuleWithValuesOfZero() throws {
+    let matcher = try XCTUnwrap(
+      AEMConversionRuleMatcher(rules: [
+        rule(conversionValue: 1, priority: 10, events: [event(Values.purchase, values: [Values.USD: 0])]),
+      ])
+    )
+
+    XCTAssertEqual(
+      matcher.ruleMatched(withRecordedEvents: [Values.purchase], recordedValues: nil, abovePriority: -1)?
+        .conversionValue,
+      1,
+      "Should match values of zero without recorded values"
+    )
+  }
+
+  func testNotMatchingRulesOfLowerPriority() throws {
+    let matcher = try XCTUnwrap(AEMConversionRuleMatcher(rules: rules))
+
+    XCTAssertNil(
+      matcher.ruleMatched(
+        withRecordedEvents: [Values.purchase, Values.donate, Values.activateApp, Values.testEvent],
+        recordedValues: [Values.purchase: [Values.USD: 1000]],
+        abovePriority: 30
+      ),
+      "Should not match rules of a priority lower than the given one"
+    )
+  }
+
+  func testCompilingTooManyEvents() {
+    let events = (0 ... AEMConversionRuleMatcher.maximumEventCount).map { event("event_\($0)") }
+
+    XCTAssertNil(
+      AEMConversionRuleMatcher(rules: [rule(conversionValue: 1, priority: 10, events: events)]),
+      "Should not compile rules referencing more events than a bitset holds"
+    )
+  }
+
+  func testConfigurationCompilesRules() {
+    let config = SampleAEMConfigurations.createConfigWithoutBusinessID()
+
+    XCTAssertEqual(
+      config.conversionRuleMatcher?.rules.count,
+      config.conversionValueRules.count,
+      "Should compile the conversion value rules of the configuration"
+    )
+  }
+
+  func testInvocationMatchesRulesOfConfigurationWithTooManyEvents() throws {
+    let events = (0 ... AEMConversionRuleMatcher.maximumEventCount).map { event("event_\($0)") }
+    let config = try XCTUnwrap(
+      AEMConfiguration(json: [
+        "default_currency": Values.USD,
+        "cutoff_time": 1,
+        "valid_from": 10000,
+        "config_mode": "DEFAULT",
+        "conversion_value_rules": [
+          ["conversion_value": 2, "priority": 20, "events": events],
+          ["conversion_value": 1, "priority": 10, "events": [event("event_1")]],
+        ],
+      ])
+    )
+    let invocation = try XCTUnwrap(
+      AEMInvocation(
+        campaignID: "test_campaign_1234",
+        acsToken: "test_token_12345",
+        acsSharedSecret: nil,
+        acsConfigID: nil,
+        businessID: nil,
+        isTestMode: false,
+        hasSKAN: false
+      )
+    )
+    invocation.recordedEvents.add("event_1")
+
+    XCTAssertNil(config.conversionRuleMatcher, "Should not compile rules referencing too many events")
+    XCTAssertTrue(
+      invocation.updateConversionValue(withConfigs: ["DEFAULT": [config]]),
+      "Should still match the rules of the configuration"
+    )
+    XCTAssertEqual(invocation.conversionValue, 1, "Should update the conversion value to the matched rule")
+  }
+
+  // MARK: - Benchmarks
+
+  func testPerformanceMatchingRules() throws {
+    guard #available(iOS 13.0, tvOS 13.0, *) else { return }
+
+    let rules = (0 ..< 64).reversed().map { index in
+      rule(conversionValue: index, priority: index, events: [
+        event("event_\(index)", values: [Values.USD: Double(index)]),
+        event("event_\((index + 1) % 64)"),
+      ])
+    }
+    let matcher = try XCTUnwrap(AEMConversionRuleMatcher(rules: rules))
+    let recordedEvents = Set((0 ..< 64).filter { $0.isMultiple(of: 2) }.map { "event_\($0)" })
+    let recordedValues: [String: [String: Any]] = Dictionary(
+      uniqueKeysWithValues: recordedEvents.map { ($0, [Values.USD: 1]) }
+    )
+
+    measure(metrics: [XCTCPUMetric(), XCTMemoryMetric()]) {
+      for _ in 0 ..< 1000 {
+        _ = matcher.ruleMatched(withRecordedEvents: recordedEvents, recordedValues: recordedValues, abovePriority: -1)
+      }
+    }
+  }
+
+  // MARK: - Helpers
+
+  func firstMatchedRule(
+    recordedEvents: Set<String>,
+    recordedValues: [String: [String: Any]]?,
+    priority: Int
+  ) -> FBAEMRule? {
+    for rule in rules {
+      if rule.priority <= priority {
+        break
+      }
+      if rule.isMatched(withRecordedEvents: recordedEvents, recordedValues: recordedValues) {
+        return rule
+      }
+    }
+    return nil
+  }
+
+  func rule(conversionValue: Int, priority: Int, events: [[String: Any]]) -> FBAEMRule {
+    FBAEMRule(json: [
+      "conversion_value": conversionValue,
+      "priority": priority,
+      "events": events,
+    ])! // swiftlint:disable:this force_unwrapping
+  }
+
+  func event(_ name: String, values: [String: Double]? = nil) -> [String: Any] {
+    var event: [String: Any] = ["event_name": name]
+    event["values"] = values?.map { ["currency": $0.key, "amount": $0.value] }
+    return event
+  }
+}
+
+#endif
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+import FBSDKCoreKit_Basics
+import XCTest
+
+#if !os(tvOS)
+
+class FBAEMConversionSimulatorTests: XCTestCase {
+
+  let configsJSON = """
+  {
+    "data": [
+      {
+        "default_currency": "USD",
+        "cutoff_time": 1,
+        "valid_from": 10000,
+        "config_mode": "DEFAULT",
+        "conversion_value_rules": [
+          {
+            "conversion_value": 3,
+            "priority": 30,
+            "events": [
+              {"event_name": "fb_mobile_purchase", "values": [{"currency": "USD", "amount": 100}]},
+              {"event_name": "Donate"}
+            ]
+          },
+          {
+            "conversion_value": 2,
+            "priority": 20,
+            "events": [{"event_name": "fb_mobile_purchase", "values": [{"currency": "USD", "amount": 10}]}]
+          },
+          {
+            "conversion_value": 1,
+            "priority": 10,
+            "events": [{"event_name": "fb_mobile_complete_registration"}]
+          }
+        ]
+      }
+    ]
+  }
+  """
+  let eventsJSON = """
+  [
+    {"event_name": "fb_mobile_complete_registration"},
+    {"event_name": "fb_mobile_purchase", "currency": "usd", "value": 5},
+    {"event_name": "fb_mobile_purchase", "currency": "USD", "value": 20},
+    {"event_name": "fb_mobile_search"},
+    {"event_name": "Donate"},
+    {"event_name": "fb_mobile_purchase", "currency": "USD", "value": 200}
+  ]
+  """
+  lazy var reportFilePath = BasicUtility.persistenceFilePath(name)
+  lazy var simulator = AEMConversionSimulator(configsJSON: configsJSON, reportFilePath: reportFilePath)
+  var configFilePath: String?
+
+  override func setUp() {
+    super.setUp()
+
+    configFilePath = AEMReporter.configFilePath
+  }
+
+  override func tearDown() {
+    try? FileManager.default.removeItem(atPath: reportFilePath)
+    if let simulator = simulator {
+      try? FileManager.default.removeItem(atPath: simulator.configFilePath)
+    }
+    AEMReporter.configFilePath = configFilePath
+    AEMReporter.invocations = []
+    AEMReporter.configs = [:]
+
+    super.tearDown()
+  }
+
+  func testReplayingEventStream() throws {
+    let simulator = try XCTUnwrap(self.simulator)
+    let events = AEMConversionSimulator.events(fromJSON: eventsJSON)
+    let campaign = try invocation("campaign_1")
+
+    let report = simulator.run(events: events, invocations: [campaign])
+
+    XCTAssertEqual(events.count, 6, "Should decode every event of the stream")
+    XCTAssertEqual(report.conversionValues, ["campaign_1": 3], "Should report the final conversion values")
+    XCTAssertEqual(
+      report.ruleEvaluations,
+      [3, 2, 2, 0, 1, 1],
+      "Should report the rules the matcher evaluated for each event"
+    )
+    XCTAssertEqual(report.latencies.count, events.count, "Should report the latency of each event")
+    XCTAssertGreaterThan(report.reportBytesWritten, 0, "Should report the bytes of report data written")
+    XCTAssertGreaterThan(report.configBytesWritten, 0, "Should report the bytes of configuration written")
+    XCTAssertEqual(
+      report.aggregationRequestCount,
+      3,
+      "Should send an aggregation request for each conversion value update"
+    )
+  }
+
+  func testReplayingEventsWithoutInvocations() throws {
+    let simulator = try XCTUnwrap(self.simulator)
+
+    let report = simulator.run(events: AEMConversionSimulator.events(fromJSON: eventsJSON), invocations: [])
+
+    XCTAssertEqual(report.totalRuleEvaluations, 0, "Should not evaluate rules without invocations")
+    XCTAssertEqual(report.reportBytesWritten, 0, "Should not write report data without invocations")
+  }
+
+  // MARK: - Benchmarks
+
+  func testPerformanceReplayingEventStream() throws {
+    guard #available(iOS 13.0, tvOS 13.0, *) else { return }
+
+    let simulator = try XCTUnwrap(self.simulator)
+    let stream = AEMConversionSimulator.events(fromJSON: eventsJSON)
+    let events = (0 ..< 200).flatMap { _ in stream }
+
+    measure(metrics: [XCTCPUMetric(), XCTMemoryMetric(), XCTStorageMetric()]) {
+      let invocations = (0 ..< 10).compactMap { try? invocation("campaign_\($0)") }
+      _ = simulator.run(events: events, invocations: invocations)
+    }
+  }
+
+  // MARK: - Helpers
+
+  func invocation(_ campaignID: String) throws -> AEMInvocation {
+    try XCTUnwrap(
+      AEMInvocation(
+        campaignID: campaignID,
+        acsToken: "test_token_12345",
+        acsSharedSecret: nil,
+        acsConfigID: nil,
+        businessID: nil,
+        isTestMode: false,
+        hasSKAN: false
+      )
+    )
+  }
+}
+
+#endif
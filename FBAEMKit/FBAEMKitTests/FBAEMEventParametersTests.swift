@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+import FBAEMKit
+import XCTest
+
+#if !os(tvOS)
+
+class FBAEMEventParametersTests: XCTestCase {
+
+  enum Keys {
+    static let content = "fb_content"
+    static let contentID = "fb_content_id"
+  }
+
+  func testProcessedParametersWithValidContent() {
+    let eventParameters = AEMEventParameters(
+      parameters: [
+        Keys.content: "[{\"id\":\"123\",\"quantity\":5}]",
+        Keys.contentID: "001"
+      ]
+    )
+    let content: [String: AnyHashable] = ["id": "123", "quantity": 5]
+
+    XCTAssertEqual(
+      eventParameters.processedParameters as? [String: AnyHashable],
+      [Keys.content: [content], Keys.contentID: "001"],
+      "Should decode the content of the parameters"
+    )
+  }
+
+  func testProcessedParametersWithInvalidContent() {
+    let parameters = [Keys.content: "[{\"id\":,\"quantity\":5}]", Keys.contentID: "001"]
+    let eventParameters = AEMEventParameters(parameters: parameters)
+
+    XCTAssertEqual(
+      eventParameters.processedParameters as? [String: String],
+      parameters,
+      "Should keep the content when it is not valid JSON"
+    )
+  }
+
+  func testProcessedParametersWithoutParameters() {
+    XCTAssertNil(
+      AEMEventParameters(parameters: nil).processedParameters,
+      "Should not have processed parameters without parameters"
+    )
+  }
+
+  func testProcessingOnce() throws {
+    let eventParameters = AEMEventParameters(parameters: [Keys.content: "[{\"id\":\"123\"}]"])
+    let processed = try XCTUnwrap(eventParameters.processedParameters as NSDictionary?)
+
+    XCTAssertTrue(
+      eventParameters.processedParameters as NSDictionary? === processed,
+      "Should reuse the parameters it processed"
+    )
+  }
+}
+
+#endif
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+import FBAEMKit
+import XCTest
+
+#if !os(tvOS)
+
+class FBAEMRecordStoreTests: XCTestCase {
+
+  lazy var filePath = NSTemporaryDirectory() + name
+  lazy var store = AEMRecordStore(filePath: filePath, objectClasses: [AEMInvocation.self])
+  let invocation1 = SampleAEMInvocations.createGeneralInvocation1()
+  let invocation2 = SampleAEMInvocations.createGeneralInvocation2()
+
+  override func setUp() {
+    super.setUp()
+
+    removeFile()
+  }
+
+  override func tearDown() {
+    removeFile()
+
+    super.tearDown()
+  }
+
+  func testLoadingWithoutFile() {
+    XCTAssertEqual(
+      store.loadObjects()?.count,
+      0,
+      "Should not load objects without a file"
+    )
+  }
+
+  func testLoadingFileInAnotherFormat() throws {
+    let data = try NSKeyedArchiver.archivedData(withRootObject: [invocation1], requiringSecureCoding: false)
+    try data.write(to: URL(fileURLWithPath: filePath))
+
+    XCTAssertNil(
+      store.loadObjects(),
+      "Should not load a file that was not written by a record store"
+    )
+  }
+
+  func testCompacting() {
+    store.compact(withObjects: [invocation1, invocation2])
+
+    let objects = AEMRecordStore(filePath: filePath, objectClasses: [AEMInvocation.self]).loadObjects()
+    XCTAssertEqual(
+      (objects as? [AEMInvocation])?.map { $0.campaignID },
+      [invocation1.campaignID, invocation2.campaignID],
+      "Should load the objects it was compacted with, in order"
+    )
+  }
+
+  func testAppendingChanges() throws {
+    store.compact(withObjects: [invocation1])
+    let size = try fileSize()
+
+    invocation1.conversionValue = 5
+    store.save(invocation1, inObjects: [invocation1, invocation2])
+    store.save(invocation2, inObjects: [invocation1, invocation2])
+
+    XCTAssertEqual(
+      store.appendedRecordCount,
+      2,
+      "Should append a record for each change"
+    )
+    XCTAssertGreaterThan(
+      try fileSize(),
+      size,
+      "Should append the changes to the file"
+    )
+    let objects = try XCTUnwrap(
+      AEMRecordStore(filePath: filePath, objectClasses: [AEMInvocation.self]).loadObjects() as? [AEMInvocation]
+    )
+    XCTAssertEqual(objects.count, 2, "Should load every saved object once")
+    XCTAssertEqual(objects.first?.conversionValue, 5, "Should load the latest state of an object")
+  }
+
+  func testCountingWrittenBytes() throws {
+    store.compact(withObjects: [invocation1, invocation2])
+    let compactedSize = try fileSize()
+    store.save(invocation1, inObjects: [invocation1, invocation2])
+    let appendedSize = try fileSize() - compactedSize
+    store.compact(withObjects: [invocation1, invocation2])
+    let recompactedSize = try fileSize()
+
+    XCTAssertEqual(
+      Int(store.writtenByteCount),
+      compactedSize + appendedSize + recompactedSize,
+      "Should count the bytes of every append and every rewrite of the file"
+    )
+  }
+
+  func testRemovingObjects() throws {
+    store.compact(withObjects: [invocation1, invocation2])
+
+    store.save([], removingObjects: [invocation1], inObjects: [invocation2])
+
+    let objects = try XCTUnwrap(
+      AEMRecordStore(filePath: filePath, objectClasses: [AEMInvocation.self]).loadObjects() as? [AEMInvocation]
+    )
+    XCTAssertEqual(
+      objects.map { $0.campaignID },
+      [invocation2.campaignID],
+      "Should not load removed objects"
+    )
+  }
+
+  func testCompactingAfterThreshold() throws {
+    store.compactionThreshold = 3
+    store.compact(withObjects: [invocation1])
+    let size = try fileSize()
+
+    for _ in 0 ..< 3 {
+      store.save(invocation1, inObjects: [invocation1])
+    }
+    XCTAssertEqual(store.appendedRecordCount, 3, "Should append changes up to the threshold")
+
+    store.save(invocation1, inObjects: [invocation1])
+    XCTAssertEqual(store.appendedRecordCount, 0, "Should compact the file past the threshold")
+    XCTAssertEqual(try fileSize(), size, "Should rewrite the file with one record per object")
+  }
+
+  func testSavingBeforeLoading() throws {
+    store.compact(withObjects: [invocation1, invocation2])
+
+    let otherStore = AEMRecordStore(filePath: filePath, objectClasses: [AEMInvocation.self])
+    otherStore.save(invocation1, inObjects: [invocation1])
+
+    XCTAssertEqual(
+      otherStore.appendedRecordCount,
+      0,
+      "Should write a snapshot when the store does not know the content of the file"
+    )
+    XCTAssertEqual(
+      otherStore.loadObjects()?.count,
+      1,
+      "Should only keep the objects it was given"
+    )
+  }
+
+  func testLoadingTruncatedFile() throws {
+    store.compact(withObjects: [invocation1])
+    let size = try fileSize()
+    store.save(invocation2, inObjects: [invocation1, invocation2])
+
+    let fileHandle = try XCTUnwrap(FileHandle(forWritingAtPath: filePath))
+    fileHandle.truncateFile(atOffset: UInt64(size + 5))
+    fileHandle.closeFile()
+
+    let reloadedStore = AEMRecordStore(filePath: filePath, objectClasses: [AEMInvocation.self])
+    XCTAssertEqual(
+      reloadedStore.loadObjects()?.count,
+      1,
+      "Should ignore a record cut short by an interrupted write"
+    )
+    reloadedStore.save(invocation1, inObjects: [invocation1])
+    XCTAssertEqual(
+      try fileSize(),
+      size,
+      "Should rewrite a damaged file on the next change"
+    )
+  }
+
+  // MARK: - Helpers
+
+  func fileSize() throws -> Int {
+    let attributes = try FileManager.default.attributesOfItem(atPath: filePath)
+    return try XCTUnwrap(attributes[.size] as? Int)
+  }
+
+  func removeFile() {
+    try? FileManager.default.removeItem(atPath: filePath)
+  }
+}
+
+#endif
@@ -71,6 +71,10 @@ class FBAEMReporterTests: XCTestCase {
     AEMReporter.queue = DispatchQueue(label: name, qos: .background)
     AEMReporter.isEnabled = true
     AEMReporter.reportFilePath = reportFilePath
+    AEMReporter.aggregationDebounceInterval = 0
+    AEMReporter.minimumAggregationRequestInterval = 0
+    AEMReporter.aggregationRetryInterval = 0
+    AEMReporter.isAggregationRequestScheduled = false
   }
 
   class func reset() {
@@ -134,6 +138,35 @@ class FBAEMReporterTests: XCTestCase {
     XCTAssertEqual(data?[0].businessID, "test_advertiserid_12345")
   }
 
+  func testLoadLegacyReportData() throws {
+    let invocation = try XCTUnwrap(AEMReporter.parseURL(urlWithInvocation))
+    let legacyData = try NSKeyedArchiver.archivedData(withRootObject: [invocation], requiringSecureCoding: false)
+    try legacyData.write(to: URL(fileURLWithPath: reportFilePath))
+
+    let data = AEMReporter._loadReportData() as? [AEMInvocation]
+    XCTAssertEqual(data?.count, 1, "Should load invocations archived before the record store")
+    XCTAssertEqual(data?[0].campaignID, "test_campaign_1234")
+  }
+
+  func testSavingInvocationAppendsToReportData() throws {
+    let invocation1 = SampleAEMInvocations.createGeneralInvocation1()
+    let invocation2 = SampleAEMInvocations.createGeneralInvocation2()
+    AEMReporter.invocations = [invocation1, invocation2]
+    AEMReporter._saveReportData()
+
+    invocation2.conversionValue = 3
+    AEMReporter._saveInvocations([invocation2])
+
+    XCTAssertEqual(
+      AEMReporter._reportStore()?.appendedRecordCount,
+      1,
+      "Should only append the changed invocation"
+    )
+    let data = AEMReporter._loadReportData() as? [AEMInvocation]
+    XCTAssertEqual(data?.count, 2, "Should load every invocation")
+    XCTAssertEqual(data?[1].conversionValue, 3, "Should load the latest state of the changed invocation")
+  }
+
   func testLoadConfigs() {
     AEMReporter._addConfigs([SampleAEMData.validConfigData1])
     AEMReporter._addConfigs([SampleAEMData.validConfigData1, SampleAEMData.validConfigData2])
@@ -381,9 +414,9 @@ class FBAEMReporterTests: XCTestCase {
       invocation.isAggregated,
       "Completing with an error should not mark the invocation as aggregated"
     )
-    XCTAssertFalse(
-      FileManager.default.fileExists(atPath: reportFilePath),
-      "Completing with an error should not write the report to the expected file path"
+    XCTAssertNotNil(
+      invocation.aggregationParameters,
+      "Completing with an error should keep the report to send it again unchanged"
     )
   }
 
@@ -405,6 +438,255 @@ class FBAEMReporterTests: XCTestCase {
     )
   }
 
+  func testDebouncingAggregationOfCampaign() {
+    // Keeps the request from being scheduled on the queue
+    AEMReporter.isAggregationRequestScheduled = true
+    AEMReporter.aggregationDebounceInterval = 60
+    let invocation = SampleAEMInvocations.createGeneralInvocation1()
+    invocation.isAggregated = false
+    AEMReporter.invocations = [invocation]
+
+    AEMReporter._scheduleAggregationRequest(for: invocation)
+    AEMReporter._sendAggregationRequest()
+
+    XCTAssertGreaterThan(
+      AEMReporter._nextAggregationRequestDate()?.timeIntervalSinceNow ?? 0,
+      59,
+      "Should schedule the request once the campaign had no update for the debounce interval"
+    )
+    XCTAssertEqual(
+      networker.startCallCount,
+      0,
+      "Should not send a campaign updated within the debounce interval"
+    )
+  }
+
+  func testMergingPendingInvocationsIntoOneRequest() throws {
+    let invocation1 = SampleAEMInvocations.createGeneralInvocation1()
+    let invocation2 = SampleAEMInvocations.createGeneralInvocation2()
+    invocation1.isAggregated = false
+    invocation2.isAggregated = false
+    AEMReporter.invocations = [invocation1, invocation2]
+
+    AEMReporter._sendAggregationRequest()
+
+    XCTAssertEqual(networker.startCallCount, 1, "Should send the pending invocations in one request")
+    XCTAssertEqual(try sentReports().count, 2, "Should send a report for each pending invocation")
+  }
+
+  func testNotResendingInvocationsInFlight() {
+    let invocation = SampleAEMInvocations.createGeneralInvocation1()
+    invocation.isAggregated = false
+    AEMReporter.invocations = [invocation]
+
+    AEMReporter._sendAggregationRequest()
+    AEMReporter._sendAggregationRequest()
+
+    XCTAssertEqual(
+      networker.startCallCount,
+      1,
+      "Should not send an invocation again while its report is in flight"
+    )
+  }
+
+  func testCappingAggregationRequestRate() {
+    AEMReporter.minimumAggregationRequestInterval = 60
+    let invocation1 = SampleAEMInvocations.createGeneralInvocation1()
+    let invocation2 = SampleAEMInvocations.createGeneralInvocation2()
+    invocation1.isAggregated = false
+    AEMReporter.invocations = [invocation1, invocation2]
+
+    AEMReporter._sendAggregationRequest()
+    networker.capturedCompletionHandler?(nil, nil)
+    invocation2.isAggregated = false
+
+    XCTAssertGreaterThan(
+      AEMReporter._nextAggregationRequestDate()?.timeIntervalSinceNow ?? 0,
+      59,
+      "Should not schedule a request before the minimum interval since the last one"
+    )
+  }
+
+  func testHoldingBackRequestOverRateLimit() {
+    // Long enough for the scheduled request never to fire during the tests
+    AEMReporter.minimumAggregationRequestInterval = 3600
+    let invocation1 = SampleAEMInvocations.createGeneralInvocation1()
+    let invocation2 = SampleAEMInvocations.createGeneralInvocation2()
+    invocation1.isAggregated = false
+    AEMReporter.invocations = [invocation1, invocation2]
+
+    AEMReporter._sendAggregationRequest()
+    networker.capturedCompletionHandler?(nil, nil)
+    invocation2.isAggregated = false
+    AEMReporter._sendAggregationRequest()
+
+    XCTAssertEqual(
+      networker.startCallCount,
+      1,
+      "Should not send a request before the minimum interval since the last one"
+    )
+    XCTAssertTrue(
+      AEMReporter.isAggregationRequestScheduled,
+      "Should schedule the request held back"
+    )
+  }
+
+  func testReschedulingWhenDeadlineMovedLater() {
+    AEMReporter.aggregationDebounceInterval = 3600
+    let invocation = SampleAEMInvocations.createGeneralInvocation1()
+    invocation.isAggregated = false
+    AEMReporter.invocations = [invocation]
+    AEMReporter._scheduleAggregationRequest(for: invocation)
+
+    // The scheduled request fires after the campaign was updated again
+    AEMReporter.isAggregationRequestScheduled = false
+    AEMReporter._sendAggregationRequest()
+
+    XCTAssertEqual(networker.startCallCount, 0, "Should not send a campaign updated within the debounce interval")
+    XCTAssertTrue(
+      AEMReporter.isAggregationRequestScheduled,
+      "Should schedule the request again for the later deadline"
+    )
+  }
+
+  func testReschedulingAfterFailedRequest() {
+    AEMReporter.minimumAggregationRequestInterval = 3600
+    let invocation = SampleAEMInvocations.createGeneralInvocation1()
+    invocation.isAggregated = false
+    AEMReporter.invocations = [invocation]
+
+    AEMReporter._sendAggregationRequest()
+    networker.capturedCompletionHandler?(nil, SampleAEMError())
+
+    XCTAssertTrue(
+      AEMReporter.isAggregationRequestScheduled,
+      "Should schedule the failed report to be sent again"
+    )
+  }
+
+  func testBackingOffAfterRepeatedFailures() {
+    AEMReporter.aggregationRetryInterval = 1000
+    let invocation = SampleAEMInvocations.createGeneralInvocation1()
+    invocation.isAggregated = false
+    AEMReporter.invocations = [invocation]
+
+    var delays = [TimeInterval]()
+    for _ in 0 ..< 5 {
+      // Sends the retry right away instead of waiting for the back off
+      AEMReporter.aggregationRetryDate = nil
+      AEMReporter.isAggregationRequestScheduled = false
+      AEMReporter._sendAggregationRequest()
+      networker.capturedCompletionHandler?(nil, SampleAEMError())
+      delays.append(AEMReporter.aggregationRetryDate?.timeIntervalSinceNow ?? 0)
+    }
+
+    for (index, delay) in delays.enumerated() {
+      let backoff = min(1000 * pow(2, Double(index)), 3600)
+      XCTAssertGreaterThanOrEqual(delay, backoff / 2 - 1, "Should wait longer after every failure")
+      XCTAssertLessThanOrEqual(delay, backoff, "Should not wait longer than the jittered back off or the cap")
+    }
+    XCTAssertEqual(networker.startCallCount, 5)
+  }
+
+  func testNotRetryingRejectedReports() {
+    let invocation = SampleAEMInvocations.createGeneralInvocation1()
+    invocation.isAggregated = false
+    AEMReporter.invocations = [invocation]
+    let error = NSError(
+      domain: "com.facebook.sdk.core",
+      code: 8,
+      userInfo: ["com.facebook.sdk:FBSDKGraphRequestErrorHTTPStatusCodeKey": 400]
+    )
+
+    AEMReporter._sendAggregationRequest()
+    networker.capturedCompletionHandler?(nil, error)
+
+    XCTAssertEqual(networker.startCallCount, 1, "Should not retry a report the server rejected")
+    XCTAssertFalse(AEMReporter.isAggregationRequestScheduled)
+    XCTAssertFalse(invocation.isAggregated, "Should keep the report to send it with the next conversion")
+  }
+
+  func testRetryingRateLimitedReports() {
+    let invocation = SampleAEMInvocations.createGeneralInvocation1()
+    invocation.isAggregated = false
+    AEMReporter.invocations = [invocation]
+    let error = NSError(
+      domain: "com.facebook.sdk.core",
+      code: 8,
+      userInfo: ["com.facebook.sdk:FBSDKGraphRequestErrorHTTPStatusCodeKey": 429]
+    )
+
+    AEMReporter._sendAggregationRequest()
+    networker.capturedCompletionHandler?(nil, error)
+
+    XCTAssertEqual(networker.startCallCount, 2, "Should retry reports the server could not take yet")
+  }
+
+  func testResettingBackoffAfterSuccess() {
+    AEMReporter.aggregationRetryInterval = 1000
+    let invocation = SampleAEMInvocations.createGeneralInvocation1()
+    invocation.isAggregated = false
+    AEMReporter.invocations = [invocation]
+
+    AEMReporter._sendAggregationRequest()
+    networker.capturedCompletionHandler?(nil, SampleAEMError())
+    AEMReporter.aggregationRetryDate = nil
+    AEMReporter.isAggregationRequestScheduled = false
+    AEMReporter._sendAggregationRequest()
+    networker.capturedCompletionHandler?(nil, nil)
+
+    XCTAssertNil(AEMReporter.aggregationRetryDate, "Should stop backing off once a request succeeds")
+  }
+
+  func testRetryingReportUnchanged() throws {
+    let invocation = SampleAEMInvocations.createGeneralInvocation1()
+    invocation.isAggregated = false
+    AEMReporter.invocations = [invocation]
+
+    AEMReporter._sendAggregationRequest()
+    let reports = try sentReports()
+    networker.capturedCompletionHandler?(nil, SampleAEMError())
+
+    XCTAssertEqual(networker.startCallCount, 2, "Should send the report again once the request failed")
+    XCTAssertEqual(
+      try sentReports() as NSArray,
+      reports as NSArray,
+      "Should send the same report again"
+    )
+  }
+
+  func testReportingInvocationUpdatedInFlight() {
+    let invocation = SampleAEMInvocations.createGeneralInvocation1()
+    invocation.isAggregated = false
+    AEMReporter.invocations = [invocation]
+
+    AEMReporter._sendAggregationRequest()
+    // Updating the conversion value discards the report in flight
+    invocation.aggregationParameters = nil
+    networker.capturedCompletionHandler?(nil, nil)
+
+    XCTAssertFalse(
+      invocation.isAggregated,
+      "Should not mark an invocation updated while in flight as aggregated"
+    )
+    XCTAssertEqual(networker.startCallCount, 2, "Should report the updated invocation")
+  }
+
+  func testSavingReportsInFlight() throws {
+    let invocation = SampleAEMInvocations.createGeneralInvocation1()
+    invocation.isAggregated = false
+    AEMReporter.invocations = [invocation]
+
+    AEMReporter._sendAggregationRequest()
+
+    let savedInvocation = try XCTUnwrap(AEMReporter._loadReportData().firstObject as? AEMInvocation)
+    XCTAssertEqual(
+      savedInvocation.aggregationParameters as NSDictionary?,
+      invocation.aggregationParameters as NSDictionary?,
+      "Should save the report in flight before sending it"
+    )
+  }
+
   func testRecordAndUpdateEvents() {
     AEMReporter.timestamp = Date()
     guard let invocation = AEMInvocation(
@@ -641,6 +923,50 @@ class FBAEMReporterTests: XCTestCase {
     )
   }
 
+  func testAttributedInvocationSharesEventParameters() throws {
+    let invocation1 = try XCTUnwrap(
+      TestInvocation(
+        campaignID: name,
+        acsToken: name,
+        acsSharedSecret: nil,
+        acsConfigID: nil,
+        businessID: "advertiser_1",
+        isTestMode: false,
+        hasSKAN: false
+      )
+    )
+    let invocation2 = try XCTUnwrap(
+      TestInvocation(
+        campaignID: name,
+        acsToken: name,
+        acsSharedSecret: nil,
+        acsConfigID: nil,
+        businessID: "advertiser_2",
+        isTestMode: false,
+        hasSKAN: false
+      )
+    )
+    invocation1.stubbedIsAttributed = false
+    invocation2.stubbedIsAttributed = false
+
+    _ = AEMReporter._attributedInvocation(
+      [invocation1, invocation2],
+      event: Values.purchase,
+      currency: nil,
+      value: nil,
+      parameters: ["fb_content": "[{\"id\":\"123\"}]"],
+      configs: [:]
+    )
+    XCTAssertNotNil(
+      invocation1.capturedEventParameters,
+      "Should try to attribute the event to every invocation"
+    )
+    XCTAssertTrue(
+      invocation1.capturedEventParameters === invocation2.capturedEventParameters,
+      "Should share the event parameters across the invocations"
+    )
+  }
+
   func testAttributedInvocationWithUnmatchedParameters() {
     let invocations = [
       SampleAEMData.invocationWithoutAdvertiserID,
@@ -823,6 +1149,11 @@ class FBAEMReporterTests: XCTestCase {
 
   // MARK: - Helpers
 
+  func sentReports() throws -> [Any] {
+    let reports = try XCTUnwrap(networker.capturedParameters["aem_conversions"] as? String)
+    return try XCTUnwrap(try JSONSerialization.jsonObject(with: Data(reports.utf8)) as? [Any])
+  }
+
   func removeReportFile() {
     do {
       try FileManager.default.removeItem(at: URL(fileURLWithPath: reportFilePath))
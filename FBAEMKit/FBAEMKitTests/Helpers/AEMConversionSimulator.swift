@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+import FBAEMKit
+import FBSDKCoreKit_Basics
+import Foundation
+
+/// Replays a stream of app events through `AEMReporter` with a stubbed networker, synchronously,
+/// and reports what the reporter did with them.
+class AEMConversionSimulator {
+
+  struct Event {
+    let name: String
+    let currency: String?
+    let value: NSNumber?
+    let parameters: [String: Any]?
+
+    init(name: String, currency: String? = nil, value: NSNumber? = nil, parameters: [String: Any]? = nil) {
+      self.name = name
+      self.currency = currency
+      self.value = value
+      self.parameters = parameters
+    }
+  }
+
+  struct Report {
+    /// The final conversion value of each invocation, by campaign ID
+    var conversionValues = [String: Int]()
+    /// The conversion value rules the rule matcher compared with the recorded events, for each event
+    var ruleEvaluations = [Int]()
+    /// The bytes appended to or rewritten in the report data file
+    var reportBytesWritten = 0
+    /// The bytes appended to or rewritten in the configuration file
+    var configBytesWritten = 0
+    var aggregationRequestCount = 0
+    /// The time `recordAndUpdateEvent` took for each event
+    var latencies = [TimeInterval]()
+
+    var totalRuleEvaluations: Int {
+      ruleEvaluations.reduce(0, +)
+    }
+
+    var bytesWritten: Int {
+      reportBytesWritten + configBytesWritten
+    }
+  }
+
+  /// Answers configuration requests with the fixture and aggregation requests with a success, synchronously
+  class Networker: NSObject, AEMNetworking {
+    let configs: [String: Any]
+    var aggregationRequestCount = 0
+
+    init(configs: [String: Any]) {
+      self.configs = configs
+    }
+
+    func startGraphRequest(
+      withGraphPath graphPath: String,
+      parameters: [String: Any],
+      tokenString: String?,
+      httpMethod method: String?,
+      completion: @escaping FBGraphRequestCompletion
+    ) {
+      if graphPath.hasSuffix("aem_conversion_configs") {
+        completion(configs, nil)
+      } else {
+        aggregationRequestCount += 1
+        completion(nil, nil)
+      }
+    }
+  }
+
+  let networker: Networker
+  let skAdNetworkReporter = TestSKAdNetworkReporter()
+  let reportFilePath: String
+  let configFilePath: String
+
+  /// - Parameter configs: A response of the `aem_conversion_configs` endpoint
+  init(configs: [String: Any], reportFilePath: String) {
+    networker = Networker(configs: configs)
+    self.reportFilePath = reportFilePath
+    configFilePath = reportFilePath + ".configs"
+  }
+
+  /// - Parameter configsJSON: The JSON of a response of the `aem_conversion_configs` endpoint
+  convenience init?(configsJSON: String, reportFilePath: String) {
+    guard
+      let data = configsJSON.data(using: .utf8),
+      let configs = try? JSONSerialization.jsonObject(with: data) as? [String: Any]
+    else {
+      return nil
+    }
+    self.init(configs: configs, reportFilePath: reportFilePath)
+  }
+
+  /// Decodes a recorded event stream, a JSON array of `event_name`, `currency`, `value` and `parameters` objects
+  static func events(fromJSON json: String) -> [Event] {
+    guard
+      let data = json.data(using: .utf8),
+      let events = try? JSONSerialization.jsonObject(with: data) as? [[String: Any]]
+    else {
+      return []
+    }
+    return events.compactMap { event in
+      guard let name = event["event_name"] as? String else {
+        return nil
+      }
+      return Event(
+        name: name,
+        currency: event["currency"] as? String,
+        value: event["value"] as? NSNumber,
+        parameters: event["parameters"] as? [String: Any]
+      )
+    }
+  }
+
+  func run(events: [Event], invocations: [AEMInvocation]) -> Report {
+    reset(invocations: invocations)
+
+    var report = Report()
+    for event in events {
+      AEMConversionRuleMatcher.evaluatedRuleCount = 0
+      let reportBytesWritten = writtenByteCount(AEMReporter._reportStore())
+      let configBytesWritten = writtenByteCount(AEMReporter._configStore())
+
+      let start = DispatchTime.now().uptimeNanoseconds
+      AEMReporter.recordAndUpdate(
+        event: event.name,
+        currency: event.currency,
+        value: event.value,
+        parameters: event.parameters
+      )
+      report.latencies.append(TimeInterval(DispatchTime.now().uptimeNanoseconds - start) / TimeInterval(NSEC_PER_SEC))
+
+      report.ruleEvaluations.append(Int(AEMConversionRuleMatcher.evaluatedRuleCount))
+      report.reportBytesWritten += writtenByteCount(AEMReporter._reportStore()) - reportBytesWritten
+      report.configBytesWritten += writtenByteCount(AEMReporter._configStore()) - configBytesWritten
+    }
+    for invocation in invocations {
+      report.conversionValues[invocation.campaignID] = invocation.conversionValue
+    }
+    report.aggregationRequestCount = networker.aggregationRequestCount
+    return report
+  }
+
+  // MARK: - Helpers
+
+  func reset(invocations: [AEMInvocation]) {
+    try? FileManager.default.removeItem(atPath: reportFilePath)
+    try? FileManager.default.removeItem(atPath: configFilePath)
+    AEMConfiguration.configure(withRuleProvider: AEMAdvertiserRuleFactory())
+    AEMReporter.configure(withNetworker: networker, appID: "123", reporter: skAdNetworkReporter)
+    // Any queue other than the designated one makes the reporter synchronous
+    AEMReporter.queue = DispatchQueue(label: String(describing: Self.self))
+    AEMReporter.isEnabled = true
+    AEMReporter.reportFilePath = reportFilePath
+    AEMReporter.configFilePath = configFilePath
+    AEMReporter.aggregationDebounceInterval = 0
+    AEMReporter.minimumAggregationRequestInterval = 0
+    AEMReporter.isAggregationRequestScheduled = false
+    AEMReporter.isLoadingConfiguration = false
+    AEMReporter.completionBlocks = []
+    AEMReporter.configs = [:]
+    AEMReporter.invocations = NSMutableArray(array: invocations)
+  }
+
+  func writtenByteCount(_ store: AEMRecordStore?) -> Int {
+    Int(store?.writtenByteCount ?? 0)
+  }
+}
@@ -13,6 +13,8 @@ class TestInvocation: AEMInvocation {
 
   var attributionCallCount = 0
   var updateConversionCallCount = 0
+  var capturedEventParameters: AEMEventParameters?
+  var stubbedIsAttributed = true
 
   override func attributeEvent(
     _ event: String,
@@ -25,6 +27,18 @@ class TestInvocation: AEMInvocation {
     return true
   }
 
+  override func attributeEvent(
+    _ event: String,
+    currency: String?,
+    value: NSNumber?,
+    eventParameters: AEMEventParameters,
+    configs: [String: [AEMConfiguration]]?
+  ) -> Bool {
+    attributionCallCount += 1
+    capturedEventParameters = eventParameters
+    return stubbedIsAttributed
+  }
+
   override func updateConversionValue(
     withConfigs configs: [String: [AEMConfiguration]]?
   ) -> Bool {
@@ -27,6 +27,10 @@
 #import "FBSDKAppEventsConfiguration.h"
 #import "FBSDKAppEventsConfigurationProviding.h"
 #import "FBSDKAppEventsDeviceInfo.h"
+#import "FBSDKAppEventsFlushExecutor.h"
+#import "FBSDKAppEventsFlushPolicy.h"
+#import "FBSDKAppEventsFlushResult.h"
+#import "FBSDKAppEventsParameterPipeline.h"
 #import "FBSDKAppEventsParameterProcessing.h"
 #import "FBSDKAppEventsReporter.h"
 #import "FBSDKAppEventsState.h"
@@ -43,6 +47,9 @@
 #import "FBSDKEventsProcessing.h"
 #import "FBSDKFeatureChecking.h"
 #import "FBSDKGateKeeperManaging.h"
+#import "FBSDKGraphRequestCircuitBreaker.h"
+#import "FBSDKGraphRequestConnecting.h"
+#import "FBSDKGraphRequestConnectionFactoryProtocol.h"
 #import "FBSDKGraphRequestFactoryProtocol.h"
 #import "FBSDKInternalUtility+Internal.h"
 #import "FBSDKLogger.h"
@@ -97,6 +104,9 @@ NSString *const FBSDKAPPEventsWKWebViewMessagesProtocolKey = @"fbmq-0.1";
 
 #define NUM_LOG_EVENTS_TO_TRY_TO_FLUSH_AFTER 100
 #define FLUSH_PERIOD_IN_SECONDS 15
+#define EAGER_FLUSH_COALESCING_WINDOW_IN_SECONDS 1
+// _eventName, _logTime, _valueToSum, _implicitlyLogged, _ui and _inBackground
+#define NUM_RESERVED_EVENT_KEYS 6
 #define USER_ID_USER_DEFAULTS_KEY @"com.facebook.sdk.appevents.userid"
 
 #define FBUnityUtilityClassName "FBUnityUtility"
@@ -109,6 +119,7 @@ static Class<FBSDKGateKeeperManaging> g_gateKeeperManager;
 static Class<FBSDKAppEventsConfigurationProviding> g_appEventsConfigurationProvider;
 static id<FBSDKServerConfigurationProviding> g_serverConfigurationProvider;
 static id<FBSDKGraphRequestFactory> g_graphRequestFactory;
+static id<FBSDKGraphRequestConnectionFactory> g_graphRequestConnectionFactory;
 static id<FBSDKFeatureChecking> g_featureChecker;
 static Class<FBSDKLogging> g_logger;
 static id<FBSDKSettings> g_settings;
@@ -124,6 +135,8 @@ static id<FBSDKAppEventsParameterProcessing, FBSDKEventsProcessing> g_restrictiv
 @property (nonatomic) UIApplicationState applicationState;
 @property (nonatomic, copy) NSString *pushNotificationsDeviceTokenString;
 @property (nonatomic, strong) dispatch_source_t flushTimer;
+@property (nonatomic, strong) FBSDKAppEventsFlushExecutor *flushExecutor;
+@property (nonatomic, strong) FBSDKAppEventsFlushPolicy *flushPolicy;
 @property (nonatomic, copy) NSString *userID;
 @property (nonatomic, strong) id<FBSDKAtePublishing> atePublisher;
 @property (nullable, nonatomic) Class<FBSDKSwizzling> swizzler;
@@ -176,6 +189,10 @@ static id<FBSDKAppEventsParameterProcessing, FBSDKEventsProcessing> g_restrictiv
   self = [super init];
   if (self) {
     _flushBehavior = flushBehavior;
+    _flushExecutor = [FBSDKAppEventsFlushExecutor new];
+    _flushPolicy = [[FBSDKAppEventsFlushPolicy alloc] initWithBaseInterval:flushPeriodInSeconds
+                                                            eventThreshold:NUM_LOG_EVENTS_TO_TRY_TO_FLUSH_AFTER
+                                                          coalescingWindow:EAGER_FLUSH_COALESCING_WINDOW_IN_SECONDS];
 
     __weak FBSDKAppEvents *weakSelf = self;
     self.flushTimer = [FBSDKUtility startGCDTimerWithInterval:flushPeriodInSeconds
@@ -184,11 +201,25 @@ static id<FBSDKAppEventsParameterProcessing, FBSDKEventsProcessing> g_restrictiv
                                                         }];
 
     self.applicationState = UIApplicationStateInactive;
+
+    // Hold back automatic flushes while Graph requests fail right away; they would only be persisted again.
+    [NSNotificationCenter.defaultCenter addObserver:self
+                                           selector:@selector(graphRequestCircuitBreakerStateDidChange:)
+                                               name:FBSDKGraphRequestCircuitBreakerStateDidChangeNotification
+                                             object:nil];
   }
 
   return self;
 }
 
+- (void)graphRequestCircuitBreakerStateDidChange:(NSNotification *)notification
+{
+  FBSDKGraphRequestCircuitBreaker *circuitBreaker = notification.object;
+  if ([circuitBreaker isKindOfClass:FBSDKGraphRequestCircuitBreaker.class]) {
+    self.flushPolicy.paused = g_settings.isGraphRequestCircuitBreakerEnabled && circuitBreaker.state == FBSDKCircuitBreakerStateOpen;
+  }
+}
+
 - (void)startObservingApplicationLifecycleNotifications
 {
   [NSNotificationCenter.defaultCenter
@@ -765,6 +796,7 @@ static id<FBSDKAppEventsParameterProcessing, FBSDKEventsProcessing> g_restrictiv
            appEventsConfigurationProvider:(Class<FBSDKAppEventsConfigurationProviding>)appEventsConfigurationProvider
               serverConfigurationProvider:(id<FBSDKServerConfigurationProviding>)serverConfigurationProvider
                       graphRequestFactory:(id<FBSDKGraphRequestFactory>)provider
+            graphRequestConnectionFactory:(id<FBSDKGraphRequestConnectionFactory>)graphRequestConnectionFactory
                            featureChecker:(id<FBSDKFeatureChecking>)featureChecker
                                     store:(id<FBSDKDataPersisting>)store
                                    logger:(Class<FBSDKLogging>)logger
@@ -785,6 +817,7 @@ static id<FBSDKAppEventsParameterProcessing, FBSDKEventsProcessing> g_restrictiv
   g_gateKeeperManager = gateKeeperManager;
   g_logger = logger;
   FBSDKAppEvents.graphRequestFactory = provider;
+  g_graphRequestConnectionFactory = graphRequestConnectionFactory;
   FBSDKAppEvents.featureChecker = featureChecker;
   g_settings = settings;
   g_paymentObserver = paymentObserver;
@@ -1011,9 +1044,35 @@ static id<FBSDKAppEventsParameterProcessing, FBSDKEventsProcessing> g_restrictiv
 
 - (void)flushForReason:(FBSDKAppEventsFlushReason)flushReason
 {
-  // Always flush asynchronously, even on main thread, for two reasons:
+  // Purchases, push token registration and the like each ask for an eager flush. Requests arriving
+  // within the coalescing window are folded into a single trailing flush.
+  if (flushReason == FBSDKAppEventsFlushReasonEagerlyFlushingEvent
+      && ![self.flushPolicy shouldPerformEagerFlushAtDate:[NSDate date]]) {
+    [self scheduleCoalescedEagerFlush];
+    return;
+  }
+  [self performFlushForReason:flushReason];
+}
+
+- (void)scheduleCoalescedEagerFlush
+{
+  NSTimeInterval delay = [self.flushPolicy eagerFlushDelayAtDate:[NSDate date]];
+  if (delay < 0) {
+    return;
+  }
+  __weak FBSDKAppEvents *weakSelf = self;
+  dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+    [weakSelf.flushPolicy recordTrailingEagerFlush];
+    [weakSelf performFlushForReason:FBSDKAppEventsFlushReasonEagerlyFlushingEvent];
+  });
+}
+
+- (void)performFlushForReason:(FBSDKAppEventsFlushReason)flushReason
+{
+  // Always flush asynchronously on the flush queue, even on main thread, for three reasons:
   // - most consistent code path for all threads.
   // - allow locks being held by caller to be released prior to actual flushing work being done.
+  // - keep serialization and event processing off the main thread.
   @synchronized(self) {
     if (!_appEventsState) {
       return;
@@ -1021,16 +1080,11 @@ static id<FBSDKAppEventsParameterProcessing, FBSDKEventsProcessing> g_restrictiv
     FBSDKAppEventsState *copy = [_appEventsState copy];
     _appEventsState = [self.appEventsStateProvider createStateWithToken:copy.tokenString
                                                                   appID:copy.appID];
+    [self.flushPolicy recordFlushAtDate:[NSDate date]];
 
-    dispatch_block_t block = ^{
-      [self flushOnMainQueue:copy forReason:flushReason];
-    };
-
-  #if DEBUG && FBTEST
-    block();
-  #else
-    dispatch_async(dispatch_get_main_queue(), block);
-  #endif
+    [self.flushExecutor execute:^{
+      [self flushAppEventsState:copy forReason:flushReason];
+    }];
   }
 }
 
@@ -1155,72 +1209,75 @@ static id<FBSDKAppEventsParameterProcessing, FBSDKEventsProcessing> g_restrictiv
 {
   [g_appEventsConfigurationProvider loadAppEventsConfigurationWithBlock:^{
     [g_serverConfigurationProvider loadServerConfigurationWithCompletionBlock:^(FBSDKServerConfiguration *serverConfiguration, NSError *error) {
-      self->_serverConfiguration = serverConfiguration;
-
-      if ([g_settings isAutoLogAppEventsEnabled] && self->_serverConfiguration.implicitPurchaseLoggingEnabled) {
-        [g_paymentObserver startObservingTransactions];
-      } else {
-        [g_paymentObserver stopObservingTransactions];
-      }
-      [g_featureChecker checkFeature:FBSDKFeatureRestrictiveDataFiltering completionBlock:^(BOOL enabled) {
-        if (enabled) {
-          [g_restrictiveDataFilterParameterProcessor enable];
+      // The providers may call back on the caller's thread, which is the flush queue when flushing
+      fb_dispatch_on_main_thread(^{
+        self->_serverConfiguration = serverConfiguration;
+
+        if ([g_settings isAutoLogAppEventsEnabled] && self->_serverConfiguration.implicitPurchaseLoggingEnabled) {
+          [g_paymentObserver startObservingTransactions];
+        } else {
+          [g_paymentObserver stopObservingTransactions];
         }
-      }];
-      [g_featureChecker checkFeature:FBSDKFeatureEventDeactivation completionBlock:^(BOOL enabled) {
-        if (enabled) {
-          [g_eventDeactivationParameterProcessor enable];
-        }
-      }];
-      if (@available(iOS 14.0, *)) {
-        __weak FBSDKAppEvents *weakSelf = self;
-        [g_featureChecker checkFeature:FBSDKFeatureATELogging completionBlock:^(BOOL enabled) {
+        [g_featureChecker checkFeature:FBSDKFeatureRestrictiveDataFiltering completionBlock:^(BOOL enabled) {
           if (enabled) {
-            [weakSelf publishATE];
+            [g_restrictiveDataFilterParameterProcessor enable];
           }
         }];
-      }
-    #if !TARGET_OS_TV
-      [g_featureChecker checkFeature:FBSDKFeatureCodelessEvents completionBlock:^(BOOL enabled) {
-        if (enabled) {
-          [self enableCodelessEvents];
-        }
-      }];
-      [g_featureChecker checkFeature:FBSDKFeatureAAM completionBlock:^(BOOL enabled) {
-        if (enabled) {
-          [self.metadataIndexer enable];
-        }
-      }];
-      [g_featureChecker checkFeature:FBSDKFeaturePrivacyProtection completionBlock:^(BOOL enabled) {
-        if (enabled) {
-          [self.onDeviceMLModelManager enable];
-        }
-      }];
-      if (@available(iOS 11.3, *)) {
-        if ([g_settings isSKAdNetworkReportEnabled]) {
-          [g_featureChecker checkFeature:FBSDKFeatureSKAdNetwork completionBlock:^(BOOL SKAdNetworkEnabled) {
-            if (SKAdNetworkEnabled) {
-              [SKAdNetwork registerAppForAdNetworkAttribution];
-              [g_featureChecker checkFeature:FBSDKFeatureSKAdNetworkConversionValue completionBlock:^(BOOL SKAdNetworkConversionValueEnabled) {
-                if (SKAdNetworkConversionValueEnabled) {
-                  [self.skAdNetworkReporter enable];
-                }
-              }];
+        [g_featureChecker checkFeature:FBSDKFeatureEventDeactivation completionBlock:^(BOOL enabled) {
+          if (enabled) {
+            [g_eventDeactivationParameterProcessor enable];
+          }
+        }];
+        if (@available(iOS 14.0, *)) {
+          __weak FBSDKAppEvents *weakSelf = self;
+          [g_featureChecker checkFeature:FBSDKFeatureATELogging completionBlock:^(BOOL enabled) {
+            if (enabled) {
+              [weakSelf publishATE];
             }
           }];
         }
-      }
-      if (@available(iOS 14.0, *)) {
-        [g_featureChecker checkFeature:FBSDKFeatureAEM completionBlock:^(BOOL AEMEnabled) {
-          if (AEMEnabled) {
-            [FBAEMReporter enable];
+      #if !TARGET_OS_TV
+        [g_featureChecker checkFeature:FBSDKFeatureCodelessEvents completionBlock:^(BOOL enabled) {
+          if (enabled) {
+            [self enableCodelessEvents];
           }
         }];
-      }
-    #endif
-      if (callback) {
-        callback();
-      }
+        [g_featureChecker checkFeature:FBSDKFeatureAAM completionBlock:^(BOOL enabled) {
+          if (enabled) {
+            [self.metadataIndexer enable];
+          }
+        }];
+        [g_featureChecker checkFeature:FBSDKFeaturePrivacyProtection completionBlock:^(BOOL enabled) {
+          if (enabled) {
+            [self.onDeviceMLModelManager enable];
+          }
+        }];
+        if (@available(iOS 11.3, *)) {
+          if ([g_settings isSKAdNetworkReportEnabled]) {
+            [g_featureChecker checkFeature:FBSDKFeatureSKAdNetwork completionBlock:^(BOOL SKAdNetworkEnabled) {
+              if (SKAdNetworkEnabled) {
+                [SKAdNetwork registerAppForAdNetworkAttribution];
+                [g_featureChecker checkFeature:FBSDKFeatureSKAdNetworkConversionValue completionBlock:^(BOOL SKAdNetworkConversionValueEnabled) {
+                  if (SKAdNetworkConversionValueEnabled) {
+                    [self.skAdNetworkReporter enable];
+                  }
+                }];
+              }
+            }];
+          }
+        }
+        if (@available(iOS 14.0, *)) {
+          [g_featureChecker checkFeature:FBSDKFeatureAEM completionBlock:^(BOOL AEMEnabled) {
+            if (AEMEnabled) {
+              [FBAEMReporter enable];
+            }
+          }];
+        }
+      #endif
+        if (callback) {
+          callback();
+        }
+      });
     }];
   }];
 }
@@ -1271,40 +1328,22 @@ static id<FBSDKAppEventsParameterProcessing, FBSDKEventsProcessing> g_restrictiv
   if (!isImplicitlyLogged && !g_explicitEventsLoggedYet) {
     g_explicitEventsLoggedYet = YES;
   }
-  __block BOOL failed = ![FBSDKAppEventsUtility validateIdentifier:eventName];
-
-  // Make sure parameter dictionary is well formed.  Log and exit if not.
-  [FBSDKTypeUtility dictionary:parameters enumerateKeysAndObjectsUsingBlock:^(id key, id obj, BOOL *stop) {
-    if (![key isKindOfClass:NSString.class]) {
-      [FBSDKAppEventsUtility logAndNotify:[NSString stringWithFormat:@"The keys in the parameters must be NSStrings, '%@' is not.", key]];
-      failed = YES;
-    }
-    if (![FBSDKAppEventsUtility validateIdentifier:key]) {
-      failed = YES;
-    }
-    if (![obj isKindOfClass:NSString.class] && ![obj isKindOfClass:NSNumber.class]) {
-      [FBSDKAppEventsUtility logAndNotify:[NSString stringWithFormat:@"The values in the parameters dictionary must be NSStrings or NSNumbers, '%@' is not.", obj]];
-      failed = YES;
-    }
-  }];
-
-  if (failed) {
-    return;
-  }
-  // Filter out deactivated params
-  parameters = [g_eventDeactivationParameterProcessor processParameters:parameters eventName:eventName];
-
+  // Deactivated params, restrictive data found with on-device ML and restrictive keys are filtered out
+  // in place, on the buffer that becomes the event dictionary.
+  NSMutableArray<id<FBSDKAppEventsParameterProcessing>> *stages = [NSMutableArray arrayWithCapacity:3];
+  [FBSDKTypeUtility array:stages addObject:g_eventDeactivationParameterProcessor];
 #if !TARGET_OS_TV
-  // Filter out restrictive data with on-device ML
-  if (self.onDeviceMLModelManager.integrityParametersProcessor) {
-    parameters = [self.onDeviceMLModelManager.integrityParametersProcessor processParameters:parameters eventName:eventName];
-  }
+  [FBSDKTypeUtility array:stages addObject:self.onDeviceMLModelManager.integrityParametersProcessor];
 #endif
-  // Filter out restrictive keys
-  parameters = [g_restrictiveDataFilterParameterProcessor processParameters:parameters
-                                                                  eventName:eventName];
+  [FBSDKTypeUtility array:stages addObject:g_restrictiveDataFilterParameterProcessor];
 
-  NSMutableDictionary<NSString *, id> *eventDictionary = [NSMutableDictionary dictionaryWithDictionary:parameters];
+  NSMutableDictionary<NSString *, id> *eventDictionary = [FBSDKAppEventsParameterPipeline eventDictionaryForEventName:eventName
+                                                                                                           parameters:parameters
+                                                                                                               stages:stages
+                                                                                                     reservedCapacity:NUM_RESERVED_EVENT_KEYS];
+  if (!eventDictionary) {
+    return;
+  }
   [FBSDKTypeUtility dictionary:eventDictionary setObject:eventName forKey:FBSDKAppEventParameterNameEventName];
   if (!eventDictionary[FBSDKAppEventParameterNameLogTime]) {
     [FBSDKTypeUtility dictionary:eventDictionary setObject:@([FBSDKAppEventsUtility unixTimeNow]) forKey:FBSDKAppEventParameterNameLogTime];
@@ -1342,18 +1381,23 @@ static id<FBSDKAppEventsParameterProcessing, FBSDKEventsProcessing> g_restrictiv
   NSString *appID = [self appID];
 
   @synchronized(self) {
+    NSMutableArray<FBSDKAppEventsState *> *statesToFlush = [NSMutableArray array];
     if (!_appEventsState) {
       _appEventsState = [self.appEventsStateProvider createStateWithToken:tokenString appID:appID];
     } else if (![_appEventsState isCompatibleWithTokenString:tokenString appID:appID]) {
       if (self.flushBehavior == FBSDKAppEventsFlushBehaviorExplicitOnly) {
         [g_appEventsStateStore persistAppEventsData:_appEventsState];
       } else {
-        [self flushForReason:FBSDKAppEventsFlushReasonSessionChange];
+        // Flushed together with any incompatible persisted states below.
+        [FBSDKTypeUtility array:statesToFlush addObject:[_appEventsState copy]];
+        [self.flushPolicy recordFlushAtDate:[NSDate date]];
       }
       _appEventsState = [self.appEventsStateProvider createStateWithToken:tokenString appID:appID];
     }
 
     [_appEventsState addEvent:eventDictionary isImplicit:isImplicitlyLogged];
+    [self.flushPolicy recordEventWithEstimatedBytes:[FBSDKAppEventsFlushPolicy estimatedBytesForEvent:eventDictionary]
+                                               date:[NSDate date]];
     if (!isImplicitlyLogged) {
       NSString *message = [NSString stringWithFormat:@"FBSDKAppEvents: Recording event @ %f: %@",
                            [FBSDKAppEventsUtility unixTimeNow],
@@ -1362,9 +1406,10 @@ static id<FBSDKAppEventsParameterProcessing, FBSDKEventsProcessing> g_restrictiv
                           logEntry:message];
     }
 
-    [self checkPersistedEvents];
+    [self checkPersistedEventsFlushingStates:statesToFlush
+                                   forReason:statesToFlush.count > 0 ? FBSDKAppEventsFlushReasonSessionChange : FBSDKAppEventsFlushReasonPersistedEvents];
 
-    if (_appEventsState.events.count > NUM_LOG_EVENTS_TO_TRY_TO_FLUSH_AFTER
+    if ([self.flushPolicy shouldFlushWithPendingEventCount:_appEventsState.events.count]
         && self.flushBehavior != FBSDKAppEventsFlushBehaviorExplicitOnly) {
       [self flushForReason:FBSDKAppEventsFlushReasonEventThreshold];
     }
@@ -1373,148 +1418,259 @@ static id<FBSDKAppEventsParameterProcessing, FBSDKEventsProcessing> g_restrictiv
 
 #pragma clang diagnostic pop
 
+- (void)checkPersistedEvents
+{
+  [self checkPersistedEventsFlushingStates:@[] forReason:FBSDKAppEventsFlushReasonPersistedEvents];
+}
+
 // this fetches persisted event states.
 // for those matching the currently tracked events, add it.
 // otherwise, either flush (if not explicitonly behavior) or persist them back.
-- (void)checkPersistedEvents
+// Everything that needs flushing, including `statesToFlush`, is sent in a single batch request.
+- (void)checkPersistedEventsFlushingStates:(NSArray<FBSDKAppEventsState *> *)statesToFlush
+                                 forReason:(FBSDKAppEventsFlushReason)reason
 {
+  NSMutableArray<FBSDKAppEventsState *> *pendingStates = [NSMutableArray arrayWithArray:statesToFlush];
   NSArray *existingEventsStates = [g_appEventsStateStore retrievePersistedAppEventsStates];
-  if (existingEventsStates.count == 0) {
-    return;
-  }
-  FBSDKAppEventsState *matchingEventsPreviouslySaved = nil;
-  // reduce lock time by creating a new FBSDKAppEventsState to collect matching persisted events.
-  @synchronized(self) {
-    if (_appEventsState) {
-      matchingEventsPreviouslySaved = [self.appEventsStateProvider createStateWithToken:_appEventsState.tokenString
-                                                                                  appID:_appEventsState.appID];
+  if (existingEventsStates.count > 0) {
+    FBSDKAppEventsState *matchingEventsPreviouslySaved = nil;
+    // reduce lock time by creating a new FBSDKAppEventsState to collect matching persisted events.
+    @synchronized(self) {
+      if (_appEventsState) {
+        matchingEventsPreviouslySaved = [self.appEventsStateProvider createStateWithToken:_appEventsState.tokenString
+                                                                                    appID:_appEventsState.appID];
+      }
     }
-  }
-  for (FBSDKAppEventsState *saved in existingEventsStates) {
-    if ([saved isCompatibleWithAppEventsState:matchingEventsPreviouslySaved]) {
-      [matchingEventsPreviouslySaved addEventsFromAppEventState:saved];
-    } else {
-      if (self.flushBehavior == FBSDKAppEventsFlushBehaviorExplicitOnly) {
-        [g_appEventsStateStore persistAppEventsData:saved];
+    for (FBSDKAppEventsState *saved in existingEventsStates) {
+      if ([saved isCompatibleWithAppEventsState:matchingEventsPreviouslySaved]) {
+        [matchingEventsPreviouslySaved addEventsFromAppEventState:saved];
       } else {
-        dispatch_async(dispatch_get_main_queue(), ^{
-          [self flushOnMainQueue:saved forReason:FBSDKAppEventsFlushReasonPersistedEvents];
-        });
+        if (self.flushBehavior == FBSDKAppEventsFlushBehaviorExplicitOnly) {
+          [g_appEventsStateStore persistAppEventsData:saved];
+        } else {
+          [FBSDKTypeUtility array:pendingStates addObject:saved];
+        }
       }
     }
-  }
-  if (matchingEventsPreviouslySaved.events.count > 0) {
-    @synchronized(self) {
-      if ([_appEventsState isCompatibleWithAppEventsState:matchingEventsPreviouslySaved]) {
-        [_appEventsState addEventsFromAppEventState:matchingEventsPreviouslySaved];
+    if (matchingEventsPreviouslySaved.events.count > 0) {
+      @synchronized(self) {
+        if ([_appEventsState isCompatibleWithAppEventsState:matchingEventsPreviouslySaved]) {
+          [_appEventsState addEventsFromAppEventState:matchingEventsPreviouslySaved];
+        }
       }
     }
   }
+  if (pendingStates.count > 0) {
+    [self.flushExecutor execute:^{
+      [self flushAppEventsStates:pendingStates forReason:reason];
+    }];
+  }
 }
 
-- (void)flushOnMainQueue:(FBSDKAppEventsState *)appEventsState
-               forReason:(FBSDKAppEventsFlushReason)reason
+- (void)flushAppEventsState:(FBSDKAppEventsState *)appEventsState
+                  forReason:(FBSDKAppEventsFlushReason)reason
 {
-  if (appEventsState.events.count == 0) {
-    return;
-  }
+  [self flushAppEventsStates:@[appEventsState] forReason:reason];
+}
 
-  if (appEventsState.appID.length == 0) {
-    [g_logger singleShotLogEntry:FBSDKLoggingBehaviorDeveloperErrors logEntry:@"Missing [FBSDKAppEvents appEventsState.appID] for [FBSDKAppEvents flushOnMainQueue:]"];
+// Runs on the flush queue. The server configuration callback always runs on the main queue, and only the
+// serialization and the network work are handed back to the flush queue.
+- (void)flushAppEventsStates:(NSArray<FBSDKAppEventsState *> *)appEventsStates
+                   forReason:(FBSDKAppEventsFlushReason)reason
+{
+  NSMutableArray<FBSDKAppEventsState *> *statesToFlush = [NSMutableArray array];
+  for (FBSDKAppEventsState *appEventsState in appEventsStates) {
+    if (appEventsState.events.count == 0) {
+      continue;
+    }
+    if (appEventsState.appID.length == 0) {
+      [g_logger singleShotLogEntry:FBSDKLoggingBehaviorDeveloperErrors logEntry:@"Missing [FBSDKAppEvents appEventsState.appID] for [FBSDKAppEvents flushAppEventsStates:]"];
+      continue;
+    }
+    [FBSDKTypeUtility array:statesToFlush addObject:appEventsState];
+  }
+  if (statesToFlush.count == 0) {
     return;
   }
 
-  [FBSDKAppEventsUtility ensureOnMainThread:NSStringFromSelector(_cmd) className:NSStringFromClass(self.class)];
+  FBSDKAppEventsFlushExecutor *executor = self.flushExecutor;
+  NSUInteger flushIdentifier = [executor beginFlush];
 
   [self fetchServerConfiguration:^(void) {
-    if ([FBSDKAppEventsUtility shouldDropAppEvent]) {
-      return;
-    }
-    NSString *receipt_data = appEventsState.extractReceiptData;
-    const BOOL shouldIncludeImplicitEvents = (self->_serverConfiguration.implicitLoggingEnabled && g_settings.isAutoLogAppEventsEnabled);
-    NSString *encodedEvents = [appEventsState JSONStringForEventsIncludingImplicitEvents:shouldIncludeImplicitEvents];
-    if (!encodedEvents || appEventsState.events.count == 0) {
-      [g_logger singleShotLogEntry:FBSDKLoggingBehaviorAppEvents
-                          logEntry:@"FBSDKAppEvents: Flushing skipped - no events after removing implicitly logged ones.\n"];
-      return;
-    }
-    NSMutableDictionary<NSString *, id> *postParameters = [FBSDKAppEventsUtility
-                                                           activityParametersDictionaryForEvent:@"CUSTOM_APP_EVENTS"
-                                                           shouldAccessAdvertisingID:self->_serverConfiguration.advertisingIDEnabled];
-    NSInteger length = receipt_data.length;
-    if (length > 0) {
-      [FBSDKTypeUtility dictionary:postParameters setObject:receipt_data forKey:@"receipt_data"];
-    }
+    [executor measureMainThreadWork:^{
+      if ([FBSDKAppEventsUtility shouldDropAppEvent]) {
+        [executor finishFlush:flushIdentifier];
+        return;
+      }
+      // Capture the state that is owned by the main thread before leaving it.
+      const BOOL shouldIncludeImplicitEvents = (self->_serverConfiguration.implicitLoggingEnabled && g_settings.isAutoLogAppEventsEnabled);
+      const BOOL shouldAccessAdvertisingID = self->_serverConfiguration.advertisingIDEnabled;
+      NSString *pushNotificationsDeviceTokenString = self.pushNotificationsDeviceTokenString;
+
+      [executor execute:^{
+        [self sendAppEventsStates:statesToFlush
+                        forReason:reason
+                  flushIdentifier:flushIdentifier
+      shouldIncludeImplicitEvents:shouldIncludeImplicitEvents
+        shouldAccessAdvertisingID:shouldAccessAdvertisingID
+               deviceTokenString:pushNotificationsDeviceTokenString];
+      }];
+    } forFlush:flushIdentifier];
+  }];
+}
 
-    [FBSDKTypeUtility dictionary:postParameters setObject:encodedEvents forKey:@"custom_events"];
-    if (appEventsState.numSkipped > 0) {
-      [FBSDKTypeUtility dictionary:postParameters setObject:[NSString stringWithFormat:@"%lu", (unsigned long)appEventsState.numSkipped] forKey:@"num_skipped_events"];
-    }
-    if (self.pushNotificationsDeviceTokenString) {
-      [FBSDKTypeUtility dictionary:postParameters setObject:self.pushNotificationsDeviceTokenString forKey:FBSDKActivitesParameterPushDeviceToken];
+// Sends one `/activities` request per state. Several states go out as a single batch request where
+// each entry carries the access token of its own state.
+- (void)sendAppEventsStates:(NSArray<FBSDKAppEventsState *> *)appEventsStates
+                  forReason:(FBSDKAppEventsFlushReason)reason
+            flushIdentifier:(NSUInteger)flushIdentifier
+shouldIncludeImplicitEvents:(BOOL)shouldIncludeImplicitEvents
+  shouldAccessAdvertisingID:(BOOL)shouldAccessAdvertisingID
+          deviceTokenString:(nullable NSString *)deviceTokenString
+{
+  FBSDKAppEventsFlushExecutor *executor = self.flushExecutor;
+  NSMutableArray<id<FBSDKGraphRequest>> *requests = [NSMutableArray array];
+  NSMutableArray<FBSDKGraphRequestCompletion> *completions = [NSMutableArray array];
+  __block NSUInteger pendingCompletionCount = 0;
+  // A flush counts once in the flush policy however many states it sends. A connectivity failure of any of them
+  // makes it a failed flush.
+  __block FBSDKAppEventsFlushResult flushResult = FBSDKAppEventsFlushResultSuccess;
+
+  for (FBSDKAppEventsState *appEventsState in appEventsStates) {
+    NSString *loggingEntry = nil;
+    id<FBSDKGraphRequest> request = [self activitiesRequestForAppEventsState:appEventsState
+                                                                   forReason:reason
+                                                 shouldIncludeImplicitEvents:shouldIncludeImplicitEvents
+                                                   shouldAccessAdvertisingID:shouldAccessAdvertisingID
+                                                           deviceTokenString:deviceTokenString
+                                                                loggingEntry:&loggingEntry];
+    if (!request) {
+      continue;
     }
+    FBSDKGraphRequestCompletion completion = ^(id<FBSDKGraphRequestConnecting> connection, id result, NSError *error) {
+      [executor measureMainThreadWork:^{
+        [executor execute:^{
+          FBSDKAppEventsFlushResult result = [self handleActivitiesPostCompletion:error
+                                                                     loggingEntry:loggingEntry
+                                                                   appEventsState:appEventsState];
+          if (flushResult != FBSDKAppEventsFlushResultNoConnectivity) {
+            flushResult = result;
+          }
+          if (--pendingCompletionCount == 0) {
+            [self.flushPolicy recordFlushResult:flushResult];
+            [executor finishFlush:flushIdentifier];
+          }
+        }];
+      } forFlush:flushIdentifier];
+    };
+    [FBSDKTypeUtility array:requests addObject:request];
+    [FBSDKTypeUtility array:completions addObject:completion];
+  }
+  pendingCompletionCount = requests.count;
 
-    NSString *loggingEntry = nil;
-    if ([g_settings.loggingBehaviors containsObject:FBSDKLoggingBehaviorAppEvents]) {
-      NSData *prettyJSONData = [FBSDKTypeUtility dataWithJSONObject:appEventsState.events
-                                                            options:NSJSONWritingPrettyPrinted
-                                                              error:NULL];
-      NSString *prettyPrintedJsonEvents = [[NSString alloc] initWithData:prettyJSONData
-                                                                encoding:NSUTF8StringEncoding];
-      // Remove this param -- just an encoding of the events which we pretty print later.
-      NSMutableDictionary<NSString *, id> *paramsForPrinting = [postParameters mutableCopy];
-      [paramsForPrinting removeObjectForKey:@"custom_events_file"];
-
-      loggingEntry = [NSString stringWithFormat:@"FBSDKAppEvents: Flushed @ %f, %lu events due to '%@' - %@\nEvents: %@",
-                      [FBSDKAppEventsUtility unixTimeNow],
-                      (unsigned long)appEventsState.events.count,
-                      [FBSDKAppEventsUtility flushReasonToString:reason],
-                      paramsForPrinting,
-                      prettyPrintedJsonEvents];
+  if (requests.count == 0) {
+    [executor finishFlush:flushIdentifier];
+    return;
+  }
+
+  // Batch requests require an app ID for `batch_app_id`. Without one, fall back to individual requests.
+  id<FBSDKGraphRequestConnecting> connection = nil;
+  if (requests.count > 1 && g_settings.appID.length > 0) {
+    connection = [g_graphRequestConnectionFactory createGraphRequestConnection];
+  }
+  if (connection) {
+    for (NSUInteger index = 0; index < requests.count; index++) {
+      [connection addRequest:[FBSDKTypeUtility array:requests objectAtIndex:index]
+                  completion:[FBSDKTypeUtility array:completions objectAtIndex:index]];
     }
-    id<FBSDKGraphRequest> request = [g_graphRequestFactory createGraphRequestWithGraphPath:[NSString stringWithFormat:@"%@/activities", appEventsState.appID]
-                                                                                parameters:postParameters
-                                                                               tokenString:appEventsState.tokenString
-                                                                                HTTPMethod:FBSDKHTTPMethodPOST
-                                                                                     flags:FBSDKGraphRequestFlagDoNotInvalidateTokenOnError | FBSDKGraphRequestFlagDisableErrorRecovery];
-    [request startWithCompletion:^(id<FBSDKGraphRequestConnecting> connection, id result, NSError *error) {
-      [self handleActivitiesPostCompletion:error
-                              loggingEntry:loggingEntry
-                            appEventsState:(FBSDKAppEventsState *)appEventsState];
-    }];
-  }];
+    [connection start];
+  } else {
+    for (NSUInteger index = 0; index < requests.count; index++) {
+      [[FBSDKTypeUtility array:requests objectAtIndex:index] startWithCompletion:[FBSDKTypeUtility array:completions objectAtIndex:index]];
+    }
+  }
 }
 
-- (void)handleActivitiesPostCompletion:(NSError *)error
-                          loggingEntry:(NSString *)loggingEntry
-                        appEventsState:(FBSDKAppEventsState *)appEventsState
+- (nullable id<FBSDKGraphRequest>)activitiesRequestForAppEventsState:(FBSDKAppEventsState *)appEventsState
+                                                           forReason:(FBSDKAppEventsFlushReason)reason
+                                         shouldIncludeImplicitEvents:(BOOL)shouldIncludeImplicitEvents
+                                           shouldAccessAdvertisingID:(BOOL)shouldAccessAdvertisingID
+                                                   deviceTokenString:(nullable NSString *)deviceTokenString
+                                                        loggingEntry:(NSString **)loggingEntryRef
 {
-  typedef NS_ENUM(NSUInteger, FBSDKAppEventsFlushResult) {
-    FlushResultSuccess,
-    FlushResultServerError,
-    FlushResultNoConnectivity,
-  };
+  NSString *receipt_data = appEventsState.extractReceiptData;
+  NSString *encodedEvents = [appEventsState JSONStringForEventsIncludingImplicitEvents:shouldIncludeImplicitEvents];
+  if (!encodedEvents || appEventsState.events.count == 0) {
+    [g_logger singleShotLogEntry:FBSDKLoggingBehaviorAppEvents
+                        logEntry:@"FBSDKAppEvents: Flushing skipped - no events after removing implicitly logged ones.\n"];
+    return nil;
+  }
+  NSMutableDictionary<NSString *, id> *postParameters = [FBSDKAppEventsUtility
+                                                         activityParametersDictionaryForEvent:@"CUSTOM_APP_EVENTS"
+                                                         shouldAccessAdvertisingID:shouldAccessAdvertisingID];
+  NSInteger length = receipt_data.length;
+  if (length > 0) {
+    [FBSDKTypeUtility dictionary:postParameters setObject:receipt_data forKey:@"receipt_data"];
+  }
 
-  [FBSDKAppEventsUtility ensureOnMainThread:NSStringFromSelector(_cmd) className:NSStringFromClass(self.class)];
+  [FBSDKTypeUtility dictionary:postParameters setObject:encodedEvents forKey:@"custom_events"];
+  if (appEventsState.numSkipped > 0) {
+    [FBSDKTypeUtility dictionary:postParameters setObject:[NSString stringWithFormat:@"%lu", (unsigned long)appEventsState.numSkipped] forKey:@"num_skipped_events"];
+  }
+  if (deviceTokenString) {
+    [FBSDKTypeUtility dictionary:postParameters setObject:deviceTokenString forKey:FBSDKActivitesParameterPushDeviceToken];
+  }
+
+  if ([g_settings.loggingBehaviors containsObject:FBSDKLoggingBehaviorAppEvents] && loggingEntryRef != NULL) {
+    NSData *prettyJSONData = [FBSDKTypeUtility dataWithJSONObject:appEventsState.events
+                                                          options:NSJSONWritingPrettyPrinted
+                                                            error:NULL];
+    NSString *prettyPrintedJsonEvents = [[NSString alloc] initWithData:prettyJSONData
+                                                              encoding:NSUTF8StringEncoding];
+    // Remove this param -- just an encoding of the events which we pretty print later.
+    NSMutableDictionary<NSString *, id> *paramsForPrinting = [postParameters mutableCopy];
+    [paramsForPrinting removeObjectForKey:@"custom_events_file"];
+
+    *loggingEntryRef = [NSString stringWithFormat:@"FBSDKAppEvents: Flushed @ %f, %lu events due to '%@' - %@\nEvents: %@",
+                        [FBSDKAppEventsUtility unixTimeNow],
+                        (unsigned long)appEventsState.events.count,
+                        [FBSDKAppEventsUtility flushReasonToString:reason],
+                        paramsForPrinting,
+                        prettyPrintedJsonEvents];
+  }
+  return [g_graphRequestFactory createGraphRequestWithGraphPath:[NSString stringWithFormat:@"%@/activities", appEventsState.appID]
+                                                     parameters:postParameters
+                                                    tokenString:appEventsState.tokenString
+                                                     HTTPMethod:FBSDKHTTPMethodPOST
+                                                          flags:FBSDKGraphRequestFlagDoNotInvalidateTokenOnError | FBSDKGraphRequestFlagDisableErrorRecovery | FBSDKGraphRequestFlagBackgroundPriority | FBSDKGraphRequestFlagRetryTransientFailures];
+}
 
-  FBSDKAppEventsFlushResult flushResult = FlushResultSuccess;
+- (FBSDKAppEventsFlushResult)handleActivitiesPostCompletion:(NSError *)error
+                                               loggingEntry:(NSString *)loggingEntry
+                                             appEventsState:(FBSDKAppEventsState *)appEventsState
+{
+  FBSDKAppEventsFlushResult flushResult = FBSDKAppEventsFlushResultSuccess;
   if (error) {
     NSInteger errorCode = [error.userInfo[FBSDKGraphRequestErrorHTTPStatusCodeKey] integerValue];
 
     // We interpret a 400 coming back from FBRequestConnection as a server error due to improper data being
     // sent down.  Otherwise we assume no connectivity, or another condition where we could treat it as no connectivity.
     // Adding 404 as having wrong/missing appID results in 404 and that is not a connectivity issue
-    flushResult = (errorCode == 400 || errorCode == 404) ? FlushResultServerError : FlushResultNoConnectivity;
+    flushResult = (errorCode == 400 || errorCode == 404) ? FBSDKAppEventsFlushResultServerError : FBSDKAppEventsFlushResultNoConnectivity;
   }
 
-  if (flushResult == FlushResultServerError) {
+  if (flushResult == FBSDKAppEventsFlushResultServerError) {
     // Only log events that developer can do something with (i.e., if parameters are incorrect).
     // as opposed to cases where the token is bad.
     if ([error.userInfo[FBSDKGraphRequestErrorKey] unsignedIntegerValue] == FBSDKGraphRequestErrorOther) {
       NSString *message = [NSString stringWithFormat:@"Failed to send AppEvents: %@", error];
-      [FBSDKAppEventsUtility logAndNotify:message allowLogAsDeveloperError:!appEventsState.areAllEventsImplicit];
+      BOOL allowLogAsDeveloperError = !appEventsState.areAllEventsImplicit;
+      // Observers of the logging result notification expect it on the main thread
+      fb_dispatch_on_main_thread(^{
+        [FBSDKAppEventsUtility logAndNotify:message allowLogAsDeveloperError:allowLogAsDeveloperError];
+      });
     }
-  } else if (flushResult == FlushResultNoConnectivity) {
+  } else if (flushResult == FBSDKAppEventsFlushResultNoConnectivity) {
     @synchronized(self) {
       if ([appEventsState isCompatibleWithAppEventsState:_appEventsState]) {
         [_appEventsState addEventsFromAppEventState:appEventsState];
@@ -1527,15 +1683,15 @@ static id<FBSDKAppEventsParameterProcessing, FBSDKEventsProcessing> g_restrictiv
 
   NSString *resultString = @"<unknown>";
   switch (flushResult) {
-    case FlushResultSuccess:
+    case FBSDKAppEventsFlushResultSuccess:
       resultString = @"Success";
       break;
 
-    case FlushResultNoConnectivity:
+    case FBSDKAppEventsFlushResultNoConnectivity:
       resultString = @"No Connectivity";
       break;
 
-    case FlushResultServerError:
+    case FBSDKAppEventsFlushResultServerError:
       resultString = [NSString stringWithFormat:@"Server Error - %@", error.description];
       break;
   }
@@ -1543,12 +1699,20 @@ static id<FBSDKAppEventsParameterProcessing, FBSDKEventsProcessing> g_restrictiv
   NSString *message = [NSString stringWithFormat:@"%@\nFlush Result : %@", loggingEntry, resultString];
   [g_logger singleShotLogEntry:FBSDKLoggingBehaviorAppEvents
                       logEntry:message];
+  return flushResult;
 }
 
 - (void)flushTimerFired:(id)arg
 {
   [FBSDKAppEventsUtility ensureOnMainThread:NSStringFromSelector(_cmd) className:NSStringFromClass(self.class)];
-  if (self.flushBehavior != FBSDKAppEventsFlushBehaviorExplicitOnly && !self.disableTimer) {
+  if (self.flushBehavior == FBSDKAppEventsFlushBehaviorExplicitOnly || self.disableTimer) {
+    return;
+  }
+  NSUInteger pendingEventCount = 0;
+  @synchronized(self) {
+    pendingEventCount = _appEventsState.events.count;
+  }
+  if ([self.flushPolicy shouldFlushOnTimerWithPendingEventCount:pendingEventCount date:[NSDate date]]) {
     [self flushForReason:FBSDKAppEventsFlushReasonTimer];
   }
 }
@@ -1581,6 +1745,12 @@ static id<FBSDKAppEventsParameterProcessing, FBSDKEventsProcessing> g_restrictiv
   [self.timeSpentRecorder suspend];
 }
 
+- (void)setApplicationState:(UIApplicationState)applicationState
+{
+  _applicationState = applicationState;
+  self.flushPolicy.applicationState = applicationState;
+}
+
 #pragma mark - Configuration Validation
 
 - (void)validateConfiguration
@@ -1650,6 +1820,7 @@ static id<FBSDKAppEventsParameterProcessing, FBSDKEventsProcessing> g_restrictiv
   [self resetApplicationState];
   g_gateKeeperManager = nil;
   g_graphRequestFactory = nil;
+  g_graphRequestConnectionFactory = nil;
 }
 
 + (void)setSingletonInstanceToInstance:(FBSDKAppEvents *)appEvents
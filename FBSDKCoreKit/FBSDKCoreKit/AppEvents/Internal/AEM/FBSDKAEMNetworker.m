@@ -23,11 +23,17 @@
                             HTTPMethod:(nullable NSString *)method
                             completion:(FBGraphRequestCompletion)completion
 {
+  // Configuration and aggregation requests are held back while the server is failing.
+  FBSDKGraphRequestFlags flags = FBSDKGraphRequestFlagSkipClientToken | FBSDKGraphRequestFlagDisableErrorRecovery | FBSDKGraphRequestFlagUsesCircuitBreaker;
+  // Configurations are fetched with GET, can be revalidated instead of downloaded again and are safe to retry.
+  if (!method || [method.uppercaseString isEqualToString:FBSDKHTTPMethodGET]) {
+    flags |= FBSDKGraphRequestFlagUseResponseCache | FBSDKGraphRequestFlagRetryTransientFailures;
+  }
   id<FBSDKGraphRequest> graphRequest = [[FBSDKGraphRequest alloc] initWithGraphPath:graphPath
                                                                          parameters:parameters
                                                                         tokenString:tokenString
                                                                          HTTPMethod:method
-                                                                              flags:FBSDKGraphRequestFlagSkipClientToken | FBSDKGraphRequestFlagDisableErrorRecovery];
+                                                                              flags:flags];
 
   [graphRequest startWithCompletion:^(id<FBSDKGraphRequestConnecting> _Nullable connection, id _Nullable result, NSError *_Nullable error) {
     completion(result, error);
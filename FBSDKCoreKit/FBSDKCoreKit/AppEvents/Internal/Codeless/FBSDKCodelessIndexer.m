@@ -17,9 +17,11 @@
 #import <sys/sysctl.h>
 #import <sys/utsname.h>
 
+#import "FBSDKAccessToken.h"
 #import "FBSDKAdvertiserIDProviding.h"
 #import "FBSDKAppEventsUtility.h"
 #import "FBSDKDataPersisting.h"
+#import "FBSDKGraphRequestCoalescer.h"
 #import "FBSDKGraphRequestConnecting.h"
 #import "FBSDKGraphRequestConnectionFactoryProtocol.h"
 #import "FBSDKGraphRequestFactoryProtocol.h"
@@ -188,24 +190,24 @@ static id<FBSDKSettings> _settings;
       if (request == nil) {
         return;
       }
-      id<FBSDKGraphRequestConnecting> requestConnection = [self.graphRequestConnectionFactory createGraphRequestConnection];
-      requestConnection.timeout = kTimeout;
-      [requestConnection addRequest:request completion:^(id<FBSDKGraphRequestConnecting> connection, id result, NSError *codelessLoadingError) {
-        if (codelessLoadingError) {
-          return;
-        }
-
-        NSDictionary<NSString *, id> *resultDictionary = [FBSDKTypeUtility dictionaryValue:result];
-        if (resultDictionary) {
-          BOOL isCodelessSetupEnabled = [FBSDKTypeUtility boolValue:resultDictionary[CODELESS_SETUP_ENABLED_FIELD]];
-          [FBSDKTypeUtility dictionary:_codelessSetting setObject:@(isCodelessSetupEnabled) forKey:CODELESS_SETUP_ENABLED_KEY];
-          [FBSDKTypeUtility dictionary:_codelessSetting setObject:[NSDate date] forKey:CODELESS_SETTING_TIMESTAMP_KEY];
-          // update the cached copy in user defaults
-          [self.store setObject:[NSKeyedArchiver archivedDataWithRootObject:_codelessSetting] forKey:defaultKey];
-          completionBlock(isCodelessSetupEnabled, codelessLoadingError);
-        }
-      }];
-      [requestConnection start];
+      [FBSDKGraphRequestCoalescer.shared startRequest:request
+                                    connectionFactory:self.graphRequestConnectionFactory
+                                              timeout:kTimeout
+                                           completion:^(id<FBSDKGraphRequestConnecting> connection, id result, NSError *codelessLoadingError) {
+                                             if (codelessLoadingError) {
+                                               return;
+                                             }
+
+                                             NSDictionary<NSString *, id> *resultDictionary = [FBSDKTypeUtility dictionaryValue:result];
+                                             if (resultDictionary) {
+                                               BOOL isCodelessSetupEnabled = [FBSDKTypeUtility boolValue:resultDictionary[CODELESS_SETUP_ENABLED_FIELD]];
+                                               [FBSDKTypeUtility dictionary:_codelessSetting setObject:@(isCodelessSetupEnabled) forKey:CODELESS_SETUP_ENABLED_KEY];
+                                               [FBSDKTypeUtility dictionary:_codelessSetting setObject:[NSDate date] forKey:CODELESS_SETTING_TIMESTAMP_KEY];
+                                               // update the cached copy in user defaults
+                                               [self.store setObject:[NSKeyedArchiver archivedDataWithRootObject:_codelessSetting] forKey:defaultKey];
+                                               completionBlock(isCodelessSetupEnabled, codelessLoadingError);
+                                             }
+                                           }];
     }
   }];
 }
@@ -227,7 +229,7 @@ static id<FBSDKSettings> _settings;
                                                                                  parameters:parameters
                                                                                 tokenString:nil
                                                                                  HTTPMethod:nil
-                                                                                      flags:FBSDKGraphRequestFlagSkipClientToken | FBSDKGraphRequestFlagDisableErrorRecovery];
+                                                                                      flags:FBSDKGraphRequestFlagSkipClientToken | FBSDKGraphRequestFlagDisableErrorRecovery | FBSDKGraphRequestFlagUseResponseCache];
   return request;
 }
 
@@ -394,7 +396,9 @@ static id<FBSDKSettings> _settings;
                                      CODELESS_INDEXING_PLATFORM_KEY : @"iOS",
                                      CODELESS_INDEXING_SESSION_ID_KEY : [self currentSessionDeviceID]
                                    }
-                                                                             HTTPMethod:FBSDKHTTPMethodPOST];
+                                                                            tokenString:FBSDKAccessToken.currentAccessToken.tokenString
+                                                                             HTTPMethod:FBSDKHTTPMethodPOST
+                                                                                  flags:FBSDKGraphRequestFlagBackgroundPriority];
   _isCodelessIndexing = YES;
   [request startWithCompletion:^(id<FBSDKGraphRequestConnecting> connection, id result, NSError *error) {
     _isCodelessIndexing = NO;
@@ -17,6 +17,10 @@ NS_SWIFT_NAME(EventDeactivationManager)
 - (void)processEvents:(NSMutableArray<NSDictionary<NSString *, id> *> *)events;
 - (nullable NSDictionary<NSString *, id> *)processParameters:(nullable NSDictionary<NSString *, id> *)parameters
                                                    eventName:(NSString *)eventName;
+- (void)processParametersInPlace:(NSMutableDictionary<NSString *, id> *)parameters
+                       eventName:(NSString *)eventName;
+/// Whether events with the given name are dropped. Always NO until the manager is enabled.
+- (BOOL)isDeactivatedEvent:(nullable NSString *)eventName;
 
 @end
 
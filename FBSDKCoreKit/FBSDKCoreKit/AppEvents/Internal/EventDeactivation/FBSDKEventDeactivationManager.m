@@ -15,37 +15,12 @@
 static NSString *const DEPRECATED_PARAM_KEY = @"deprecated_param";
 static NSString *const DEPRECATED_EVENT_KEY = @"is_deprecated_event";
 
-@interface FBSDKDeactivatedEvent : NSObject
-
-@property (nonatomic, readonly, copy) NSString *eventName;
-@property (nullable, nonatomic, readonly, copy) NSSet<NSString *> *deactivatedParams;
-
-- (instancetype)initWithEventName:(NSString *)eventName
-                deactivatedParams:(NSSet<NSString *> *)deactivatedParams;
-
-@end
-
-@implementation FBSDKDeactivatedEvent
-
-- (instancetype)initWithEventName:(NSString *)eventName
-                deactivatedParams:(NSSet<NSString *> *)deactivatedParams
-{
-  self = [super init];
-  if (self) {
-    _eventName = eventName;
-    _deactivatedParams = deactivatedParams;
-  }
-
-  return self;
-}
-
-@end
-
 @interface FBSDKEventDeactivationManager ()
 
 @property (nonatomic) BOOL isEventDeactivationEnabled;
-@property (nonatomic, strong) NSMutableSet<NSString *> *deactivatedEvents;
-@property (nonatomic, strong) NSMutableArray<FBSDKDeactivatedEvent *> *eventsWithDeactivatedParams;
+@property (nonatomic, copy) NSSet<NSString *> *deactivatedEvents;
+// Deactivated parameter names keyed by event name.
+@property (nonatomic, copy) NSDictionary<NSString *, NSSet<NSString *> *> *deactivatedParamsByEvent;
 @property (nonatomic) id<FBSDKServerConfigurationProviding> serverConfigurationProvider;
 
 @end
@@ -70,30 +45,38 @@ static NSString *const DEPRECATED_EVENT_KEY = @"is_deprecated_event";
 
 - (void)enable
 {
-  @try {
-    static dispatch_once_t onceToken;
-    dispatch_once(&onceToken, ^{
-      NSDictionary<NSString *, id> *restrictiveParams = [self.serverConfigurationProvider cachedServerConfiguration].restrictiveParams;
-      if (restrictiveParams) {
-        [self _updateDeactivatedEvents:restrictiveParams];
-        self.isEventDeactivationEnabled = YES;
+  @synchronized(self) {
+    @try {
+      if (!self.isEventDeactivationEnabled) {
+        NSDictionary<NSString *, id> *restrictiveParams = [self.serverConfigurationProvider cachedServerConfiguration].restrictiveParams;
+        if (restrictiveParams) {
+          [self _updateDeactivatedEvents:restrictiveParams];
+          self.isEventDeactivationEnabled = YES;
+        }
       }
-    });
-  } @catch (NSException *exception) {}
+    } @catch (NSException *exception) {}
+  }
 }
 
 - (void)processEvents:(NSMutableArray<NSDictionary<NSString *, id> *> *)events
 {
   @try {
-    if (!self.isEventDeactivationEnabled) {
+    if (!self.isEventDeactivationEnabled || self.deactivatedEvents.count == 0) {
       return;
     }
-    NSArray<NSDictionary<NSString *, id> *> *eventArray = [events copy];
-    for (NSDictionary<NSString *, NSDictionary<NSString *, id> *> *event in eventArray) {
+    // Compact the kept events to the front in a single pass, then trim the tail.
+    NSUInteger keptCount = 0;
+    for (NSUInteger index = 0; index < events.count; index++) {
+      NSDictionary<NSString *, NSDictionary<NSString *, id> *> *event = events[index];
       if ([self.deactivatedEvents containsObject:event[@"event"][@"_eventName"]]) {
-        [events removeObject:event];
+        continue;
       }
+      if (keptCount != index) {
+        events[keptCount] = event;
+      }
+      keptCount++;
     }
+    [events removeObjectsInRange:NSMakeRange(keptCount, events.count - keptCount)];
   } @catch (NSException *exception) {}
 }
 
@@ -101,23 +84,42 @@ static NSString *const DEPRECATED_EVENT_KEY = @"is_deprecated_event";
                                                    eventName:(NSString *)eventName
 {
   @try {
-    if (!self.isEventDeactivationEnabled || parameters.count == 0 || self.eventsWithDeactivatedParams.count == 0) {
+    if (!self.isEventDeactivationEnabled || parameters.count == 0 || eventName == nil) {
       return parameters;
     }
-    NSMutableDictionary<NSString *, id> *params = [NSMutableDictionary dictionaryWithDictionary:parameters];
-    for (NSString *key in [parameters keyEnumerator]) {
-      for (FBSDKDeactivatedEvent *event in self.eventsWithDeactivatedParams) {
-        if ([event.eventName isEqualToString:eventName] && [event.deactivatedParams containsObject:key]) {
-          [params removeObjectForKey:key];
-        }
-      }
+    NSSet<NSString *> *deactivatedParams = self.deactivatedParamsByEvent[eventName];
+    if (deactivatedParams.count == 0) {
+      return parameters;
     }
+    NSMutableDictionary<NSString *, id> *params = [NSMutableDictionary dictionaryWithDictionary:parameters];
+    [params removeObjectsForKeys:deactivatedParams.allObjects];
     return [params copy];
   } @catch (NSException *exception) {
     return parameters;
   }
 }
 
+- (void)processParametersInPlace:(NSMutableDictionary<NSString *, id> *)parameters
+                       eventName:(NSString *)eventName
+{
+  @try {
+    if (!self.isEventDeactivationEnabled || parameters.count == 0 || eventName == nil) {
+      return;
+    }
+    for (NSString *key in self.deactivatedParamsByEvent[eventName]) {
+      [parameters removeObjectForKey:key];
+    }
+  } @catch (NSException *exception) {}
+}
+
+- (BOOL)isDeactivatedEvent:(nullable NSString *)eventName
+{
+  if (!self.isEventDeactivationEnabled || eventName == nil) {
+    return NO;
+  }
+  return [self.deactivatedEvents containsObject:eventName];
+}
+
 #pragma mark - Private Method
 
 - (void)_updateDeactivatedEvents:(nullable NSDictionary<NSString *, id> *)events
@@ -126,9 +128,7 @@ static NSString *const DEPRECATED_EVENT_KEY = @"is_deprecated_event";
   if (events.count == 0) {
     return;
   }
-  [self.deactivatedEvents removeAllObjects];
-  [self.eventsWithDeactivatedParams removeAllObjects];
-  NSMutableArray<FBSDKDeactivatedEvent *> *deactivatedParamsArray = [NSMutableArray array];
+  NSMutableDictionary<NSString *, NSSet<NSString *> *> *deactivatedParamsByEvent = [NSMutableDictionary dictionary];
   NSMutableSet<NSString *> *deactivatedEventSet = [NSMutableSet set];
   for (NSString *eventName in events.allKeys) {
     NSDictionary<NSString *, id> *eventInfo = [FBSDKTypeUtility dictionary:events objectForKey:eventName ofType:NSDictionary.class];
@@ -138,14 +138,15 @@ static NSString *const DEPRECATED_EVENT_KEY = @"is_deprecated_event";
     if (eventInfo[DEPRECATED_EVENT_KEY]) {
       [deactivatedEventSet addObject:eventName];
     }
-    if (eventInfo[DEPRECATED_PARAM_KEY]) {
-      FBSDKDeactivatedEvent *eventWithDeactivatedParams = [[FBSDKDeactivatedEvent alloc] initWithEventName:eventName
-                                                                                         deactivatedParams:[NSSet setWithArray:eventInfo[DEPRECATED_PARAM_KEY]]];
-      [FBSDKTypeUtility array:deactivatedParamsArray addObject:eventWithDeactivatedParams];
+    NSArray<NSString *> *deactivatedParams = [FBSDKTypeUtility arrayValue:eventInfo[DEPRECATED_PARAM_KEY]];
+    if (deactivatedParams) {
+      [FBSDKTypeUtility dictionary:deactivatedParamsByEvent
+                         setObject:[NSSet setWithArray:deactivatedParams]
+                            forKey:eventName];
     }
   }
   self.deactivatedEvents = deactivatedEventSet;
-  self.eventsWithDeactivatedParams = deactivatedParamsArray;
+  self.deactivatedParamsByEvent = deactivatedParamsByEvent;
 }
 
 @end
@@ -11,6 +11,7 @@
 #import <FBSDKCoreKit_Basics/FBSDKCoreKit_Basics.h>
 
 #import "FBSDKDataPersisting.h"
+#import "FBSDKGraphRequestCoalescer.h"
 #import "FBSDKGraphRequestConnecting.h"
 #import "FBSDKGraphRequestConnectionFactory.h"
 #import "FBSDKGraphRequestFactoryProtocol.h"
@@ -125,12 +126,12 @@ static dispatch_once_t sharedConfigurationManagerNonce;
                                                                                    parameters:@{
                                        @"fields" : [NSString stringWithFormat:@"app_events_config.os_version(%@)", [UIDevice currentDevice].systemVersion]
                                      }];
-    id<FBSDKGraphRequestConnecting> requestConnection = [self.graphRequestConnectionFactory createGraphRequestConnection];
-    requestConnection.timeout = kTimeout;
-    [requestConnection addRequest:request completion:^(id<FBSDKGraphRequestConnecting> connection, id result, NSError *error) {
-      [self _processResponse:result error:error];
-    }];
-    [requestConnection start];
+    [FBSDKGraphRequestCoalescer.shared startRequest:request
+                                  connectionFactory:self.graphRequestConnectionFactory
+                                            timeout:kTimeout
+                                         completion:^(id<FBSDKGraphRequestConnecting> connection, id result, NSError *error) {
+                                           [self _processResponse:result error:error];
+                                         }];
   }
 }
 
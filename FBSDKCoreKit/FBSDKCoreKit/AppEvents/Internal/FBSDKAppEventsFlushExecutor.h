@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import "FBSDKLogging.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Runs the work of an app events flush (serialization, receipt extraction, event processing and logging)
+ on a dedicated serial queue and keeps track of how much main thread time each flush costs.
+ */
+NS_SWIFT_NAME(AppEventsFlushExecutor)
+@interface FBSDKAppEventsFlushExecutor : NSObject
+
+/// The main thread time in milliseconds spent by the most recently finished flush.
+@property (nonatomic, readonly) double lastFlushMainThreadTime;
+
+- (instancetype)initWithLogger:(Class<FBSDKLogging>)logger NS_DESIGNATED_INITIALIZER;
+
+/// Asynchronously runs the block on the serial flush queue.
+- (void)execute:(dispatch_block_t)block;
+
+/// Starts tracking a flush and returns the identifier to pass to the other tracking methods.
+- (NSUInteger)beginFlush;
+
+/**
+ Runs the block synchronously. If called on the main thread the elapsed time is charged to the flush.
+ Use it to wrap the parts of a flush that are handed back on the main queue by other components.
+ */
+- (void)measureMainThreadWork:(dispatch_block_t)block forFlush:(NSUInteger)flushIdentifier;
+
+/// Stops tracking the flush and publishes its main thread time.
+- (void)finishFlush:(NSUInteger)flushIdentifier;
+
+@end
+
+NS_ASSUME_NONNULL_END
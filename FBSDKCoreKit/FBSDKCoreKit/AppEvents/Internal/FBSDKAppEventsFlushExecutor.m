@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import "FBSDKAppEventsFlushExecutor.h"
+
+#import <FBSDKCoreKit_Basics/FBSDKCoreKit_Basics.h>
+
+#import "FBSDKLogger.h"
+
+static const char *const FBSDKAppEventsFlushQueueLabel = "com.facebook.sdk.AppEventsFlushQueue";
+
+@interface FBSDKAppEventsFlushExecutor ()
+
+@property (nonatomic, readonly) dispatch_queue_t queue;
+@property (nonatomic, readonly) Class<FBSDKLogging> logger;
+@property (nonatomic, readonly) NSMutableDictionary<NSNumber *, NSNumber *> *mainThreadTimes;
+@property (nonatomic) NSUInteger flushCount;
+@property (nonatomic, readwrite) double lastFlushMainThreadTime;
+
+@end
+
+@implementation FBSDKAppEventsFlushExecutor
+
+- (instancetype)init
+{
+  return [self initWithLogger:FBSDKLogger.class];
+}
+
+- (instancetype)initWithLogger:(Class<FBSDKLogging>)logger
+{
+  if ((self = [super init])) {
+    _logger = logger;
+    _queue = dispatch_queue_create(FBSDKAppEventsFlushQueueLabel, DISPATCH_QUEUE_SERIAL);
+    _mainThreadTimes = [NSMutableDictionary new];
+  }
+  return self;
+}
+
+- (void)execute:(dispatch_block_t)block
+{
+  if (!block) {
+    return;
+  }
+#if DEBUG && FBTEST
+  block();
+#else
+  dispatch_async(self.queue, block);
+#endif
+}
+
+- (NSUInteger)beginFlush
+{
+  @synchronized(self) {
+    NSUInteger flushIdentifier = ++self.flushCount;
+    [FBSDKTypeUtility dictionary:self.mainThreadTimes setObject:@0 forKey:@(flushIdentifier)];
+    return flushIdentifier;
+  }
+}
+
+- (void)measureMainThreadWork:(dispatch_block_t)block forFlush:(NSUInteger)flushIdentifier
+{
+  if (!block) {
+    return;
+  }
+  if (!NSThread.isMainThread) {
+    block();
+    return;
+  }
+  CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+  block();
+  double elapsed = (CFAbsoluteTimeGetCurrent() - start) * 1000;
+
+  @synchronized(self) {
+    NSNumber *current = self.mainThreadTimes[@(flushIdentifier)];
+    if (current) {
+      [FBSDKTypeUtility dictionary:self.mainThreadTimes setObject:@(current.doubleValue + elapsed) forKey:@(flushIdentifier)];
+    }
+  }
+}
+
+- (void)finishFlush:(NSUInteger)flushIdentifier
+{
+  NSNumber *mainThreadTime = nil;
+  @synchronized(self) {
+    mainThreadTime = self.mainThreadTimes[@(flushIdentifier)];
+    if (!mainThreadTime) {
+      return;
+    }
+    [self.mainThreadTimes removeObjectForKey:@(flushIdentifier)];
+    self.lastFlushMainThreadTime = mainThreadTime.doubleValue;
+  }
+
+  NSString *message = [NSString stringWithFormat:@"FBSDKAppEvents: Flush <#%lu> main thread time: %.3f msec",
+                       (unsigned long)flushIdentifier,
+                       mainThreadTime.doubleValue];
+  [self.logger singleShotLogEntry:FBSDKLoggingBehaviorPerformanceCharacteristics
+                         logEntry:message];
+}
+
+@end
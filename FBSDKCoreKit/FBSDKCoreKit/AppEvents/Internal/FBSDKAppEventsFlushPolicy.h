@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import <UIKit/UIKit.h>
+
+#import "FBSDKAppEventsFlushResult.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Decides when pending app events should be flushed.
+
+ The flush interval and the batch size adapt to the rate at which events are logged, to the estimated
+ size of the pending payload, to the result of previous flushes and to the application state.
+ Failed flushes due to connectivity back off exponentially. Eager flushes requested in quick succession
+ are coalesced into a single flush. Flushes on event count and on timer stop while the policy is paused.
+
+ This type is thread safe.
+ */
+NS_SWIFT_NAME(AppEventsFlushPolicy)
+@interface FBSDKAppEventsFlushPolicy : NSObject
+
+/// The interval the flush timer currently waits for between flushes.
+@property (nonatomic, readonly) NSTimeInterval currentInterval;
+
+/// The number of pending events that currently triggers a flush.
+@property (nonatomic, readonly) NSUInteger currentEventThreshold;
+
+/// The number of consecutive flushes that failed due to connectivity.
+@property (nonatomic, readonly) NSUInteger consecutiveFailureCount;
+
+/// The estimated size in bytes of the events logged since the last flush.
+@property (nonatomic, readonly) NSUInteger pendingPayloadBytes;
+
+@property (nonatomic) UIApplicationState applicationState;
+
+/// Whether automatic flushes are held back, for example while the Graph API keeps failing.
+@property (nonatomic, getter = isPaused) BOOL paused;
+
+- (instancetype)init NS_UNAVAILABLE;
++ (instancetype)new NS_UNAVAILABLE;
+
+- (instancetype)initWithBaseInterval:(NSTimeInterval)baseInterval
+                      eventThreshold:(NSUInteger)eventThreshold
+                   coalescingWindow:(NSTimeInterval)coalescingWindow
+  NS_DESIGNATED_INITIALIZER;
+
+/// Records a newly logged event of the given estimated size.
+- (void)recordEventWithEstimatedBytes:(NSUInteger)bytes date:(NSDate *)date;
+
+/// Whether logging an event that brings the pending count to `eventCount` should trigger a flush.
+- (BOOL)shouldFlushWithPendingEventCount:(NSUInteger)eventCount;
+
+/// Whether a timer tick at `date` should trigger a flush.
+- (BOOL)shouldFlushOnTimerWithPendingEventCount:(NSUInteger)eventCount date:(NSDate *)date;
+
+/**
+ Whether an eager flush requested at `date` should happen immediately.
+ Returns NO when a flush was requested within the coalescing window, in which case the caller should rely
+ on `eagerFlushDelayAtDate:` to schedule a single trailing flush.
+ */
+- (BOOL)shouldPerformEagerFlushAtDate:(NSDate *)date;
+
+/**
+ The delay after which a trailing flush should run to cover eager flushes coalesced at `date`,
+ or a negative value when a trailing flush is already scheduled.
+ */
+- (NSTimeInterval)eagerFlushDelayAtDate:(NSDate *)date;
+
+/// Marks the trailing eager flush as performed.
+- (void)recordTrailingEagerFlush;
+
+/// Records that a flush started at `date`.
+- (void)recordFlushAtDate:(NSDate *)date;
+
+/// Records the result of a flush, adjusting the back off.
+- (void)recordFlushResult:(FBSDKAppEventsFlushResult)result;
+
+/// A cheap estimate of the size of an event once encoded.
++ (NSUInteger)estimatedBytesForEvent:(NSDictionary<NSString *, id> *)event;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import "FBSDKAppEventsFlushPolicy.h"
+
+// The longest the timer waits between flushes when backing off after connectivity failures.
+static const NSTimeInterval FBSDKAppEventsFlushPolicyMaxBackoffInterval = 600;
+// The factor by which the base interval may be stretched when events are rare.
+static const NSUInteger FBSDKAppEventsFlushPolicyMaxStretchFactor = 4;
+// The estimated pending payload size that triggers a flush regardless of the event count.
+static const NSUInteger FBSDKAppEventsFlushPolicyPayloadBytesThreshold = 64 * 1024;
+// While backing off, only flush on event count when approaching the maximum events held by a state.
+static const NSUInteger FBSDKAppEventsFlushPolicyBackoffEventThreshold = 900;
+// Keeps the back off exponent in a sane range.
+static const NSUInteger FBSDKAppEventsFlushPolicyMaxFailureCount = 10;
+// Weight of the most recent gap between events in the moving average.
+static const double FBSDKAppEventsFlushPolicyEventGapSmoothing = 0.2;
+// Allows timer ticks that fire slightly early to still count as elapsed.
+static const NSTimeInterval FBSDKAppEventsFlushPolicyTimerLeeway = 1;
+
+@interface FBSDKAppEventsFlushPolicy ()
+
+@property (nonatomic, readonly) NSTimeInterval baseInterval;
+@property (nonatomic, readonly) NSUInteger baseEventThreshold;
+@property (nonatomic, readonly) NSTimeInterval coalescingWindow;
+@property (nullable, nonatomic) NSDate *lastEventDate;
+@property (nonatomic) NSTimeInterval averageEventGap;
+@property (nullable, nonatomic) NSDate *lastFlushDate;
+@property (nullable, nonatomic) NSDate *lastEagerFlushDate;
+@property (nonatomic) BOOL isTrailingEagerFlushScheduled;
+
+@end
+
+@implementation FBSDKAppEventsFlushPolicy
+{
+  UIApplicationState _applicationState;
+  NSUInteger _consecutiveFailureCount;
+  NSUInteger _pendingPayloadBytes;
+  BOOL _paused;
+}
+
+- (instancetype)initWithBaseInterval:(NSTimeInterval)baseInterval
+                      eventThreshold:(NSUInteger)eventThreshold
+                   coalescingWindow:(NSTimeInterval)coalescingWindow
+{
+  if ((self = [super init])) {
+    _baseInterval = baseInterval;
+    _baseEventThreshold = eventThreshold;
+    _coalescingWindow = coalescingWindow;
+    _applicationState = UIApplicationStateInactive;
+    _lastFlushDate = [NSDate date];
+  }
+  return self;
+}
+
+#pragma mark - Properties
+
+- (UIApplicationState)applicationState
+{
+  @synchronized(self) {
+    return _applicationState;
+  }
+}
+
+- (void)setApplicationState:(UIApplicationState)applicationState
+{
+  @synchronized(self) {
+    _applicationState = applicationState;
+  }
+}
+
+- (BOOL)isPaused
+{
+  @synchronized(self) {
+    return _paused;
+  }
+}
+
+- (void)setPaused:(BOOL)paused
+{
+  @synchronized(self) {
+    _paused = paused;
+  }
+}
+
+- (NSUInteger)consecutiveFailureCount
+{
+  @synchronized(self) {
+    return _consecutiveFailureCount;
+  }
+}
+
+- (NSUInteger)pendingPayloadBytes
+{
+  @synchronized(self) {
+    return _pendingPayloadBytes;
+  }
+}
+
+- (NSTimeInterval)currentInterval
+{
+  @synchronized(self) {
+    if (_consecutiveFailureCount > 0) {
+      NSTimeInterval backoff = self.baseInterval * pow(2, _consecutiveFailureCount);
+      return MIN(MAX(backoff, self.baseInterval), FBSDKAppEventsFlushPolicyMaxBackoffInterval);
+    }
+    // Events logged in the background should go out before the app gets suspended.
+    if (_applicationState == UIApplicationStateBackground || self.averageEventGap <= 0) {
+      return self.baseInterval;
+    }
+    // When fewer than one event is expected per interval, wait longer to send bigger batches.
+    NSTimeInterval stretched = MIN(self.averageEventGap, self.baseInterval * FBSDKAppEventsFlushPolicyMaxStretchFactor);
+    return MAX(self.baseInterval, stretched);
+  }
+}
+
+- (NSUInteger)currentEventThreshold
+{
+  @synchronized(self) {
+    if (_consecutiveFailureCount > 0) {
+      return MAX(self.baseEventThreshold, FBSDKAppEventsFlushPolicyBackoffEventThreshold);
+    }
+    if (self.averageEventGap <= 0) {
+      return self.baseEventThreshold;
+    }
+    // At high event rates, grow the batch so that the threshold fires at most about once per interval.
+    NSUInteger expectedEventsPerInterval = (NSUInteger)round(self.baseInterval / self.averageEventGap);
+    NSUInteger maxThreshold = MIN(self.baseEventThreshold * FBSDKAppEventsFlushPolicyMaxStretchFactor,
+                                  FBSDKAppEventsFlushPolicyBackoffEventThreshold);
+    return MIN(MAX(self.baseEventThreshold, expectedEventsPerInterval), MAX(maxThreshold, self.baseEventThreshold));
+  }
+}
+
+#pragma mark - Decisions
+
+- (void)recordEventWithEstimatedBytes:(NSUInteger)bytes date:(NSDate *)date
+{
+  @synchronized(self) {
+    if (self.lastEventDate) {
+      NSTimeInterval gap = MAX(0, [date timeIntervalSinceDate:self.lastEventDate]);
+      self.averageEventGap = (self.averageEventGap <= 0)
+      ? gap
+      : (FBSDKAppEventsFlushPolicyEventGapSmoothing * gap) + ((1 - FBSDKAppEventsFlushPolicyEventGapSmoothing) * self.averageEventGap);
+    }
+    self.lastEventDate = date;
+    _pendingPayloadBytes += bytes;
+  }
+}
+
+- (BOOL)shouldFlushWithPendingEventCount:(NSUInteger)eventCount
+{
+  NSUInteger threshold = self.currentEventThreshold;
+  @synchronized(self) {
+    if (_paused) {
+      return NO;
+    }
+    if (eventCount > threshold) {
+      return YES;
+    }
+    return _consecutiveFailureCount == 0
+    && _pendingPayloadBytes >= FBSDKAppEventsFlushPolicyPayloadBytesThreshold;
+  }
+}
+
+- (BOOL)shouldFlushOnTimerWithPendingEventCount:(NSUInteger)eventCount date:(NSDate *)date
+{
+  if (eventCount == 0) {
+    return NO;
+  }
+  NSTimeInterval interval = self.currentInterval;
+  @synchronized(self) {
+    if (_paused) {
+      return NO;
+    }
+    if (!self.lastFlushDate) {
+      return YES;
+    }
+    return [date timeIntervalSinceDate:self.lastFlushDate] + FBSDKAppEventsFlushPolicyTimerLeeway >= interval;
+  }
+}
+
+- (BOOL)shouldPerformEagerFlushAtDate:(NSDate *)date
+{
+  @synchronized(self) {
+    if (self.lastEagerFlushDate
+        && [date timeIntervalSinceDate:self.lastEagerFlushDate] < self.coalescingWindow) {
+      return NO;
+    }
+    self.lastEagerFlushDate = date;
+    return YES;
+  }
+}
+
+- (NSTimeInterval)eagerFlushDelayAtDate:(NSDate *)date
+{
+  @synchronized(self) {
+    if (self.isTrailingEagerFlushScheduled) {
+      return -1;
+    }
+    self.isTrailingEagerFlushScheduled = YES;
+    NSTimeInterval elapsed = self.lastEagerFlushDate ? [date timeIntervalSinceDate:self.lastEagerFlushDate] : 0;
+    return MAX(0, self.coalescingWindow - elapsed);
+  }
+}
+
+- (void)recordTrailingEagerFlush
+{
+  @synchronized(self) {
+    self.isTrailingEagerFlushScheduled = NO;
+    self.lastEagerFlushDate = [NSDate date];
+  }
+}
+
+- (void)recordFlushAtDate:(NSDate *)date
+{
+  @synchronized(self) {
+    self.lastFlushDate = date;
+    _pendingPayloadBytes = 0;
+  }
+}
+
+- (void)recordFlushResult:(FBSDKAppEventsFlushResult)result
+{
+  @synchronized(self) {
+    switch (result) {
+      case FBSDKAppEventsFlushResultNoConnectivity:
+        _consecutiveFailureCount = MIN(_consecutiveFailureCount + 1, FBSDKAppEventsFlushPolicyMaxFailureCount);
+        break;
+      case FBSDKAppEventsFlushResultSuccess:
+      case FBSDKAppEventsFlushResultServerError:
+        _consecutiveFailureCount = 0;
+        break;
+    }
+  }
+}
+
++ (NSUInteger)estimatedBytesForEvent:(NSDictionary<NSString *, id> *)event
+{
+  __block NSUInteger bytes = 2;
+  [event enumerateKeysAndObjectsUsingBlock:^(id key, id obj, BOOL *stop) {
+    // Quotes, colon and comma around each entry.
+    bytes += 6;
+    if ([key isKindOfClass:NSString.class]) {
+      bytes += ((NSString *)key).length;
+    }
+    if ([obj isKindOfClass:NSString.class]) {
+      bytes += ((NSString *)obj).length;
+    } else {
+      bytes += 8;
+    }
+  }];
+  return bytes;
+}
+
+@end
@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import "FBSDKAppEventsParameterProcessing.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Turns the parameters of a logged event into the dictionary that is recorded for the event.
+
+ The parameters are validated while being copied into a single buffer sized for the parameters and the
+ keys added afterwards by the caller. Each processor then runs as a stage on that buffer, in place when the
+ processor supports it, so no intermediate dictionaries are created per stage.
+ */
+NS_SWIFT_NAME(AppEventsParameterPipeline)
+@interface FBSDKAppEventsParameterPipeline : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
++ (instancetype)new NS_UNAVAILABLE;
+
+/**
+ Returns the processed parameters in a mutable dictionary with room for `reservedCapacity` more entries,
+ or nil when the event name or any of the parameters are invalid. Every invalid entry is logged.
+ */
++ (nullable NSMutableDictionary<NSString *, id> *)eventDictionaryForEventName:(NSString *)eventName
+                                                                   parameters:(nullable NSDictionary<NSString *, id> *)parameters
+                                                                       stages:(NSArray<id<FBSDKAppEventsParameterProcessing>> *)stages
+                                                             reservedCapacity:(NSUInteger)reservedCapacity;
+
+@end
+
+NS_ASSUME_NONNULL_END
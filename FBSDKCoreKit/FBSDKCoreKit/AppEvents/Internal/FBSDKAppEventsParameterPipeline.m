@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import "FBSDKAppEventsParameterPipeline.h"
+
+#import <FBSDKCoreKit_Basics/FBSDKCoreKit_Basics.h>
+
+#import "FBSDKAppEventsUtility.h"
+
+@implementation FBSDKAppEventsParameterPipeline
+
++ (nullable NSMutableDictionary<NSString *, id> *)eventDictionaryForEventName:(NSString *)eventName
+                                                                   parameters:(nullable NSDictionary<NSString *, id> *)parameters
+                                                                       stages:(NSArray<id<FBSDKAppEventsParameterProcessing>> *)stages
+                                                             reservedCapacity:(NSUInteger)reservedCapacity
+{
+  __block BOOL failed = ![FBSDKAppEventsUtility validateIdentifier:eventName];
+  NSDictionary<NSString *, id> *validParameters = [FBSDKTypeUtility dictionaryValue:parameters];
+  NSMutableDictionary<NSString *, id> *buffer = [NSMutableDictionary dictionaryWithCapacity:validParameters.count + reservedCapacity];
+
+  // Make sure parameter dictionary is well formed while copying it. Log every invalid entry.
+  [validParameters enumerateKeysAndObjectsUsingBlock:^(id key, id obj, BOOL *stop) {
+    if (![key isKindOfClass:NSString.class]) {
+      [FBSDKAppEventsUtility logAndNotify:[NSString stringWithFormat:@"The keys in the parameters must be NSStrings, '%@' is not.", key]];
+      failed = YES;
+    }
+    if (![FBSDKAppEventsUtility validateIdentifier:key]) {
+      failed = YES;
+    }
+    if (![obj isKindOfClass:NSString.class] && ![obj isKindOfClass:NSNumber.class]) {
+      [FBSDKAppEventsUtility logAndNotify:[NSString stringWithFormat:@"The values in the parameters dictionary must be NSStrings or NSNumbers, '%@' is not.", obj]];
+      failed = YES;
+    }
+    if (!failed) {
+      [FBSDKTypeUtility dictionary:buffer setObject:obj forKey:key];
+    }
+  }];
+
+  if (failed) {
+    return nil;
+  }
+
+  for (id<FBSDKAppEventsParameterProcessing> stage in stages) {
+    if ([stage respondsToSelector:@selector(processParametersInPlace:eventName:)]) {
+      [stage processParametersInPlace:buffer eventName:eventName];
+      continue;
+    }
+    NSDictionary<NSString *, id> *processed = [stage processParameters:buffer eventName:eventName];
+    if (processed != buffer) {
+      [buffer removeAllObjects];
+      [buffer addEntriesFromDictionary:[FBSDKTypeUtility dictionaryValue:processed] ?: @{}];
+    }
+  }
+  return buffer;
+}
+
+@end
@@ -17,6 +17,12 @@ NS_SWIFT_NAME(AppEventsParameterProcessing)
 - (nullable NSDictionary<NSString *, id> *)processParameters:(nullable NSDictionary<NSString *, id> *)parameters
                                                    eventName:(NSString *)eventName;
 
+@optional
+
+/// Same as `processParameters:eventName:` but updates the given parameters instead of copying them.
+- (void)processParametersInPlace:(NSMutableDictionary<NSString *, id> *)parameters
+                       eventName:(NSString *)eventName;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import "FBSDKEventsProcessing.h"
+
+@class FBSDKEventDeactivationManager;
+@class FBSDKRestrictiveDataFilterManager;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Applies event deactivation and restrictive event name filtering to a list of events
+ in a single sweep, instead of one pass per processor.
+ */
+NS_SWIFT_NAME(CombinedEventsProcessor)
+@interface FBSDKCombinedEventsProcessor : NSObject <FBSDKEventsProcessing>
+
+@property (nonatomic, readonly) FBSDKEventDeactivationManager *eventDeactivationManager;
+@property (nonatomic, readonly) FBSDKRestrictiveDataFilterManager *restrictiveDataFilterManager;
+
+- (instancetype)init NS_UNAVAILABLE;
++ (instancetype)new NS_UNAVAILABLE;
+
+- (instancetype)initWithEventDeactivationManager:(FBSDKEventDeactivationManager *)eventDeactivationManager
+                    restrictiveDataFilterManager:(FBSDKRestrictiveDataFilterManager *)restrictiveDataFilterManager
+  NS_DESIGNATED_INITIALIZER;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import "FBSDKCombinedEventsProcessor.h"
+
+#import <FBSDKCoreKit_Basics/FBSDKCoreKit_Basics.h>
+
+#import "FBSDKEventDeactivationManager.h"
+#import "FBSDKRestrictiveDataFilterManager.h"
+
+static NSString *const FBSDKRestrictedEventNameReplacement = @"_removed_";
+
+@implementation FBSDKCombinedEventsProcessor
+
+- (instancetype)initWithEventDeactivationManager:(FBSDKEventDeactivationManager *)eventDeactivationManager
+                    restrictiveDataFilterManager:(FBSDKRestrictiveDataFilterManager *)restrictiveDataFilterManager
+{
+  if ((self = [super init])) {
+    _eventDeactivationManager = eventDeactivationManager;
+    _restrictiveDataFilterManager = restrictiveDataFilterManager;
+  }
+  return self;
+}
+
+- (void)processEvents:(NSMutableArray<NSDictionary<NSString *, id> *> *)events
+{
+  @try {
+    // Kept events are compacted to the front so that dropping events stays linear.
+    NSUInteger keptCount = 0;
+    for (NSUInteger index = 0; index < events.count; index++) {
+      NSDictionary<NSString *, NSMutableDictionary<NSString *, id> *> *event = events[index];
+      NSMutableDictionary<NSString *, id> *eventDictionary = event[@"event"];
+      NSString *eventName = [FBSDKTypeUtility dictionary:eventDictionary objectForKey:@"_eventName" ofType:NSString.class];
+      if ([self.eventDeactivationManager isDeactivatedEvent:eventName]) {
+        continue;
+      }
+      if ([self.restrictiveDataFilterManager isRestrictedEvent:eventName]) {
+        [FBSDKTypeUtility dictionary:eventDictionary setObject:FBSDKRestrictedEventNameReplacement forKey:@"_eventName"];
+      }
+      if (keptCount != index) {
+        events[keptCount] = event;
+      }
+      keptCount++;
+    }
+    [events removeObjectsInRange:NSMakeRange(keptCount, events.count - keptCount)];
+  } @catch (NSException *exception) {}
+}
+
+@end
@@ -50,23 +50,32 @@
     return parameters;
   }
   NSMutableDictionary<NSString *, id> *params = [NSMutableDictionary dictionaryWithDictionary:parameters];
+  [self processParametersInPlace:params eventName:eventName];
+  return [params copy];
+}
+
+- (void)processParametersInPlace:(NSMutableDictionary<NSString *, id> *)parameters
+                       eventName:(NSString *)eventName
+{
+  if (!self.isIntegrityEnabled || parameters.count == 0) {
+    return;
+  }
   NSMutableDictionary<NSString *, id> *restrictiveParams = [NSMutableDictionary dictionary];
 
-  for (NSString *key in [parameters keyEnumerator]) {
+  for (NSString *key in parameters.allKeys) {
     NSString *valueString = [FBSDKTypeUtility coercedToStringValue:parameters[key]];
     BOOL shouldFilter = [self.integrityProcessor processIntegrity:key] || [self.integrityProcessor processIntegrity:valueString];
     if (shouldFilter) {
       [FBSDKTypeUtility dictionary:restrictiveParams setObject:self.isSampleEnabled ? valueString : @"" forKey:key];
-      [params removeObjectForKey:key];
+      [parameters removeObjectForKey:key];
     }
   }
   if ([restrictiveParams count] > 0) {
     NSString *restrictiveParamsJSONString = [FBSDKBasicUtility JSONStringForObject:restrictiveParams
                                                                              error:NULL
                                                               invalidObjectHandler:NULL];
-    [FBSDKTypeUtility dictionary:params setObject:restrictiveParamsJSONString forKey:@"_onDeviceParams"];
+    [FBSDKTypeUtility dictionary:parameters setObject:restrictiveParamsJSONString forKey:@"_onDeviceParams"];
   }
-  return [params copy];
 }
 
 @end
@@ -24,6 +24,10 @@ NS_SWIFT_NAME(RestrictiveDataFilterManager)
 - (void)processEvents:(NSArray<NSDictionary<NSString *, id> *> *)events;
 - (nullable NSDictionary<NSString *, id> *)processParameters:(nullable NSDictionary<NSString *, id> *)parameters
                                                    eventName:(NSString *)eventName;
+- (void)processParametersInPlace:(NSMutableDictionary<NSString *, id> *)parameters
+                       eventName:(NSString *)eventName;
+/// Whether events with the given name have their name replaced. Always NO until the manager is enabled.
+- (BOOL)isRestrictedEvent:(nullable NSString *)eventName;
 @end
 
 NS_ASSUME_NONNULL_END
@@ -13,42 +13,14 @@
 #import "FBSDKServerConfigurationManager.h"
 #import "FBSDKServerConfigurationProviding.h"
 
-@interface FBSDKRestrictiveEventFilter : NSObject
-
-@property (nonatomic, readonly, copy) NSString *eventName;
-@property (nonatomic, readonly, copy) NSDictionary<NSString *, id> *restrictiveParams;
-
-- (instancetype)init NS_UNAVAILABLE;
-+ (instancetype)new NS_UNAVAILABLE;
-
-- (instancetype)initWithEventName:(NSString *)eventName
-                restrictiveParams:(NSDictionary<NSString *, id> *)restrictiveParams;
-
-@end
-
-@implementation FBSDKRestrictiveEventFilter
-
-- (instancetype)initWithEventName:(NSString *)eventName
-                restrictiveParams:(NSDictionary<NSString *, id> *)restrictiveParams
-{
-  self = [super init];
-  if (self) {
-    _eventName = [eventName copy];
-    _restrictiveParams = [restrictiveParams copy];
-  }
-
-  return self;
-}
-
-@end
-
 static FBSDKRestrictiveDataFilterManager *_instance;
 
 @interface FBSDKRestrictiveDataFilterManager ()
 
 @property (nonatomic) BOOL isRestrictiveEventFilterEnabled;
-@property (nonatomic) NSMutableArray<FBSDKRestrictiveEventFilter *> *params;
-@property (nonatomic) NSMutableSet<NSString *> *restrictedEvents;
+// Restricted parameter types keyed by event name, then by parameter name.
+@property (nonatomic, copy) NSDictionary<NSString *, NSDictionary<NSString *, NSString *> *> *params;
+@property (nonatomic, copy) NSSet<NSString *> *restrictedEvents;
 @property (nonatomic) id<FBSDKServerConfigurationProviding> serverConfigurationProvider;
 
 @end
@@ -85,23 +57,7 @@ static FBSDKRestrictiveDataFilterManager *_instance;
   if (parameters) {
     @try {
       NSMutableDictionary<NSString *, id> *params = [NSMutableDictionary dictionaryWithDictionary:parameters];
-      NSMutableDictionary<NSString *, NSString *> *restrictedParams = [NSMutableDictionary dictionary];
-
-      for (NSString *key in [parameters keyEnumerator]) {
-        NSString *type = [self getMatchedDataTypeWithEventName:eventName paramKey:key];
-        if (type) {
-          [FBSDKTypeUtility dictionary:restrictedParams setObject:type forKey:key];
-          [params removeObjectForKey:key];
-        }
-      }
-
-      if ([[restrictedParams allKeys] count] > 0) {
-        NSString *restrictedParamsJSONString = [FBSDKBasicUtility JSONStringForObject:restrictedParams
-                                                                                error:NULL
-                                                                 invalidObjectHandler:NULL];
-        [FBSDKTypeUtility dictionary:params setObject:restrictedParamsJSONString forKey:@"_restrictedParams"];
-      }
-
+      [self processParametersInPlace:params eventName:eventName];
       return [params copy];
     } @catch (NSException *exception) {
       return parameters;
@@ -111,6 +67,36 @@ static FBSDKRestrictiveDataFilterManager *_instance;
   return nil;
 }
 
+- (void)processParametersInPlace:(NSMutableDictionary<NSString *, id> *)parameters
+                       eventName:(NSString *)eventName
+{
+  if (!self.isRestrictiveEventFilterEnabled || parameters.count == 0) {
+    return;
+  }
+  @try {
+    NSDictionary<NSString *, NSString *> *restrictiveParams = [self restrictiveParamsForEventName:eventName];
+    if (restrictiveParams.count == 0) {
+      return;
+    }
+    NSMutableDictionary<NSString *, NSString *> *restrictedParams = [NSMutableDictionary dictionary];
+
+    // Walk the rules of the event rather than the parameters so the parameters can be updated as we go.
+    [restrictiveParams enumerateKeysAndObjectsUsingBlock:^(NSString *key, NSString *type, BOOL *stop) {
+      if (parameters[key]) {
+        [FBSDKTypeUtility dictionary:restrictedParams setObject:type forKey:key];
+        [parameters removeObjectForKey:key];
+      }
+    }];
+
+    if ([[restrictedParams allKeys] count] > 0) {
+      NSString *restrictedParamsJSONString = [FBSDKBasicUtility JSONStringForObject:restrictedParams
+                                                                              error:NULL
+                                                               invalidObjectHandler:NULL];
+      [FBSDKTypeUtility dictionary:parameters setObject:restrictedParamsJSONString forKey:@"_restrictedParams"];
+    }
+  } @catch (NSException *exception) {}
+}
+
 - (void)processEvents:(NSArray<NSMutableDictionary<NSString *, id> *> *)events
 {
   @try {
@@ -128,12 +114,25 @@ static FBSDKRestrictiveDataFilterManager *_instance;
   } @catch (NSException *exception) {}
 }
 
+- (BOOL)isRestrictedEvent:(nullable NSString *)eventName
+{
+  if (!self.isRestrictiveEventFilterEnabled || eventName == nil) {
+    return NO;
+  }
+  @synchronized(self) {
+    return [self.restrictedEvents containsObject:eventName];
+  }
+}
+
 #pragma mark - Private Methods
 
-- (BOOL)isRestrictedEvent:(NSString *)eventName
+- (nullable NSDictionary<NSString *, NSString *> *)restrictiveParamsForEventName:(nullable NSString *)eventName
 {
+  if (eventName == nil) {
+    return nil;
+  }
   @synchronized(self) {
-    return [self.restrictedEvents containsObject:eventName];
+    return self.params[eventName];
   }
 }
 
@@ -141,15 +140,7 @@ static FBSDKRestrictiveDataFilterManager *_instance;
                                               paramKey:(NSString *)paramKey
 {
   // match by params in custom events with event name
-  for (FBSDKRestrictiveEventFilter *filter in self.params) {
-    if ([filter.eventName isEqualToString:eventName]) {
-      NSString *type = [FBSDKTypeUtility coercedToStringValue:filter.restrictiveParams[paramKey]];
-      if (type) {
-        return type;
-      }
-    }
-  }
-  return nil;
+  return [self restrictiveParamsForEventName:eventName][paramKey];
 }
 
 - (void)updateFilters:(nullable NSDictionary<NSString *, id> *)restrictiveParams
@@ -160,25 +151,29 @@ static FBSDKRestrictiveDataFilterManager *_instance;
   restrictiveParams = [FBSDKTypeUtility dictionaryValue:restrictiveParams];
   if (restrictiveParams.count > 0) {
     @synchronized(self) {
-      [self.params removeAllObjects];
-      [self.restrictedEvents removeAllObjects];
-      NSMutableArray<FBSDKRestrictiveEventFilter *> *eventFilterArray = [NSMutableArray array];
+      NSMutableDictionary<NSString *, NSDictionary<NSString *, NSString *> *> *eventFilters = [NSMutableDictionary dictionary];
       NSMutableSet<NSString *> *restrictedEventSet = [NSMutableSet set];
       for (NSString *eventName in restrictiveParams.allKeys) {
         NSDictionary<NSString *, id> *eventInfo = restrictiveParams[eventName];
         if (!eventInfo) {
           continue;
         }
-        if (eventInfo[RESTRICTIVE_PARAM_KEY]) {
-          FBSDKRestrictiveEventFilter *restrictiveEventFilter = [[FBSDKRestrictiveEventFilter alloc] initWithEventName:eventName
-                                                                                                     restrictiveParams:eventInfo[RESTRICTIVE_PARAM_KEY]];
-          [FBSDKTypeUtility array:eventFilterArray addObject:restrictiveEventFilter];
+        NSDictionary<NSString *, id> *restrictiveParamTypes = [FBSDKTypeUtility dictionaryValue:eventInfo[RESTRICTIVE_PARAM_KEY]];
+        if (restrictiveParamTypes) {
+          // Coerce the types once here rather than on every lookup.
+          NSMutableDictionary<NSString *, NSString *> *types = [NSMutableDictionary dictionary];
+          [restrictiveParamTypes enumerateKeysAndObjectsUsingBlock:^(NSString *paramKey, id type, BOOL *stop) {
+            [FBSDKTypeUtility dictionary:types
+                               setObject:[FBSDKTypeUtility coercedToStringValue:type]
+                                  forKey:paramKey];
+          }];
+          [FBSDKTypeUtility dictionary:eventFilters setObject:types forKey:eventName];
         }
         if (restrictiveParams[eventName][PROCESS_EVENT_NAME_KEY]) {
           [restrictedEventSet addObject:eventName];
         }
       }
-      self.params = eventFilterArray;
+      self.params = eventFilters;
       self.restrictedEvents = restrictedEventSet;
     }
   }
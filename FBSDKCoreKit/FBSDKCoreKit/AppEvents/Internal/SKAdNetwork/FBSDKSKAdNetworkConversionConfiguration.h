@@ -11,6 +11,7 @@
  #import <Foundation/Foundation.h>
 
  #import "FBSDKSKAdNetworkRule.h"
+ #import "FBSDKSKAdNetworkRuleMatcher.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -25,6 +26,9 @@ NS_SWIFT_NAME(SKAdNetworkConversionConfiguration)
 @property (nonatomic, readonly, copy) NSSet<NSString *> *eventSet;
 @property (nonatomic, readonly, copy) NSSet<NSString *> *currencySet;
 
+/// The conversion value rules compiled for matching, nil when they reference too many event names
+@property (nullable, nonatomic, readonly) FBSDKSKAdNetworkRuleMatcher *conversionRuleMatcher;
+
 - (instancetype)init NS_UNAVAILABLE;
 + (instancetype)new NS_UNAVAILABLE;
 
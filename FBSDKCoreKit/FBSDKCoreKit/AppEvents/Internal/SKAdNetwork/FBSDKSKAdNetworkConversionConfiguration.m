@@ -37,6 +37,7 @@
       }
       _eventSet = [FBSDKSKAdNetworkConversionConfiguration getEventSetFromRules:_conversionValueRules];
       _currencySet = [FBSDKSKAdNetworkConversionConfiguration getCurrencySetFromRules:_conversionValueRules];
+      _conversionRuleMatcher = [[FBSDKSKAdNetworkRuleMatcher alloc] initWithRules:_conversionValueRules];
     } @catch (NSException *exception) {
       return nil;
     }
@@ -0,0 +1,21 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#if !TARGET_OS_TV
+
+#import "FBSDKApplicationObserving.h"
+#import "FBSDKSKAdNetworkReporter.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface FBSDKSKAdNetworkReporter (ApplicationObserving) <FBSDKApplicationObserving>
+@end
+
+NS_ASSUME_NONNULL_END
+
+#endif
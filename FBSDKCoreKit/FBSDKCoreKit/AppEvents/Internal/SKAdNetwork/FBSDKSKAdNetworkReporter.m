@@ -9,6 +9,7 @@
 #if !TARGET_OS_TV
 
 #import "FBSDKSKAdNetworkReporter.h"
+#import "FBSDKSKAdNetworkReporter+ApplicationObserving.h"
 
 #import <StoreKit/StoreKit.h>
 
@@ -25,6 +26,9 @@
 
 #define FBSDK_SKADNETWORK_CONFIG_TIME_OUT 86400
 
+// The report data of a burst of events is saved once, this many seconds after the first change
+static const NSTimeInterval FBSDKSKAdNetworkReportDataSaveInterval = 5;
+
 typedef void (*send_type)(Class, SEL, NSInteger);
 
 typedef void (^FBSDKSKAdNetworkReporterBlock)(void);
@@ -48,6 +52,9 @@ static char *const serialQueueLabel = "com.facebook.appevents.SKAdNetwork.FBSDKS
 @property (nonnull, nonatomic) id<FBSDKGraphRequestFactory> graphRequestFactory;
 @property (nonnull, nonatomic) id<FBSDKDataPersisting> store;
 @property (nonnull, nonatomic) Class<FBSDKConversionValueUpdating> conversionValueUpdatable;
+@property (nonatomic) NSTimeInterval reportDataSaveInterval;
+@property (nonatomic) BOOL isReportDataDirty;
+@property (nonatomic) BOOL isReportDataSaveScheduled;
 
 @end
 
@@ -60,6 +67,7 @@ static char *const serialQueueLabel = "com.facebook.appevents.SKAdNetwork.FBSDKS
   self.graphRequestFactory = graphRequestFactory;
   self.store = store;
   self.conversionValueUpdatable = conversionValueUpdatable;
+  self.reportDataSaveInterval = FBSDKSKAdNetworkReportDataSaveInterval;
   return self;
 }
 
@@ -212,22 +220,35 @@ static char *const serialQueueLabel = "com.facebook.appevents.SKAdNetwork.FBSDKS
   }
   if (isCacheUpdated) {
     [self _checkAndUpdateConversionValue];
-    [self _saveReportData];
+    [self _setNeedsSaveReportData];
   }
 }
 
 - (void)_checkAndUpdateConversionValue
 {
   // Update conversion value if a rule is matched
+  FBSDKSKAdNetworkRule *rule = [self _matchedRule];
+  if (rule) {
+    [self _updateConversionValue:rule.conversionValue];
+  }
+}
+
+- (nullable FBSDKSKAdNetworkRule *)_matchedRule
+{
+  if (self.config.conversionRuleMatcher) {
+    return [self.config.conversionRuleMatcher ruleMatchedWithRecordedEvents:self.recordedEvents
+                                                             recordedValues:self.recordedValues
+                                                     minimumConversionValue:self.conversionValue];
+  }
   for (FBSDKSKAdNetworkRule *rule in self.config.conversionValueRules) {
     if (rule.conversionValue < self.conversionValue) {
       break;
     }
     if ([rule isMatchedWithRecordedEvents:self.recordedEvents recordedValues:self.recordedValues]) {
-      [self _updateConversionValue:rule.conversionValue];
-      break;
+      return rule;
     }
   }
+  return nil;
 }
 
 - (void)_updateConversionValue:(NSInteger)value
@@ -239,7 +260,7 @@ static char *const serialQueueLabel = "com.facebook.appevents.SKAdNetwork.FBSDKS
     [self.conversionValueUpdatable updateConversionValue:value];
     self.conversionValue = value + 1;
     self.timestamp = [NSDate date];
-    [self _saveReportData];
+    [self _setNeedsSaveReportData];
   }
 }
 
@@ -304,6 +325,32 @@ static char *const serialQueueLabel = "com.facebook.appevents.SKAdNetwork.FBSDKS
   }
 }
 
+- (void)_setNeedsSaveReportData
+{
+  self.isReportDataDirty = YES;
+  if (self.isReportDataSaveScheduled) {
+    return;
+  }
+  if (!self.serialQueue || self.reportDataSaveInterval <= 0) {
+    [self _saveReportDataIfNeeded];
+    return;
+  }
+  self.isReportDataSaveScheduled = YES;
+  dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(self.reportDataSaveInterval * NSEC_PER_SEC)), self.serialQueue, ^{
+    self.isReportDataSaveScheduled = NO;
+    [self _saveReportDataIfNeeded];
+  });
+}
+
+- (void)_saveReportDataIfNeeded
+{
+  if (!self.isReportDataDirty) {
+    return;
+  }
+  self.isReportDataDirty = NO;
+  [self _saveReportData];
+}
+
 - (void)dispatchOnQueue:(dispatch_queue_t)queue block:(dispatch_block_t)block
 {
   if (block != nil) {
@@ -322,6 +369,20 @@ static char *const serialQueueLabel = "com.facebook.appevents.SKAdNetwork.FBSDKS
   return self.configRefreshTimestamp && [[NSDate date] timeIntervalSinceDate:self.configRefreshTimestamp] < FBSDK_SKADNETWORK_CONFIG_TIME_OUT;
 }
 
+#pragma mark - FBSDKApplicationObserving
+
+- (void)applicationDidEnterBackground:(nullable UIApplication *)application
+{
+  if (!self.serialQueue) {
+    return;
+  }
+  // Saves the changes that are waiting for the save interval, as the app may not be resumed.
+  // The save is synchronous because the app can be suspended as soon as this returns.
+  dispatch_sync(self.serialQueue, ^{
+    [self _saveReportDataIfNeeded];
+  });
+}
+
 #pragma mark - Testability
 
 #if DEBUG && FBTEST
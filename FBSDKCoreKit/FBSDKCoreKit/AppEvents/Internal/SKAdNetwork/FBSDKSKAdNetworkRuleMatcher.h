@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#if !TARGET_OS_TV
+
+ #import <Foundation/Foundation.h>
+
+ #import "FBSDKSKAdNetworkRule.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ The conversion value rules of a configuration, compiled for matching.
+
+ Event names and currencies are interned to small integer IDs, recorded events become a bitset and
+ recorded values a dense array indexed by event and currency ID, so matching a rule is a subset test
+ followed by numeric comparisons. Matches `-[FBSDKSKAdNetworkRule isMatchedWithRecordedEvents:recordedValues:]` exactly.
+ */
+NS_SWIFT_NAME(SKAdNetworkRuleMatcher)
+@interface FBSDKSKAdNetworkRuleMatcher : NSObject
+
+/// The largest number of distinct event names the rules can reference.
+@property (class, nonatomic, readonly, assign) NSUInteger maximumEventCount;
+
+@property (nonatomic, readonly, copy) NSArray<FBSDKSKAdNetworkRule *> *rules;
+@property (nonatomic, readonly, copy) NSDictionary<NSString *, NSNumber *> *eventIDs;
+@property (nonatomic, readonly, copy) NSDictionary<NSString *, NSNumber *> *currencyIDs;
+
+- (instancetype)init NS_UNAVAILABLE;
++ (instancetype)new NS_UNAVAILABLE;
+
+/**
+ Compiles rules sorted in descending conversion value order.
+ Returns nil when the rules reference more than `maximumEventCount` event names.
+ */
+- (nullable instancetype)initWithRules:(NSArray<FBSDKSKAdNetworkRule *> *)rules;
+
+/// Returns the first rule matched by the recorded events and values whose conversion value is at least `conversionValue`.
+- (nullable FBSDKSKAdNetworkRule *)ruleMatchedWithRecordedEvents:(NSSet<NSString *> *)recordedEvents
+                                                  recordedValues:(NSDictionary<NSString *, NSDictionary<NSString *, id> *> *)recordedValues
+                                          minimumConversionValue:(NSInteger)conversionValue;
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+#endif
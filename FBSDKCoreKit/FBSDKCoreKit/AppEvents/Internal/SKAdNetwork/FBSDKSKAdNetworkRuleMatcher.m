@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#if !TARGET_OS_TV
+
+#import "FBSDKSKAdNetworkRuleMatcher.h"
+
+#import <FBSDKCoreKit_Basics/FBSDKCoreKit_Basics.h>
+
+static const NSUInteger FBSDKSKAdNetworkRuleMatcherMaximumEventCount = 64;
+
+#if DEBUG && FBTEST
+// The rules compared with recorded events, by every matcher
+static NSUInteger g_evaluatedRuleCount = 0;
+#endif
+
+typedef struct {
+  NSInteger conversionValue;
+  // The IDs of the events the rule requires, as a bitset
+  uint64_t eventMask;
+  BOOL isMatchable;
+  // The values the rule requires, any one of which is enough
+  NSUInteger firstCondition;
+  NSUInteger conditionCount;
+  BOOL requiresValues;
+} FBSDKSKAdNetworkCompiledRule;
+
+typedef struct {
+  NSUInteger valueIndex;
+  double threshold;
+} FBSDKSKAdNetworkValueCondition;
+
+@implementation FBSDKSKAdNetworkRuleMatcher
+{
+  NSData *_compiledRules;
+  NSData *_valueConditions;
+  NSUInteger _minimumRequiredEventCount;
+}
+
++ (NSUInteger)maximumEventCount
+{
+  return FBSDKSKAdNetworkRuleMatcherMaximumEventCount;
+}
+
+- (nullable instancetype)initWithRules:(NSArray<FBSDKSKAdNetworkRule *> *)rules
+{
+  if ((self = [super init])) {
+    NSMutableDictionary<NSString *, NSNumber *> *eventIDs = [NSMutableDictionary new];
+    NSMutableDictionary<NSString *, NSNumber *> *currencyIDs = [NSMutableDictionary new];
+    for (FBSDKSKAdNetworkRule *rule in rules) {
+      for (FBSDKSKAdNetworkEvent *event in rule.events) {
+        if ([event.eventName isKindOfClass:NSString.class] && !eventIDs[event.eventName]) {
+          if (eventIDs.count == FBSDKSKAdNetworkRuleMatcherMaximumEventCount) {
+            return nil;
+          }
+          [FBSDKTypeUtility dictionary:eventIDs setObject:@(eventIDs.count) forKey:event.eventName];
+        }
+        for (NSString *currency in event.values) {
+          if ([currency isKindOfClass:NSString.class] && !currencyIDs[currency]) {
+            [FBSDKTypeUtility dictionary:currencyIDs setObject:@(currencyIDs.count) forKey:currency];
+          }
+        }
+      }
+    }
+    _rules = [rules copy];
+    _eventIDs = [eventIDs copy];
+    _currencyIDs = [currencyIDs copy];
+    [self _compileRules];
+  }
+  return self;
+}
+
+- (void)_compileRules
+{
+  NSMutableData *compiledRules = [NSMutableData dataWithLength:_rules.count * sizeof(FBSDKSKAdNetworkCompiledRule)];
+  NSMutableData *valueConditions = [NSMutableData new];
+  FBSDKSKAdNetworkCompiledRule *compiledRule = compiledRules.mutableBytes;
+  _minimumRequiredEventCount = FBSDKSKAdNetworkRuleMatcherMaximumEventCount + 1;
+  for (FBSDKSKAdNetworkRule *rule in _rules) {
+    compiledRule->conversionValue = rule.conversionValue;
+    compiledRule->isMatchable = YES;
+    compiledRule->firstCondition = valueConditions.length / sizeof(FBSDKSKAdNetworkValueCondition);
+    for (FBSDKSKAdNetworkEvent *event in rule.events) {
+      NSNumber *eventID = [FBSDKTypeUtility dictionary:_eventIDs objectForKey:event.eventName ofType:NSNumber.class];
+      if (eventID == nil) {
+        compiledRule->isMatchable = NO;
+        break;
+      }
+      compiledRule->eventMask |= 1ULL << eventID.unsignedIntegerValue;
+      if (!event.values) {
+        continue;
+      }
+      compiledRule->requiresValues = YES;
+      for (NSString *currency in event.values) {
+        NSNumber *currencyID = [FBSDKTypeUtility dictionary:_currencyIDs objectForKey:currency ofType:NSNumber.class];
+        NSNumber *valueInMapping = [FBSDKTypeUtility dictionary:event.values objectForKey:currency ofType:NSNumber.class];
+        if (currencyID == nil || valueInMapping == nil) {
+          continue;
+        }
+        FBSDKSKAdNetworkValueCondition condition = {
+          eventID.unsignedIntegerValue * _currencyIDs.count + currencyID.unsignedIntegerValue,
+          valueInMapping.doubleValue,
+        };
+        [valueConditions appendBytes:&condition length:sizeof(condition)];
+        compiledRule->conditionCount++;
+      }
+      // Like the rule, the events after the first one with values are not checked
+      break;
+    }
+    if (compiledRule->isMatchable) {
+      _minimumRequiredEventCount = MIN(_minimumRequiredEventCount, (NSUInteger)__builtin_popcountll(compiledRule->eventMask));
+    }
+    compiledRule++;
+  }
+  _compiledRules = compiledRules;
+  _valueConditions = valueConditions;
+}
+
+- (nullable FBSDKSKAdNetworkRule *)ruleMatchedWithRecordedEvents:(NSSet<NSString *> *)recordedEvents
+                                                  recordedValues:(NSDictionary<NSString *, NSDictionary<NSString *, id> *> *)recordedValues
+                                          minimumConversionValue:(NSInteger)conversionValue
+{
+  const FBSDKSKAdNetworkCompiledRule *compiledRules = _compiledRules.bytes;
+  // The rules are sorted in descending conversion value order
+  if (0 == _rules.count || compiledRules[0].conversionValue < conversionValue) {
+    return nil;
+  }
+  uint64_t recordedEventMask = [self _eventMaskWithRecordedEvents:recordedEvents];
+  // No rule can match before as many events were recorded as the rule requiring the fewest
+  if ((NSUInteger)__builtin_popcountll(recordedEventMask) < _minimumRequiredEventCount) {
+    return nil;
+  }
+  NSData *values = nil;
+  for (NSUInteger i = 0; i < _rules.count; i++) {
+    const FBSDKSKAdNetworkCompiledRule *compiledRule = &compiledRules[i];
+    if (compiledRule->conversionValue < conversionValue) {
+      break;
+    }
+  #if DEBUG && FBTEST
+    g_evaluatedRuleCount++;
+  #endif
+    if (!compiledRule->isMatchable || (compiledRule->eventMask & ~recordedEventMask) != 0) {
+      continue;
+    }
+    if (compiledRule->requiresValues && !values) {
+      values = [self _valuesWithRecordedValues:recordedValues];
+    }
+    if ([self _isMatchedWithRule:compiledRule values:values.bytes]) {
+      return [FBSDKTypeUtility array:_rules objectAtIndex:i];
+    }
+  }
+  return nil;
+}
+
+#pragma mark - Helpers
+
+- (uint64_t)_eventMaskWithRecordedEvents:(NSSet<NSString *> *)recordedEvents
+{
+  uint64_t eventMask = 0;
+  for (NSString *event in recordedEvents) {
+    NSNumber *eventID = [FBSDKTypeUtility dictionary:_eventIDs objectForKey:event ofType:NSNumber.class];
+    if (eventID != nil) {
+      eventMask |= 1ULL << eventID.unsignedIntegerValue;
+    }
+  }
+  return eventMask;
+}
+
+// Values that were not recorded are NaN, which no comparison matches
+- (NSData *)_valuesWithRecordedValues:(NSDictionary<NSString *, NSDictionary<NSString *, id> *> *)recordedValues
+{
+  NSUInteger valueCount = _eventIDs.count * _currencyIDs.count;
+  NSMutableData *data = [NSMutableData dataWithLength:valueCount * sizeof(double)];
+  double *values = data.mutableBytes;
+  for (NSUInteger i = 0; i < valueCount; i++) {
+    values[i] = NAN;
+  }
+  recordedValues = [FBSDKTypeUtility dictionaryValue:recordedValues];
+  for (NSString *event in recordedValues) {
+    NSNumber *eventID = [FBSDKTypeUtility dictionary:_eventIDs objectForKey:event ofType:NSNumber.class];
+    if (eventID == nil) {
+      continue;
+    }
+    NSDictionary<NSString *, id> *recordedEventValues = [FBSDKTypeUtility dictionary:recordedValues objectForKey:event ofType:NSDictionary.class];
+    for (NSString *currency in recordedEventValues) {
+      NSNumber *currencyID = [FBSDKTypeUtility dictionary:_currencyIDs objectForKey:currency ofType:NSNumber.class];
+      NSNumber *value = [FBSDKTypeUtility dictionary:recordedEventValues objectForKey:currency ofType:NSNumber.class];
+      if (currencyID != nil && value != nil) {
+        values[eventID.unsignedIntegerValue * _currencyIDs.count + currencyID.unsignedIntegerValue] = value.doubleValue;
+      }
+    }
+  }
+  return data;
+}
+
+- (BOOL)_isMatchedWithRule:(const FBSDKSKAdNetworkCompiledRule *)compiledRule
+                    values:(const double *)values
+{
+  if (!compiledRule->requiresValues) {
+    return YES;
+  }
+  const FBSDKSKAdNetworkValueCondition *valueConditions = _valueConditions.bytes;
+  for (NSUInteger i = 0; i < compiledRule->conditionCount; i++) {
+    const FBSDKSKAdNetworkValueCondition *condition = &valueConditions[compiledRule->firstCondition + i];
+    if (values[condition->valueIndex] > condition->threshold) {
+      return YES;
+    }
+  }
+  return NO;
+}
+
+#if DEBUG && FBTEST
+
++ (NSUInteger)evaluatedRuleCount
+{
+  return g_evaluatedRuleCount;
+}
+
++ (void)setEvaluatedRuleCount:(NSUInteger)count
+{
+  g_evaluatedRuleCount = count;
+}
+
+#endif
+
+@end
+
+#endif
@@ -37,6 +37,7 @@
 #import "FBSDKBridgeAPI+ApplicationObserving.h"
 #import "FBSDKBridgeAPIRequest+Private.h"
 #import "FBSDKButton+Subclass.h"
+#import "FBSDKCombinedEventsProcessor.h"
 #import "FBSDKCrashObserver.h"
 #import "FBSDKCrashShield+Internal.h"
 #import "FBSDKDynamicFrameworkLoader.h"
@@ -92,6 +93,7 @@
  #import "FBSDKModelManager+RulesFromKeyProvider.h"
  #import "FBSDKProfile+Internal.h"
  #import "FBSDKSKAdNetworkReporter+AppEventsReporter.h"
+ #import "FBSDKSKAdNetworkReporter+ApplicationObserving.h"
  #import "FBSDKSKAdNetworkReporter+Internal.h"
  #import "FBSDKURL+Internal.h"
  #import "FBSDKURLOpener.h"
@@ -661,7 +663,8 @@ static UIApplicationState _applicationState;
                                                                                     settings:sharedSettings
                                                                                 crashHandler:sharedCrashHandler];
 
-  [FBSDKServerConfigurationManager.shared configureWithGraphRequestFactory:graphRequestFactory];
+  [FBSDKServerConfigurationManager.shared configureWithGraphRequestFactory:graphRequestFactory
+                                            graphRequestConnectionFactory:graphRequestConnectionFactory];
   [FBSDKSettings configureWithStore:store
      appEventsConfigurationProvider:FBSDKAppEventsConfigurationManager.class
              infoDictionaryProvider:NSBundle.mainBundle
@@ -695,11 +698,14 @@ static UIApplicationState _applicationState;
                                       serverConfigurationProvider:serverConfigurationProvider];
   FBSDKEventDeactivationManager *eventDeactivationManager = [FBSDKEventDeactivationManager new];
   FBSDKRestrictiveDataFilterManager *restrictiveDataFilterManager = [[FBSDKRestrictiveDataFilterManager alloc] initWithServerConfigurationProvider:serverConfigurationProvider];
-  [FBSDKAppEventsState configureWithEventProcessors:@[eventDeactivationManager, restrictiveDataFilterManager]];
+  FBSDKCombinedEventsProcessor *eventsProcessor = [[FBSDKCombinedEventsProcessor alloc] initWithEventDeactivationManager:eventDeactivationManager
+                                                                                          restrictiveDataFilterManager:restrictiveDataFilterManager];
+  [FBSDKAppEventsState configureWithEventProcessors:@[eventsProcessor]];
   [self.appEvents configureWithGateKeeperManager:FBSDKGateKeeperManager.class
                   appEventsConfigurationProvider:FBSDKAppEventsConfigurationManager.class
                      serverConfigurationProvider:serverConfigurationProvider
                              graphRequestFactory:graphRequestFactory
+                   graphRequestConnectionFactory:graphRequestConnectionFactory
                                   featureChecker:self.featureChecker
                                            store:store
                                           logger:FBSDKLogger.class
@@ -765,6 +771,7 @@ static UIApplicationState _applicationState;
     self.skAdNetworkReporter = [[FBSDKSKAdNetworkReporter alloc] initWithGraphRequestFactory:graphRequestFactory
                                                                                        store:store
                                                                     conversionValueUpdatable:SKAdNetwork.class];
+    [self addObserver:self.skAdNetworkReporter];
   }
   if (@available(iOS 14.0, *)) {
     [FBAEMReporter configureWithNetworker:[FBSDKAEMNetworker new]
@@ -126,6 +126,7 @@ static dispatch_once_t sharedSettingsNonce;
 {
   if ((self = [super init])) {
     _isGraphErrorRecoveryEnabled = YES;
+    _isGraphRequestCircuitBreakerEnabled = YES;
     _graphAPIVersion = [self defaultGraphAPIVersion];
   }
 
@@ -12,6 +12,7 @@
 
 #import <FBSDKCoreKit_Basics/FBSDKCoreKit_Basics.h>
 
+#import "FBSDKGraphRequestCoalescer.h"
 #import "FBSDKGraphRequestConnecting.h"
 #import "FBSDKGraphRequestConnection.h"
 #import "FBSDKGraphRequestDataAttachment.h"
@@ -256,8 +257,14 @@ static id<FBSDKGraphRequestConnectionFactory> _connectionFactory;
 
 - (id<FBSDKGraphRequestConnecting>)startWithCompletion:(nullable FBSDKGraphRequestCompletion)completion
 {
-  id<FBSDKGraphRequestConnecting> connection = [self.graphRequestConnectionFactory createGraphRequestConnection];
   id<FBSDKGraphRequest> request = (id<FBSDKGraphRequest>)self;
+  FBSDKGraphRequestCoalescer *coalescer = FBSDKGraphRequestCoalescer.shared;
+  if (coalescer.isEnabled) {
+    return [coalescer startRequest:request
+                 connectionFactory:self.graphRequestConnectionFactory
+                        completion:completion];
+  }
+  id<FBSDKGraphRequestConnecting> connection = [self.graphRequestConnectionFactory createGraphRequestConnection];
   [connection addRequest:request completion:completion];
   [connection start];
   return connection;
@@ -19,10 +19,17 @@
 #import "FBSDKGraphErrorRecoveryProcessor.h"
 #import "FBSDKGraphRequest+Internal.h"
 #import "FBSDKGraphRequestBody.h"
+#import "FBSDKGraphRequestCircuitBreaker.h"
+#import "FBSDKGraphRequestCoalescer.h"
 #import "FBSDKGraphRequestConnectionFactory.h"
+#import "FBSDKGraphRequestConnectionMetrics+Internal.h"
 #import "FBSDKGraphRequestDataAttachment.h"
 #import "FBSDKGraphRequestMetadata.h"
 #import "FBSDKGraphRequestPiggybackManagerProvider.h"
+#import "FBSDKGraphRequestRetryPolicy.h"
+#import "FBSDKGraphRequestScheduler.h"
+#import "FBSDKGraphResponseCache.h"
+#import "FBSDKGraphResponseParser.h"
 #import "FBSDKInternalUtility+Internal.h"
 #import "FBSDKLogger+Internal.h"
 #import "FBSDKOperatingSystemVersionComparing.h"
@@ -57,6 +64,7 @@ static NSString *const kUserAgentBase = @"FBiOSSDK";
 static NSString *const kBatchRestMethodBaseURL = @"method/";
 
 static NSTimeInterval g_defaultTimeout = 60.0;
+static id<FBSDKGraphRequestConnectionMetricsSink> g_metricsSink;
 
 #if !TARGET_OS_TV
 static FBSDKAccessToken *_Nullable _CreateExpiredAccessToken(FBSDKAccessToken *accessToken)
@@ -107,6 +115,18 @@ static FBSDKAccessToken *_Nullable _CreateExpiredAccessToken(FBSDKAccessToken *a
   FBSDKGraphRequestMetadata *_recoveringRequestMetadata;
   FBSDKGraphErrorRecoveryProcessor *_errorRecoveryProcessor;
 #endif
+  NSString *_responseCacheKey;
+  FBSDKGraphResponseCacheEntry *_responseCacheEntry;
+  FBSDKGraphRequestSchedulerCompletion _schedulerFinish;
+  FBSDKGraphRequestPriority _priority;
+  BOOL _retriesTransientFailures;
+  BOOL _isAdmittedByCircuitBreaker;
+  uint64_t _connectionStartTime;
+  NSUInteger _piggybackedRequestCount;
+  unsigned long long _requestBodyBytes;
+  unsigned long long _encodedRequestBodyBytes;
+  NSURLSessionTaskMetrics *_taskMetrics;
+  FBSDKGraphRequestBody *_streamedBody;
 }
 
 static BOOL _canMakeRequests = NO;
@@ -152,12 +172,18 @@ static BOOL _canMakeRequests = NO;
     _macCatalystDeterminator = macCatalystDeterminator;
     _accessTokenProvider = accessTokenProvider;
     _accessTokenSetter = accessTokenSetter;
+    _responseCache = FBSDKGraphResponseCache.shared;
+    _scheduler = FBSDKGraphRequestScheduler.shared;
+    _retryPolicy = FBSDKGraphRequestRetryPolicy.shared;
+    _circuitBreaker = FBSDKGraphRequestCircuitBreaker.shared;
+    _metricsSink = g_metricsSink;
   }
   return self;
 }
 
 - (void)dealloc
 {
+  [self finishScheduledTask];
   [self.session invalidateAndCancel];
 }
 
@@ -175,6 +201,30 @@ static BOOL _canMakeRequests = NO;
   return g_defaultTimeout;
 }
 
++ (void)setRequestCoalescingWindow:(NSTimeInterval)requestCoalescingWindow
+{
+  FBSDKGraphRequestCoalescer.shared.window = MAX(0, requestCoalescingWindow);
+}
+
++ (NSTimeInterval)requestCoalescingWindow
+{
+  return FBSDKGraphRequestCoalescer.shared.window;
+}
+
++ (void)setMetricsSink:(nullable id<FBSDKGraphRequestConnectionMetricsSink>)metricsSink
+{
+  @synchronized(self) {
+    g_metricsSink = metricsSink;
+  }
+}
+
++ (nullable id<FBSDKGraphRequestConnectionMetricsSink>)metricsSink
+{
+  @synchronized(self) {
+    return g_metricsSink;
+  }
+}
+
 - (void)addRequest:(id<FBSDKGraphRequest>)request
         completion:(FBSDKGraphRequestCompletion)completion
 {
@@ -208,6 +258,7 @@ static BOOL _canMakeRequests = NO;
 - (void)cancel
 {
   self.state = kStateCancelled;
+  [self finishScheduledTask];
   [self.session invalidateAndCancel];
 }
 
@@ -220,6 +271,7 @@ static BOOL _canMakeRequests = NO;
 
 - (void)start
 {
+  _connectionStartTime = [FBSDKInternalUtility.sharedUtility currentTimeInMilliseconds];
   if (![self.class canMakeRequests]) {
     NSString *msg = @"FBSDKGraphRequestConnection cannot be started before Facebook SDK initialized.";
     // TODO: Use a logger provider for this.
@@ -238,16 +290,86 @@ static BOOL _canMakeRequests = NO;
                                  logEntry:@"FBSDKGraphRequestConnection cannot be started again."];
     return;
   }
+  // Piggybacked requests do not make a background connection more urgent.
+  _priority = [self priorityForRequests:self.requests];
+  _retriesTransientFailures = [self requests:self.requests allHaveFlag:FBSDKGraphRequestFlagRetryTransientFailures];
+  _isAdmittedByCircuitBreaker = _priority == FBSDKGraphRequestPriorityBackground
+  || [self requests:self.requests allHaveFlag:FBSDKGraphRequestFlagUsesCircuitBreaker];
+  NSUInteger requestCount = self.requests.count;
   Class<FBSDKGraphRequestPiggybackManaging> piggybackManager = [self.piggybackManagerProvider.class piggybackManager];
   [piggybackManager.class addPiggybackRequests:self];
+  _piggybackedRequestCount = self.requests.count - requestCount;
   NSMutableURLRequest *request = [self requestWithBatch:self.requests timeout:_timeout];
+  FBSDKGraphResponseCacheEntry *freshEntry = [self applyResponseCacheToRequest:request];
+  if (_retriesTransientFailures && [request.HTTPMethod isEqualToString:@"POST"]) {
+    // Every attempt carries the same key so that the server can discard duplicates.
+    [request setValue:[NSUUID UUID].UUIDString forHTTPHeaderField:FBSDKIdempotencyKeyHeaderField];
+  }
 
   self.state = kStateStarted;
 
+  if (freshEntry) {
+    [self completeWithCachedEntry:freshEntry];
+    return;
+  }
+
+  [self admitURLRequest:request];
+}
+
+// Sends the request through the circuit breaker, then the scheduler.
+- (void)admitURLRequest:(NSURLRequest *)request
+{
+  if (!self.usesCircuitBreaker) {
+    [self scheduleURLRequest:request];
+    return;
+  }
+  [self.circuitBreaker admitRequest:^(BOOL admitted) {
+    if (admitted) {
+      [self scheduleURLRequest:request];
+    } else {
+      [self completeWithCircuitBreakerRejection];
+    }
+  }];
+}
+
+// Only background work and the SDK's own configuration requests are held back;
+// requests the user is waiting for always go out.
+- (BOOL)usesCircuitBreaker
+{
+  return _isAdmittedByCircuitBreaker && self.settings.isGraphRequestCircuitBreakerEnabled;
+}
+
+- (void)scheduleURLRequest:(NSURLRequest *)request
+{
+  [self.scheduler scheduleTaskWithPriority:_priority task:^(FBSDKGraphRequestSchedulerCompletion finish) {
+    [self executeURLRequest:request finish:finish];
+  }];
+}
+
+- (void)executeURLRequest:(NSURLRequest *)request finish:(FBSDKGraphRequestSchedulerCompletion)finish
+{
+  if (self.state == kStateCancelled) {
+    // Cancelled while waiting for the scheduler; report it like a cancelled task would.
+    finish();
+    [self completeFBSDKURLSessionWithResponse:nil
+                                         data:nil
+                                 networkError:[NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorCancelled userInfo:nil]];
+    return;
+  }
+
+  @synchronized(self) {
+    _schedulerFinish = [finish copy];
+    _taskMetrics = nil;
+  }
   [self logRequest:request bodyLength:0 bodyLogger:nil attachmentLogger:nil];
   _requestStartTime = [FBSDKInternalUtility.sharedUtility currentTimeInMilliseconds];
 
   FBSDKURLSessionTaskBlock completionHandler = ^(NSData *responseDataV1, NSURLResponse *responseV1, NSError *errorV1) {
+    [self finishScheduledTask];
+    [self recordOutcomeWithResponse:responseV1 error:errorV1];
+    if ([self retryURLRequest:request afterResponse:responseV1 error:errorV1]) {
+      return;
+    }
     FBSDKURLSessionTaskBlock handler = ^(NSData *responseDataV2,
                                          NSURLResponse *responseV2,
                                          NSError *errorV2) {
@@ -276,6 +398,118 @@ static BOOL _canMakeRequests = NO;
   }
 }
 
+// Frees the slot of the request in the scheduler, at most once.
+- (void)finishScheduledTask
+{
+  FBSDKGraphRequestSchedulerCompletion finish = nil;
+  @synchronized(self) {
+    finish = _schedulerFinish;
+    _schedulerFinish = nil;
+  }
+  if (finish) {
+    finish();
+  }
+}
+
+- (FBSDKGraphRequestPriority)priorityForRequests:(NSArray<FBSDKGraphRequestMetadata *> *)requests
+{
+  return [self requests:requests allHaveFlag:FBSDKGraphRequestFlagBackgroundPriority]
+  ? FBSDKGraphRequestPriorityBackground
+  : FBSDKGraphRequestPriorityDefault;
+}
+
+- (BOOL)requests:(NSArray<FBSDKGraphRequestMetadata *> *)requests allHaveFlag:(FBSDKGraphRequestFlags)flag
+{
+  if (requests.count == 0) {
+    return NO;
+  }
+  for (FBSDKGraphRequestMetadata *metadata in requests) {
+    if (!([metadata.request flags] & flag)) {
+      return NO;
+    }
+  }
+  return YES;
+}
+
+// Sends the request again later if it failed transiently and the retry policy allows it.
+- (BOOL)retryURLRequest:(NSURLRequest *)request
+          afterResponse:(nullable NSURLResponse *)response
+                  error:(nullable NSError *)error
+{
+  if (!_retriesTransientFailures
+      || self.state == kStateCancelled
+      || (self.usesCircuitBreaker && self.circuitBreaker.state == FBSDKCircuitBreakerStateOpen)
+      || ![FBSDKGraphRequestRetryPolicy isTransientFailureWithResponse:response error:error]) {
+    return NO;
+  }
+  NSTimeInterval delay = [self.retryPolicy delayBeforeRetryingAttempt:self.retryCount + 1
+                                                             response:response
+                                                                error:error];
+  if (delay < 0) {
+    return NO;
+  }
+  self.retryCount++;
+  [self.logger appendFormat:@"Retrying <#%lu> in %.3f seconds (retry %lu)\n\n",
+   (unsigned long)self.logger.loggerSerialNumber,
+   delay,
+   (unsigned long)self.retryCount];
+  [self.logger emitToNSLog];
+  [self.retryPolicy performAfterDelay:delay block:^{
+    [self admitURLRequest:[self URLRequestWithNewBodyStream:request]];
+  }];
+  return YES;
+}
+
+// The body stream of a request is consumed by the attempt that sent it, so each attempt needs a new one.
+- (NSURLRequest *)URLRequestWithNewBodyStream:(NSURLRequest *)request
+{
+  if (!request.HTTPBodyStream || !_streamedBody) {
+    return request;
+  }
+  NSMutableURLRequest *newRequest = [request mutableCopy];
+  newRequest.HTTPBodyStream = [_streamedBody multipartDataStream];
+  return newRequest;
+}
+
+- (void)recordOutcomeWithResponse:(nullable NSURLResponse *)response error:(nullable NSError *)error
+{
+  if ([FBSDKGraphRequestRetryPolicy isConnectivityFailureWithError:error]) {
+    // Being offline says nothing about the health of the server.
+    return;
+  }
+  if ([FBSDKGraphRequestRetryPolicy isTransientFailureWithResponse:response error:error]) {
+    [self.circuitBreaker recordFailure];
+  } else if (response) {
+    [self.retryPolicy recordSuccess];
+    [self.circuitBreaker recordSuccess];
+  }
+}
+
+- (void)completeWithCircuitBreakerRejection
+{
+  [self.logger appendFormat:@"Request <#%lu>\nNot sent: the circuit breaker is open\n\n", (unsigned long)self.logger.loggerSerialNumber];
+  [self.logger emitToNSLog];
+
+  NSError *error = [FBSDKError errorWithCode:FBSDKErrorNetwork
+                                     message:@"Graph requests are paused after repeated transient failures"];
+  [self performOnDelegateQueue:^{
+    if (self.state == kStateCancelled) {
+      return;
+    }
+    [self completeFBSDKURLSessionWithResponse:nil data:nil networkError:error];
+  }];
+}
+
+// Completes asynchronously, like a request sent over the network.
+- (void)performOnDelegateQueue:(dispatch_block_t)block
+{
+  if (_delegateQueue) {
+    [_delegateQueue addOperationWithBlock:block];
+  } else {
+    dispatch_async(dispatch_get_main_queue(), block);
+  }
+}
+
 - (NSOperationQueue *)delegateQueue
 {
   return _delegateQueue;
@@ -537,7 +771,10 @@ static BOOL _canMakeRequests = NO;
   [request setValue:[body mimeContentType] forHTTPHeaderField:@"Content-Type"];
   request.HTTPShouldHandleCookies = NO;
 
-  [self logRequest:request bodyLength:(request.HTTPBody.length / 1024) bodyLogger:bodyLogger attachmentLogger:attachmentLogger];
+  unsigned long long bodyLength = request.HTTPBodyStream ? body.multipartDataLength : request.HTTPBody.length;
+  _requestBodyBytes = request.HTTPBodyStream ? body.multipartDataLength : body.dataLength;
+  _encodedRequestBodyBytes = bodyLength;
+  [self logRequest:request bodyLength:(NSUInteger)(bodyLength / 1024) bodyLogger:bodyLogger attachmentLogger:attachmentLogger];
 
   return request;
 }
@@ -548,6 +785,12 @@ static BOOL _canMakeRequests = NO;
   if ((compressedData = [body compressedData])) {
     request.HTTPBody = compressedData;
     [request setValue:@"gzip" forHTTPHeaderField:@"Content-Encoding"];
+  } else if (body.prefersStreaming) {
+    // Stream large and file backed attachments instead of building the whole body in memory.
+    // The body is kept to create new streams for retries and redirects.
+    _streamedBody = body;
+    request.HTTPBodyStream = [body multipartDataStream];
+    [request setValue:[NSString stringWithFormat:@"%llu", body.multipartDataLength] forHTTPHeaderField:@"Content-Length"];
   } else {
     request.HTTPBody = body.data;
   }
@@ -611,6 +854,74 @@ static BOOL _canMakeRequests = NO;
   return url;
 }
 
+#pragma mark - Private methods (response cache)
+
+// Returns a cached entry that can be used without sending the request. Otherwise adds
+// the validator of the cached entry, if any, to the request.
+- (nullable FBSDKGraphResponseCacheEntry *)applyResponseCacheToRequest:(NSMutableURLRequest *)request
+{
+  _responseCacheKey = nil;
+  _responseCacheEntry = nil;
+  if (self.requests.count != 1 || ![request.HTTPMethod isEqualToString:@"GET"]) {
+    return nil;
+  }
+  FBSDKGraphRequestMetadata *metadata = self.requests.firstObject;
+  if (!([metadata.request flags] & FBSDKGraphRequestFlagUseResponseCache)) {
+    return nil;
+  }
+  _responseCacheKey = [FBSDKGraphResponseCache keyForURL:request.URL];
+  if (!_responseCacheKey) {
+    return nil;
+  }
+  // Bypass the URL loading system cache so that 304 responses reach the connection.
+  request.cachePolicy = NSURLRequestReloadIgnoringLocalCacheData;
+
+  FBSDKGraphResponseCacheEntry *entry = [self.responseCache entryForKey:_responseCacheKey];
+  if (!entry.object) {
+    return nil;
+  }
+  if ([entry isFreshAtDate:[NSDate date]]) {
+    return entry;
+  }
+  if (entry.ETag) {
+    [request setValue:entry.ETag forHTTPHeaderField:@"If-None-Match"];
+    _responseCacheEntry = entry;
+  }
+  return nil;
+}
+
+- (void)completeWithCachedEntry:(FBSDKGraphResponseCacheEntry *)entry
+{
+  [self.logger appendFormat:@"Response <#%lu>\nServed from the response cache\n\n", (unsigned long)self.logger.loggerSerialNumber];
+  [self.logger emitToNSLog];
+
+  [self performOnDelegateQueue:^{
+    if (self.state == kStateCancelled) {
+      return;
+    }
+    self.state = kStateCompleted;
+    [self recordMetricsWithResponse:nil data:nil error:nil servedFromResponseCache:YES];
+    [self _completeWithResults:@[@{ @"code" : @200, @"body" : entry.object }] networkError:nil];
+  }];
+}
+
+- (void)storeResponseData:(NSData *)data results:(NSArray *)results
+{
+  if (!_responseCacheKey || _urlResponse.statusCode != 200 || results.count != 1) {
+    return;
+  }
+  NSDictionary<NSString *, id> *result = [FBSDKTypeUtility dictionaryValue:results.firstObject];
+  id body = result[@"body"];
+  if (!body || [FBSDKTypeUtility dictionaryValue:body][@"error"]) {
+    return;
+  }
+  [self.responseCache storeResponse:_urlResponse
+                               data:data
+                             object:body
+                             forKey:_responseCacheKey
+                               date:[NSDate date]];
+}
+
 #pragma mark - Private methods (response parsing)
 
 - (void)completeFBSDKURLSessionWithResponse:(NSURLResponse *)response
@@ -637,7 +948,14 @@ static BOOL _canMakeRequests = NO;
 
     NSInteger statusCode = _urlResponse.statusCode;
 
-    if (!error && [response.MIMEType hasPrefix:@"image"]) {
+    if (!error && statusCode == 304 && _responseCacheEntry.object) {
+      // The cached body is still current, so reuse the object parsed when it was stored.
+      FBSDKGraphResponseCacheEntry *entry = [self.responseCache refreshEntry:_responseCacheEntry
+                                                                withResponse:_urlResponse
+                                                                      forKey:_responseCacheKey
+                                                                        date:[NSDate date]] ?: _responseCacheEntry;
+      results = @[@{ @"code" : @200, @"body" : entry.object }];
+    } else if (!error && [response.MIMEType hasPrefix:@"image"]) {
       error = [FBSDKError errorWithCode:FBSDKErrorGraphRequestNonTextMimeTypeReturned
                                 message:@"Response is a non-text MIME type; endpoints that return images and other "
                @"binary data should be fetched using NSURLRequest and NSURLSession"];
@@ -645,6 +963,9 @@ static BOOL _canMakeRequests = NO;
       results = [self parseJSONResponse:data
                                   error:&error
                              statusCode:statusCode];
+      if (!error) {
+        [self storeResponseData:data results:results];
+      }
     }
   } else if (!error) {
     error = [FBSDKError errorWithCode:FBSDKErrorUnknown
@@ -672,11 +993,46 @@ static BOOL _canMakeRequests = NO;
   }
   [_logger emitToNSLog];
 
+  [self recordMetricsWithResponse:_urlResponse data:data error:error servedFromResponseCache:NO];
   [self _completeWithResults:results networkError:error];
 
   [self.session invalidateAndCancel];
 }
 
+// Sends a record of the network cost of the connection to the metrics sink, if any.
+- (void)recordMetricsWithResponse:(nullable NSHTTPURLResponse *)response
+                             data:(nullable NSData *)data
+                            error:(nullable NSError *)error
+          servedFromResponseCache:(BOOL)servedFromResponseCache
+{
+  id<FBSDKGraphRequestConnectionMetricsSink> sink = self.metricsSink;
+  if (!sink) {
+    return;
+  }
+  FBSDKGraphRequestConnectionMetrics *metrics = [[FBSDKGraphRequestConnectionMetrics alloc] initWithBatchSize:self.requests.count
+                                                                                     piggybackedRequestCount:_piggybackedRequestCount];
+  metrics.servedFromResponseCache = servedFromResponseCache;
+  metrics.retryCount = self.retryCount;
+  metrics.statusCode = response.statusCode;
+  metrics.error = error;
+  if (_connectionStartTime > 0) {
+    metrics.totalDuration = ([FBSDKInternalUtility.sharedUtility currentTimeInMilliseconds] - _connectionStartTime) / 1000.0;
+  }
+  if (!servedFromResponseCache) {
+    metrics.requestBodyBytes = _requestBodyBytes;
+    metrics.encodedRequestBodyBytes = _encodedRequestBodyBytes;
+    metrics.responseBodyBytes = data.length;
+    NSURLSessionTaskMetrics *taskMetrics = nil;
+    @synchronized(self) {
+      taskMetrics = _taskMetrics;
+    }
+    if (taskMetrics) {
+      [metrics applyTaskMetrics:taskMetrics];
+    }
+  }
+  [sink recordConnectionMetrics:metrics];
+}
+
 //
 // If there is one request, the JSON is the response.
 // If there are multiple requests, the JSON has an array of dictionaries whose
@@ -688,21 +1044,18 @@ static BOOL _canMakeRequests = NO;
 //
 // In both cases, this function returns an NSArray containing the results.
 // The NSArray looks just like the multiple request case except the body
-// value is converted from a string to parsed JSON.
+// value is converted from a string to parsed JSON, lazily for batches.
 //
 - (NSArray *)parseJSONResponse:(NSData *)data
                          error:(NSError **)error
                     statusCode:(NSInteger)statusCode
 {
-  // Graph API can return "true" or "false", which is not valid JSON.
-  // Translate that before asking JSON parser to look at it.
-  NSString *responseUTF8 = [[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding];
-  NSMutableArray *results = [NSMutableArray new];;
-  id response = [self parseJSONOrOtherwise:responseUTF8 error:error];
-
-  if (responseUTF8 == nil) {
-    NSString *base64Data = data.length != 0 ? [data base64EncodedStringWithOptions:0] : @"";
-    if (base64Data != nil) {
+  NSMutableArray *results = [NSMutableArray new];
+  id response = nil;
+  if (error == NULL || *error == nil) {
+    // Parse the response bytes directly rather than through an intermediate string.
+    response = [FBSDKGraphResponseParser objectWithData:data];
+    if (!response) {
       [self.eventLogger logInternalEvent:@"fb_response_invalid_utf8" isImplicitlyLogged:YES];
     }
   }
@@ -725,24 +1078,9 @@ static BOOL _canMakeRequests = NO;
      }];
   } else if ([response isKindOfClass:NSArray.class]) {
     // response is the array of responses, but the body element of each needs
-    // to be decoded from JSON.
-    for (id item in response) {
-      // Don't let errors parsing one response stop us from parsing another.
-      NSError *batchResultError = nil;
-      if (![item isKindOfClass:[NSDictionary<NSString *, id> class]]) {
-        [FBSDKTypeUtility array:results addObject:item];
-      } else {
-        NSMutableDictionary<NSString *, id> *result = [((NSDictionary<NSString *, id> *)item) mutableCopy];
-        if (result[@"body"]) {
-          [FBSDKTypeUtility dictionary:result setObject:[self parseJSONOrOtherwise:result[@"body"] error:&batchResultError] forKey:@"body"];
-        }
-        [FBSDKTypeUtility array:results addObject:result];
-      }
-      if (batchResultError && (*error == nil)) {
-        // We'll report back the last error we saw.
-        *error = batchResultError;
-      }
-    }
+    // to be decoded from JSON. Each body is only decoded when the result of its
+    // request is processed, so earlier completions are not delayed by later bodies.
+    [results addObjectsFromArray:[FBSDKGraphResponseParser lazyResultsForBatchResponse:response]];
   } else if ([response isKindOfClass:[NSDictionary<NSString *, id> class]]
              && (responseError = [FBSDKTypeUtility dictionaryValue:response[@"error"]]) != nil
              && [responseError[@"type"] isEqualToString:@"OAuthException"]) {
@@ -767,38 +1105,6 @@ static BOOL _canMakeRequests = NO;
   return results;
 }
 
-- (id)parseJSONOrOtherwise:(NSString *)unsafeString
-                     error:(NSError **)error
-{
-  id parsed = nil;
-
-  // Historically, people have passed-in `id` here. So, gotta double-check.
-  NSString *const utf8 = FBSDK_CAST_TO_CLASS_OR_NIL(unsafeString, NSString);
-  if (!(*error) && utf8) {
-    parsed = [FBSDKBasicUtility objectForJSONString:utf8 error:error];
-    // if we fail parse we attempt a re-parse of a modified input to support results in the form "foo=bar", "true", etc.
-    // which is shouldn't be necessary since Graph API v2.1.
-    if (*error) {
-      // we round-trip our hand-wired response through the parser in order to remain
-      // consistent with the rest of the output of this function (note, if perf turns out
-      // to be a problem -- unlikely -- we can return the following dictionary outright)
-      NSError *reparseError = nil;
-      parsed =
-      [FBSDKBasicUtility
-       objectForJSONString:
-       [FBSDKBasicUtility JSONStringForObject:@{ FBSDKNonJSONResponseProperty : utf8 }
-                                        error:NULL
-                         invalidObjectHandler:NULL]
-       error:&reparseError];
-
-      if (!reparseError) {
-        *error = nil;
-      }
-    }
-  }
-  return parsed;
-}
-
 - (void)_completeWithResults:(NSArray *)results
                 networkError:(NSError *)networkError
 {
@@ -815,7 +1121,7 @@ static BOOL _canMakeRequests = NO;
 #endif
 
   [self.requests enumerateObjectsUsingBlock:^(FBSDKGraphRequestMetadata *metadata, NSUInteger i, BOOL *stop) {
-    id result = networkError ? nil : [FBSDKTypeUtility array:results objectAtIndex:i];
+    id result = networkError ? nil : [FBSDKGraphResponseParser resolvedResult:[FBSDKTypeUtility array:results objectAtIndex:i]];
     NSError *const resultError = networkError ?: [self errorFromResult:result request:metadata.request];
 
     id body = nil;
@@ -1189,6 +1495,22 @@ static BOOL _canMakeRequests = NO;
   }
 }
 
+- (void)      URLSession:(NSURLSession *)session
+                    task:(NSURLSessionTask *)task
+  didFinishCollectingMetrics:(NSURLSessionTaskMetrics *)metrics
+{
+  @synchronized(self) {
+    _taskMetrics = metrics;
+  }
+}
+
+- (void)URLSession:(NSURLSession *)session
+              task:(NSURLSessionTask *)task
+ needNewBodyStream:(void (^)(NSInputStream *_Nullable bodyStream))completionHandler
+{
+  completionHandler([_streamedBody multipartDataStream]);
+}
+
 #pragma mark - FBSDKGraphErrorRecoveryProcessorDelegate
 
 #if !TARGET_OS_TV
@@ -9,6 +9,9 @@
 #import "FBSDKGraphRequestDataAttachment.h"
 
 @implementation FBSDKGraphRequestDataAttachment
+{
+  NSData *_data;
+}
 
 - (instancetype)initWithData:(NSData *)data filename:(NSString *)filename contentType:(NSString *)contentType
 {
@@ -20,4 +23,24 @@
   return self;
 }
 
+- (instancetype)initWithFileURL:(NSURL *)fileURL filename:(NSString *)filename contentType:(NSString *)contentType
+{
+  if ((self = [super init])) {
+    _fileURL = [fileURL copy];
+    _filename = [filename copy];
+    _contentType = [contentType copy];
+  }
+  return self;
+}
+
+- (NSData *)data
+{
+  @synchronized(self) {
+    if (!_data && _fileURL) {
+      _data = [NSData dataWithContentsOfURL:_fileURL options:NSDataReadingMappedIfSafe error:NULL] ?: [NSData data];
+    }
+    return _data;
+  }
+}
+
 @end
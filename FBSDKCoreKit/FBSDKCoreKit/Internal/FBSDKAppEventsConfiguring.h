@@ -12,6 +12,7 @@
 @protocol FBSDKAppEventsConfigurationProviding;
 @protocol FBSDKServerConfigurationProviding;
 @protocol FBSDKGraphRequestFactory;
+@protocol FBSDKGraphRequestConnectionFactory;
 @protocol FBSDKFeatureChecking;
 @protocol FBSDKDataPersisting;
 @protocol FBSDKLogging;
@@ -43,6 +44,7 @@ NS_SWIFT_NAME(AppEventsConfiguring)
            appEventsConfigurationProvider:(Class<FBSDKAppEventsConfigurationProviding>)appEventsConfigurationProvider
               serverConfigurationProvider:(id<FBSDKServerConfigurationProviding>)serverConfigurationProvider
                      graphRequestFactory:(id<FBSDKGraphRequestFactory>)graphRequestFactory
+           graphRequestConnectionFactory:(id<FBSDKGraphRequestConnectionFactory>)graphRequestConnectionFactory
                            featureChecker:(id<FBSDKFeatureChecking>)featureChecker
                                     store:(id<FBSDKDataPersisting>)store
                                    logger:(Class<FBSDKLogging>)logger
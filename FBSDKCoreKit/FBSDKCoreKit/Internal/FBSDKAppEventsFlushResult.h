@@ -0,0 +1,16 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import <Foundation/Foundation.h>
+
+typedef NS_ENUM(NSUInteger, FBSDKAppEventsFlushResult)
+{
+  FBSDKAppEventsFlushResultSuccess,
+  FBSDKAppEventsFlushResultServerError,
+  FBSDKAppEventsFlushResultNoConnectivity,
+} NS_SWIFT_NAME(AppEventsFlushResult);
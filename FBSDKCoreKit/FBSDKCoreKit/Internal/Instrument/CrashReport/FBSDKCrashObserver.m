@@ -10,6 +10,7 @@
 
 #import <FBSDKCoreKit_Basics/FBSDKCoreKit_Basics.h>
 
+#import "FBSDKAccessToken.h"
 #import "FBSDKCrashShield.h"
 #import "FBSDKFeatureChecking.h"
 #import "FBSDKFeatureManager+FeatureChecking.h"
@@ -60,7 +61,9 @@ NS_ASSUME_NONNULL_BEGIN
 
     id<FBSDKGraphRequest> request = [_graphRequestFactory createGraphRequestWithGraphPath:[NSString stringWithFormat:@"%@/instruments", [_settings appID]]
                                                                                parameters:@{@"crash_reports" : crashReports ?: @""}
-                                                                               HTTPMethod:FBSDKHTTPMethodPOST];
+                                                                              tokenString:FBSDKAccessToken.currentAccessToken.tokenString
+                                                                               HTTPMethod:FBSDKHTTPMethodPOST
+                                                                                    flags:FBSDKGraphRequestFlagBackgroundPriority];
 
     [request startWithCompletion:^(id<FBSDKGraphRequestConnecting> connection, id result, NSError *error) {
       if (!error && [result isKindOfClass:[NSDictionary<NSString *, id> class]] && result[@"success"]) {
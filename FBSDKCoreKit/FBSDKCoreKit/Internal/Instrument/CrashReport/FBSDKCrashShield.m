@@ -10,6 +10,7 @@
 
 #import <FBSDKCoreKit_Basics/FBSDKCoreKit_Basics.h>
 
+#import "FBSDKAccessToken.h"
 #import "FBSDKFeatureChecking.h"
 #import "FBSDKFeatureDisabling.h"
 #import "FBSDKGraphRequestFactoryProtocol.h"
@@ -158,7 +159,9 @@ static id<FBSDKSettings> _settings;
       if (disabledFeatureReport) {
         id<FBSDKGraphRequest> request = [_graphRequestFactory createGraphRequestWithGraphPath:[NSString stringWithFormat:@"%@/instruments", [self.settings appID]]
                                                                                    parameters:@{@"crash_shield" : disabledFeatureReport}
-                                                                                   HTTPMethod:FBSDKHTTPMethodPOST];
+                                                                                  tokenString:FBSDKAccessToken.currentAccessToken.tokenString
+                                                                                   HTTPMethod:FBSDKHTTPMethodPOST
+                                                                                        flags:FBSDKGraphRequestFlagBackgroundPriority];
 
         [request startWithCompletion:nil];
       }
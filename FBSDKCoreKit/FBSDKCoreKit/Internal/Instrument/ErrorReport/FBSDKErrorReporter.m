@@ -10,6 +10,7 @@
 
 #import <FBSDKCoreKit_Basics/FBSDKCoreKit_Basics.h>
 
+#import "FBSDKAccessToken.h"
 #import "FBSDKGraphRequest.h"
 #import "FBSDKGraphRequestConnection.h"
 #import "FBSDKGraphRequestFactory.h"
@@ -124,7 +125,9 @@ NSString *const kFBSDKErrorTimestamp = @"timestamp";
   NSString *errorData = [[NSString alloc] initWithData:jsonData encoding:NSUTF8StringEncoding];
   id<FBSDKGraphRequest> request = [self.graphRequestFactory createGraphRequestWithGraphPath:[NSString stringWithFormat:@"%@/instruments", self.settings.appID]
                                                                                  parameters:@{@"error_reports" : errorData ?: @""}
-                                                                                 HTTPMethod:FBSDKHTTPMethodPOST];
+                                                                                tokenString:FBSDKAccessToken.currentAccessToken.tokenString
+                                                                                 HTTPMethod:FBSDKHTTPMethodPOST
+                                                                                      flags:FBSDKGraphRequestFlagBackgroundPriority];
 
   [request startWithCompletion:^(id<FBSDKGraphRequestConnecting> connection, id result, NSError *error) {
     if (!error && [result isKindOfClass:[NSDictionary<NSString *, id> class]] && result[@"success"]) {
@@ -19,6 +19,18 @@ NS_SWIFT_NAME(GraphRequestBody)
 
 @property (nonatomic, retain, readonly) NSData *data;
 
+/// The size in bytes of the multipart body, known without building it.
+@property (nonatomic, readonly) unsigned long long multipartDataLength;
+
+/// The size in bytes of the body last built by `data` or `compressedData`, before compression.
+@property (nonatomic, readonly) NSUInteger dataLength;
+
+/**
+  Whether the multipart body should be sent with `multipartDataStream` rather than `data`,
+  because it refers to files or is large enough that concatenating it would be costly.
+ */
+@property (nonatomic, readonly) BOOL prefersStreaming;
+
 /**
   Determines whether to use multipart/form-data or application/json as the Content-Type.
   If binary attachments are added, this will default to YES.
@@ -45,6 +57,12 @@ NS_SWIFT_NAME(GraphRequestBody)
 
 - (nullable NSData *)compressedData;
 
+/**
+  A new stream over the multipart body, or nil for JSON bodies.
+  Attachments are read in chunks as the stream is consumed, so memory use does not depend on their size.
+ */
+- (nullable NSInputStream *)multipartDataStream;
+
 @end
 
 NS_ASSUME_NONNULL_END
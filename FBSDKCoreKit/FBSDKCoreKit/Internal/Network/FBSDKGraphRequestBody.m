@@ -12,6 +12,7 @@
 
 #import "FBSDKConstants.h"
 #import "FBSDKCrypto.h"
+#import "FBSDKGraphRequestBodyStream.h"
 #import "FBSDKGraphRequestDataAttachment.h"
 #import "FBSDKLogger.h"
 #import "FBSDKLogger+Internal.h"
@@ -19,9 +20,19 @@
 
 #define kNewline @"\r\n"
 
+// Multipart bodies above this size are streamed rather than concatenated in memory.
+static const unsigned long long FBSDKGraphRequestBodyStreamingThreshold = 1024 * 1024;
+// JSON bodies above this size are compressed on several threads.
+static const NSUInteger FBSDKGraphRequestBodyParallelCompressionThreshold = 512 * 1024;
+static const NSUInteger FBSDKGraphRequestBodyCompressionChunkSize = 128 * 1024;
+
 @interface FBSDKGraphRequestBody ()
 
-@property (nonatomic) NSMutableData *data;
+// The completed parts of the multipart body: NSData held by reference, or file NSURLs.
+@property (nonatomic) NSMutableArray<id> *parts;
+// The part the boundaries and form values are currently written to.
+@property (nonatomic) NSMutableData *currentPart;
+@property (nonatomic) BOOL hasFileParts;
 @property (nonatomic) NSMutableDictionary<NSString *, id> *json;
 @property (nonatomic) NSString *stringBoundary;
 
@@ -33,7 +44,8 @@
 {
   if ((self = [super init])) {
     _stringBoundary = [FBSDKCrypto randomString:32];
-    _data = [NSMutableData new];
+    _parts = [NSMutableArray new];
+    _currentPart = [NSMutableData new];
     _json = [NSMutableDictionary dictionary];
     _requiresMultipartDataFormat = NO;
   }
@@ -52,13 +64,28 @@
 
 - (void)appendUTF8:(NSString *)utf8
 {
-  if (!_data.length) {
+  if (!_multipartDataLength) {
     NSString *headerUTF8 = [NSString stringWithFormat:@"--%@%@", _stringBoundary, kNewline];
     NSData *headerData = [headerUTF8 dataUsingEncoding:NSUTF8StringEncoding];
-    [_data appendData:headerData];
+    [_currentPart appendData:headerData];
+    _multipartDataLength += headerData.length;
   }
   NSData *data = [utf8 dataUsingEncoding:NSUTF8StringEncoding];
-  [_data appendData:data];
+  [_currentPart appendData:data];
+  _multipartDataLength += data.length;
+}
+
+- (void)appendPart:(id)part length:(unsigned long long)length
+{
+  if (!length) {
+    return;
+  }
+  if (_currentPart.length) {
+    [FBSDKTypeUtility array:_parts addObject:_currentPart];
+    _currentPart = [NSMutableData new];
+  }
+  [FBSDKTypeUtility array:_parts addObject:part];
+  _multipartDataLength += length;
 }
 
 - (void)appendWithKey:(NSString *)key
@@ -80,7 +107,7 @@
 {
   NSData *data = UIImageJPEGRepresentation(image, FBSDKSettings.sharedSettings.JPEGCompressionQuality);
   [self _appendWithKey:key filename:key contentType:@"image/jpeg" contentBlock:^{
-    [self->_data appendData:data];
+    [self appendPart:data length:data.length];
   }];
   self.requiresMultipartDataFormat = YES;
   [logger appendFormat:@"\n    %@:\t<Image - %lu kB>", key, (unsigned long)(data.length / 1024)];
@@ -91,7 +118,7 @@
                logger:(nullable FBSDKLogger *)logger
 {
   [self _appendWithKey:key filename:key contentType:@"content/unknown" contentBlock:^{
-    [self->_data appendData:data];
+    [self appendPart:data length:data.length];
   }];
   self.requiresMultipartDataFormat = YES;
   [logger appendFormat:@"\n    %@:\t<Data - %lu kB>", key, (unsigned long)(data.length / 1024)];
@@ -103,18 +130,58 @@
 {
   NSString *filename = dataAttachment.filename ?: key;
   NSString *contentType = dataAttachment.contentType ?: @"content/unknown";
-  NSData *data = dataAttachment.data;
+  // File backed attachments are read while the body is streamed rather than loaded here.
+  id part = dataAttachment.fileURL ?: dataAttachment.data;
+  unsigned long long length = [FBSDKGraphRequestBodyStream lengthOfPart:part];
   [self _appendWithKey:key filename:filename contentType:contentType contentBlock:^{
-    [self->_data appendData:data];
+    [self appendPart:part length:length];
   }];
+  if (dataAttachment.fileURL) {
+    self.hasFileParts = YES;
+  }
   self.requiresMultipartDataFormat = YES;
-  [logger appendFormat:@"\n    %@:\t<Data - %lu kB>", key, (unsigned long)(data.length / 1024)];
+  [logger appendFormat:@"\n    %@:\t<Data - %lu kB>", key, (unsigned long)(length / 1024)];
+}
+
+- (BOOL)prefersStreaming
+{
+  return self.requiresMultipartDataFormat
+  && (self.hasFileParts || _multipartDataLength > FBSDKGraphRequestBodyStreamingThreshold);
+}
+
+- (nullable NSInputStream *)multipartDataStream
+{
+  if (!self.requiresMultipartDataFormat) {
+    return nil;
+  }
+  return [FBSDKGraphRequestBodyStream inputStreamWithParts:[self allParts]];
+}
+
+- (NSArray<id> *)allParts
+{
+  NSMutableArray<id> *parts = [_parts mutableCopy];
+  if (_currentPart.length) {
+    [FBSDKTypeUtility array:parts addObject:[_currentPart copy]];
+  }
+  return parts;
 }
 
 - (NSData *)data
 {
   if (self.requiresMultipartDataFormat) {
-    return [_data copy];
+    NSMutableData *data = [NSMutableData dataWithCapacity:(NSUInteger)_multipartDataLength];
+    for (id part in [self allParts]) {
+      if ([part isKindOfClass:NSURL.class]) {
+        NSData *fileData = [NSData dataWithContentsOfURL:part options:NSDataReadingMappedIfSafe error:NULL];
+        if (fileData) {
+          [data appendData:fileData];
+        }
+      } else {
+        [data appendData:part];
+      }
+    }
+    _dataLength = data.length;
+    return data;
   } else {
     NSData *jsonData;
     if (_json.allKeys.count > 0) {
@@ -122,7 +189,7 @@
     } else {
       jsonData = [NSData data];
     }
-
+    _dataLength = jsonData.length;
     return jsonData;
   }
 }
@@ -153,11 +220,21 @@
 
 - (nullable NSData *)compressedData
 {
-  if (!self.data.length || ![[self mimeContentType] isEqualToString:@"application/json"]) {
+  if (![[self mimeContentType] isEqualToString:@"application/json"]) {
     return nil;
   }
-
-  return [FBSDKBasicUtility gzip:self.data];
+  // Serialize once; the JSON is rebuilt on every access to `data`.
+  NSData *data = self.data;
+  if (!data.length) {
+    return nil;
+  }
+  if (data.length > FBSDKGraphRequestBodyParallelCompressionThreshold) {
+    return [FBSDKGzipCompressor parallelGzip:data
+                                       level:FBSDKGzipCompressionLevelDefault
+                                    strategy:FBSDKGzipStrategyDefault
+                                   chunkSize:FBSDKGraphRequestBodyCompressionChunkSize];
+  }
+  return [FBSDKGzipCompressor gzip:data level:FBSDKGzipCompressionLevelDefault strategy:FBSDKGzipStrategyDefault];
 }
 
 @end
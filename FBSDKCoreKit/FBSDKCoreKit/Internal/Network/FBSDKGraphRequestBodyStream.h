@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Streams the parts of a request body without concatenating them in memory.
+
+ Parts are either `NSData`, read as is, or file `NSURL`s, opened when the reader reaches them.
+ Bytes are only produced when the stream is read, straight into the reader's buffer, so a stream
+ that is never read costs nothing and at most one file is open at any time.
+ */
+NS_SWIFT_NAME(GraphRequestBodyStream)
+@interface FBSDKGraphRequestBodyStream : NSInputStream
+
+- (instancetype)initWithData:(NSData *)data NS_UNAVAILABLE;
+- (nullable instancetype)initWithURL:(NSURL *)url NS_UNAVAILABLE;
+
+- (instancetype)initWithParts:(NSArray<id> *)parts NS_DESIGNATED_INITIALIZER;
+
+/**
+ Returns an unopened stream that reads the parts in order, suitable for `HTTPBodyStream`.
+ Each call returns a new stream.
+ */
++ (NSInputStream *)inputStreamWithParts:(NSArray<id> *)parts;
+
+/// The size in bytes of a part, or 0 for files that cannot be read.
++ (unsigned long long)lengthOfPart:(id)part;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import "FBSDKGraphRequestBodyStream.h"
+
+#import <FBSDKCoreKit_Basics/FBSDKCoreKit_Basics.h>
+
+@implementation FBSDKGraphRequestBodyStream
+{
+  NSArray<id> *_parts;
+  NSUInteger _partIndex;
+  NSUInteger _dataOffset;
+  NSInputStream *_fileStream;
+  NSStreamStatus _status;
+  NSError *_error;
+  __weak id<NSStreamDelegate> _delegate;
+}
+
+- (instancetype)initWithParts:(NSArray<id> *)parts
+{
+  if ((self = [super initWithData:[NSData data]])) {
+    _parts = [parts copy];
+    _status = NSStreamStatusNotOpen;
+  }
+  return self;
+}
+
++ (NSInputStream *)inputStreamWithParts:(NSArray<id> *)parts
+{
+  return [[self alloc] initWithParts:parts];
+}
+
++ (unsigned long long)lengthOfPart:(id)part
+{
+  if ([part isKindOfClass:NSData.class]) {
+    return ((NSData *)part).length;
+  }
+  if ([part isKindOfClass:NSURL.class]) {
+    NSNumber *fileSize = nil;
+    if ([(NSURL *)part getResourceValue:&fileSize forKey:NSURLFileSizeKey error:NULL]) {
+      return fileSize.unsignedLongLongValue;
+    }
+  }
+  return 0;
+}
+
+#pragma mark - NSStream
+
+- (void)open
+{
+  if (_status == NSStreamStatusNotOpen) {
+    _status = _parts.count ? NSStreamStatusOpen : NSStreamStatusAtEnd;
+  }
+}
+
+- (void)close
+{
+  [_fileStream close];
+  _fileStream = nil;
+  _status = NSStreamStatusClosed;
+}
+
+- (NSStreamStatus)streamStatus
+{
+  return _status;
+}
+
+- (nullable NSError *)streamError
+{
+  return _error;
+}
+
+- (nullable id<NSStreamDelegate>)delegate
+{
+  return _delegate;
+}
+
+- (void)setDelegate:(nullable id<NSStreamDelegate>)delegate
+{
+  _delegate = delegate;
+}
+
+// Reads never block, so there are no events to deliver on a run loop.
+- (void)scheduleInRunLoop:(NSRunLoop *)runLoop forMode:(NSRunLoopMode)mode {}
+
+- (void)removeFromRunLoop:(NSRunLoop *)runLoop forMode:(NSRunLoopMode)mode {}
+
+- (nullable id)propertyForKey:(NSStreamPropertyKey)key
+{
+  return nil;
+}
+
+- (BOOL)setProperty:(nullable id)property forKey:(NSStreamPropertyKey)key
+{
+  return NO;
+}
+
+#pragma mark - NSInputStream
+
+- (NSInteger)read:(uint8_t *)buffer maxLength:(NSUInteger)length
+{
+  if (_status == NSStreamStatusAtEnd) {
+    return 0;
+  }
+  if (_status != NSStreamStatusOpen) {
+    return -1;
+  }
+
+  NSUInteger totalRead = 0;
+  while (totalRead < length && _partIndex < _parts.count) {
+    NSInteger bytesRead = [self _readPart:[FBSDKTypeUtility array:_parts objectAtIndex:_partIndex] intoBuffer:buffer + totalRead maxLength:length - totalRead];
+    if (bytesRead < 0) {
+      [_fileStream close];
+      _fileStream = nil;
+      _status = NSStreamStatusError;
+      return -1;
+    }
+    if (bytesRead == 0) {
+      [self _moveToNextPart];
+    } else {
+      totalRead += (NSUInteger)bytesRead;
+    }
+  }
+  if (_partIndex >= _parts.count) {
+    _status = NSStreamStatusAtEnd;
+  }
+  return (NSInteger)totalRead;
+}
+
+- (BOOL)getBuffer:(uint8_t *_Nullable *_Nonnull)buffer length:(NSUInteger *)length
+{
+  return NO;
+}
+
+- (BOOL)hasBytesAvailable
+{
+  return _status == NSStreamStatusOpen;
+}
+
+#pragma mark - CFReadStream bridging
+
+// NSURLSession uses the stream through CFReadStream, which calls these on NSInputStream subclasses.
+- (void)_scheduleInCFRunLoop:(CFRunLoopRef)runLoop forMode:(CFStringRef)mode {}
+
+- (void)_unscheduleFromCFRunLoop:(CFRunLoopRef)runLoop forMode:(CFStringRef)mode {}
+
+- (BOOL)_setCFClientFlags:(CFOptionFlags)flags
+                 callback:(CFReadStreamClientCallBack)callback
+                  context:(CFStreamClientContext *)context
+{
+  return NO;
+}
+
+#pragma mark - Helpers
+
+// Returns the number of bytes read from the part, 0 once it is exhausted, or -1 on errors.
+- (NSInteger)_readPart:(id)part intoBuffer:(uint8_t *)buffer maxLength:(NSUInteger)length
+{
+  if ([part isKindOfClass:NSData.class]) {
+    NSData *data = (NSData *)part;
+    NSUInteger count = MIN(length, data.length - _dataOffset);
+    [data getBytes:buffer range:NSMakeRange(_dataOffset, count)];
+    _dataOffset += count;
+    return (NSInteger)count;
+  }
+  if ([part isKindOfClass:NSURL.class]) {
+    if (!_fileStream) {
+      _fileStream = [NSInputStream inputStreamWithURL:(NSURL *)part];
+      [_fileStream open];
+    }
+    NSInteger bytesRead = [_fileStream read:buffer maxLength:length];
+    if (bytesRead < 0 || !_fileStream) {
+      _error = _fileStream.streamError
+      ?: [NSError errorWithDomain:NSCocoaErrorDomain code:NSFileReadUnknownError userInfo:@{NSURLErrorKey : part}];
+      return -1;
+    }
+    return bytesRead;
+  }
+  return 0;
+}
+
+- (void)_moveToNextPart
+{
+  [_fileStream close];
+  _fileStream = nil;
+  _dataOffset = 0;
+  _partIndex++;
+}
+
+@end
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import "FBSDKGraphRequestRetryPolicy.h"
+
+@class FBSDKTokenBucket;
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef NS_ENUM(NSUInteger, FBSDKCircuitBreakerState) {
+  /// Requests are sent.
+  FBSDKCircuitBreakerStateClosed = 0,
+  /// Requests fail right away until the cool down elapses.
+  FBSDKCircuitBreakerStateOpen,
+  /// A single probe request is sent to find out whether the server recovered.
+  FBSDKCircuitBreakerStateHalfOpen,
+} NS_SWIFT_NAME(CircuitBreakerState);
+
+/// Posted with the circuit breaker as the object whenever its state changes.
+FOUNDATION_EXPORT NSNotificationName const FBSDKGraphRequestCircuitBreakerStateDidChangeNotification
+NS_SWIFT_NAME(GraphRequestCircuitBreakerStateDidChange);
+
+/// Returns the current date.
+typedef NSDate *_Nonnull (^FBSDKDateProvider)(void)
+NS_SWIFT_NAME(DateProvider);
+
+/**
+ Process wide admission control for background priority Graph request connections.
+
+ A token bucket smooths bursts of connections. Consecutive transient server failures open the circuit, after which
+ background connections fail right away instead of adding load to an unhealthy server. Once the cool down elapses a single
+ probe is let through; its success closes the circuit, and its failure opens it again for twice as long.
+
+ Observe `FBSDKGraphRequestCircuitBreakerStateDidChangeNotification` to pause work that would only fail.
+ This type is thread safe.
+ */
+NS_SWIFT_NAME(GraphRequestCircuitBreaker)
+@interface FBSDKGraphRequestCircuitBreaker : NSObject
+
+@property (class, nonatomic, readonly) FBSDKGraphRequestCircuitBreaker *shared;
+
+@property (nonatomic, readonly) FBSDKCircuitBreakerState state;
+/// The number of consecutive transient failures that opens the circuit.
+@property (nonatomic, readonly) NSUInteger failureThreshold;
+/// The current cool down of the open circuit.
+@property (nonatomic, readonly) NSTimeInterval cooldown;
+@property (nonatomic, readonly) FBSDKTokenBucket *rateLimiter;
+
+- (instancetype)init NS_UNAVAILABLE;
++ (instancetype)new NS_UNAVAILABLE;
+
+/**
+ @param dateProvider The clock, or nil to use the current date.
+ @param delayedBlockPerformer Runs the delayed admissions and the end of cool downs, or nil to use the global queue.
+ */
+- (instancetype)initWithFailureThreshold:(NSUInteger)failureThreshold
+                                cooldown:(NSTimeInterval)cooldown
+                             maxCooldown:(NSTimeInterval)maxCooldown
+                             rateLimiter:(FBSDKTokenBucket *)rateLimiter
+                      notificationCenter:(NSNotificationCenter *)notificationCenter
+                            dateProvider:(nullable FBSDKDateProvider)dateProvider
+                   delayedBlockPerformer:(nullable FBSDKDelayedBlockPerformer)delayedBlockPerformer
+  NS_DESIGNATED_INITIALIZER;
+
+/**
+ Calls `completion` once the request may be sent, or right away with NO if the circuit does not let it through.
+ Admitted requests must report their outcome with `recordSuccess` or `recordFailure`.
+ */
+- (void)admitRequest:(void (^)(BOOL admitted))completion;
+
+/// Records a request answered without a transient failure.
+- (void)recordSuccess;
+
+/// Records a request that failed transiently.
+- (void)recordFailure;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import "FBSDKGraphRequestCircuitBreaker.h"
+
+#import "FBSDKTokenBucket.h"
+
+NSNotificationName const FBSDKGraphRequestCircuitBreakerStateDidChangeNotification = @"com.facebook.sdk.FBSDKGraphRequestCircuitBreakerStateDidChangeNotification";
+
+static const NSUInteger FBSDKGraphRequestCircuitBreakerFailureThreshold = 5;
+static const NSTimeInterval FBSDKGraphRequestCircuitBreakerCooldown = 30;
+static const NSTimeInterval FBSDKGraphRequestCircuitBreakerMaxCooldown = 300;
+// Lets the handful of requests issued at launch through at once, then about one request per second.
+static const double FBSDKGraphRequestCircuitBreakerBurstCapacity = 30;
+static const double FBSDKGraphRequestCircuitBreakerTokensPerSecond = 1;
+
+@interface FBSDKGraphRequestCircuitBreaker ()
+
+@property (nonatomic, readonly) NSTimeInterval baseCooldown;
+@property (nonatomic, readonly) NSTimeInterval maxCooldown;
+@property (nonatomic, readonly) NSNotificationCenter *notificationCenter;
+@property (nonatomic, readonly, copy) FBSDKDateProvider dateProvider;
+@property (nonatomic, readonly, copy) FBSDKDelayedBlockPerformer delayedBlockPerformer;
+
+@end
+
+@implementation FBSDKGraphRequestCircuitBreaker
+{
+  FBSDKCircuitBreakerState _state;
+  NSTimeInterval _cooldown;
+  NSUInteger _consecutiveFailureCount;
+  NSDate *_openDate;
+  NSDate *_probeDate;
+  NSUInteger _openCount;
+}
+
++ (FBSDKGraphRequestCircuitBreaker *)shared
+{
+  static dispatch_once_t onceToken;
+  static FBSDKGraphRequestCircuitBreaker *shared;
+  dispatch_once(&onceToken, ^{
+    FBSDKTokenBucket *rateLimiter = [[FBSDKTokenBucket alloc] initWithCapacity:FBSDKGraphRequestCircuitBreakerBurstCapacity
+                                                               tokensPerSecond:FBSDKGraphRequestCircuitBreakerTokensPerSecond];
+    shared = [[self alloc] initWithFailureThreshold:FBSDKGraphRequestCircuitBreakerFailureThreshold
+                                           cooldown:FBSDKGraphRequestCircuitBreakerCooldown
+                                        maxCooldown:FBSDKGraphRequestCircuitBreakerMaxCooldown
+                                        rateLimiter:rateLimiter
+                                 notificationCenter:NSNotificationCenter.defaultCenter
+                                       dateProvider:nil
+                              delayedBlockPerformer:nil];
+  });
+  return shared;
+}
+
+- (instancetype)initWithFailureThreshold:(NSUInteger)failureThreshold
+                                cooldown:(NSTimeInterval)cooldown
+                             maxCooldown:(NSTimeInterval)maxCooldown
+                             rateLimiter:(FBSDKTokenBucket *)rateLimiter
+                      notificationCenter:(NSNotificationCenter *)notificationCenter
+                            dateProvider:(nullable FBSDKDateProvider)dateProvider
+                   delayedBlockPerformer:(nullable FBSDKDelayedBlockPerformer)delayedBlockPerformer
+{
+  if ((self = [super init])) {
+    _failureThreshold = MAX(1, failureThreshold);
+    _baseCooldown = MAX(0, cooldown);
+    _maxCooldown = MAX(_baseCooldown, maxCooldown);
+    _cooldown = _baseCooldown;
+    _rateLimiter = rateLimiter;
+    _notificationCenter = notificationCenter;
+    _dateProvider = [dateProvider copy] ?: ^NSDate * {
+      return [NSDate date];
+    };
+    _delayedBlockPerformer = [delayedBlockPerformer copy] ?: ^(NSTimeInterval delay, dispatch_block_t block) {
+      dispatch_after(
+        dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)),
+        dispatch_get_global_queue(QOS_CLASS_UTILITY, 0),
+        block
+      );
+    };
+  }
+  return self;
+}
+
+#pragma mark - Properties
+
+- (FBSDKCircuitBreakerState)state
+{
+  @synchronized(self) {
+    return _state;
+  }
+}
+
+- (NSTimeInterval)cooldown
+{
+  @synchronized(self) {
+    return _cooldown;
+  }
+}
+
+#pragma mark - Admission
+
+- (void)admitRequest:(void (^)(BOOL admitted))completion
+{
+  if (!completion) {
+    return;
+  }
+  NSDate *date = self.dateProvider();
+  BOOL admitted = NO;
+  BOOL didChangeState = NO;
+  @synchronized(self) {
+    didChangeState = [self endCooldownIfNeededAtDate:date];
+    switch (_state) {
+      case FBSDKCircuitBreakerStateClosed:
+        admitted = YES;
+        break;
+      case FBSDKCircuitBreakerStateOpen:
+        admitted = NO;
+        break;
+      case FBSDKCircuitBreakerStateHalfOpen:
+        // A probe that never reported back does not block the circuit forever.
+        admitted = !_probeDate || [date timeIntervalSinceDate:_probeDate] >= _cooldown;
+        if (admitted) {
+          _probeDate = date;
+        }
+        break;
+    }
+  }
+  if (didChangeState) {
+    [self postStateDidChange];
+  }
+
+  if (!admitted) {
+    completion(NO);
+    return;
+  }
+  NSTimeInterval delay = [self.rateLimiter reserveTokenAtDate:date];
+  if (delay <= 0) {
+    completion(YES);
+  } else {
+    self.delayedBlockPerformer(delay, ^{
+      completion(YES);
+    });
+  }
+}
+
+- (void)recordSuccess
+{
+  BOOL didChangeState = NO;
+  @synchronized(self) {
+    _consecutiveFailureCount = 0;
+    if (_state == FBSDKCircuitBreakerStateHalfOpen) {
+      _state = FBSDKCircuitBreakerStateClosed;
+      _cooldown = self.baseCooldown;
+      _probeDate = nil;
+      didChangeState = YES;
+    }
+  }
+  if (didChangeState) {
+    [self postStateDidChange];
+  }
+}
+
+- (void)recordFailure
+{
+  NSDate *date = self.dateProvider();
+  BOOL didOpen = NO;
+  NSUInteger openCount = 0;
+  NSTimeInterval cooldown = 0;
+  @synchronized(self) {
+    switch (_state) {
+      case FBSDKCircuitBreakerStateClosed:
+        _consecutiveFailureCount++;
+        didOpen = _consecutiveFailureCount >= self.failureThreshold;
+        break;
+      case FBSDKCircuitBreakerStateHalfOpen:
+        _cooldown = MIN(_cooldown * 2, self.maxCooldown);
+        didOpen = YES;
+        break;
+      case FBSDKCircuitBreakerStateOpen:
+        break;
+    }
+    if (didOpen) {
+      _state = FBSDKCircuitBreakerStateOpen;
+      _consecutiveFailureCount = 0;
+      _openDate = date;
+      _probeDate = nil;
+      openCount = ++_openCount;
+      cooldown = _cooldown;
+    }
+  }
+  if (!didOpen) {
+    return;
+  }
+  [self postStateDidChange];
+
+  // Let observers know when a probe can go out, even if no request asks for it.
+  __weak typeof(self) weakSelf = self;
+  self.delayedBlockPerformer(cooldown, ^{
+    [weakSelf endCooldownOfOpening:openCount];
+  });
+}
+
+#pragma mark - Private
+
+- (BOOL)endCooldownIfNeededAtDate:(NSDate *)date
+{
+  if (_state != FBSDKCircuitBreakerStateOpen || [date timeIntervalSinceDate:_openDate] < _cooldown) {
+    return NO;
+  }
+  _state = FBSDKCircuitBreakerStateHalfOpen;
+  return YES;
+}
+
+- (void)endCooldownOfOpening:(NSUInteger)openCount
+{
+  BOOL didChangeState = NO;
+  @synchronized(self) {
+    if (openCount == _openCount && _state == FBSDKCircuitBreakerStateOpen) {
+      _state = FBSDKCircuitBreakerStateHalfOpen;
+      didChangeState = YES;
+    }
+  }
+  if (didChangeState) {
+    [self postStateDidChange];
+  }
+}
+
+- (void)postStateDidChange
+{
+  [self.notificationCenter postNotificationName:FBSDKGraphRequestCircuitBreakerStateDidChangeNotification
+                                         object:self];
+}
+
+@end
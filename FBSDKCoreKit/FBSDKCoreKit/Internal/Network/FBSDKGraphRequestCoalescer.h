@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import "FBSDKGraphRequestConnecting.h"
+
+@protocol FBSDKGraphRequest;
+@protocol FBSDKGraphRequestConnectionFactory;
+@protocol FBSDKSettings;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Merges independent Graph requests started within a short window into batch requests,
+ so that the requests issued together at launch cost a single round trip.
+
+ Each request keeps its own completion, called with the connection returned when it was started.
+ Requests are only batched together when they were created with the same connection factory,
+ and fall back to individual connections when no app ID is available for the batch.
+ A batch uses the largest timeout of its requests. Requests whose connection was given a delegate
+ are never batched, so that the delegate only hears about its own request.
+ */
+NS_SWIFT_NAME(GraphRequestCoalescer)
+@interface FBSDKGraphRequestCoalescer : NSObject
+
+@property (class, nonatomic, readonly) FBSDKGraphRequestCoalescer *shared;
+
+/// How long to wait for more requests after the first one is started. Defaults to 0, which disables coalescing.
+@property (nonatomic) NSTimeInterval window;
+
+@property (nonatomic, readonly, getter = isEnabled) BOOL enabled;
+
+/// The number of requests waiting for the window to elapse.
+@property (nonatomic, readonly) NSUInteger pendingRequestCount;
+
+- (instancetype)init NS_UNAVAILABLE;
++ (instancetype)new NS_UNAVAILABLE;
+
+- (instancetype)initWithSettings:(id<FBSDKSettings>)settings NS_DESIGNATED_INITIALIZER;
+
+/**
+ Queues the request to be sent with the other requests started within the window.
+ Returns a connection that can be used to cancel the request before it is answered.
+ */
+- (id<FBSDKGraphRequestConnecting>)startRequest:(id<FBSDKGraphRequest>)request
+                              connectionFactory:(id<FBSDKGraphRequestConnectionFactory>)connectionFactory
+                                     completion:(nullable FBSDKGraphRequestCompletion)completion;
+
+/**
+ Queues the request like `startRequest:connectionFactory:completion:`, with a timeout for its connection.
+ When coalescing is disabled, the request is started right away on its own connection.
+
+ @param timeout The timeout of the connection, or 0 for the default timeout.
+ */
+- (id<FBSDKGraphRequestConnecting>)startRequest:(id<FBSDKGraphRequest>)request
+                              connectionFactory:(id<FBSDKGraphRequestConnectionFactory>)connectionFactory
+                                        timeout:(NSTimeInterval)timeout
+                                     completion:(nullable FBSDKGraphRequestCompletion)completion;
+
+/// Sends the pending requests right away.
+- (void)flush;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import "FBSDKGraphRequestCoalescer.h"
+
+#import <FBSDKCoreKit_Basics/FBSDKCoreKit_Basics.h>
+
+#import "FBSDKGraphRequestConnectionFactoryProtocol.h"
+#import "FBSDKGraphRequestProtocol.h"
+#import "FBSDKSettings.h"
+#import "FBSDKSettingsProtocol.h"
+
+// The Graph API rejects batches with more requests than this.
+static const NSUInteger FBSDKGraphRequestCoalescerMaxBatchSize = 50;
+
+// Stands in for the connection of a coalesced request until the batch it ends up in is answered.
+@interface FBSDKCoalescedGraphRequestConnection : NSObject <FBSDKGraphRequestConnecting>
+
+@property (nonatomic, assign) NSTimeInterval timeout;
+@property (nonatomic, weak, nullable) id<FBSDKGraphRequestConnectionDelegate> delegate;
+@property (nonatomic, readonly) id<FBSDKGraphRequest> request;
+@property (nonatomic, readonly) id<FBSDKGraphRequestConnectionFactory> connectionFactory;
+@property (nullable, nonatomic, readonly, copy) FBSDKGraphRequestCompletion completion;
+@property (nonatomic, weak) FBSDKGraphRequestCoalescer *coalescer;
+@property (atomic, getter = isCancelled) BOOL cancelled;
+
+- (instancetype)initWithRequest:(id<FBSDKGraphRequest>)request
+              connectionFactory:(id<FBSDKGraphRequestConnectionFactory>)connectionFactory
+                        timeout:(NSTimeInterval)timeout
+                     completion:(nullable FBSDKGraphRequestCompletion)completion
+                      coalescer:(FBSDKGraphRequestCoalescer *)coalescer;
+
+@end
+
+@interface FBSDKGraphRequestCoalescer ()
+
+@property (nonatomic, readonly) id<FBSDKSettings> settings;
+@property (nonatomic, readonly) NSMutableArray<FBSDKCoalescedGraphRequestConnection *> *pendingConnections;
+@property (nonatomic) NSUInteger flushGeneration;
+
+- (void)removePendingConnection:(FBSDKCoalescedGraphRequestConnection *)connection;
+
+@end
+
+@implementation FBSDKCoalescedGraphRequestConnection
+
+- (instancetype)initWithRequest:(id<FBSDKGraphRequest>)request
+              connectionFactory:(id<FBSDKGraphRequestConnectionFactory>)connectionFactory
+                        timeout:(NSTimeInterval)timeout
+                     completion:(nullable FBSDKGraphRequestCompletion)completion
+                      coalescer:(FBSDKGraphRequestCoalescer *)coalescer
+{
+  if ((self = [super init])) {
+    _request = request;
+    _connectionFactory = connectionFactory;
+    _timeout = timeout;
+    _completion = [completion copy];
+    _coalescer = coalescer;
+  }
+  return self;
+}
+
+- (void)addRequest:(id<FBSDKGraphRequest>)request
+        completion:(FBSDKGraphRequestCompletion)handler
+{
+  @throw [NSException exceptionWithName:NSInternalInconsistencyException
+                                 reason:@"Cannot add requests once started or if a URLRequest is set"
+                               userInfo:nil];
+}
+
+- (void)start
+{
+  // Coalesced requests are started by the coalescer.
+}
+
+- (void)cancel
+{
+  self.cancelled = YES;
+  [self.coalescer removePendingConnection:self];
+}
+
+@end
+
+@implementation FBSDKGraphRequestCoalescer
+
++ (FBSDKGraphRequestCoalescer *)shared
+{
+  static FBSDKGraphRequestCoalescer *instance;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    instance = [[self alloc] initWithSettings:FBSDKSettings.sharedSettings];
+  });
+  return instance;
+}
+
+- (instancetype)initWithSettings:(id<FBSDKSettings>)settings
+{
+  if ((self = [super init])) {
+    _settings = settings;
+    _pendingConnections = [NSMutableArray new];
+  }
+  return self;
+}
+
+- (BOOL)isEnabled
+{
+  return self.window > 0;
+}
+
+- (NSUInteger)pendingRequestCount
+{
+  @synchronized(self) {
+    return self.pendingConnections.count;
+  }
+}
+
+- (id<FBSDKGraphRequestConnecting>)startRequest:(id<FBSDKGraphRequest>)request
+                              connectionFactory:(id<FBSDKGraphRequestConnectionFactory>)connectionFactory
+                                     completion:(nullable FBSDKGraphRequestCompletion)completion
+{
+  return [self startRequest:request
+          connectionFactory:connectionFactory
+                    timeout:0
+                 completion:completion];
+}
+
+- (id<FBSDKGraphRequestConnecting>)startRequest:(id<FBSDKGraphRequest>)request
+                              connectionFactory:(id<FBSDKGraphRequestConnectionFactory>)connectionFactory
+                                        timeout:(NSTimeInterval)timeout
+                                     completion:(nullable FBSDKGraphRequestCompletion)completion
+{
+  if (!self.isEnabled) {
+    id<FBSDKGraphRequestConnecting> connection = [connectionFactory createGraphRequestConnection];
+    if (timeout > 0) {
+      connection.timeout = timeout;
+    }
+    [connection addRequest:request completion:completion];
+    [connection start];
+    return connection;
+  }
+
+  FBSDKCoalescedGraphRequestConnection *connection = [[FBSDKCoalescedGraphRequestConnection alloc] initWithRequest:request
+                                                                                                 connectionFactory:connectionFactory
+                                                                                                           timeout:timeout
+                                                                                                        completion:completion
+                                                                                                         coalescer:self];
+  BOOL isFirstPendingConnection = NO;
+  NSUInteger generation = 0;
+  @synchronized(self) {
+    [FBSDKTypeUtility array:self.pendingConnections addObject:connection];
+    isFirstPendingConnection = self.pendingConnections.count == 1;
+    generation = self.flushGeneration;
+  }
+
+  if (isFirstPendingConnection) {
+    __weak typeof(self) weakSelf = self;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(self.window * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+      [weakSelf flushGeneration:generation];
+    });
+  }
+  return connection;
+}
+
+- (void)flush
+{
+  NSArray<FBSDKCoalescedGraphRequestConnection *> *connections;
+  @synchronized(self) {
+    connections = [self.pendingConnections copy];
+    [self.pendingConnections removeAllObjects];
+    self.flushGeneration++;
+  }
+  if (connections.count == 0) {
+    return;
+  }
+
+  // Only requests sharing a connection factory can go in the same batch. A request whose connection has a delegate
+  // goes on its own, as the delegate would otherwise be told about the progress of the other requests.
+  NSMutableArray<NSMutableArray<FBSDKCoalescedGraphRequestConnection *> *> *groups = [NSMutableArray array];
+  for (FBSDKCoalescedGraphRequestConnection *connection in connections) {
+    NSMutableArray<FBSDKCoalescedGraphRequestConnection *> *group = nil;
+    for (NSMutableArray<FBSDKCoalescedGraphRequestConnection *> *candidate in groups) {
+      if (!connection.delegate
+          && !candidate.firstObject.delegate
+          && candidate.firstObject.connectionFactory == connection.connectionFactory
+          && candidate.count < FBSDKGraphRequestCoalescerMaxBatchSize) {
+        group = candidate;
+        break;
+      }
+    }
+    if (group) {
+      [FBSDKTypeUtility array:group addObject:connection];
+    } else {
+      [FBSDKTypeUtility array:groups addObject:[NSMutableArray arrayWithObject:connection]];
+    }
+  }
+
+  // Batches need an app ID, without one every request goes out on its own.
+  BOOL canBatch = self.settings.appID.length > 0;
+  for (NSArray<FBSDKCoalescedGraphRequestConnection *> *group in groups) {
+    if (canBatch) {
+      [self startConnections:group];
+    } else {
+      for (FBSDKCoalescedGraphRequestConnection *connection in group) {
+        [self startConnections:@[connection]];
+      }
+    }
+  }
+}
+
+#pragma mark - Private
+
+- (void)flushGeneration:(NSUInteger)generation
+{
+  @synchronized(self) {
+    if (generation != self.flushGeneration) {
+      // Already flushed, a newer window is pending.
+      return;
+    }
+  }
+  [self flush];
+}
+
+- (void)startConnections:(NSArray<FBSDKCoalescedGraphRequestConnection *> *)coalescedConnections
+{
+  id<FBSDKGraphRequestConnecting> connection = [coalescedConnections.firstObject.connectionFactory createGraphRequestConnection];
+  connection.delegate = coalescedConnections.firstObject.delegate;
+
+  // Use the largest timeout so that no request gets less time than it asked for. A request without one gets the
+  // default timeout of the connection.
+  NSTimeInterval timeout = 0;
+  BOOL usesDefaultTimeout = NO;
+  for (FBSDKCoalescedGraphRequestConnection *coalescedConnection in coalescedConnections) {
+    if (coalescedConnection.timeout > 0) {
+      timeout = MAX(timeout, coalescedConnection.timeout);
+    } else {
+      usesDefaultTimeout = YES;
+    }
+  }
+  if (usesDefaultTimeout) {
+    timeout = MAX(timeout, connection.timeout);
+  }
+  if (timeout > 0) {
+    connection.timeout = timeout;
+  }
+
+  for (FBSDKCoalescedGraphRequestConnection *coalescedConnection in coalescedConnections) {
+    [connection addRequest:coalescedConnection.request
+                completion:^(id<FBSDKGraphRequestConnecting> potentialConnection, id result, NSError *error) {
+                  if (coalescedConnection.isCancelled || !coalescedConnection.completion) {
+                    return;
+                  }
+                  coalescedConnection.completion(coalescedConnection, result, error);
+                }];
+  }
+  [connection start];
+}
+
+- (void)removePendingConnection:(FBSDKCoalescedGraphRequestConnection *)connection
+{
+  @synchronized(self) {
+    [self.pendingConnections removeObject:connection];
+  }
+}
+
+@end
@@ -20,7 +20,11 @@
 @protocol FBSDKOperatingSystemVersionComparing;
 @protocol FBSDKMacCatalystDetermining;
 @class FBSDKGraphRequestBody;
+@class FBSDKGraphRequestCircuitBreaker;
 @class FBSDKGraphRequestMetadata;
+@class FBSDKGraphRequestRetryPolicy;
+@class FBSDKGraphRequestScheduler;
+@class FBSDKGraphResponseCache;
 @class FBSDKLogger;
 
 #import <FBSDKCoreKit/FBSDKGraphRequestConnection.h>
@@ -56,6 +60,13 @@ typedef NS_ENUM(NSUInteger, FBSDKGraphRequestConnectionState) {
 @property (nonatomic, strong) id<FBSDKMacCatalystDetermining> macCatalystDeterminator;
 @property (nonatomic, strong) Class<FBSDKAccessTokenProviding> accessTokenProvider;
 @property (nonatomic, strong) Class<FBSDKAccessTokenSetting> accessTokenSetter;
+@property (nonatomic, strong) FBSDKGraphResponseCache *responseCache;
+@property (nonatomic, strong) FBSDKGraphRequestScheduler *scheduler;
+@property (nonatomic, strong) FBSDKGraphRequestRetryPolicy *retryPolicy;
+@property (nonatomic, strong) FBSDKGraphRequestCircuitBreaker *circuitBreaker;
+/// The number of times the requests of the connection were sent again after a transient failure.
+@property (nonatomic, assign) NSUInteger retryCount;
+@property (nullable, nonatomic, strong) id<FBSDKGraphRequestConnectionMetricsSink> metricsSink;
 
 + (BOOL)canMakeRequests;
 + (void)setCanMakeRequests;
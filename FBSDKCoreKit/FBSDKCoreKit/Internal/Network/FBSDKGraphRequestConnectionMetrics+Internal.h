@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import <FBSDKCoreKit/FBSDKGraphRequestConnectionMetrics.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface FBSDKGraphRequestConnectionMetrics ()
+
+@property (nonatomic, readwrite) NSTimeInterval domainLookupDuration;
+@property (nonatomic, readwrite) NSTimeInterval connectDuration;
+@property (nonatomic, readwrite) NSTimeInterval secureConnectionDuration;
+@property (nonatomic, readwrite) NSTimeInterval timeToFirstByte;
+@property (nonatomic, readwrite) NSTimeInterval totalDuration;
+@property (nonatomic, readwrite, getter = isReusedConnection) BOOL reusedConnection;
+@property (nonatomic, readwrite, getter = isServedFromResponseCache) BOOL servedFromResponseCache;
+@property (nonatomic, readwrite) unsigned long long requestBodyBytes;
+@property (nonatomic, readwrite) unsigned long long encodedRequestBodyBytes;
+@property (nonatomic, readwrite) unsigned long long responseBodyBytes;
+@property (nonatomic, readwrite) unsigned long long encodedResponseBodyBytes;
+@property (nonatomic, readwrite) NSUInteger retryCount;
+@property (nonatomic, readwrite) NSInteger statusCode;
+@property (nullable, nonatomic, readwrite) NSError *error;
+
+- (instancetype)initWithBatchSize:(NSUInteger)batchSize
+          piggybackedRequestCount:(NSUInteger)piggybackedRequestCount
+  NS_DESIGNATED_INITIALIZER;
+
+/**
+ Copies the timings of the last transaction of `taskMetrics`, and the response bytes received over all of
+ its transactions when the system reports them, which it does from iOS 13.
+ */
+- (void)applyTaskMetrics:(NSURLSessionTaskMetrics *)taskMetrics;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import "FBSDKGraphRequestConnectionMetrics+Internal.h"
+
+static NSTimeInterval FBSDKDurationBetweenDates(NSDate *_Nullable start, NSDate *_Nullable end)
+{
+  if (!start || !end) {
+    return 0;
+  }
+  return MAX(0, [end timeIntervalSinceDate:start]);
+}
+
+@implementation FBSDKGraphRequestConnectionMetrics
+
+- (instancetype)initWithBatchSize:(NSUInteger)batchSize
+          piggybackedRequestCount:(NSUInteger)piggybackedRequestCount
+{
+  if ((self = [super init])) {
+    _batchSize = batchSize;
+    _piggybackedRequestCount = piggybackedRequestCount;
+  }
+  return self;
+}
+
+- (void)applyTaskMetrics:(NSURLSessionTaskMetrics *)taskMetrics
+{
+  NSURLSessionTaskTransactionMetrics *transaction = taskMetrics.transactionMetrics.lastObject;
+  if (!transaction) {
+    return;
+  }
+  self.domainLookupDuration = FBSDKDurationBetweenDates(transaction.domainLookupStartDate, transaction.domainLookupEndDate);
+  self.connectDuration = FBSDKDurationBetweenDates(transaction.connectStartDate, transaction.connectEndDate);
+  self.secureConnectionDuration = FBSDKDurationBetweenDates(transaction.secureConnectionStartDate, transaction.secureConnectionEndDate);
+  self.timeToFirstByte = FBSDKDurationBetweenDates(transaction.fetchStartDate, transaction.responseStartDate);
+  self.reusedConnection = transaction.isReusedConnection;
+
+  if (@available(iOS 13.0, tvOS 13.0, *)) {
+    int64_t received = 0;
+    for (NSURLSessionTaskTransactionMetrics *metrics in taskMetrics.transactionMetrics) {
+      received += metrics.countOfResponseBodyBytesReceived;
+    }
+    _encodedResponseBodyBytes = (unsigned long long)MAX(0, received);
+  }
+}
+
+- (NSString *)description
+{
+  return [NSString stringWithFormat:@"<%@: %p; batchSize: %lu; piggybacked: %lu; retries: %lu; status: %ld; "
+          @"dns: %.3f; connect: %.3f; tls: %.3f; ttfb: %.3f; total: %.3f; "
+          @"request bytes: %llu (%llu sent); response bytes: %llu (%llu received)>",
+          NSStringFromClass(self.class),
+          self,
+          (unsigned long)self.batchSize,
+          (unsigned long)self.piggybackedRequestCount,
+          (unsigned long)self.retryCount,
+          (long)self.statusCode,
+          self.domainLookupDuration,
+          self.connectDuration,
+          self.secureConnectionDuration,
+          self.timeToFirstByte,
+          self.totalDuration,
+          self.requestBodyBytes,
+          self.encodedRequestBodyBytes,
+          self.responseBodyBytes,
+          self.encodedResponseBodyBytes];
+}
+
+@end
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Returns a random number in [0, 1).
+typedef double (^FBSDKRandomNumberGenerator)(void)
+NS_SWIFT_NAME(RandomNumberGenerator);
+
+/// Runs `block` after `delay` seconds.
+typedef void (^FBSDKDelayedBlockPerformer)(NSTimeInterval delay, dispatch_block_t block)
+NS_SWIFT_NAME(DelayedBlockPerformer);
+
+/// The header carrying the key that lets the server discard the duplicates of a retried POST request.
+FOUNDATION_EXPORT NSString *const FBSDKIdempotencyKeyHeaderField
+NS_SWIFT_NAME(IdempotencyKeyHeaderField);
+
+/**
+ Decides whether and when a Graph request that failed transiently should be sent again.
+
+ Network errors that are likely to go away, `429` and `5xx` responses are retried with exponential
+ back off and full jitter, or after the delay asked for by a `Retry-After` header. Retries draw from a
+ shared budget that successful requests refill, so that an outage does not multiply the load by the
+ number of attempts.
+
+ This type is thread safe.
+ */
+NS_SWIFT_NAME(GraphRequestRetryPolicy)
+@interface FBSDKGraphRequestRetryPolicy : NSObject
+
+@property (class, nonatomic, readonly) FBSDKGraphRequestRetryPolicy *shared;
+
+/// The maximum number of times a request is sent, including the first attempt.
+@property (nonatomic, readonly) NSUInteger maxAttempts;
+@property (nonatomic, readonly) NSTimeInterval baseDelay;
+/// The longest a request waits before being retried. Requests asked to wait longer are not retried.
+@property (nonatomic, readonly) NSTimeInterval maxDelay;
+/// The number of retries currently allowed by the budget.
+@property (nonatomic, readonly) double availableRetryBudget;
+
+- (instancetype)init NS_UNAVAILABLE;
++ (instancetype)new NS_UNAVAILABLE;
+
+/**
+ @param retryBudget The number of retries allowed in a burst. Each successful request earns back a tenth of a retry.
+ @param randomNumberGenerator The source of jitter, or nil to use a random one.
+ @param delayedBlockPerformer Schedules the retries, or nil to use the global queue.
+ */
+- (instancetype)initWithMaxAttempts:(NSUInteger)maxAttempts
+                          baseDelay:(NSTimeInterval)baseDelay
+                           maxDelay:(NSTimeInterval)maxDelay
+                        retryBudget:(double)retryBudget
+              randomNumberGenerator:(nullable FBSDKRandomNumberGenerator)randomNumberGenerator
+              delayedBlockPerformer:(nullable FBSDKDelayedBlockPerformer)delayedBlockPerformer
+  NS_DESIGNATED_INITIALIZER;
+
+/**
+ The delay before sending a request again after the given failed attempt, or a negative value
+ if the request should not be retried. A non negative result consumes one retry from the budget.
+ @param attempt The number of attempts made so far, starting at 1.
+ */
+- (NSTimeInterval)delayBeforeRetryingAttempt:(NSUInteger)attempt
+                                    response:(nullable NSURLResponse *)response
+                                       error:(nullable NSError *)error;
+
+/// Records a request answered without a transient failure, refilling the budget.
+- (void)recordSuccess;
+
+/// Runs `block` after `delay` seconds.
+- (void)performAfterDelay:(NSTimeInterval)delay block:(dispatch_block_t)block;
+
+/// Whether the error or the response indicates a failure that may go away by itself.
++ (BOOL)isTransientFailureWithResponse:(nullable NSURLResponse *)response
+                                 error:(nullable NSError *)error;
+
+/// Whether the error means that the device is offline or cannot reach the network, rather than that the server failed.
++ (BOOL)isConnectivityFailureWithError:(nullable NSError *)error;
+
+/// The delay asked for by the `Retry-After` header of the response, or a negative value.
++ (NSTimeInterval)retryAfterDelayForResponse:(nullable NSURLResponse *)response date:(NSDate *)date;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import "FBSDKGraphRequestRetryPolicy.h"
+
+#import <FBSDKCoreKit_Basics/FBSDKCoreKit_Basics.h>
+
+NSString *const FBSDKIdempotencyKeyHeaderField = @"Idempotency-Key";
+
+static const NSUInteger FBSDKGraphRequestRetryPolicyMaxAttempts = 3;
+static const NSTimeInterval FBSDKGraphRequestRetryPolicyBaseDelay = 1;
+static const NSTimeInterval FBSDKGraphRequestRetryPolicyMaxDelay = 60;
+static const double FBSDKGraphRequestRetryPolicyRetryBudget = 10;
+// The part of a retry earned back by each successful request.
+static const double FBSDKGraphRequestRetryPolicyBudgetRefill = 0.1;
+
+@interface FBSDKGraphRequestRetryPolicy ()
+
+@property (nonatomic, readonly) double maxRetryBudget;
+@property (nonatomic, readonly, copy) FBSDKRandomNumberGenerator randomNumberGenerator;
+@property (nonatomic, readonly, copy) FBSDKDelayedBlockPerformer delayedBlockPerformer;
+
+@end
+
+@implementation FBSDKGraphRequestRetryPolicy
+{
+  double _availableRetryBudget;
+}
+
++ (FBSDKGraphRequestRetryPolicy *)shared
+{
+  static dispatch_once_t onceToken;
+  static FBSDKGraphRequestRetryPolicy *shared;
+  dispatch_once(&onceToken, ^{
+    shared = [[self alloc] initWithMaxAttempts:FBSDKGraphRequestRetryPolicyMaxAttempts
+                                     baseDelay:FBSDKGraphRequestRetryPolicyBaseDelay
+                                      maxDelay:FBSDKGraphRequestRetryPolicyMaxDelay
+                                   retryBudget:FBSDKGraphRequestRetryPolicyRetryBudget
+                         randomNumberGenerator:nil
+                         delayedBlockPerformer:nil];
+  });
+  return shared;
+}
+
+- (instancetype)initWithMaxAttempts:(NSUInteger)maxAttempts
+                          baseDelay:(NSTimeInterval)baseDelay
+                           maxDelay:(NSTimeInterval)maxDelay
+                        retryBudget:(double)retryBudget
+              randomNumberGenerator:(nullable FBSDKRandomNumberGenerator)randomNumberGenerator
+              delayedBlockPerformer:(nullable FBSDKDelayedBlockPerformer)delayedBlockPerformer
+{
+  if ((self = [super init])) {
+    _maxAttempts = MAX(1, maxAttempts);
+    _baseDelay = MAX(0, baseDelay);
+    _maxDelay = MAX(_baseDelay, maxDelay);
+    _maxRetryBudget = MAX(0, retryBudget);
+    _availableRetryBudget = _maxRetryBudget;
+    _randomNumberGenerator = [randomNumberGenerator copy] ?: ^double {
+      return (double)arc4random() / ((double)UINT32_MAX + 1);
+    };
+    _delayedBlockPerformer = [delayedBlockPerformer copy] ?: ^(NSTimeInterval delay, dispatch_block_t block) {
+      dispatch_after(
+        dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)),
+        dispatch_get_global_queue(QOS_CLASS_UTILITY, 0),
+        block
+      );
+    };
+  }
+  return self;
+}
+
+- (double)availableRetryBudget
+{
+  @synchronized(self) {
+    return _availableRetryBudget;
+  }
+}
+
+- (NSTimeInterval)delayBeforeRetryingAttempt:(NSUInteger)attempt
+                                    response:(nullable NSURLResponse *)response
+                                       error:(nullable NSError *)error
+{
+  if (attempt >= self.maxAttempts || ![self.class isTransientFailureWithResponse:response error:error]) {
+    return -1;
+  }
+
+  // Full jitter: a random delay up to the exponential back off, so that clients failing together spread out.
+  NSTimeInterval backoff = MIN(self.maxDelay, self.baseDelay * pow(2, attempt - 1));
+  NSTimeInterval delay = backoff * MIN(MAX(self.randomNumberGenerator(), 0), 1);
+  NSTimeInterval retryAfter = [self.class retryAfterDelayForResponse:response date:[NSDate date]];
+  if (retryAfter > self.maxDelay) {
+    return -1;
+  }
+  delay = MAX(delay, retryAfter);
+
+  @synchronized(self) {
+    if (_availableRetryBudget < 1) {
+      return -1;
+    }
+    _availableRetryBudget -= 1;
+  }
+  return delay;
+}
+
+- (void)recordSuccess
+{
+  @synchronized(self) {
+    _availableRetryBudget = MIN(self.maxRetryBudget, _availableRetryBudget + FBSDKGraphRequestRetryPolicyBudgetRefill);
+  }
+}
+
+- (void)performAfterDelay:(NSTimeInterval)delay block:(dispatch_block_t)block
+{
+  if (block) {
+    self.delayedBlockPerformer(MAX(0, delay), block);
+  }
+}
+
++ (BOOL)isTransientFailureWithResponse:(nullable NSURLResponse *)response
+                                 error:(nullable NSError *)error
+{
+  if (error) {
+    if (![error.domain isEqualToString:NSURLErrorDomain]) {
+      return NO;
+    }
+    switch (error.code) {
+      case NSURLErrorTimedOut:
+      case NSURLErrorCannotFindHost:
+      case NSURLErrorCannotConnectToHost:
+      case NSURLErrorNetworkConnectionLost:
+      case NSURLErrorDNSLookupFailed:
+      case NSURLErrorNotConnectedToInternet:
+        return YES;
+      default:
+        return NO;
+    }
+  }
+  if (![response isKindOfClass:NSHTTPURLResponse.class]) {
+    return NO;
+  }
+  NSInteger statusCode = ((NSHTTPURLResponse *)response).statusCode;
+  return statusCode == 429 || statusCode == 500 || statusCode == 502 || statusCode == 503 || statusCode == 504;
+}
+
++ (BOOL)isConnectivityFailureWithError:(nullable NSError *)error
+{
+  if (![error.domain isEqualToString:NSURLErrorDomain]) {
+    return NO;
+  }
+  switch (error.code) {
+    case NSURLErrorTimedOut:
+    case NSURLErrorCannotFindHost:
+    case NSURLErrorDNSLookupFailed:
+    case NSURLErrorNotConnectedToInternet:
+      return YES;
+    default:
+      return NO;
+  }
+}
+
++ (NSTimeInterval)retryAfterDelayForResponse:(nullable NSURLResponse *)response date:(NSDate *)date
+{
+  if (![response isKindOfClass:NSHTTPURLResponse.class]) {
+    return -1;
+  }
+  NSString *retryAfter = [FBSDKTypeUtility coercedToStringValue:((NSHTTPURLResponse *)response).allHeaderFields[@"Retry-After"]];
+  retryAfter = [retryAfter stringByTrimmingCharactersInSet:NSCharacterSet.whitespaceCharacterSet];
+  if (retryAfter.length == 0) {
+    return -1;
+  }
+  NSScanner *scanner = [NSScanner scannerWithString:retryAfter];
+  NSInteger seconds = 0;
+  if ([scanner scanInteger:&seconds] && scanner.isAtEnd) {
+    return seconds >= 0 ? seconds : -1;
+  }
+
+  static NSDateFormatter *formatter;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    formatter = [NSDateFormatter new];
+    formatter.locale = [NSLocale localeWithLocaleIdentifier:@"en_US_POSIX"];
+    formatter.timeZone = [NSTimeZone timeZoneForSecondsFromGMT:0];
+    formatter.dateFormat = @"EEE, dd MMM yyyy HH:mm:ss zzz";
+  });
+  NSDate *retryDate = nil;
+  @synchronized(formatter) {
+    retryDate = [formatter dateFromString:retryAfter];
+  }
+  if (!retryDate) {
+    return -1;
+  }
+  return MAX(0, [retryDate timeIntervalSinceDate:date]);
+}
+
+@end
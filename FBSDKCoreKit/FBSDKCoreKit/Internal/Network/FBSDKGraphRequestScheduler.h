@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// The classes of Graph requests, from the most to the least urgent.
+typedef NS_ENUM(NSUInteger, FBSDKGraphRequestPriority) {
+  /// Requests the user may be waiting for, such as login, sharing or profile requests.
+  FBSDKGraphRequestPriorityDefault = 0,
+  /// Telemetry and other requests nobody is waiting for.
+  FBSDKGraphRequestPriorityBackground,
+} NS_SWIFT_NAME(GraphRequestPriority);
+
+/// A snapshot of how long the requests of a priority class waited before being sent.
+NS_SWIFT_NAME(GraphRequestQueueMetrics)
+@interface FBSDKGraphRequestQueueMetrics : NSObject
+
+/// The number of requests sent since the metrics were last reset.
+@property (nonatomic, readonly) NSUInteger startedCount;
+/// The number of those requests that had to wait for a slot.
+@property (nonatomic, readonly) NSUInteger deferredCount;
+@property (nonatomic, readonly) NSTimeInterval totalQueueingDelay;
+@property (nonatomic, readonly) NSTimeInterval maxQueueingDelay;
+@property (nonatomic, readonly) NSTimeInterval averageQueueingDelay;
+/// The number of requests currently waiting.
+@property (nonatomic, readonly) NSUInteger pendingCount;
+/// The number of requests currently sent and not answered yet.
+@property (nonatomic, readonly) NSUInteger inFlightCount;
+
+- (instancetype)init NS_UNAVAILABLE;
++ (instancetype)new NS_UNAVAILABLE;
+
+@end
+
+/// Called by a scheduled task once its request is answered, to free its slot.
+typedef void (^FBSDKGraphRequestSchedulerCompletion)(void)
+NS_SWIFT_NAME(GraphRequestSchedulerCompletion);
+
+typedef void (^FBSDKGraphRequestSchedulerTask)(FBSDKGraphRequestSchedulerCompletion finish)
+NS_SWIFT_NAME(GraphRequestSchedulerTask);
+
+/**
+ Decides when Graph request connections send their requests.
+
+ Each priority class has its own limit of requests in flight. Requests over the limit wait in
+ first in, first out order. Background requests also wait while default requests are waiting or in flight,
+ unless they have already waited for `maxDeferral`, so that telemetry does not compete with the requests
+ the user is waiting for, without being starved.
+
+ Tasks that can start right away run synchronously on the calling thread. This type is thread safe.
+ */
+NS_SWIFT_NAME(GraphRequestScheduler)
+@interface FBSDKGraphRequestScheduler : NSObject
+
+@property (class, nonatomic, readonly) FBSDKGraphRequestScheduler *shared;
+
+@property (nonatomic, readonly) NSUInteger maxConcurrentRequests;
+@property (nonatomic, readonly) NSUInteger maxConcurrentBackgroundRequests;
+/// The longest a background request is held back because of default requests.
+@property (nonatomic, readonly) NSTimeInterval maxDeferral;
+
+- (instancetype)init NS_UNAVAILABLE;
++ (instancetype)new NS_UNAVAILABLE;
+
+- (instancetype)initWithMaxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+              maxConcurrentBackgroundRequests:(NSUInteger)maxConcurrentBackgroundRequests
+                                  maxDeferral:(NSTimeInterval)maxDeferral
+  NS_DESIGNATED_INITIALIZER;
+
+/**
+ Runs the task once a slot of its priority class is available.
+ The task must call `finish` exactly once; later calls are ignored.
+ */
+- (void)scheduleTaskWithPriority:(FBSDKGraphRequestPriority)priority
+                            task:(FBSDKGraphRequestSchedulerTask)task;
+
+- (FBSDKGraphRequestQueueMetrics *)metricsForPriority:(FBSDKGraphRequestPriority)priority;
+
+/// Clears the queueing delays recorded so far.
+- (void)resetMetrics;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import "FBSDKGraphRequestScheduler.h"
+
+#import <FBSDKCoreKit_Basics/FBSDKCoreKit_Basics.h>
+
+static const NSUInteger FBSDKGraphRequestPriorityCount = 2;
+// Matches the connections per host of the shared URL session.
+static const NSUInteger FBSDKGraphRequestSchedulerMaxConcurrentRequests = 6;
+static const NSUInteger FBSDKGraphRequestSchedulerMaxConcurrentBackgroundRequests = 2;
+static const NSTimeInterval FBSDKGraphRequestSchedulerMaxDeferral = 10;
+
+@interface FBSDKGraphRequestQueueMetrics ()
+
+- (instancetype)initWithStartedCount:(NSUInteger)startedCount
+                       deferredCount:(NSUInteger)deferredCount
+                  totalQueueingDelay:(NSTimeInterval)totalQueueingDelay
+                    maxQueueingDelay:(NSTimeInterval)maxQueueingDelay
+                        pendingCount:(NSUInteger)pendingCount
+                       inFlightCount:(NSUInteger)inFlightCount;
+
+@end
+
+@implementation FBSDKGraphRequestQueueMetrics
+
+- (instancetype)initWithStartedCount:(NSUInteger)startedCount
+                       deferredCount:(NSUInteger)deferredCount
+                  totalQueueingDelay:(NSTimeInterval)totalQueueingDelay
+                    maxQueueingDelay:(NSTimeInterval)maxQueueingDelay
+                        pendingCount:(NSUInteger)pendingCount
+                       inFlightCount:(NSUInteger)inFlightCount
+{
+  if ((self = [super init])) {
+    _startedCount = startedCount;
+    _deferredCount = deferredCount;
+    _totalQueueingDelay = totalQueueingDelay;
+    _maxQueueingDelay = maxQueueingDelay;
+    _pendingCount = pendingCount;
+    _inFlightCount = inFlightCount;
+  }
+  return self;
+}
+
+- (NSTimeInterval)averageQueueingDelay
+{
+  return _startedCount > 0 ? _totalQueueingDelay / _startedCount : 0;
+}
+
+@end
+
+@interface FBSDKGraphRequestSchedulerEntry : NSObject
+
+@property (nonatomic, readonly, copy) FBSDKGraphRequestSchedulerTask task;
+@property (nonatomic, readonly) CFAbsoluteTime enqueueTime;
+
+@end
+
+@implementation FBSDKGraphRequestSchedulerEntry
+
+- (instancetype)initWithTask:(FBSDKGraphRequestSchedulerTask)task enqueueTime:(CFAbsoluteTime)enqueueTime
+{
+  if ((self = [super init])) {
+    _task = [task copy];
+    _enqueueTime = enqueueTime;
+  }
+  return self;
+}
+
+@end
+
+@implementation FBSDKGraphRequestScheduler
+{
+  NSMutableArray<FBSDKGraphRequestSchedulerEntry *> *_pendingEntries[FBSDKGraphRequestPriorityCount];
+  NSUInteger _inFlightCounts[FBSDKGraphRequestPriorityCount];
+  NSUInteger _startedCounts[FBSDKGraphRequestPriorityCount];
+  NSUInteger _deferredCounts[FBSDKGraphRequestPriorityCount];
+  NSTimeInterval _totalQueueingDelays[FBSDKGraphRequestPriorityCount];
+  NSTimeInterval _maxQueueingDelays[FBSDKGraphRequestPriorityCount];
+  BOOL _isDeferralCheckScheduled;
+}
+
++ (FBSDKGraphRequestScheduler *)shared
+{
+  static dispatch_once_t onceToken;
+  static FBSDKGraphRequestScheduler *shared;
+  dispatch_once(&onceToken, ^{
+    shared = [[self alloc] initWithMaxConcurrentRequests:FBSDKGraphRequestSchedulerMaxConcurrentRequests
+                         maxConcurrentBackgroundRequests:FBSDKGraphRequestSchedulerMaxConcurrentBackgroundRequests
+                                             maxDeferral:FBSDKGraphRequestSchedulerMaxDeferral];
+  });
+  return shared;
+}
+
+- (instancetype)initWithMaxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+              maxConcurrentBackgroundRequests:(NSUInteger)maxConcurrentBackgroundRequests
+                                  maxDeferral:(NSTimeInterval)maxDeferral
+{
+  if ((self = [super init])) {
+    _maxConcurrentRequests = MAX(1, maxConcurrentRequests);
+    _maxConcurrentBackgroundRequests = MAX(1, maxConcurrentBackgroundRequests);
+    _maxDeferral = MAX(0, maxDeferral);
+    for (NSUInteger priority = 0; priority < FBSDKGraphRequestPriorityCount; priority++) {
+      _pendingEntries[priority] = [NSMutableArray new];
+    }
+  }
+  return self;
+}
+
+- (void)scheduleTaskWithPriority:(FBSDKGraphRequestPriority)priority
+                            task:(FBSDKGraphRequestSchedulerTask)task
+{
+  if (!task) {
+    return;
+  }
+  priority = MIN(priority, FBSDKGraphRequestPriorityCount - 1);
+  FBSDKGraphRequestSchedulerEntry *entry = [[FBSDKGraphRequestSchedulerEntry alloc] initWithTask:task
+                                                                                     enqueueTime:CFAbsoluteTimeGetCurrent()];
+  BOOL canStart = NO;
+  @synchronized(self) {
+    canStart = _pendingEntries[priority].count == 0 && [self canStartEntry:entry priority:priority now:entry.enqueueTime];
+    if (canStart) {
+      [self recordStartWithPriority:priority delay:0 deferred:NO];
+    } else {
+      [FBSDKTypeUtility array:_pendingEntries[priority] addObject:entry];
+    }
+  }
+  if (canStart) {
+    task([self completionForPriority:priority]);
+  } else {
+    [self runStartableTasks];
+  }
+}
+
+- (FBSDKGraphRequestQueueMetrics *)metricsForPriority:(FBSDKGraphRequestPriority)priority
+{
+  priority = MIN(priority, FBSDKGraphRequestPriorityCount - 1);
+  @synchronized(self) {
+    return [[FBSDKGraphRequestQueueMetrics alloc] initWithStartedCount:_startedCounts[priority]
+                                                         deferredCount:_deferredCounts[priority]
+                                                    totalQueueingDelay:_totalQueueingDelays[priority]
+                                                      maxQueueingDelay:_maxQueueingDelays[priority]
+                                                          pendingCount:_pendingEntries[priority].count
+                                                         inFlightCount:_inFlightCounts[priority]];
+  }
+}
+
+- (void)resetMetrics
+{
+  @synchronized(self) {
+    for (NSUInteger priority = 0; priority < FBSDKGraphRequestPriorityCount; priority++) {
+      _startedCounts[priority] = 0;
+      _deferredCounts[priority] = 0;
+      _totalQueueingDelays[priority] = 0;
+      _maxQueueingDelays[priority] = 0;
+    }
+  }
+}
+
+#pragma mark - Private
+
+- (void)runStartableTasks
+{
+  NSMutableArray<FBSDKGraphRequestSchedulerEntry *> *startableEntries = [NSMutableArray array];
+  NSMutableArray<NSNumber *> *priorities = [NSMutableArray array];
+  NSTimeInterval deferralCheckDelay = -1;
+  CFAbsoluteTime now = CFAbsoluteTimeGetCurrent();
+
+  @synchronized(self) {
+    for (NSUInteger priority = 0; priority < FBSDKGraphRequestPriorityCount; priority++) {
+      NSMutableArray<FBSDKGraphRequestSchedulerEntry *> *entries = _pendingEntries[priority];
+      while (entries.count > 0 && [self canStartEntry:entries.firstObject priority:priority now:now]) {
+        FBSDKGraphRequestSchedulerEntry *entry = entries.firstObject;
+        [entries removeObjectAtIndex:0];
+        [self recordStartWithPriority:priority delay:MAX(0, now - entry.enqueueTime) deferred:YES];
+        [startableEntries addObject:entry];
+        [priorities addObject:@(priority)];
+      }
+    }
+
+    // Background requests held back by default requests are let through once they waited long enough.
+    FBSDKGraphRequestSchedulerEntry *deferredEntry = _pendingEntries[FBSDKGraphRequestPriorityBackground].firstObject;
+    if (deferredEntry
+        && !_isDeferralCheckScheduled
+        && _inFlightCounts[FBSDKGraphRequestPriorityBackground] < self.maxConcurrentBackgroundRequests) {
+      _isDeferralCheckScheduled = YES;
+      deferralCheckDelay = MAX(0, self.maxDeferral - (now - deferredEntry.enqueueTime));
+    }
+  }
+
+  if (deferralCheckDelay >= 0) {
+    __weak typeof(self) weakSelf = self;
+    dispatch_after(
+      dispatch_time(DISPATCH_TIME_NOW, (int64_t)(deferralCheckDelay * NSEC_PER_SEC)),
+      dispatch_get_global_queue(QOS_CLASS_UTILITY, 0),
+      ^{
+        typeof(self) strongSelf = weakSelf;
+        if (!strongSelf) {
+          return;
+        }
+        @synchronized(strongSelf) {
+          strongSelf->_isDeferralCheckScheduled = NO;
+        }
+        [strongSelf runStartableTasks];
+      }
+    );
+  }
+
+  [startableEntries enumerateObjectsUsingBlock:^(FBSDKGraphRequestSchedulerEntry *entry, NSUInteger index, BOOL *stop) {
+    entry.task([self completionForPriority:priorities[index].unsignedIntegerValue]);
+  }];
+}
+
+- (BOOL)canStartEntry:(FBSDKGraphRequestSchedulerEntry *)entry
+             priority:(NSUInteger)priority
+                  now:(CFAbsoluteTime)now
+{
+  if (priority == FBSDKGraphRequestPriorityDefault) {
+    return _inFlightCounts[priority] < self.maxConcurrentRequests;
+  }
+  if (_inFlightCounts[priority] >= self.maxConcurrentBackgroundRequests) {
+    return NO;
+  }
+  BOOL isDefaultPriorityBusy = _inFlightCounts[FBSDKGraphRequestPriorityDefault] > 0
+  || _pendingEntries[FBSDKGraphRequestPriorityDefault].count > 0;
+  return !isDefaultPriorityBusy || now - entry.enqueueTime >= self.maxDeferral;
+}
+
+- (void)recordStartWithPriority:(NSUInteger)priority delay:(NSTimeInterval)delay deferred:(BOOL)deferred
+{
+  _inFlightCounts[priority]++;
+  _startedCounts[priority]++;
+  _totalQueueingDelays[priority] += delay;
+  _maxQueueingDelays[priority] = MAX(_maxQueueingDelays[priority], delay);
+  if (deferred) {
+    _deferredCounts[priority]++;
+  }
+}
+
+- (FBSDKGraphRequestSchedulerCompletion)completionForPriority:(NSUInteger)priority
+{
+  __block BOOL didFinish = NO;
+  return ^{
+    @synchronized(self) {
+      if (didFinish) {
+        return;
+      }
+      didFinish = YES;
+      if (self->_inFlightCounts[priority] > 0) {
+        self->_inFlightCounts[priority]--;
+      }
+    }
+    [self runStartableTasks];
+  };
+}
+
+@end
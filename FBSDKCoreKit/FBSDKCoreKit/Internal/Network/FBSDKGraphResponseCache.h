@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import <Foundation/Foundation.h>
+
+@protocol FBSDKNotificationObserving;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// A cached Graph API response.
+NS_SWIFT_NAME(GraphResponseCacheEntry)
+@interface FBSDKGraphResponseCacheEntry : NSObject
+
+/// The validator to send back in `If-None-Match`, if the server provided one.
+@property (nullable, nonatomic, readonly, copy) NSString *ETag;
+
+/// The date until which the response can be used without asking the server.
+@property (nonatomic, readonly) NSDate *expirationDate;
+
+/// The raw response body.
+@property (nonatomic, readonly) NSData *data;
+
+/// The parsed response body. The body is parsed at most once per entry.
+@property (nullable, nonatomic, readonly) id object;
+
+- (instancetype)init NS_UNAVAILABLE;
++ (instancetype)new NS_UNAVAILABLE;
+
+- (instancetype)initWithETag:(nullable NSString *)ETag
+              expirationDate:(NSDate *)expirationDate
+                        data:(NSData *)data
+                      object:(nullable id)object
+  NS_DESIGNATED_INITIALIZER;
+
+- (BOOL)isFreshAtDate:(NSDate *)date;
+
+@end
+
+/**
+ A small persistent cache for the responses of idempotent Graph API GET requests.
+
+ Entries honour the `ETag` and `Cache-Control` headers of the response: responses with a `max-age`
+ are reused without a request until they expire, and responses with an `ETag` are revalidated with
+ `If-None-Match` so that a `304 Not Modified` reuses the body parsed earlier. Responses marked `no-store`
+ are not kept.
+
+ Keys are hashes of the request URL so that tokens in the URL are not written to disk.
+ At most `countLimit` entries are kept in memory, the least recently used are evicted first.
+ Lookups that find nothing are remembered too, so that a request without a cached response
+ reads the disk once. This type is thread safe.
+ */
+NS_SWIFT_NAME(GraphResponseCache)
+@interface FBSDKGraphResponseCache : NSObject
+
+/// The cache shared by Graph request connections, persisted in the caches directory.
+/// It is emptied whenever the access token changes.
+@property (class, nonatomic, readonly) FBSDKGraphResponseCache *shared;
+
+/// The maximum number of entries and remembered misses kept in memory.
+@property (nonatomic, readonly) NSUInteger countLimit;
+
+/// The number of entries and remembered misses currently kept in memory.
+@property (nonatomic, readonly) NSUInteger entryCount;
+
+- (instancetype)init NS_UNAVAILABLE;
++ (instancetype)new NS_UNAVAILABLE;
+
+/**
+ Creates a cache with the default count limit.
+ @param directoryURL The directory the entries are persisted in, or nil to only keep them in memory.
+ */
+- (instancetype)initWithDirectoryURL:(nullable NSURL *)directoryURL;
+
+/**
+ Creates a cache.
+ @param directoryURL The directory the entries are persisted in, or nil to only keep them in memory.
+ @param countLimit The maximum number of entries kept in memory.
+ @param notificationCenter Used to empty the cache when the access token changes.
+ */
+- (instancetype)initWithDirectoryURL:(nullable NSURL *)directoryURL
+                          countLimit:(NSUInteger)countLimit
+                  notificationCenter:(nullable id<FBSDKNotificationObserving>)notificationCenter
+  NS_DESIGNATED_INITIALIZER;
+
+/// The key for the responses of a URL.
++ (nullable NSString *)keyForURL:(nullable NSURL *)URL;
+
+- (nullable FBSDKGraphResponseCacheEntry *)entryForKey:(NSString *)key;
+
+/**
+ Stores a response if its headers allow it.
+ @param object The parsed body, kept so that later revalidations do not parse it again.
+ @return The stored entry, or nil if the response cannot be cached.
+ */
+- (nullable FBSDKGraphResponseCacheEntry *)storeResponse:(NSHTTPURLResponse *)response
+                                                    data:(NSData *)data
+                                                  object:(nullable id)object
+                                                  forKey:(NSString *)key
+                                                    date:(NSDate *)date;
+
+/**
+ Extends the life of an entry after the server answered `304 Not Modified`.
+ @return The refreshed entry, or nil if the response does not allow caching anymore.
+ */
+- (nullable FBSDKGraphResponseCacheEntry *)refreshEntry:(FBSDKGraphResponseCacheEntry *)entry
+                                           withResponse:(NSHTTPURLResponse *)response
+                                                 forKey:(NSString *)key
+                                                   date:(NSDate *)date;
+
+- (void)removeEntryForKey:(NSString *)key;
+
+- (void)removeAllEntries;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,317 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import "FBSDKGraphResponseCache.h"
+
+#import <FBSDKCoreKit_Basics/FBSDKCoreKit_Basics.h>
+
+#import "FBSDKAccessToken.h"
+#import "FBSDKGraphResponseParser.h"
+#import "NSNotificationCenter+Extensions.h"
+
+static NSString *const FBSDKGraphResponseCacheDirectoryName = @"com.facebook.sdk.GraphResponseCache";
+static const NSUInteger FBSDKGraphResponseCacheDefaultCountLimit = 100;
+static const char *const FBSDKGraphResponseCacheQueueLabel = "com.facebook.sdk.GraphResponseCache";
+static NSString *const FBSDKGraphResponseCacheETagKey = @"etag";
+static NSString *const FBSDKGraphResponseCacheExpirationDateKey = @"expiration_date";
+static NSString *const FBSDKGraphResponseCacheDataKey = @"data";
+
+static NSString *_Nullable FBSDKGraphResponseCacheHeaderValue(NSHTTPURLResponse *response, NSString *name)
+{
+  // Header names are case insensitive.
+  for (id key in response.allHeaderFields) {
+    if ([key isKindOfClass:NSString.class] && [(NSString *)key caseInsensitiveCompare:name] == NSOrderedSame) {
+      return [FBSDKTypeUtility stringValueOrNil:response.allHeaderFields[key]];
+    }
+  }
+  return nil;
+}
+
+// Returns NO when the response must not be stored, otherwise sets how long it can be used without revalidation.
+static BOOL FBSDKGraphResponseCacheMaxAge(NSHTTPURLResponse *response, NSTimeInterval *maxAge)
+{
+  *maxAge = 0;
+  BOOL mustRevalidate = NO;
+  NSString *cacheControl = FBSDKGraphResponseCacheHeaderValue(response, @"Cache-Control");
+  for (NSString *component in [cacheControl componentsSeparatedByString:@","]) {
+    NSString *directive = [component stringByTrimmingCharactersInSet:NSCharacterSet.whitespaceCharacterSet].lowercaseString;
+    if ([directive isEqualToString:@"no-store"]) {
+      return NO;
+    } else if ([directive isEqualToString:@"no-cache"]) {
+      mustRevalidate = YES;
+    } else if ([directive hasPrefix:@"max-age="]) {
+      *maxAge = MAX(0, [directive substringFromIndex:@"max-age=".length].doubleValue);
+    }
+  }
+  if (mustRevalidate) {
+    *maxAge = 0;
+  }
+  return YES;
+}
+
+@implementation FBSDKGraphResponseCacheEntry
+{
+  id _object;
+}
+
+- (instancetype)initWithETag:(nullable NSString *)ETag
+              expirationDate:(NSDate *)expirationDate
+                        data:(NSData *)data
+                      object:(nullable id)object
+{
+  if ((self = [super init])) {
+    _ETag = [ETag copy];
+    _expirationDate = expirationDate;
+    _data = data;
+    _object = object;
+  }
+  return self;
+}
+
+- (nullable id)object
+{
+  @synchronized(self) {
+    if (!_object) {
+      _object = [FBSDKGraphResponseParser objectWithData:_data];
+    }
+    return _object;
+  }
+}
+
+- (BOOL)isFreshAtDate:(NSDate *)date
+{
+  return [self.expirationDate compare:date] == NSOrderedDescending;
+}
+
+@end
+
+@interface FBSDKGraphResponseCache ()
+
+@property (nullable, nonatomic, readonly) NSURL *directoryURL;
+// Holds NSNull for the keys known to have no entry.
+@property (nonatomic, readonly) NSMutableDictionary<NSString *, id> *entries;
+// The keys of `entries`, from the least to the most recently used.
+@property (nonatomic, readonly) NSMutableOrderedSet<NSString *> *recentKeys;
+@property (nonatomic, readonly) dispatch_queue_t queue;
+
+@end
+
+@implementation FBSDKGraphResponseCache
+
++ (FBSDKGraphResponseCache *)shared
+{
+  static FBSDKGraphResponseCache *shared;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    NSURL *cachesURL = [NSFileManager.defaultManager URLsForDirectory:NSCachesDirectory inDomains:NSUserDomainMask].firstObject;
+    shared = [[self alloc] initWithDirectoryURL:[cachesURL URLByAppendingPathComponent:FBSDKGraphResponseCacheDirectoryName]
+                                     countLimit:FBSDKGraphResponseCacheDefaultCountLimit
+                             notificationCenter:NSNotificationCenter.defaultCenter];
+  });
+  return shared;
+}
+
+- (instancetype)initWithDirectoryURL:(nullable NSURL *)directoryURL
+{
+  return [self initWithDirectoryURL:directoryURL
+                         countLimit:FBSDKGraphResponseCacheDefaultCountLimit
+                 notificationCenter:nil];
+}
+
+- (instancetype)initWithDirectoryURL:(nullable NSURL *)directoryURL
+                          countLimit:(NSUInteger)countLimit
+                  notificationCenter:(nullable id<FBSDKNotificationObserving>)notificationCenter
+{
+  if ((self = [super init])) {
+    _directoryURL = [directoryURL copy];
+    _countLimit = countLimit;
+    _entries = [NSMutableDictionary new];
+    _recentKeys = [NSMutableOrderedSet new];
+    _queue = dispatch_queue_create(FBSDKGraphResponseCacheQueueLabel, DISPATCH_QUEUE_SERIAL);
+    // Responses belong to the user they were fetched for.
+    [notificationCenter addObserver:self
+                           selector:@selector(_accessTokenDidChange:)
+                               name:FBSDKAccessTokenDidChangeNotification
+                             object:nil];
+  }
+  return self;
+}
+
++ (nullable NSString *)keyForURL:(nullable NSURL *)URL
+{
+  return URL.absoluteString.length ? [FBSDKBasicUtility SHA256Hash:URL.absoluteString] : nil;
+}
+
+- (nullable FBSDKGraphResponseCacheEntry *)entryForKey:(NSString *)key
+{
+  @synchronized(self) {
+    id entry = self.entries[key];
+    if (!entry) {
+      entry = [self _loadEntryForKey:key] ?: NSNull.null;
+    }
+    [self _keepEntry:entry forKey:key];
+    return [entry isKindOfClass:FBSDKGraphResponseCacheEntry.class] ? entry : nil;
+  }
+}
+
+- (nullable FBSDKGraphResponseCacheEntry *)storeResponse:(NSHTTPURLResponse *)response
+                                                    data:(NSData *)data
+                                                  object:(nullable id)object
+                                                  forKey:(NSString *)key
+                                                    date:(NSDate *)date
+{
+  NSTimeInterval maxAge = 0;
+  NSString *ETag = FBSDKGraphResponseCacheHeaderValue(response, @"ETag");
+  if (!FBSDKGraphResponseCacheMaxAge(response, &maxAge) || (!ETag && maxAge <= 0)) {
+    [self removeEntryForKey:key];
+    return nil;
+  }
+  FBSDKGraphResponseCacheEntry *entry = [[FBSDKGraphResponseCacheEntry alloc] initWithETag:ETag
+                                                                            expirationDate:[date dateByAddingTimeInterval:maxAge]
+                                                                                      data:data
+                                                                                    object:object];
+  [self _setEntry:entry forKey:key];
+  return entry;
+}
+
+- (nullable FBSDKGraphResponseCacheEntry *)refreshEntry:(FBSDKGraphResponseCacheEntry *)entry
+                                           withResponse:(NSHTTPURLResponse *)response
+                                                 forKey:(NSString *)key
+                                                   date:(NSDate *)date
+{
+  NSTimeInterval maxAge = 0;
+  if (!FBSDKGraphResponseCacheMaxAge(response, &maxAge)) {
+    [self removeEntryForKey:key];
+    return nil;
+  }
+  // A 304 may carry a new validator; otherwise keep the one that matched.
+  NSString *ETag = FBSDKGraphResponseCacheHeaderValue(response, @"ETag") ?: entry.ETag;
+  FBSDKGraphResponseCacheEntry *refreshed = [[FBSDKGraphResponseCacheEntry alloc] initWithETag:ETag
+                                                                                expirationDate:[date dateByAddingTimeInterval:maxAge]
+                                                                                          data:entry.data
+                                                                                        object:entry.object];
+  [self _setEntry:refreshed forKey:key];
+  return refreshed;
+}
+
+- (void)removeEntryForKey:(NSString *)key
+{
+  @synchronized(self) {
+    [self _keepEntry:NSNull.null forKey:key];
+  }
+  NSURL *fileURL = [self _fileURLForKey:key];
+  if (fileURL) {
+    dispatch_async(self.queue, ^{
+      [NSFileManager.defaultManager removeItemAtURL:fileURL error:NULL];
+    });
+  }
+}
+
+- (void)removeAllEntries
+{
+  @synchronized(self) {
+    [self.entries removeAllObjects];
+    [self.recentKeys removeAllObjects];
+  }
+  NSURL *directoryURL = self.directoryURL;
+  if (directoryURL) {
+    dispatch_async(self.queue, ^{
+      [NSFileManager.defaultManager removeItemAtURL:directoryURL error:NULL];
+    });
+  }
+}
+
+- (NSUInteger)entryCount
+{
+  @synchronized(self) {
+    return self.entries.count;
+  }
+}
+
+- (void)_accessTokenDidChange:(NSNotification *)notification
+{
+  [self removeAllEntries];
+}
+
+// Must be called while synchronized on self.
+- (void)_keepEntry:(id)entry forKey:(NSString *)key
+{
+  [FBSDKTypeUtility dictionary:self.entries setObject:entry forKey:key];
+  [self.recentKeys removeObject:key];
+  [self.recentKeys addObject:key];
+  while (self.recentKeys.count > self.countLimit) {
+    NSString *leastRecentKey = self.recentKeys.firstObject;
+    [self.entries removeObjectForKey:leastRecentKey];
+    [self.recentKeys removeObjectAtIndex:0];
+  }
+}
+
+#pragma mark - Persistence
+
+- (nullable NSURL *)_fileURLForKey:(NSString *)key
+{
+  return [self.directoryURL URLByAppendingPathComponent:[key stringByAppendingPathExtension:@"plist"]];
+}
+
+- (void)_setEntry:(FBSDKGraphResponseCacheEntry *)entry forKey:(NSString *)key
+{
+  @synchronized(self) {
+    [self _keepEntry:entry forKey:key];
+  }
+  NSURL *fileURL = [self _fileURLForKey:key];
+  if (!fileURL) {
+    return;
+  }
+  NSMutableDictionary<NSString *, id> *plist = [NSMutableDictionary dictionary];
+  [FBSDKTypeUtility dictionary:plist setObject:entry.ETag forKey:FBSDKGraphResponseCacheETagKey];
+  [FBSDKTypeUtility dictionary:plist setObject:entry.expirationDate forKey:FBSDKGraphResponseCacheExpirationDateKey];
+  [FBSDKTypeUtility dictionary:plist setObject:entry.data forKey:FBSDKGraphResponseCacheDataKey];
+  NSURL *directoryURL = self.directoryURL;
+  dispatch_async(self.queue, ^{
+    NSData *data = [NSPropertyListSerialization dataWithPropertyList:plist
+                                                              format:NSPropertyListBinaryFormat_v1_0
+                                                             options:0
+                                                               error:NULL];
+    if (data) {
+      [NSFileManager.defaultManager createDirectoryAtURL:directoryURL withIntermediateDirectories:YES attributes:nil error:NULL];
+      [data writeToURL:fileURL atomically:YES];
+    }
+  });
+}
+
+- (nullable FBSDKGraphResponseCacheEntry *)_loadEntryForKey:(NSString *)key
+{
+  NSURL *fileURL = [self _fileURLForKey:key];
+  if (!fileURL) {
+    return nil;
+  }
+  // Read on the queue so that pending writes and removals of the entry are applied first.
+  __block NSData *fileData = nil;
+  dispatch_sync(self.queue, ^{
+    fileData = [NSData dataWithContentsOfURL:fileURL];
+  });
+  if (!fileData) {
+    return nil;
+  }
+  NSDictionary<NSString *, id> *plist = [FBSDKTypeUtility dictionaryValue:
+                                         [NSPropertyListSerialization propertyListWithData:fileData
+                                                                                   options:NSPropertyListImmutable
+                                                                                    format:NULL
+                                                                                     error:NULL]];
+  NSDate *expirationDate = [FBSDKTypeUtility dictionary:plist objectForKey:FBSDKGraphResponseCacheExpirationDateKey ofType:NSDate.class];
+  NSData *data = [FBSDKTypeUtility dictionary:plist objectForKey:FBSDKGraphResponseCacheDataKey ofType:NSData.class];
+  if (!expirationDate || !data) {
+    return nil;
+  }
+  return [[FBSDKGraphResponseCacheEntry alloc] initWithETag:[FBSDKTypeUtility dictionary:plist objectForKey:FBSDKGraphResponseCacheETagKey ofType:NSString.class]
+                                             expirationDate:expirationDate
+                                                       data:data
+                                                     object:nil];
+}
+
+@end
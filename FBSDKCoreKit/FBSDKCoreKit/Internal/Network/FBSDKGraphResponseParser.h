@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Parses Graph API responses straight from the response bytes.
+
+ The entries of a batch response keep their body as the raw JSON string until the entry is resolved,
+ so each body is decoded once, right before the completion handler of its request runs.
+ */
+NS_SWIFT_NAME(GraphResponseParser)
+@interface FBSDKGraphResponseParser : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
++ (instancetype)new NS_UNAVAILABLE;
+
+/**
+ Parses a response body.
+ Bodies that are not JSON, such as "foo=bar", are wrapped in a dictionary under `FBSDKNonJSONResponseProperty`.
+ @return nil if the data is not valid UTF-8.
+ */
++ (nullable id)objectWithData:(NSData *)data;
+
+/**
+ Wraps the dictionary entries of a batch response so that their body is only parsed when resolved.
+ Other entries are kept as is.
+ */
++ (NSArray<id> *)lazyResultsForBatchResponse:(NSArray<id> *)response;
+
+/**
+ Returns a batch entry with its body parsed, parsing it on first use.
+ Results that were not wrapped by `lazyResultsForBatchResponse:` are returned as is.
+ */
++ (nullable id)resolvedResult:(nullable id)result;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import "FBSDKGraphResponseParser.h"
+
+#import <FBSDKCoreKit_Basics/FBSDKCoreKit_Basics.h>
+
+#import "FBSDKGraphRequestConnection.h"
+
+// A batch entry whose body is decoded on first use.
+@interface FBSDKLazyGraphBatchResult : NSObject
+
+@property (nonatomic, readonly, copy) NSDictionary<NSString *, id> *entry;
+@property (nullable, nonatomic) NSDictionary<NSString *, id> *resolvedEntry;
+
+- (instancetype)initWithEntry:(NSDictionary<NSString *, id> *)entry;
+
+@end
+
+@implementation FBSDKLazyGraphBatchResult
+
+- (instancetype)initWithEntry:(NSDictionary<NSString *, id> *)entry
+{
+  if ((self = [super init])) {
+    _entry = [entry copy];
+  }
+  return self;
+}
+
+- (NSDictionary<NSString *, id> *)resolve
+{
+  @synchronized(self) {
+    if (!self.resolvedEntry) {
+      NSMutableDictionary<NSString *, id> *result = [self.entry mutableCopy];
+      // Bodies that are not strings are kept as is.
+      NSString *body = [FBSDKTypeUtility stringValueOrNil:self.entry[@"body"]];
+      NSData *data = [body dataUsingEncoding:NSUTF8StringEncoding];
+      if (data) {
+        [FBSDKTypeUtility dictionary:result setObject:[FBSDKGraphResponseParser objectWithData:data] forKey:@"body"];
+      }
+      self.resolvedEntry = result;
+    }
+    return self.resolvedEntry;
+  }
+}
+
+- (NSString *)description
+{
+  return self.entry.description;
+}
+
+@end
+
+@implementation FBSDKGraphResponseParser
+
++ (nullable id)objectWithData:(NSData *)data
+{
+  if (data.length) {
+    // Graph API can return "true" or "false", which are only valid as JSON fragments.
+    id parsed = [FBSDKTypeUtility JSONObjectWithData:data options:NSJSONReadingAllowFragments error:NULL];
+    if (parsed) {
+      return parsed;
+    }
+  }
+  // Only pay for a string when the response is not JSON, to support results such as "foo=bar".
+  NSString *string = [[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding];
+  if (!string) {
+    return nil;
+  }
+  return @{ FBSDKNonJSONResponseProperty : string };
+}
+
++ (NSArray<id> *)lazyResultsForBatchResponse:(NSArray<id> *)response
+{
+  NSMutableArray<id> *results = [NSMutableArray arrayWithCapacity:response.count];
+  for (id item in response) {
+    if ([item isKindOfClass:NSDictionary.class] && ((NSDictionary<NSString *, id> *)item)[@"body"]) {
+      [FBSDKTypeUtility array:results addObject:[[FBSDKLazyGraphBatchResult alloc] initWithEntry:item]];
+    } else {
+      [FBSDKTypeUtility array:results addObject:item];
+    }
+  }
+  return results;
+}
+
++ (nullable id)resolvedResult:(nullable id)result
+{
+  if ([result isKindOfClass:FBSDKLazyGraphBatchResult.class]) {
+    return [(FBSDKLazyGraphBatchResult *)result resolve];
+  }
+  return result;
+}
+
+@end
@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import "FBSDKURLSessionProxying.h"
+
+@class FBSDKURLSessionPool;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ A session proxy that runs its requests on the shared session of a pool.
+
+ Invalidating the proxy only cancels the tasks it started; the pooled session stays valid.
+ Completion handlers and delegate callbacks are delivered on the delegate queue when one is set.
+ */
+NS_SWIFT_NAME(PooledURLSession)
+@interface FBSDKPooledURLSession : NSObject <FBSDKURLSessionProxying, NSURLSessionDataDelegate>
+
+@property (nonatomic, readonly) FBSDKURLSessionPool *pool;
+@property (nullable, nonatomic, weak) id<NSURLSessionDataDelegate> delegate;
+@property (nullable, nonatomic, retain) NSOperationQueue *delegateQueue;
+
+- (instancetype)init NS_UNAVAILABLE;
++ (instancetype)new NS_UNAVAILABLE;
+
+- (instancetype)initWithPool:(FBSDKURLSessionPool *)pool
+                    delegate:(nullable id<NSURLSessionDataDelegate>)delegate
+               delegateQueue:(nullable NSOperationQueue *)delegateQueue
+  NS_DESIGNATED_INITIALIZER;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import "FBSDKPooledURLSession.h"
+
+#import "FBSDKURLSessionPool.h"
+
+@interface FBSDKPooledURLSession ()
+
+@property (nonatomic, readonly) NSMutableSet<NSURLSessionTask *> *tasks;
+
+@end
+
+@implementation FBSDKPooledURLSession
+
+- (instancetype)initWithPool:(FBSDKURLSessionPool *)pool
+                    delegate:(nullable id<NSURLSessionDataDelegate>)delegate
+               delegateQueue:(nullable NSOperationQueue *)delegateQueue
+{
+  if ((self = [super init])) {
+    _pool = pool;
+    _delegate = delegate;
+    _delegateQueue = delegateQueue;
+    _tasks = [NSMutableSet new];
+  }
+  return self;
+}
+
+- (void)executeURLRequest:(NSURLRequest *)request
+        completionHandler:(FBSDKURLSessionTaskBlock)handler
+{
+  __block NSURLSessionDataTask *task = nil;
+  task = [self.pool dataTaskWithRequest:request
+                               delegate:self
+                      completionHandler:^(NSData *_Nullable data, NSURLResponse *_Nullable response, NSError *_Nullable error) {
+                        @synchronized(self) {
+                          [self.tasks removeObject:task];
+                        }
+                        task = nil;
+                        [self deliver:^{
+                          if (handler) {
+                            handler(data, response, error);
+                          }
+                        }];
+                      }];
+  @synchronized(self) {
+    [self.tasks addObject:task];
+  }
+  [task resume];
+}
+
+- (void)invalidateAndCancel
+{
+  NSArray<NSURLSessionTask *> *tasks;
+  @synchronized(self) {
+    tasks = self.tasks.allObjects;
+    [self.tasks removeAllObjects];
+  }
+  for (NSURLSessionTask *task in tasks) {
+    [task cancel];
+  }
+}
+
+#pragma mark - Private
+
+- (void)deliver:(dispatch_block_t)block
+{
+  NSOperationQueue *queue = self.delegateQueue;
+  if (queue && queue != NSOperationQueue.currentQueue) {
+    [queue addOperationWithBlock:block];
+  } else {
+    block();
+  }
+}
+
+#pragma mark - NSURLSessionDataDelegate
+
+- (void)        URLSession:(NSURLSession *)session
+                      task:(NSURLSessionTask *)task
+           didSendBodyData:(int64_t)bytesSent
+            totalBytesSent:(int64_t)totalBytesSent
+  totalBytesExpectedToSend:(int64_t)totalBytesExpectedToSend
+{
+  id<NSURLSessionDataDelegate> delegate = self.delegate;
+  if (![delegate respondsToSelector:@selector(URLSession:task:didSendBodyData:totalBytesSent:totalBytesExpectedToSend:)]) {
+    return;
+  }
+  [self deliver:^{
+    [delegate      URLSession:session
+                         task:task
+              didSendBodyData:bytesSent
+               totalBytesSent:totalBytesSent
+     totalBytesExpectedToSend:totalBytesExpectedToSend];
+  }];
+}
+
+- (void)      URLSession:(NSURLSession *)session
+                    task:(NSURLSessionTask *)task
+  didFinishCollectingMetrics:(NSURLSessionTaskMetrics *)metrics
+{
+  id<NSURLSessionDataDelegate> delegate = self.delegate;
+  if (![delegate respondsToSelector:@selector(URLSession:task:didFinishCollectingMetrics:)]) {
+    return;
+  }
+  [self deliver:^{
+    [delegate URLSession:session task:task didFinishCollectingMetrics:metrics];
+  }];
+}
+
+@end
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ A token bucket rate limiter.
+
+ The bucket starts full and refills continuously. Callers reserve tokens ahead of time, so a caller
+ finding the bucket empty is told how long to wait for its token instead of being turned away.
+
+ This type is thread safe.
+ */
+NS_SWIFT_NAME(TokenBucket)
+@interface FBSDKTokenBucket : NSObject
+
+/// The number of tokens available in a burst.
+@property (nonatomic, readonly) double capacity;
+@property (nonatomic, readonly) double tokensPerSecond;
+
+- (instancetype)init NS_UNAVAILABLE;
++ (instancetype)new NS_UNAVAILABLE;
+
+- (instancetype)initWithCapacity:(double)capacity
+                 tokensPerSecond:(double)tokensPerSecond
+  NS_DESIGNATED_INITIALIZER;
+
+/// Takes a token and returns how long to wait before using it, 0 if it can be used right away.
+- (NSTimeInterval)reserveTokenAtDate:(NSDate *)date;
+
+/// The number of tokens left at the given date. Negative when tokens are reserved ahead of time.
+- (double)availableTokensAtDate:(NSDate *)date;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import "FBSDKTokenBucket.h"
+
+@implementation FBSDKTokenBucket
+{
+  double _tokens;
+  NSDate *_lastRefillDate;
+}
+
+- (instancetype)initWithCapacity:(double)capacity
+                 tokensPerSecond:(double)tokensPerSecond
+{
+  if ((self = [super init])) {
+    _capacity = MAX(1, capacity);
+    _tokensPerSecond = MAX(DBL_MIN, tokensPerSecond);
+    _tokens = _capacity;
+  }
+  return self;
+}
+
+- (NSTimeInterval)reserveTokenAtDate:(NSDate *)date
+{
+  @synchronized(self) {
+    [self refillAtDate:date];
+    _tokens -= 1;
+    return _tokens >= 0 ? 0 : -_tokens / self.tokensPerSecond;
+  }
+}
+
+- (double)availableTokensAtDate:(NSDate *)date
+{
+  @synchronized(self) {
+    [self refillAtDate:date];
+    return _tokens;
+  }
+}
+
+#pragma mark - Private
+
+- (void)refillAtDate:(NSDate *)date
+{
+  if (_lastRefillDate) {
+    NSTimeInterval elapsed = MAX(0, [date timeIntervalSinceDate:_lastRefillDate]);
+    _tokens = MIN(self.capacity, _tokens + elapsed * self.tokensPerSecond);
+  }
+  if (!_lastRefillDate || [date compare:_lastRefillDate] == NSOrderedDescending) {
+    _lastRefillDate = date;
+  }
+}
+
+@end
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import <FBSDKCoreKit_Basics/FBSDKCoreKit_Basics.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Owns a single long lived URL session for a session configuration so that connections share
+ its connection pool, TLS sessions and HTTP/2 streams instead of paying for a new session each time.
+
+ The session delegate callbacks of each task are routed to the delegate the task was created with.
+ The session is never invalidated; cancel individual tasks instead.
+ */
+NS_SWIFT_NAME(URLSessionPool)
+@interface FBSDKURLSessionPool : NSObject <NSURLSessionDataDelegate>
+
+/// The process wide pool for the default session configuration.
+@property (class, nonatomic, readonly) FBSDKURLSessionPool *shared;
+
+/// The shared session, created on first use.
+@property (nonatomic, readonly) NSURLSession *session;
+
+- (instancetype)init NS_UNAVAILABLE;
++ (instancetype)new NS_UNAVAILABLE;
+
+- (instancetype)initWithConfiguration:(NSURLSessionConfiguration *)configuration NS_DESIGNATED_INITIALIZER;
+
+/**
+ Creates a suspended data task on the shared session.
+ The delegate receives the session delegate callbacks of the task until the task completes.
+ */
+- (NSURLSessionDataTask *)dataTaskWithRequest:(NSURLRequest *)request
+                                     delegate:(nullable id<NSURLSessionDataDelegate>)delegate
+                            completionHandler:(FBSDKURLSessionTaskBlock)handler;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import "FBSDKURLSessionPool.h"
+
+static NSString *const FBSDKURLSessionPoolQueueName = @"com.facebook.sdk.URLSessionPool";
+
+@interface FBSDKURLSessionPool ()
+
+@property (nonatomic, readonly, copy) NSURLSessionConfiguration *configuration;
+@property (nonatomic, readonly) NSOperationQueue *delegateQueue;
+@property (nonatomic, readonly) NSMapTable<NSNumber *, id<NSURLSessionDataDelegate>> *taskDelegates;
+
+@end
+
+@implementation FBSDKURLSessionPool
+{
+  NSURLSession *_session;
+}
+
++ (FBSDKURLSessionPool *)shared
+{
+  static FBSDKURLSessionPool *instance;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    instance = [[self alloc] initWithConfiguration:NSURLSessionConfiguration.defaultSessionConfiguration];
+  });
+  return instance;
+}
+
+- (instancetype)initWithConfiguration:(NSURLSessionConfiguration *)configuration
+{
+  if ((self = [super init])) {
+    _configuration = [configuration copy];
+    _delegateQueue = [NSOperationQueue new];
+    _delegateQueue.name = FBSDKURLSessionPoolQueueName;
+    _delegateQueue.maxConcurrentOperationCount = 1;
+    _taskDelegates = [NSMapTable strongToWeakObjectsMapTable];
+  }
+  return self;
+}
+
+- (NSURLSession *)session
+{
+  @synchronized(self) {
+    if (!_session) {
+      _session = [NSURLSession sessionWithConfiguration:self.configuration
+                                               delegate:self
+                                          delegateQueue:self.delegateQueue];
+    }
+    return _session;
+  }
+}
+
+- (NSURLSessionDataTask *)dataTaskWithRequest:(NSURLRequest *)request
+                                     delegate:(nullable id<NSURLSessionDataDelegate>)delegate
+                            completionHandler:(FBSDKURLSessionTaskBlock)handler
+{
+  __block NSURLSessionDataTask *task = nil;
+  task = [self.session dataTaskWithRequest:request
+                         completionHandler:^(NSData *_Nullable data, NSURLResponse *_Nullable response, NSError *_Nullable error) {
+                           [self removeDelegateForTask:task];
+                           task = nil;
+                           if (handler) {
+                             handler(data, response, error);
+                           }
+                         }];
+  if (delegate) {
+    @synchronized(self) {
+      [self.taskDelegates setObject:delegate forKey:@(task.taskIdentifier)];
+    }
+  }
+  return task;
+}
+
+#pragma mark - Private
+
+- (nullable id<NSURLSessionDataDelegate>)delegateForTask:(NSURLSessionTask *)task
+{
+  @synchronized(self) {
+    return [self.taskDelegates objectForKey:@(task.taskIdentifier)];
+  }
+}
+
+- (void)removeDelegateForTask:(nullable NSURLSessionTask *)task
+{
+  if (!task) {
+    return;
+  }
+  @synchronized(self) {
+    [self.taskDelegates removeObjectForKey:@(task.taskIdentifier)];
+  }
+}
+
+#pragma mark - NSURLSessionDataDelegate
+
+- (void)        URLSession:(NSURLSession *)session
+                      task:(NSURLSessionTask *)task
+           didSendBodyData:(int64_t)bytesSent
+            totalBytesSent:(int64_t)totalBytesSent
+  totalBytesExpectedToSend:(int64_t)totalBytesExpectedToSend
+{
+  id<NSURLSessionDataDelegate> delegate = [self delegateForTask:task];
+  if ([delegate respondsToSelector:@selector(URLSession:task:didSendBodyData:totalBytesSent:totalBytesExpectedToSend:)]) {
+    [delegate      URLSession:session
+                         task:task
+              didSendBodyData:bytesSent
+               totalBytesSent:totalBytesSent
+     totalBytesExpectedToSend:totalBytesExpectedToSend];
+  }
+}
+
+- (void)      URLSession:(NSURLSession *)session
+                    task:(NSURLSessionTask *)task
+  didFinishCollectingMetrics:(NSURLSessionTaskMetrics *)metrics
+{
+  id<NSURLSessionDataDelegate> delegate = [self delegateForTask:task];
+  if ([delegate respondsToSelector:@selector(URLSession:task:didFinishCollectingMetrics:)]) {
+    [delegate URLSession:session task:task didFinishCollectingMetrics:metrics];
+  }
+}
+
+- (void)URLSession:(NSURLSession *)session
+              task:(NSURLSessionTask *)task
+ needNewBodyStream:(void (^)(NSInputStream *_Nullable bodyStream))completionHandler
+{
+  id<NSURLSessionDataDelegate> delegate = [self delegateForTask:task];
+  if ([delegate respondsToSelector:@selector(URLSession:task:needNewBodyStream:)]) {
+    [delegate URLSession:session task:task needNewBodyStream:completionHandler];
+  } else {
+    completionHandler(nil);
+  }
+}
+
+@end
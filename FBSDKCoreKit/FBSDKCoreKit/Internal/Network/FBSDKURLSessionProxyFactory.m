@@ -10,12 +10,21 @@
 
 #import <Foundation/Foundation.h>
 
+#import "FBSDKPooledURLSession.h"
+#import "FBSDKURLSessionPool.h"
+
 @implementation FBSDKURLSessionProxyFactory
 
 - (nonnull id<FBSDKURLSessionProxying>)createSessionProxyWithDelegate:(id<NSURLSessionDataDelegate>)delegate
                                                                 queue:(NSOperationQueue *)queue
 {
-  return (id<FBSDKURLSessionProxying>)[[FBSDKURLSession alloc] initWithDelegate:delegate delegateQueue:queue];
+  // Callers asking for a specific delegate queue up front keep a dedicated session.
+  if (queue) {
+    return (id<FBSDKURLSessionProxying>)[[FBSDKURLSession alloc] initWithDelegate:delegate delegateQueue:queue];
+  }
+  return [[FBSDKPooledURLSession alloc] initWithPool:FBSDKURLSessionPool.shared
+                                            delegate:delegate
+                                       delegateQueue:nil];
 }
 
 @end
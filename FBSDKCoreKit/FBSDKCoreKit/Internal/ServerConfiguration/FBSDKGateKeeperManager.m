@@ -17,6 +17,7 @@
 #import "FBSDKDataPersisting.h"
 #import "FBSDKGraphRequest.h"
 #import "FBSDKGraphRequest+Internal.h"
+#import "FBSDKGraphRequestCoalescer.h"
 #import "FBSDKGraphRequestConnecting.h"
 #import "FBSDKGraphRequestConnectionFactoryProtocol.h"
 #import "FBSDKGraphRequestFactoryProtocol.h"
@@ -125,13 +126,13 @@ static id<FBSDKDataPersisting> _store;
           id<FBSDKGraphRequest> request = [self.class requestToLoadGateKeepers];
 
           // start request with specified timeout instead of the default 180s
-          id<FBSDKGraphRequestConnecting> requestConnection = [self.graphRequestConnectionFactory createGraphRequestConnection];
-          requestConnection.timeout = kTimeout;
-          [requestConnection addRequest:request completion:^(id<FBSDKGraphRequestConnecting> connection, id result, NSError *error) {
-            _requeryFinishedForAppStart = YES;
-            [self processLoadRequestResponse:result error:error];
-          }];
-          [requestConnection start];
+          [FBSDKGraphRequestCoalescer.shared startRequest:request
+                                        connectionFactory:self.graphRequestConnectionFactory
+                                                  timeout:kTimeout
+                                               completion:^(id<FBSDKGraphRequestConnecting> connection, id result, NSError *error) {
+                                                 _requeryFinishedForAppStart = YES;
+                                                 [self processLoadRequestResponse:result error:error];
+                                               }];
         }
       }
     }
@@ -153,7 +154,7 @@ static id<FBSDKDataPersisting> _store;
                                                         parameters:parameters
                                                        tokenString:nil
                                                         HTTPMethod:nil
-                                                             flags:FBSDKGraphRequestFlagSkipClientToken | FBSDKGraphRequestFlagDisableErrorRecovery];
+                                                             flags:FBSDKGraphRequestFlagSkipClientToken | FBSDKGraphRequestFlagDisableErrorRecovery | FBSDKGraphRequestFlagUseResponseCache | FBSDKGraphRequestFlagRetryTransientFailures | FBSDKGraphRequestFlagUsesCircuitBreaker];
 }
 
 #pragma mark - Helper Class Methods
@@ -14,6 +14,7 @@
 #define FBSDK_SERVER_CONFIGURATION_MANAGER_CACHE_TIMEOUT (60 * 60)
 
 @protocol FBSDKGraphRequestFactory;
+@protocol FBSDKGraphRequestConnectionFactory;
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -40,7 +41,8 @@ NS_SWIFT_NAME(ServerConfigurationManager)
  */
 - (void)loadServerConfigurationWithCompletionBlock:(nullable FBSDKServerConfigurationBlock)completionBlock;
 
-- (void)configureWithGraphRequestFactory:(id<FBSDKGraphRequestFactory>)graphRequestFactory;
+- (void)configureWithGraphRequestFactory:(id<FBSDKGraphRequestFactory>)graphRequestFactory
+           graphRequestConnectionFactory:(id<FBSDKGraphRequestConnectionFactory>)graphRequestConnectionFactory;
 
 @end
 
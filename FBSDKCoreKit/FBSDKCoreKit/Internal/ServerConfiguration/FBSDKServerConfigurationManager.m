@@ -12,8 +12,8 @@
 #import <objc/runtime.h>
 
 #import "FBSDKAppEventsUtility.h"
-#import "FBSDKGraphRequestConnection.h"
-#import "FBSDKGraphRequestConnection+GraphRequestConnecting.h"
+#import "FBSDKGraphRequestCoalescer.h"
+#import "FBSDKGraphRequestConnecting.h"
 #import "FBSDKGraphRequestFactory.h"
 #import "FBSDKImageDownloader.h"
 #import "FBSDKInternalUtility+Internal.h"
@@ -93,8 +93,10 @@ typedef NS_OPTIONS(NSUInteger, FBSDKServerConfigurationManagerAppEventsFeatures)
 }
 
 - (void)configureWithGraphRequestFactory:(id<FBSDKGraphRequestFactory>)graphRequestFactory
+           graphRequestConnectionFactory:(id<FBSDKGraphRequestConnectionFactory>)graphRequestConnectionFactory
 {
   self.graphRequestFactory = graphRequestFactory;
+  self.graphRequestConnectionFactory = graphRequestConnectionFactory;
 }
 
 #pragma mark - Public
@@ -175,13 +177,13 @@ typedef NS_OPTIONS(NSUInteger, FBSDKServerConfigurationManagerAppEventsFeatures)
           id<FBSDKGraphRequest> request = [self requestToLoadServerConfiguration:appID];
 
           // start request with specified timeout instead of the default 180s
-          id<FBSDKGraphRequestConnecting> requestConnection = [FBSDKGraphRequestConnection new];
-          requestConnection.timeout = kTimeout;
-          [requestConnection addRequest:request completion:^(id<FBSDKGraphRequestConnecting> connection, id result, NSError *error) {
-            self.requeryFinishedForAppStart = YES;
-            [self processLoadRequestResponse:result error:error appID:appID];
-          }];
-          [requestConnection start];
+          [FBSDKGraphRequestCoalescer.shared startRequest:request
+                                        connectionFactory:self.graphRequestConnectionFactory
+                                                  timeout:kTimeout
+                                               completion:^(id<FBSDKGraphRequestConnecting> connection, id result, NSError *error) {
+                                                 self.requeryFinishedForAppStart = YES;
+                                                 [self processLoadRequestResponse:result error:error appID:appID];
+                                               }];
         }
       }
     }
@@ -319,7 +321,7 @@ typedef NS_OPTIONS(NSUInteger, FBSDKServerConfigurationManagerAppEventsFeatures)
                                                         parameters:parameters
                                                        tokenString:nil
                                                         HTTPMethod:nil
-                                                             flags:FBSDKGraphRequestFlagSkipClientToken | FBSDKGraphRequestFlagDisableErrorRecovery];
+                                                             flags:FBSDKGraphRequestFlagSkipClientToken | FBSDKGraphRequestFlagDisableErrorRecovery | FBSDKGraphRequestFlagUseResponseCache | FBSDKGraphRequestFlagRetryTransientFailures | FBSDKGraphRequestFlagUsesCircuitBreaker];
 }
 
 #pragma mark - Helper Class Methods
@@ -432,6 +434,7 @@ typedef NS_OPTIONS(NSUInteger, FBSDKServerConfigurationManagerAppEventsFeatures)
 - (void)reset
 {
   self.graphRequestFactory = nil;
+  self.graphRequestConnectionFactory = nil;
 }
 
 #endif
@@ -42,6 +42,8 @@
 #import <FBSDKCoreKit/FBSDKGraphRequestConnection.h>
 #import <FBSDKCoreKit/FBSDKGraphRequestConnection+GraphRequestConnecting.h>
 #import <FBSDKCoreKit/FBSDKGraphRequestConnectionFactory.h>
+#import <FBSDKCoreKit/FBSDKGraphRequestConnectionMetrics.h>
+#import <FBSDKCoreKit/FBSDKGraphRequestConnectionMetricsSink.h>
 #import <FBSDKCoreKit/FBSDKGraphRequestDataAttachment.h>
 #import <FBSDKCoreKit/FBSDKGraphRequestFactory.h>
 #import <FBSDKCoreKit/FBSDKGraphRequestFactoryProtocol.h>
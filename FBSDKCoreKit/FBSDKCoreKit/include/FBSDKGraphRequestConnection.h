@@ -9,6 +9,7 @@
 #import <Foundation/Foundation.h>
 
 #import <FBSDKCoreKit/FBSDKGraphRequestConnecting.h>
+#import <FBSDKCoreKit/FBSDKGraphRequestConnectionMetricsSink.h>
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -154,6 +155,19 @@ NS_SWIFT_NAME(GraphRequestConnection)
  */
 @property (class, nonatomic, assign) NSTimeInterval defaultConnectionTimeout;
 
+/**
+ Requests started with `FBSDKGraphRequest startWithCompletion:` within this interval of each other
+ are sent together in one batch request. Each request still gets its own completion.
+ Defaults to 0, which disables coalescing.
+ */
+@property (class, nonatomic, assign) NSTimeInterval requestCoalescingWindow;
+
+/**
+ Receives a record of the timings, sizes and retries of every connection as it completes.
+ Connections use the sink set when they are created. Defaults to nil.
+ */
+@property (class, nullable, nonatomic, strong) id<FBSDKGraphRequestConnectionMetricsSink> metricsSink;
+
 /**
   The delegate object that receives updates.
  */
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ The network cost of a single `FBSDKGraphRequestConnection`, recorded once when the connection completes.
+
+ Timings describe the last attempt of the connection and come from `NSURLSessionTaskMetrics`; they are 0
+ when the system did not report them, for example when the connection was reused or the response was served
+ from the response cache. Sizes are in bytes.
+ */
+NS_SWIFT_NAME(GraphRequestConnectionMetrics)
+@interface FBSDKGraphRequestConnectionMetrics : NSObject
+
+/// The time spent resolving the host name.
+@property (nonatomic, readonly) NSTimeInterval domainLookupDuration;
+
+/// The time spent establishing the connection, including the TLS handshake.
+@property (nonatomic, readonly) NSTimeInterval connectDuration;
+
+/// The time spent on the TLS handshake.
+@property (nonatomic, readonly) NSTimeInterval secureConnectionDuration;
+
+/// The time from the start of the fetch to the first byte of the response.
+@property (nonatomic, readonly) NSTimeInterval timeToFirstByte;
+
+/// The time from the start of the connection to its completion, including queueing and retries.
+@property (nonatomic, readonly) NSTimeInterval totalDuration;
+
+/// Whether the last attempt reused an open connection.
+@property (nonatomic, readonly, getter = isReusedConnection) BOOL reusedConnection;
+
+/// Whether the response was served from the response cache without reaching the network.
+@property (nonatomic, readonly, getter = isServedFromResponseCache) BOOL servedFromResponseCache;
+
+/// The size of the request body before gzip compression.
+@property (nonatomic, readonly) unsigned long long requestBodyBytes;
+
+/// The size of the request body as sent, after gzip compression when the body was compressed.
+@property (nonatomic, readonly) unsigned long long encodedRequestBodyBytes;
+
+/// The size of the response body after decoding.
+@property (nonatomic, readonly) unsigned long long responseBodyBytes;
+
+/// The size of the response body as received, before decoding, or 0 when the system does not report it (before iOS 13).
+@property (nonatomic, readonly) unsigned long long encodedResponseBodyBytes;
+
+/// The number of requests sent in the connection, including piggybacked requests.
+@property (nonatomic, readonly) NSUInteger batchSize;
+
+/// The number of requests the SDK piggybacked onto the connection.
+@property (nonatomic, readonly) NSUInteger piggybackedRequestCount;
+
+/// The number of times the requests were sent again after a transient failure.
+@property (nonatomic, readonly) NSUInteger retryCount;
+
+/// The HTTP status code of the response, or 0 when there was no response.
+@property (nonatomic, readonly) NSInteger statusCode;
+
+/// The error the connection failed with, if any.
+@property (nullable, nonatomic, readonly) NSError *error;
+
+- (instancetype)init NS_UNAVAILABLE;
++ (instancetype)new NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import <Foundation/Foundation.h>
+
+@class FBSDKGraphRequestConnectionMetrics;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Receives the network metrics of every `FBSDKGraphRequestConnection`.
+
+ Records are delivered on the thread the connection completes on, before the completion handlers run,
+ so implementations should return quickly and aggregate elsewhere.
+ */
+NS_SWIFT_NAME(GraphRequestConnectionMetricsSink)
+@protocol FBSDKGraphRequestConnectionMetricsSink <NSObject>
+
+- (void)recordConnectionMetrics:(FBSDKGraphRequestConnectionMetrics *)metrics
+  NS_SWIFT_NAME(record(_:));
+
+@end
+
+NS_ASSUME_NONNULL_END
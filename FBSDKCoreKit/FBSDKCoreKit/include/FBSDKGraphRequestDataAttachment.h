@@ -30,6 +30,18 @@ NS_SWIFT_NAME(GraphRequestDataAttachment)
                  contentType:(NSString *)contentType
 NS_DESIGNATED_INITIALIZER;
 
+/**
+  Initializes the receiver with a file to attach and metadata.
+ The file is read in chunks while the request is sent rather than loaded in memory.
+ @param fileURL The URL of the local file to attach
+ @param filename The filename for the attachment
+ @param contentType The content type for the attachment
+ */
+- (instancetype)initWithFileURL:(NSURL *)fileURL
+                       filename:(NSString *)filename
+                    contentType:(NSString *)contentType
+NS_DESIGNATED_INITIALIZER;
+
 /**
   The content type for the attachment.
  */
@@ -37,9 +49,15 @@ NS_DESIGNATED_INITIALIZER;
 
 /**
   The attachment data.
+ For file attachments, the file is mapped in memory on first access.
  */
 @property (nonatomic, strong, readonly) NSData *data;
 
+/**
+  The local file to attach, if the receiver was initialized with one.
+ */
+@property (nullable, nonatomic, copy, readonly) NSURL *fileURL;
+
 /**
   The filename for the attachment.
  */
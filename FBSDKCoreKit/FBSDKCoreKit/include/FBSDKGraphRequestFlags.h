@@ -21,6 +21,14 @@ typedef NS_OPTIONS(NSUInteger, FBSDKGraphRequestFlags) {
   FBSDKGraphRequestFlagDoNotInvalidateTokenOnError = 1 << 2,
   // indicates this request should not perform error recovery
   FBSDKGraphRequestFlagDisableErrorRecovery = 1 << 3,
+  // indicates the response of this GET request may be cached and revalidated using its ETag and Cache-Control headers
+  FBSDKGraphRequestFlagUseResponseCache = 1 << 4,
+  // indicates this request may wait while requests the user is waiting for are in flight
+  FBSDKGraphRequestFlagBackgroundPriority = 1 << 5,
+  // indicates this request should be sent again, with back off, after network errors and 429 or 5xx responses
+  FBSDKGraphRequestFlagRetryTransientFailures = 1 << 6,
+  // indicates this request may fail right away, or wait for the rate limit, after repeated server failures
+  FBSDKGraphRequestFlagUsesCircuitBreaker = 1 << 7,
 } NS_SWIFT_NAME(GraphRequestFlags);
 
 NS_ASSUME_NONNULL_END
@@ -160,6 +160,12 @@ DEPRECATED_MSG_ATTRIBUTE("`Settings.isGraphErrorRecoveryEnabled` is deprecated a
  */
 @property (nonatomic) BOOL isGraphErrorRecoveryEnabled;
 
+/**
+ Whether background Graph requests, such as app event flushes, stop being sent for a while after repeated server failures.
+ Requests the user is waiting for are never held back. Defaults to YES.
+ */
+@property (nonatomic) BOOL isGraphRequestCircuitBreakerEnabled;
+
 /**
   The Facebook App ID used by the SDK.
 
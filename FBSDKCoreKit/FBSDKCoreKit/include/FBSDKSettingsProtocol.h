@@ -37,6 +37,7 @@ DEPRECATED_MSG_ATTRIBUTE("property class `loggingBehaviors` is deprecated and wi
 @property (nonatomic) BOOL shouldUseTokenOptimizations;
 @property (nonatomic, copy) NSString *graphAPIVersion;
 @property (nonatomic) BOOL isGraphErrorRecoveryEnabled;
+@property (nonatomic) BOOL isGraphRequestCircuitBreakerEnabled;
 @property (nullable, nonatomic, readonly, copy) NSString *graphAPIDebugParamValue;
 @property (nonatomic, getter = isAdvertiserTrackingEnabled) BOOL advertiserTrackingEnabled;
 @property (nonatomic) BOOL shouldUseCachedValuesForExpensiveMetadata;
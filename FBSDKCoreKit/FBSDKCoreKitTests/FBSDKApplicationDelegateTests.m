@@ -14,6 +14,7 @@
 #import "FBSDKAppEventsStateFactory.h"
 #import "FBSDKApplicationObserving.h"
 #import "FBSDKAuthenticationToken+Internal.h"
+#import "FBSDKCombinedEventsProcessor.h"
 #import "FBSDKConversionValueUpdating.h"
 #import "FBSDKCoreKitTests-Swift.h"
 #import "FBSDKCrashShield+Internal.h"
@@ -191,6 +192,12 @@ static NSString *bitmaskKey = @"com.facebook.sdk.kits.bitmask";
     FBSDKGraphRequestFactory.class,
     "Initializing the SDK should set graph request factory for event logging"
   );
+  NSObject *graphRequestConnectionFactory = (NSObject *) self.appEvents.capturedConfigureGraphRequestConnectionFactory;
+  XCTAssertEqualObjects(
+    graphRequestConnectionFactory.class,
+    FBSDKGraphRequestConnectionFactory.class,
+    "Initializing the SDK should set graph request connection factory for event logging"
+  );
   XCTAssertEqualObjects(
     self.appEvents.capturedConfigureAppEventsConfigurationProvider,
     FBSDKAppEventsConfigurationManager.class,
@@ -293,14 +300,25 @@ static NSString *bitmaskKey = @"com.facebook.sdk.kits.bitmask";
 
   [self.delegate initializeSDKWithLaunchOptions:@{}];
 
-  NSArray *expected = @[
+  FBSDKCombinedEventsProcessor *processor = FBSDKAppEventsState.eventProcessors.firstObject;
+  XCTAssertEqual(
+    FBSDKAppEventsState.eventProcessors.count,
+    1,
+    "Initializing the SDK should configure a single events processor for FBSDKAppEventsState"
+  );
+  XCTAssertTrue(
+    [processor isKindOfClass:FBSDKCombinedEventsProcessor.class],
+    "Initializing the SDK should combine the events processors for FBSDKAppEventsState"
+  );
+  XCTAssertEqualObjects(
+    processor.eventDeactivationManager,
     self.appEvents.capturedConfigureEventDeactivationParameterProcessor,
-    self.appEvents.capturedConfigureRestrictiveDataFilterParameterProcessor
-  ];
+    "The combined events processor should use the event deactivation manager given to app events"
+  );
   XCTAssertEqualObjects(
-    FBSDKAppEventsState.eventProcessors,
-    expected,
-    "Initializing the SDK should configure events processors for FBSDKAppEventsState"
+    processor.restrictiveDataFilterManager,
+    self.appEvents.capturedConfigureRestrictiveDataFilterParameterProcessor,
+    "The combined events processor should use the restrictive data filter manager given to app events"
   );
 }
 
@@ -469,6 +487,10 @@ static NSString *bitmaskKey = @"com.facebook.sdk.kits.bitmask";
       SKAdNetwork.class,
       "Should be configured with the default Conversion Value Updating Class"
     );
+    XCTAssertTrue(
+      [self.delegate.applicationObservers containsObject:[self.delegate skAdNetworkReporter]],
+      "Should observe the application to save the report data when backgrounding"
+    );
   }
 }
 
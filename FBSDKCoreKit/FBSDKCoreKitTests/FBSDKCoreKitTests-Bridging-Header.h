@@ -42,8 +42,12 @@
 #import "FBSDKAppEventsConfigurationProviding.h"
 #import "FBSDKAppEventsConfiguring.h"
 #import "FBSDKAppEventsDeviceInfo+Testing.h"
+#import "FBSDKAppEventsFlushExecutor.h"
+#import "FBSDKAppEventsFlushPolicy.h"
+#import "FBSDKAppEventsFlushResult.h"
 #import "FBSDKAppEventsFlushReason.h"
 #import "FBSDKAppEventsNumberParser.h"
+#import "FBSDKAppEventsParameterPipeline.h"
 #import "FBSDKAppEventsParameterProcessing.h"
 #import "FBSDKAppEventsReporter.h"
 #import "FBSDKAppEventsState.h"
@@ -88,6 +92,7 @@
 #import "FBSDKClientTokenProviding.h"
 #import "FBSDKCloseIcon.h"
 #import "FBSDKCloseIcon+Testing.h"
+#import "FBSDKCombinedEventsProcessor.h"
 #import "FBSDKConversionValueUpdating.h"
 #import "FBSDKCrashHandler+Testing.h"
 #import "FBSDKCrashObserver.h"
@@ -120,6 +125,8 @@
 #import "FBSDKGraphRequest+Internal.h"
 #import "FBSDKGraphRequest+Testing.h"
 #import "FBSDKGraphRequestBody.h"
+#import "FBSDKGraphRequestCircuitBreaker.h"
+#import "FBSDKGraphRequestCoalescer.h"
 #import "FBSDKGraphRequestConnecting.h"
 #import "FBSDKGraphRequestConnecting+Internal.h"
 #import "FBSDKGraphRequestConnection+Testing.h"
@@ -132,6 +139,11 @@
 #import "FBSDKGraphRequestPiggybackManagerProvider.h"
 #import "FBSDKGraphRequestPiggybackManagerProviding.h"
 #import "FBSDKGraphRequestPiggybackManaging.h"
+#import "FBSDKGraphRequestRetryPolicy.h"
+#import "FBSDKGraphRequestScheduler.h"
+#import "FBSDKGraphResponseCache.h"
+#import "FBSDKGraphResponseCache+Testing.h"
+#import "FBSDKGraphResponseParser.h"
 #import "FBSDKHumanSilhouetteIcon.h"
 #import "FBSDKHybridAppEventsScriptMessageHandler+Testing.h"
 #import "FBSDKInstrumentManager+Testing.h"
@@ -158,6 +170,7 @@
 #import "FBSDKPasteboard.h"
 #import "FBSDKPaymentObserving.h"
 #import "FBSDKPaymentProductRequestor.h"
+#import "FBSDKPooledURLSession.h"
 #import "FBSDKProductRequestFactory.h"
 #import "FBSDKProfileCodingKey.h"
 #import "FBSDKProfile+Internal.h"
@@ -172,6 +185,8 @@
 #import "FBSDKSKAdNetworkReporter.h"
 #import "FBSDKSKAdNetworkReporter+Testing.h"
 #import "FBSDKSKAdNetworkRule.h"
+#import "FBSDKSKAdNetworkRuleMatcher.h"
+#import "FBSDKSKAdNetworkRuleMatcher+Testing.h"
 #import "FBSDKServerConfiguration.h"
 #import "FBSDKServerConfiguration+Internal.h"
 #import "FBSDKServerConfigurationLoading.h"
@@ -188,10 +203,12 @@
 #import "FBSDKTimeSpentRecording.h"
 #import "FBSDKTimeSpentRecordingCreating.h"
 #import "FBSDKTimeSpentRecordingFactory.h"
+#import "FBSDKTokenBucket.h"
 #import "FBSDKTokenCache.h"
 #import "FBSDKUserDataStore.h"
 #import "FBSDKURL+Internal.h"
 #import "FBSDKURLOpener.h"
+#import "FBSDKURLSessionPool.h"
 #import "FBSDKURLSessionProxyFactory.h"
 #import "FBSDKURLSessionProxyProviding.h"
 #import "FBSDKViewHierarchy.h"
@@ -15,9 +15,14 @@
 #import "FBSDKCoreKitTests-Swift.h"
 #import "FBSDKFeatureManager.h"
 #import "FBSDKGraphRequest+Internal.h"
+#import "FBSDKGraphRequestCircuitBreaker.h"
 #import "FBSDKGraphRequestConnection+Internal.h"
+#import "FBSDKGraphRequestRetryPolicy.h"
+#import "FBSDKGraphRequestScheduler.h"
+#import "FBSDKGraphResponseCache.h"
 #import "FBSDKSettings+Internal.h"
 #import "FBSDKSettingsProtocol.h"
+#import "FBSDKTokenBucket.h"
 #import "FBSDKURLSessionProxyFactory.h"
 
 @interface FBSDKGraphRequestConnectionTests : XCTestCase <FBSDKGraphRequestConnectionDelegate>
@@ -80,6 +85,12 @@
                                                                 macCatalystDeterminator:self.macCatalystDeterminator
                                                                     accessTokenProvider:TestAccessTokenWallet.class
                                                                       accessTokenSetter:TestAccessTokenWallet.class];
+  // Requests of the test session are never answered, so each test gets its own slots.
+  self.connection.scheduler = [[FBSDKGraphRequestScheduler alloc] initWithMaxConcurrentRequests:6
+                                                               maxConcurrentBackgroundRequests:2
+                                                                                   maxDeferral:10];
+  self.connection.circuitBreaker = [self circuitBreakerWithRateLimiter:[[FBSDKTokenBucket alloc] initWithCapacity:100
+                                                                                                  tokensPerSecond:100]];
   self.graphRequestConnectionFactory.stubbedConnection = self.connection;
 }
 
@@ -972,6 +983,497 @@
   [self waitForExpectations:@[expectation] timeout:1];
 }
 
+// MARK: - Response Cache
+
+- (void)testRevalidatingCachedResponse
+{
+  FBSDKGraphResponseCache *cache = [[FBSDKGraphResponseCache alloc] initWithDirectoryURL:nil];
+  id<FBSDKGraphRequest> request = [[TestGraphRequest alloc] initWithGraphPath:@"me"
+                                                                   parameters:@{@"fields" : @"id"}
+                                                                        flags:FBSDKGraphRequestFlagUseResponseCache];
+  __block id firstResult = nil;
+  self.connection.responseCache = cache;
+  [self.connection addRequest:request
+                   completion:^(id<FBSDKGraphRequestConnecting> potentialConnection, id result, NSError *error) {
+                     firstResult = result;
+                   }];
+  [self.connection start];
+
+  XCTAssertNil([self.session.capturedRequest valueForHTTPHeaderField:@"If-None-Match"]);
+  NSURL *url = self.session.capturedRequest.URL;
+  NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:url
+                                                            statusCode:200
+                                                           HTTPVersion:nil
+                                                          headerFields:@{@"ETag" : @"\"abc\""}];
+  self.session.capturedCompletion([@"{\"id\":\"123\"}" dataUsingEncoding:NSUTF8StringEncoding], response, nil);
+  XCTAssertNotNil(firstResult);
+
+  XCTestExpectation *expectation = [[XCTestExpectation alloc] initWithDescription:self.name];
+  FBSDKGraphRequestConnection *connection = [[FBSDKGraphRequestConnection alloc] initWithURLSessionProxyFactory:self.sessionFactory
+                                                                                     errorConfigurationProvider:self.errorConfigurationProvider
+                                                                                       piggybackManagerProvider:self.piggybackManagerProvider
+                                                                                                       settings:self.settings
+                                                                                  graphRequestConnectionFactory:self.graphRequestConnectionFactory
+                                                                                                    eventLogger:self.eventLogger
+                                                                                 operatingSystemVersionComparer:self.processInfo
+                                                                                        macCatalystDeterminator:self.macCatalystDeterminator
+                                                                                            accessTokenProvider:TestAccessTokenWallet.class
+                                                                                              accessTokenSetter:TestAccessTokenWallet.class];
+  connection.responseCache = cache;
+  connection.scheduler = self.connection.scheduler;
+  connection.circuitBreaker = self.connection.circuitBreaker;
+  [connection addRequest:request
+              completion:^(id<FBSDKGraphRequestConnecting> potentialConnection, id result, NSError *error) {
+                XCTAssertNil(error);
+                XCTAssertTrue(result == firstResult, "Should reuse the object parsed for the cached response");
+                [expectation fulfill];
+              }];
+  [connection start];
+
+  XCTAssertEqualObjects(
+    [self.session.capturedRequest valueForHTTPHeaderField:@"If-None-Match"],
+    @"\"abc\"",
+    "Should revalidate the cached response"
+  );
+  NSHTTPURLResponse *notModified = [[NSHTTPURLResponse alloc] initWithURL:url statusCode:304 HTTPVersion:nil headerFields:nil];
+  self.session.capturedCompletion([NSData data], notModified, nil);
+  [self waitForExpectations:@[expectation] timeout:1];
+}
+
+- (void)testNotUsingResponseCacheWithoutFlag
+{
+  FBSDKGraphResponseCache *cache = [[FBSDKGraphResponseCache alloc] initWithDirectoryURL:nil];
+  self.connection.responseCache = cache;
+  [self.connection addRequest:self.requestForMeWithEmptyFields
+                   completion:^(id<FBSDKGraphRequestConnecting> potentialConnection, id result, NSError *error) {}];
+  [self.connection start];
+
+  NSURL *url = self.session.capturedRequest.URL;
+  NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:url
+                                                            statusCode:200
+                                                           HTTPVersion:nil
+                                                          headerFields:@{@"Cache-Control" : @"max-age=60"}];
+  self.session.capturedCompletion([@"{}" dataUsingEncoding:NSUTF8StringEncoding], response, nil);
+
+  XCTAssertNil(
+    [cache entryForKey:[FBSDKGraphResponseCache keyForURL:url]],
+    "Should only cache the responses of requests that opt in"
+  );
+}
+
+// MARK: - Scheduling
+
+- (void)testDeferringBackgroundRequests
+{
+  FBSDKGraphRequestScheduler *scheduler = self.connection.scheduler;
+  [self.connection addRequest:self.requestForMeWithEmptyFields
+                   completion:^(id<FBSDKGraphRequestConnecting> potentialConnection, id result, NSError *error) {}];
+  [self.connection start];
+  FBSDKURLSessionTaskBlock defaultCompletion = self.session.capturedCompletion;
+  self.session.capturedRequest = nil;
+
+  FBSDKGraphRequestConnection *backgroundConnection = [[FBSDKGraphRequestConnection alloc] initWithURLSessionProxyFactory:self.sessionFactory
+                                                                                               errorConfigurationProvider:self.errorConfigurationProvider
+                                                                                                 piggybackManagerProvider:self.piggybackManagerProvider
+                                                                                                                 settings:self.settings
+                                                                                            graphRequestConnectionFactory:self.graphRequestConnectionFactory
+                                                                                                              eventLogger:self.eventLogger
+                                                                                           operatingSystemVersionComparer:self.processInfo
+                                                                                                  macCatalystDeterminator:self.macCatalystDeterminator
+                                                                                                      accessTokenProvider:TestAccessTokenWallet.class
+                                                                                                        accessTokenSetter:TestAccessTokenWallet.class];
+  backgroundConnection.scheduler = scheduler;
+  backgroundConnection.circuitBreaker = self.connection.circuitBreaker;
+  [backgroundConnection addRequest:[[TestGraphRequest alloc] initWithGraphPath:@"activities"
+                                                                    parameters:@{}
+                                                                         flags:FBSDKGraphRequestFlagBackgroundPriority]
+                        completion:^(id<FBSDKGraphRequestConnecting> potentialConnection, id result, NSError *error) {}];
+  [backgroundConnection start];
+
+  XCTAssertNil(self.session.capturedRequest, "Should hold back background requests while a default request is in flight");
+  XCTAssertEqual([scheduler metricsForPriority:FBSDKGraphRequestPriorityBackground].pendingCount, 1);
+
+  NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:self.sampleUrl statusCode:200 HTTPVersion:nil headerFields:nil];
+  defaultCompletion([@"{}" dataUsingEncoding:NSUTF8StringEncoding], response, nil);
+
+  XCTAssertNotNil(self.session.capturedRequest, "Should send background requests once the default requests are answered");
+  FBSDKGraphRequestQueueMetrics *metrics = [scheduler metricsForPriority:FBSDKGraphRequestPriorityBackground];
+  XCTAssertEqual(metrics.deferredCount, 1);
+  XCTAssertEqual(metrics.inFlightCount, 1);
+}
+
+- (void)testCancellingConnectionFreesItsSlot
+{
+  FBSDKGraphRequestScheduler *scheduler = self.connection.scheduler;
+  [self.connection addRequest:self.requestForMeWithEmptyFields
+                   completion:^(id<FBSDKGraphRequestConnecting> potentialConnection, id result, NSError *error) {}];
+  [self.connection start];
+
+  XCTAssertEqual([scheduler metricsForPriority:FBSDKGraphRequestPriorityDefault].inFlightCount, 1);
+
+  [self.connection cancel];
+
+  XCTAssertEqual(
+    [scheduler metricsForPriority:FBSDKGraphRequestPriorityDefault].inFlightCount,
+    0,
+    "Should free the slot of a cancelled connection"
+  );
+}
+
+// MARK: - Retries
+
+- (FBSDKGraphRequestRetryPolicy *)immediateRetryPolicy
+{
+  return [[FBSDKGraphRequestRetryPolicy alloc] initWithMaxAttempts:3
+                                                          baseDelay:1
+                                                           maxDelay:60
+                                                        retryBudget:10
+                                              randomNumberGenerator:^double {
+                                                return 0;
+                                              }
+                                              delayedBlockPerformer:^(NSTimeInterval delay, dispatch_block_t block) {
+                                                block();
+                                              }];
+}
+
+- (void)testRetryingTransientFailures
+{
+  __block id receivedResult = nil;
+  self.connection.retryPolicy = self.immediateRetryPolicy;
+  [self.connection addRequest:[[TestGraphRequest alloc] initWithGraphPath:@"me"
+                                                               parameters:@{@"fields" : @"id"}
+                                                                    flags:FBSDKGraphRequestFlagRetryTransientFailures]
+                   completion:^(id<FBSDKGraphRequestConnecting> potentialConnection, id result, NSError *error) {
+                     receivedResult = result;
+                   }];
+  [self.connection start];
+
+  NSHTTPURLResponse *unavailable = [[NSHTTPURLResponse alloc] initWithURL:self.sampleUrl statusCode:503 HTTPVersion:nil headerFields:nil];
+  self.session.capturedCompletion([NSData data], unavailable, nil);
+
+  XCTAssertEqual(self.session.capturedRequests.count, 2, "Should send the request again after a transient failure");
+  XCTAssertEqual(self.connection.retryCount, 1);
+  XCTAssertNil(receivedResult, "Should not complete while retrying");
+
+  NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:self.sampleUrl statusCode:200 HTTPVersion:nil headerFields:nil];
+  self.session.capturedCompletion([@"{\"id\":\"123\"}" dataUsingEncoding:NSUTF8StringEncoding], response, nil);
+
+  XCTAssertEqualObjects(receivedResult, @{@"id" : @"123"});
+}
+
+- (void)testRetryingPostRequestsWithIdempotencyKey
+{
+  self.connection.retryPolicy = self.immediateRetryPolicy;
+  [self.connection addRequest:[[TestGraphRequest alloc] initWithGraphPath:@"activities"
+                                                               parameters:@{@"event" : @"CUSTOM_APP_EVENTS"}
+                                                              tokenString:nil
+                                                               HTTPMethod:FBSDKHTTPMethodPOST
+                                                                    flags:FBSDKGraphRequestFlagRetryTransientFailures]
+                   completion:^(id<FBSDKGraphRequestConnecting> potentialConnection, id result, NSError *error) {}];
+  [self.connection start];
+
+  self.session.capturedCompletion(nil, nil, [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorNetworkConnectionLost userInfo:nil]);
+
+  NSArray<NSURLRequest *> *requests = self.session.capturedRequests;
+  XCTAssertEqual(requests.count, 2);
+  NSString *key = [requests.firstObject valueForHTTPHeaderField:FBSDKIdempotencyKeyHeaderField];
+  XCTAssertNotNil(key, "Should add an idempotency key to retried POST requests");
+  XCTAssertEqualObjects(
+    [requests.lastObject valueForHTTPHeaderField:FBSDKIdempotencyKeyHeaderField],
+    key,
+    "Should send the same idempotency key with every attempt"
+  );
+}
+
+- (void)testRetryingStreamedUpload
+{
+  self.connection.retryPolicy = self.immediateRetryPolicy;
+  NSData *attachment = [NSMutableData dataWithLength:2 * 1024 * 1024];
+  [self.connection addRequest:[[TestGraphRequest alloc] initWithGraphPath:@"me/videos"
+                                                               parameters:@{@"source" : attachment}
+                                                              tokenString:nil
+                                                               HTTPMethod:FBSDKHTTPMethodPOST
+                                                                    flags:FBSDKGraphRequestFlagRetryTransientFailures]
+                   completion:^(id<FBSDKGraphRequestConnecting> potentialConnection, id result, NSError *error) {}];
+  [self.connection start];
+
+  self.session.capturedCompletion(nil, nil, [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorNetworkConnectionLost userInfo:nil]);
+
+  NSArray<NSURLRequest *> *requests = self.session.capturedRequests;
+  XCTAssertEqual(requests.count, 2, "Should send the streamed upload again");
+  XCTAssertNotNil(requests.firstObject.HTTPBodyStream);
+  XCTAssertNotNil(requests.lastObject.HTTPBodyStream);
+  XCTAssertNotEqual(
+    requests.firstObject.HTTPBodyStream,
+    requests.lastObject.HTTPBodyStream,
+    "Should not resend the body stream consumed by the first attempt"
+  );
+}
+
+- (void)testProvidingNewBodyStream
+{
+  NSData *attachment = [NSMutableData dataWithLength:2 * 1024 * 1024];
+  id<FBSDKGraphRequest> request = [[TestGraphRequest alloc] initWithGraphPath:@"me/videos" parameters:@{@"source" : attachment} HTTPMethod:FBSDKHTTPMethodPOST];
+  [self.connection addRequest:request completion:^(id<FBSDKGraphRequestConnecting> potentialConnection, id result, NSError *error) {}];
+  NSURLRequest *urlRequest = [self.connection requestWithBatch:self.connection.requests timeout:0];
+
+  __block NSInputStream *newStream = nil;
+  [(id<NSURLSessionTaskDelegate>)self.connection URLSession:NSURLSession.sharedSession
+                                                       task:[NSURLSession.sharedSession dataTaskWithURL:self.sampleUrl]
+                                          needNewBodyStream:^(NSInputStream *bodyStream) {
+                                            newStream = bodyStream;
+                                          }];
+
+  XCTAssertNotNil(newStream, "Should provide a body stream when the session asks for a new one");
+  XCTAssertNotEqual(newStream, urlRequest.HTTPBodyStream);
+}
+
+- (void)testNotRetryingWithoutFlag
+{
+  __block NSError *receivedError = nil;
+  self.connection.retryPolicy = self.immediateRetryPolicy;
+  [self.connection addRequest:self.requestForMeWithEmptyFields
+                   completion:^(id<FBSDKGraphRequestConnecting> potentialConnection, id result, NSError *error) {
+                     receivedError = error;
+                   }];
+  [self.connection start];
+
+  self.session.capturedCompletion(nil, nil, [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorTimedOut userInfo:nil]);
+
+  XCTAssertEqual(self.session.capturedRequests.count, 1);
+  XCTAssertNil([self.session.capturedRequest valueForHTTPHeaderField:FBSDKIdempotencyKeyHeaderField]);
+  XCTAssertNotNil(receivedError, "Should complete with the transient error");
+}
+
+// MARK: - Circuit Breaker
+
+- (FBSDKGraphRequestCircuitBreaker *)circuitBreakerWithRateLimiter:(FBSDKTokenBucket *)rateLimiter
+{
+  return [[FBSDKGraphRequestCircuitBreaker alloc] initWithFailureThreshold:2
+                                                                  cooldown:30
+                                                               maxCooldown:300
+                                                               rateLimiter:rateLimiter
+                                                        notificationCenter:[NSNotificationCenter new]
+                                                              dateProvider:nil
+                                                     delayedBlockPerformer:^(NSTimeInterval delay, dispatch_block_t block) {}];
+}
+
+- (id<FBSDKGraphRequest>)backgroundRequest
+{
+  return [[TestGraphRequest alloc] initWithGraphPath:@"activities"
+                                          parameters:@{}
+                                               flags:FBSDKGraphRequestFlagBackgroundPriority];
+}
+
+- (void)testRecordingTransientFailures
+{
+  [self.connection addRequest:self.requestForMeWithEmptyFields
+                   completion:^(id<FBSDKGraphRequestConnecting> potentialConnection, id result, NSError *error) {}];
+  [self.connection start];
+  NSHTTPURLResponse *unavailable = [[NSHTTPURLResponse alloc] initWithURL:self.sampleUrl statusCode:503 HTTPVersion:nil headerFields:nil];
+  self.session.capturedCompletion(nil, unavailable, nil);
+
+  XCTAssertEqual(self.connection.circuitBreaker.state, FBSDKCircuitBreakerStateClosed);
+
+  [self.connection.circuitBreaker recordFailure];
+
+  XCTAssertEqual(
+    self.connection.circuitBreaker.state,
+    FBSDKCircuitBreakerStateOpen,
+    "Should count the transient failures of connections towards opening the circuit"
+  );
+}
+
+- (void)testNotRecordingConnectivityFailures
+{
+  [self.connection.circuitBreaker recordFailure];
+  [self.connection addRequest:self.requestForMeWithEmptyFields
+                   completion:^(id<FBSDKGraphRequestConnecting> potentialConnection, id result, NSError *error) {}];
+  [self.connection start];
+  self.session.capturedCompletion(nil, nil, [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorNotConnectedToInternet userInfo:nil]);
+
+  XCTAssertEqual(
+    self.connection.circuitBreaker.state,
+    FBSDKCircuitBreakerStateClosed,
+    "Being offline should not count towards opening the circuit"
+  );
+}
+
+- (void)testRejectingBackgroundRequestsWhileCircuitIsOpen
+{
+  XCTestExpectation *expectation = [[XCTestExpectation alloc] initWithDescription:self.name];
+  [self.connection.circuitBreaker recordFailure];
+  [self.connection.circuitBreaker recordFailure];
+
+  [self.connection addRequest:self.backgroundRequest
+                   completion:^(id<FBSDKGraphRequestConnecting> potentialConnection, id result, NSError *error) {
+                     XCTAssertEqual(error.code, FBSDKErrorNetwork, "Should fail right away while the circuit is open");
+                     [expectation fulfill];
+                   }];
+  [self.connection start];
+
+  XCTAssertNil(self.session.capturedRequest, "Should not send background requests while the circuit is open");
+  [self waitForExpectations:@[expectation] timeout:1];
+}
+
+- (void)testRejectingCircuitBreakerRequestsWhileCircuitIsOpen
+{
+  XCTestExpectation *expectation = [[XCTestExpectation alloc] initWithDescription:self.name];
+  [self.connection.circuitBreaker recordFailure];
+  [self.connection.circuitBreaker recordFailure];
+  TestGraphRequest *request = [[TestGraphRequest alloc] initWithGraphPath:@"gatekeepers"
+                                                               parameters:@{}
+                                                                    flags:FBSDKGraphRequestFlagUsesCircuitBreaker];
+
+  [self.connection addRequest:request
+                   completion:^(id<FBSDKGraphRequestConnecting> potentialConnection, id result, NSError *error) {
+                     XCTAssertEqual(error.code, FBSDKErrorNetwork, "Should fail right away while the circuit is open");
+                     [expectation fulfill];
+                   }];
+  [self.connection start];
+
+  XCTAssertNil(self.session.capturedRequest, "Should admit requests flagged for the circuit breaker through it");
+  [self waitForExpectations:@[expectation] timeout:1];
+}
+
+- (void)testSendingMixedRequestsWhileCircuitIsOpen
+{
+  [self.connection.circuitBreaker recordFailure];
+  [self.connection.circuitBreaker recordFailure];
+  TestGraphRequest *request = [[TestGraphRequest alloc] initWithGraphPath:@"gatekeepers"
+                                                               parameters:@{}
+                                                                    flags:FBSDKGraphRequestFlagUsesCircuitBreaker];
+
+  [self.connection addRequest:request
+                   completion:^(id<FBSDKGraphRequestConnecting> potentialConnection, id result, NSError *error) {}];
+  [self.connection addRequest:self.requestForMeWithEmptyFields
+                   completion:^(id<FBSDKGraphRequestConnecting> potentialConnection, id result, NSError *error) {}];
+  [self.connection start];
+
+  XCTAssertNotNil(self.session.capturedRequest, "Should not hold back a batch that contains a request the user is waiting for");
+}
+
+- (void)testSendingDefaultRequestsWhileCircuitIsOpen
+{
+  [self.connection.circuitBreaker recordFailure];
+  [self.connection.circuitBreaker recordFailure];
+
+  [self.connection addRequest:self.requestForMeWithEmptyFields
+                   completion:^(id<FBSDKGraphRequestConnecting> potentialConnection, id result, NSError *error) {}];
+  [self.connection start];
+
+  XCTAssertNotNil(self.session.capturedRequest, "Should never hold back the requests the user is waiting for");
+}
+
+- (void)testSendingBackgroundRequestsWithCircuitBreakerDisabled
+{
+  self.settings.isGraphRequestCircuitBreakerEnabled = NO;
+  [self.connection.circuitBreaker recordFailure];
+  [self.connection.circuitBreaker recordFailure];
+
+  [self.connection addRequest:self.backgroundRequest
+                   completion:^(id<FBSDKGraphRequestConnecting> potentialConnection, id result, NSError *error) {}];
+  [self.connection start];
+
+  XCTAssertNotNil(self.session.capturedRequest, "Should not use the circuit breaker once it is disabled in the settings");
+}
+
+- (void)testDelayingBackgroundRequestsOverRateLimit
+{
+  __block NSTimeInterval capturedDelay = 0;
+  __block dispatch_block_t capturedBlock = nil;
+  self.connection.circuitBreaker = [[FBSDKGraphRequestCircuitBreaker alloc] initWithFailureThreshold:2
+                                                                                            cooldown:30
+                                                                                         maxCooldown:300
+                                                                                         rateLimiter:[[FBSDKTokenBucket alloc] initWithCapacity:1 tokensPerSecond:1]
+                                                                                  notificationCenter:[NSNotificationCenter new]
+                                                                                        dateProvider:^NSDate * {
+                                                                                          return [NSDate dateWithTimeIntervalSince1970:0];
+                                                                                        }
+                                                                               delayedBlockPerformer:^(NSTimeInterval delay, dispatch_block_t block) {
+                                                                                 capturedDelay = delay;
+                                                                                 capturedBlock = block;
+                                                                               }];
+  [self.connection.circuitBreaker admitRequest:^(BOOL admitted) {}];
+
+  [self.connection addRequest:self.backgroundRequest
+                   completion:^(id<FBSDKGraphRequestConnecting> potentialConnection, id result, NSError *error) {}];
+  [self.connection start];
+
+  XCTAssertNil(self.session.capturedRequest, "Should wait for a token");
+  XCTAssertEqualWithAccuracy(capturedDelay, 1, 0.001);
+
+  capturedBlock();
+
+  XCTAssertNotNil(self.session.capturedRequest, "Should send the request once a token is available");
+}
+
+// MARK: - Metrics
+
+- (void)testUsingDefaultMetricsSink
+{
+  TestGraphRequestConnectionMetricsSink *sink = [TestGraphRequestConnectionMetricsSink new];
+  FBSDKGraphRequestConnection.metricsSink = sink;
+
+  XCTAssertEqual([FBSDKGraphRequestConnection new].metricsSink, sink, "Connections should use the sink set when they are created");
+
+  FBSDKGraphRequestConnection.metricsSink = nil;
+}
+
+- (void)testRecordingMetrics
+{
+  TestGraphRequestConnectionMetricsSink *sink = [TestGraphRequestConnectionMetricsSink new];
+  self.connection.metricsSink = sink;
+  TestGraphRequestPiggybackManager.stubbedPiggybackRequests = @[[[TestGraphRequest alloc] initWithGraphPath:@"app"
+                                                                                                parameters:@{@"fields" : @"id"}
+                                                                                                     flags:FBSDKGraphRequestFlagNone]];
+  [self.connection addRequest:self.requestForMeWithEmptyFields
+                   completion:^(id<FBSDKGraphRequestConnecting> potentialConnection, id result, NSError *error) {}];
+  [self.connection start];
+
+  NSData *data = [@"[{\"code\":200,\"body\":\"{\\\"id\\\":\\\"1\\\"}\"},{\"code\":200,\"body\":\"{\\\"id\\\":\\\"2\\\"}\"}]"
+                  dataUsingEncoding:NSUTF8StringEncoding];
+  NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:self.sampleUrl statusCode:200 HTTPVersion:nil headerFields:nil];
+  self.session.capturedCompletion(data, response, nil);
+
+  XCTAssertEqual(sink.capturedMetrics.count, 1, "Should record one metrics record per connection");
+  FBSDKGraphRequestConnectionMetrics *metrics = sink.capturedMetrics.firstObject;
+  XCTAssertEqual(metrics.batchSize, 2);
+  XCTAssertEqual(metrics.piggybackedRequestCount, 1);
+  XCTAssertEqual(metrics.retryCount, 0);
+  XCTAssertEqual(metrics.statusCode, 200);
+  XCTAssertNil(metrics.error);
+  XCTAssertFalse(metrics.isServedFromResponseCache);
+  XCTAssertEqual(metrics.encodedRequestBodyBytes, self.session.capturedRequest.HTTPBody.length, "Should record the size of the body as sent");
+  XCTAssertGreaterThan(metrics.requestBodyBytes, 0, "Should record the size of the body before compression");
+  XCTAssertEqual(metrics.responseBodyBytes, data.length);
+  XCTAssertEqual(metrics.encodedResponseBodyBytes, 0, "Should not guess the size of the body as received without task metrics");
+}
+
+- (void)testRecordingRetriesAndErrorsInMetrics
+{
+  TestGraphRequestConnectionMetricsSink *sink = [TestGraphRequestConnectionMetricsSink new];
+  self.connection.metricsSink = sink;
+  self.connection.retryPolicy = self.immediateRetryPolicy;
+  [self.connection addRequest:[[TestGraphRequest alloc] initWithGraphPath:@"me"
+                                                               parameters:@{@"fields" : @"id"}
+                                                                    flags:FBSDKGraphRequestFlagRetryTransientFailures]
+                   completion:^(id<FBSDKGraphRequestConnecting> potentialConnection, id result, NSError *error) {}];
+  [self.connection start];
+
+  self.session.capturedCompletion(nil, nil, [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorTimedOut userInfo:nil]);
+
+  XCTAssertEqual(sink.capturedMetrics.count, 0, "Should not record metrics while retrying");
+
+  self.session.capturedCompletion(nil, nil, [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorBadURL userInfo:nil]);
+
+  FBSDKGraphRequestConnectionMetrics *metrics = sink.capturedMetrics.firstObject;
+  XCTAssertEqual(sink.capturedMetrics.count, 1);
+  XCTAssertEqual(metrics.retryCount, 1);
+  XCTAssertEqual(metrics.statusCode, 0);
+  XCTAssertNotNil(metrics.error, "Should record the error the connection failed with");
+}
+
 - (void)testConnectionDelegate
 {
   XCTestExpectation *expectation = [self expectationWithDescription:self.name];
@@ -1241,6 +1743,19 @@
   XCTAssertEqualObjects([request valueForHTTPHeaderField:@"Content-Type"], @"application/json");
 }
 
+- (void)testRequestWithBatchConstructionWithLargeAttachment
+{
+  NSData *attachment = [NSMutableData dataWithLength:2 * 1024 * 1024];
+  id<FBSDKGraphRequest> singleRequest = [[TestGraphRequest alloc] initWithGraphPath:@"me/videos" parameters:@{@"source" : attachment} HTTPMethod:FBSDKHTTPMethodPOST];
+  [self.connection addRequest:singleRequest completion:^(id<FBSDKGraphRequestConnecting> potentialConnection, id result, NSError *error) {}];
+  NSURLRequest *request = [self.connection requestWithBatch:self.connection.requests timeout:0];
+
+  XCTAssertNil(request.HTTPBody, "Should not build large multipart bodies in memory");
+  XCTAssertNotNil(request.HTTPBodyStream);
+  XCTAssertGreaterThan([request valueForHTTPHeaderField:@"Content-Length"].longLongValue, (long long)attachment.length);
+  XCTAssertTrue([[request valueForHTTPHeaderField:@"Content-Type"] hasPrefix:@"multipart/form-data"]);
+}
+
 #pragma mark - accessTokenWithRequest
 
 - (void)testAccessTokenWithRequest
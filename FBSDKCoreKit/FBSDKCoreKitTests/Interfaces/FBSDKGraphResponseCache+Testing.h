@@ -0,0 +1,19 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import "FBSDKGraphResponseCache.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface FBSDKGraphResponseCache (Testing)
+
+- (void)_accessTokenDidChange:(NSNotification *)notification;
+
+@end
+
+NS_ASSUME_NONNULL_END
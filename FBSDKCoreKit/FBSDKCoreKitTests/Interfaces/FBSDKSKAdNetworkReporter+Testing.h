@@ -24,6 +24,8 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic) NSDate *timestamp;
 @property (nonnull, nonatomic) NSMutableSet<NSString *> *recordedEvents;
 @property (nonnull, nonatomic) NSMutableDictionary<NSString *, id> *recordedValues;
+@property (nonatomic) NSTimeInterval reportDataSaveInterval;
+@property (nonatomic) BOOL isReportDataSaveScheduled;
 
 @property (nonnull, nonatomic, readonly) id<FBSDKGraphRequestFactory> graphRequestFactory;
 @property (nonnull, nonatomic, readonly) id<FBSDKDataPersisting> store;
@@ -35,6 +37,7 @@ NS_ASSUME_NONNULL_BEGIN
                      currency:(nullable NSString *)currency
                         value:(nullable NSNumber *)value;
 - (void)_updateConversionValue:(NSInteger)value;
+- (void)applicationDidEnterBackground:(nullable UIApplication *)application;
 
 - (void)setSKAdNetworkReportEnabled:(BOOL)enabled;
 
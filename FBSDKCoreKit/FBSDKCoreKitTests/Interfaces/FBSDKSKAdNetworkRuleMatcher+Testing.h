@@ -0,0 +1,20 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import "FBSDKSKAdNetworkRuleMatcher.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface FBSDKSKAdNetworkRuleMatcher (Testing)
+
+/// The rules compared with recorded events, by every matcher
+@property (class, nonatomic, assign) NSUInteger evaluatedRuleCount;
+
+@end
+
+NS_ASSUME_NONNULL_END
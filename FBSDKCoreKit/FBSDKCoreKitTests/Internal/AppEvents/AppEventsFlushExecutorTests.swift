@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+import XCTest
+
+class AppEventsFlushExecutorTests: XCTestCase {
+
+  let executor = AppEventsFlushExecutor(logger: TestLogger.self)
+
+  override func setUp() {
+    super.setUp()
+
+    TestLogger.reset()
+  }
+
+  override func tearDown() {
+    TestLogger.reset()
+
+    super.tearDown()
+  }
+
+  func testExecutingWork() {
+    var didExecute = false
+    executor.execute {
+      didExecute = true
+    }
+
+    XCTAssertTrue(didExecute, "Should execute the flush work")
+  }
+
+  func testMeasuringMainThreadWorkRunsBlock() {
+    let flush = executor.beginFlush()
+    var didExecute = false
+    executor.measureMainThreadWork({ didExecute = true }, forFlush: flush)
+
+    XCTAssertTrue(didExecute, "Should run the measured block")
+  }
+
+  func testFinishingFlushPublishesMainThreadTime() {
+    let flush = executor.beginFlush()
+    executor.measureMainThreadWork({ usleep(2000) }, forFlush: flush)
+    executor.finishFlush(flush)
+
+    XCTAssertGreaterThan(
+      executor.lastFlushMainThreadTime,
+      0,
+      "Should record the main thread time spent by the flush"
+    )
+    XCTAssertEqual(TestLogger.capturedLoggingBehavior, .performanceCharacteristics)
+    XCTAssertTrue(
+      TestLogger.capturedLogEntry?.contains("main thread time") == true,
+      "Should publish the main thread time of the flush"
+    )
+  }
+
+  func testFinishingUnknownFlush() {
+    executor.finishFlush(100)
+
+    XCTAssertNil(TestLogger.capturedLogEntry, "Should not publish metrics for a flush that was never started")
+  }
+
+  func testFinishingFlushOnlyOnce() {
+    let flush = executor.beginFlush()
+    executor.finishFlush(flush)
+    TestLogger.reset()
+    executor.finishFlush(flush)
+
+    XCTAssertNil(TestLogger.capturedLogEntry, "Should only publish metrics once per flush")
+  }
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+import XCTest
+
+class AppEventsFlushPolicyTests: XCTestCase {
+
+  let start = Date()
+  lazy var policy = AppEventsFlushPolicy(baseInterval: 15, eventThreshold: 100, coalescingWindow: 1)
+
+  func testDefaults() {
+    XCTAssertEqual(policy.currentInterval, 15, "Should start with the base interval")
+    XCTAssertEqual(policy.currentEventThreshold, 100, "Should start with the base event threshold")
+    XCTAssertEqual(policy.consecutiveFailureCount, 0)
+    XCTAssertEqual(policy.pendingPayloadBytes, 0)
+  }
+
+  func testFlushingOnEventThreshold() {
+    XCTAssertFalse(policy.shouldFlush(withPendingEventCount: 100))
+    XCTAssertTrue(policy.shouldFlush(withPendingEventCount: 101))
+  }
+
+  func testFlushingOnPayloadSize() {
+    policy.recordEvent(withEstimatedBytes: 64 * 1024, date: start)
+
+    XCTAssertTrue(
+      policy.shouldFlush(withPendingEventCount: 1),
+      "Should flush when the pending payload is large regardless of the event count"
+    )
+  }
+
+  func testRecordingFlushResetsPendingPayload() {
+    policy.recordEvent(withEstimatedBytes: 1000, date: start)
+    policy.recordFlush(at: start)
+
+    XCTAssertEqual(policy.pendingPayloadBytes, 0)
+  }
+
+  func testBackingOffAfterConnectivityFailures() {
+    policy.recordFlushResult(.noConnectivity)
+    XCTAssertEqual(policy.currentInterval, 30)
+
+    policy.recordFlushResult(.noConnectivity)
+    XCTAssertEqual(policy.currentInterval, 60)
+
+    for _ in 0 ..< 20 {
+      policy.recordFlushResult(.noConnectivity)
+    }
+    XCTAssertEqual(policy.currentInterval, 600, "Should cap the back off")
+  }
+
+  func testBackOffRaisesEventThreshold() {
+    policy.recordFlushResult(.noConnectivity)
+    policy.recordEvent(withEstimatedBytes: 64 * 1024, date: start)
+
+    XCTAssertFalse(
+      policy.shouldFlush(withPendingEventCount: 500),
+      "Should not flush on size or count while backing off"
+    )
+    XCTAssertTrue(policy.shouldFlush(withPendingEventCount: 901))
+  }
+
+  func testSuccessResetsBackOff() {
+    policy.recordFlushResult(.noConnectivity)
+    policy.recordFlushResult(.success)
+
+    XCTAssertEqual(policy.consecutiveFailureCount, 0)
+    XCTAssertEqual(policy.currentInterval, 15)
+  }
+
+  func testStretchingIntervalForRareEvents() {
+    policy.recordEvent(withEstimatedBytes: 10, date: start)
+    policy.recordEvent(withEstimatedBytes: 10, date: start.addingTimeInterval(40))
+
+    XCTAssertEqual(policy.currentInterval, 40, accuracy: 0.001, "Should wait longer when events are rare")
+
+    policy.applicationState = .background
+    XCTAssertEqual(policy.currentInterval, 15, accuracy: 0.001, "Should not stretch the interval in the background")
+  }
+
+  func testGrowingThresholdForFrequentEvents() {
+    for index in 0 ..< 10 {
+      policy.recordEvent(withEstimatedBytes: 10, date: start.addingTimeInterval(Double(index) * 0.05))
+    }
+
+    XCTAssertEqual(
+      Double(policy.currentEventThreshold),
+      300,
+      accuracy: 1,
+      "Should grow the batch to about one interval worth of events"
+    )
+  }
+
+  func testTimerFlushes() {
+    policy.recordFlush(at: start)
+
+    XCTAssertFalse(policy.shouldFlushOnTimer(withPendingEventCount: 0, date: start.addingTimeInterval(15)))
+    XCTAssertFalse(policy.shouldFlushOnTimer(withPendingEventCount: 1, date: start.addingTimeInterval(5)))
+    XCTAssertTrue(policy.shouldFlushOnTimer(withPendingEventCount: 1, date: start.addingTimeInterval(15)))
+  }
+
+  func testPausing() {
+    policy.recordFlush(at: start)
+    policy.isPaused = true
+
+    XCTAssertFalse(policy.shouldFlush(withPendingEventCount: 101), "Should not flush on event count while paused")
+    XCTAssertFalse(
+      policy.shouldFlushOnTimer(withPendingEventCount: 1, date: start.addingTimeInterval(15)),
+      "Should not flush on timer while paused"
+    )
+
+    policy.isPaused = false
+
+    XCTAssertTrue(policy.shouldFlushOnTimer(withPendingEventCount: 1, date: start.addingTimeInterval(15)))
+  }
+
+  func testCoalescingEagerFlushes() {
+    XCTAssertTrue(policy.shouldPerformEagerFlush(at: start), "Should perform the first eager flush")
+    XCTAssertFalse(policy.shouldPerformEagerFlush(at: start.addingTimeInterval(0.2)))
+    XCTAssertEqual(policy.eagerFlushDelay(at: start.addingTimeInterval(0.2)), 0.8, accuracy: 0.001)
+    XCTAssertLessThan(
+      policy.eagerFlushDelay(at: start.addingTimeInterval(0.3)),
+      0,
+      "Should only schedule one trailing flush"
+    )
+    XCTAssertTrue(policy.shouldPerformEagerFlush(at: start.addingTimeInterval(2)))
+  }
+
+  func testEstimatingEventBytes() {
+    let bytes = AppEventsFlushPolicy.estimatedBytes(forEvent: ["_eventName": "fb_mobile_purchase", "value": 1])
+
+    XCTAssertGreaterThan(bytes, "_eventName".count + "fb_mobile_purchase".count)
+  }
+}
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+import XCTest
+
+class AppEventsParameterPipelineTests: XCTestCase {
+
+  class InPlaceParameterProcessor: NSObject, AppEventsParameterProcessing {
+    var keysToRemove = [String]()
+    var processParametersCallCount = 0
+    var processParametersInPlaceCallCount = 0
+
+    func enable() {}
+
+    func processParameters(_ parameters: [String: Any]?, eventName: String) -> [String: Any]? {
+      processParametersCallCount += 1
+      return parameters
+    }
+
+    func processParameters(inPlace parameters: NSMutableDictionary, eventName: String) {
+      processParametersInPlaceCallCount += 1
+      parameters.removeObjects(forKeys: keysToRemove)
+    }
+  }
+
+  let eventName = "fb_mobile_purchase"
+  let inPlaceProcessor = InPlaceParameterProcessor()
+  let copyingProcessor = TestAppEventsParameterProcessor()
+
+  func eventDictionary(
+    parameters: [String: Any]?,
+    stages: [AppEventsParameterProcessing] = []
+  ) -> NSMutableDictionary? {
+    AppEventsParameterPipeline.eventDictionary(
+      forEventName: eventName,
+      parameters: parameters,
+      stages: stages,
+      reservedCapacity: 6
+    )
+  }
+
+  func testValidParameters() {
+    let parameters: [String: Any] = ["fb_currency": "USD", "fb_num_items": 3]
+
+    XCTAssertEqual(
+      eventDictionary(parameters: parameters) as? [String: AnyHashable],
+      ["fb_currency": "USD", "fb_num_items": 3],
+      "Valid parameters should be copied into the event dictionary"
+    )
+  }
+
+  func testMissingParameters() {
+    XCTAssertEqual(
+      eventDictionary(parameters: nil)?.count,
+      0,
+      "Missing parameters should give an empty event dictionary"
+    )
+  }
+
+  func testInvalidEventName() {
+    let result = AppEventsParameterPipeline.eventDictionary(
+      forEventName: "$invalid",
+      parameters: nil,
+      stages: [inPlaceProcessor],
+      reservedCapacity: 0
+    )
+
+    XCTAssertNil(result, "An invalid event name should drop the event")
+    XCTAssertEqual(inPlaceProcessor.processParametersInPlaceCallCount, 0, "Stages should not run for invalid events")
+  }
+
+  func testInvalidParameterKey() {
+    XCTAssertNil(
+      eventDictionary(parameters: ["$invalid": "value"], stages: [inPlaceProcessor]),
+      "An invalid parameter key should drop the event"
+    )
+    XCTAssertEqual(inPlaceProcessor.processParametersInPlaceCallCount, 0)
+  }
+
+  func testInvalidParameterValue() {
+    XCTAssertNil(
+      eventDictionary(parameters: ["key": Date()]),
+      "A parameter value that is neither a string nor a number should drop the event"
+    )
+  }
+
+  func testRunningStagesInPlace() {
+    inPlaceProcessor.keysToRemove = ["removed"]
+
+    let result = eventDictionary(parameters: ["kept": "1", "removed": "2"], stages: [inPlaceProcessor])
+
+    XCTAssertEqual(result as? [String: String], ["kept": "1"])
+    XCTAssertEqual(inPlaceProcessor.processParametersInPlaceCallCount, 1, "Should prefer processing in place")
+    XCTAssertEqual(inPlaceProcessor.processParametersCallCount, 0, "Should not copy the parameters for in place stages")
+  }
+
+  func testRunningCopyingStages() {
+    let result = eventDictionary(parameters: ["kept": "1"], stages: [copyingProcessor, inPlaceProcessor])
+
+    XCTAssertEqual(copyingProcessor.capturedEventName, eventName)
+    XCTAssertEqual(copyingProcessor.capturedParameters as? [String: String], ["kept": "1"])
+    XCTAssertEqual(result as? [String: String], ["kept": "1"], "Should keep the result of stages that do not process in place")
+    XCTAssertEqual(inPlaceProcessor.processParametersInPlaceCallCount, 1, "Should run every stage")
+  }
+
+  // MARK: - Benchmarks
+
+  func testPerformanceWith5Parameters() {
+    measurePipeline(parameterCount: 5)
+  }
+
+  func testPerformanceWith20Parameters() {
+    measurePipeline(parameterCount: 20)
+  }
+
+  func testPerformanceWith50Parameters() {
+    measurePipeline(parameterCount: 50)
+  }
+
+  func measurePipeline(parameterCount: Int) {
+    guard #available(iOS 13.0, tvOS 13.0, *) else { return }
+
+    var parameters = [String: Any]()
+    for index in 0 ..< parameterCount {
+      parameters["param_\(index)"] = index.isMultiple(of: 2) ? "value_\(index)" : index
+    }
+    inPlaceProcessor.keysToRemove = ["param_0", "param_1"]
+    let stages = [inPlaceProcessor, InPlaceParameterProcessor(), InPlaceParameterProcessor()]
+
+    // CPU time and instructions per iteration of 1,000 events; the memory metric reflects the allocations.
+    measure(metrics: [XCTCPUMetric(), XCTMemoryMetric()]) {
+      for _ in 0 ..< 1000 {
+        _ = eventDictionary(parameters: parameters, stages: stages)
+      }
+    }
+  }
+}
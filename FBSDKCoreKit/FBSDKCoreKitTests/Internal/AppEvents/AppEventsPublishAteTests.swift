@@ -55,6 +55,7 @@ class AppEventsPublishAteTests: XCTestCase {
       appEventsConfigurationProvider: TestAppEventsConfigurationProvider.self,
       serverConfigurationProvider: TestServerConfigurationProvider(),
       graphRequestFactory: TestGraphRequestFactory(),
+      graphRequestConnectionFactory: TestGraphRequestConnectionFactory(),
       featureChecker: TestFeatureManager(),
       store: UserDefaultsSpy(),
       logger: TestLogger.self,
@@ -173,7 +173,7 @@ class CodelessIndexerTests: XCTestCase { // swiftlint:disable:this type_body_len
     )
     XCTAssertEqual(
       graphRequestFactory.capturedFlags,
-      [.skipClientToken, .disableErrorRecovery],
+      [.skipClientToken, .disableErrorRecovery, .useResponseCache],
       "Should create a request with the expected flags"
     )
   }
@@ -494,7 +494,7 @@ class CodelessIndexerTests: XCTestCase { // swiftlint:disable:this type_body_len
     )
     XCTAssertEqual(
       graphRequestFactory.capturedFlags,
-      [],
+      .backgroundPriority,
       "Should create a request with the expected flags"
     )
   }
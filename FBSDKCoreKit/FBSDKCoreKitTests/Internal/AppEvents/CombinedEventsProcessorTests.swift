@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+import XCTest
+
+class CombinedEventsProcessorTests: XCTestCase {
+
+  let rawConfiguration = [
+    "restrictiveParams": [
+      "deprecated_event": [
+        "is_deprecated_event": true
+      ],
+      "restricted_event": [
+        "process_event_name": true
+      ]
+    ]
+  ]
+  lazy var serverConfiguration = ServerConfigurationFixtures.config(withDictionary: rawConfiguration)
+  lazy var provider = TestServerConfigurationProvider(configuration: serverConfiguration)
+  lazy var eventDeactivationManager = EventDeactivationManager(serverConfigurationProvider: provider)
+  lazy var restrictiveDataFilterManager = RestrictiveDataFilterManager(serverConfigurationProvider: provider)
+  lazy var processor = CombinedEventsProcessor(
+    eventDeactivationManager: eventDeactivationManager,
+    restrictiveDataFilterManager: restrictiveDataFilterManager
+  )
+
+  func event(named name: String) -> [String: Any] {
+    [
+      "event": NSMutableDictionary(dictionary: ["_eventName": name]),
+      "isImplicit": false
+    ]
+  }
+
+  func eventNames(_ events: NSMutableArray) -> [String?] {
+    events.map { (($0 as? [String: Any])?["event"] as? NSDictionary)?["_eventName"] as? String }
+  }
+
+  func testProcessingEventsBeforeEnabling() {
+    let events = NSMutableArray(array: [event(named: "deprecated_event"), event(named: "restricted_event")])
+
+    processor.processEvents(events)
+
+    XCTAssertEqual(
+      eventNames(events),
+      ["deprecated_event", "restricted_event"],
+      "Events should not be processed until the managers are enabled"
+    )
+  }
+
+  func testProcessingEventsInOneSweep() {
+    eventDeactivationManager.enable()
+    restrictiveDataFilterManager.enable()
+    let events = NSMutableArray(array: [
+      event(named: "deprecated_event"),
+      event(named: "some_event"),
+      event(named: "deprecated_event"),
+      event(named: "restricted_event"),
+      event(named: "deprecated_event"),
+      event(named: "other_event"),
+    ])
+
+    processor.processEvents(events)
+
+    XCTAssertEqual(
+      eventNames(events),
+      ["some_event", "_removed_", "other_event"],
+      "Deactivated events should be dropped and restricted event names replaced, preserving the order"
+    )
+  }
+
+  func testProcessingEventsWithMissingKeys() {
+    eventDeactivationManager.enable()
+    restrictiveDataFilterManager.enable()
+    let events = NSMutableArray(array: [["some_event": [:]], event(named: "deprecated_event")])
+
+    XCTAssertNoThrow(processor.processEvents(events))
+    XCTAssertEqual(events.count, 1, "Events with missing keys should be kept")
+  }
+}
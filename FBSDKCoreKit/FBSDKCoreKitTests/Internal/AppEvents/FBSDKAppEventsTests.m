@@ -18,6 +18,7 @@
 #import "FBSDKAppEvents+SourceApplicationTracking.h"
 #import "FBSDKAppEventsConfigurationProviding.h"
 #import "FBSDKAppEventsState.h"
+#import "FBSDKAppEventsFlushPolicy.h"
 #import "FBSDKAppEventsUtility.h"
 #import "FBSDKApplicationDelegate.h"
 #import "FBSDKConstants.h"
@@ -36,6 +37,7 @@
 @interface FBSDKAppEvents (Testing)
 @property (nonatomic, copy) NSString *pushNotificationsDeviceTokenString;
 @property (nullable, nonatomic) Class<FBSDKSwizzling> swizzler;
+@property (nonatomic, strong) FBSDKAppEventsFlushPolicy *flushPolicy;
 
 - (instancetype)initWithFlushBehavior:(FBSDKAppEventsFlushBehavior)flushBehavior
                  flushPeriodInSeconds:(int)flushPeriodInSeconds;
@@ -49,6 +51,7 @@
       isImplicitlyLogged:(BOOL)isImplicitlyLogged
              accessToken:(FBSDKAccessToken *)accessToken;
 - (void)applicationDidBecomeActive;
+- (void)checkPersistedEvents;
 - (void)applicationMovingFromActiveStateOrTerminating;
 - (void)setFlushBehavior:(FBSDKAppEventsFlushBehavior)flushBehavior;
 - (void)publishATE;
@@ -103,6 +106,7 @@
 @property (nonnull, nonatomic) TestTimeSpentRecorder *timeSpentRecorder;
 @property (nonnull, nonatomic) TestAppEventsParameterProcessor *integrityParametersProcessor;
 @property (nonnull, nonatomic) TestGraphRequestFactory *graphRequestFactory;
+@property (nonnull, nonatomic) TestGraphRequestConnectionFactory *graphRequestConnectionFactory;
 @property (nonnull, nonatomic) UserDefaultsSpy *store;
 @property (nonnull, nonatomic) TestFeatureManager *featureManager;
 @property (nonnull, nonatomic) TestSettings *settings;
@@ -154,6 +158,7 @@
   self.purchaseAmount = 1.0;
   self.currency = @"USD";
   self.graphRequestFactory = [TestGraphRequestFactory new];
+  self.graphRequestConnectionFactory = [TestGraphRequestConnectionFactory new];
   self.store = [UserDefaultsSpy new];
   self.featureManager = [TestFeatureManager new];
   self.paymentObserver = [TestPaymentObserver new];
@@ -203,6 +208,7 @@
                          appEventsConfigurationProvider:TestAppEventsConfigurationProvider.class
                             serverConfigurationProvider:self.serverConfigurationProvider
                                     graphRequestFactory:self.graphRequestFactory
+                          graphRequestConnectionFactory:self.graphRequestConnectionFactory
                                          featureChecker:self.featureManager
                                                   store:self.store
                                                  logger:TestLogger.class
@@ -741,6 +747,63 @@
   XCTAssertEqual(FBSDKAppEventsFlushBehaviorExplicitOnly, FBSDKAppEvents.flushBehavior);
 }
 
+- (void)testFlushingIncompatiblePersistedStatesInOneBatch
+{
+  self.settings.appID = self.mockAppID;
+  [FBSDKAppEvents.shared setFlushBehavior:FBSDKAppEventsFlushBehaviorAuto];
+  TestGraphRequestConnection *connection = [TestGraphRequestConnection new];
+  self.graphRequestConnectionFactory.stubbedConnection = connection;
+
+  FBSDKAppEventsState *first = [[FBSDKAppEventsState alloc] initWithToken:@"token1" appID:self.mockAppID];
+  [first addEvent:@{@"_eventName" : @"event1"} isImplicit:NO];
+  FBSDKAppEventsState *second = [[FBSDKAppEventsState alloc] initWithToken:@"token2" appID:self.mockAppID];
+  [second addEvent:@{@"_eventName" : @"event2"} isImplicit:NO];
+  self.appEventsStateStore.persistedStatesToBeRetrieved = @[first, second];
+
+  [FBSDKAppEvents.shared checkPersistedEvents];
+  TestAppEventsConfigurationProvider.capturedBlock();
+  self.serverConfigurationProvider.capturedCompletionBlock(nil, nil);
+
+  XCTAssertEqual(connection.capturedRequests.count, 2, "Should add one activities request per state to the batch");
+  XCTAssertEqual(connection.startCallCount, 1, "Should send all states in a single connection");
+  XCTAssertEqualObjects(connection.capturedRequests.firstObject.tokenString, @"token1");
+  XCTAssertEqualObjects(connection.capturedRequests.lastObject.tokenString, @"token2");
+  XCTAssertEqual(
+    self.graphRequestFactory.capturedRequests.count,
+    2,
+    "Should create the requests with the graph request factory"
+  );
+}
+
+- (void)testFailedBatchCountsAsOneFailedFlush
+{
+  self.settings.appID = self.mockAppID;
+  [FBSDKAppEvents.shared setFlushBehavior:FBSDKAppEventsFlushBehaviorAuto];
+  TestGraphRequestConnection *connection = [TestGraphRequestConnection new];
+  self.graphRequestConnectionFactory.stubbedConnection = connection;
+
+  FBSDKAppEventsState *first = [[FBSDKAppEventsState alloc] initWithToken:@"token1" appID:self.mockAppID];
+  [first addEvent:@{@"_eventName" : @"event1"} isImplicit:NO];
+  FBSDKAppEventsState *second = [[FBSDKAppEventsState alloc] initWithToken:@"token2" appID:self.mockAppID];
+  [second addEvent:@{@"_eventName" : @"event2"} isImplicit:NO];
+  self.appEventsStateStore.persistedStatesToBeRetrieved = @[first, second];
+
+  [FBSDKAppEvents.shared checkPersistedEvents];
+  TestAppEventsConfigurationProvider.capturedBlock();
+  self.serverConfigurationProvider.capturedCompletionBlock(nil, nil);
+
+  NSError *error = [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorNotConnectedToInternet userInfo:nil];
+  for (FBSDKGraphRequestCompletion completion in connection.capturedCompletions) {
+    completion(connection, nil, error);
+  }
+
+  XCTAssertEqual(
+    FBSDKAppEvents.shared.flushPolicy.consecutiveFailureCount,
+    1,
+    "A failed batch should count as a single failed flush"
+  );
+}
+
 - (void)testCheckPersistedEventsCalledWhenLogEvent
 {
   [FBSDKAppEvents logEvent:FBSDKAppEventNamePurchased valueToSum:@(self.purchaseAmount) parameters:@{} accessToken:nil];
@@ -1043,6 +1106,22 @@
   );
 }
 
+- (void)testFetchServerConfigurationCallsBackOnMainThread
+{
+  XCTestExpectation *expectation = [self expectationWithDescription:@"callback"];
+  [[FBSDKAppEvents shared] fetchServerConfiguration:^void (void) {
+    XCTAssertTrue(NSThread.isMainThread, "Should call back on the main thread");
+    [expectation fulfill];
+  }];
+  TestAppEventsConfigurationProvider.capturedBlock();
+  FBSDKServerConfigurationBlock completion = self.serverConfigurationProvider.capturedCompletionBlock;
+  dispatch_async(dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+    completion(nil, nil);
+  });
+
+  [self waitForExpectationsWithTimeout:1 handler:nil];
+}
+
 - (void)testFetchingConfigurationIncludingCertainFeatures
 {
   [[FBSDKAppEvents shared] fetchServerConfiguration:nil];
@@ -88,6 +88,7 @@ static NSString *const FBSDKSettingsAdvertisingTrackingStatus = @"com.facebook.s
                          appEventsConfigurationProvider:TestAppEventsConfigurationProvider.self
                             serverConfigurationProvider:TestServerConfigurationProvider.self
                                     graphRequestFactory:[TestGraphRequestFactory new]
+                          graphRequestConnectionFactory:[TestGraphRequestConnectionFactory new]
                                          featureChecker:[TestFeatureManager new]
                                                   store:self.userDefaultsSpy
                                                  logger:TestLogger.class
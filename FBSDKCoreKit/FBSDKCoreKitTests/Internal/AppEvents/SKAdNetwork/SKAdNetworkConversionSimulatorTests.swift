@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+import XCTest
+
+#if !os(tvOS)
+
+class SKAdNetworkConversionSimulatorTests: XCTestCase {
+
+  let configurationJSON = """
+  {
+    "data": [
+      {
+        "timer_buckets": 1,
+        "timer_interval": 1000,
+        "cutoff_time": 1,
+        "default_currency": "USD",
+        "conversion_value_rules": [
+          {
+            "conversion_value": 3,
+            "events": [
+              {"event_name": "fb_mobile_purchase", "values": [{"currency": "USD", "amount": 100}]},
+              {"event_name": "Donate"}
+            ]
+          },
+          {
+            "conversion_value": 2,
+            "events": [{"event_name": "fb_mobile_purchase", "values": [{"currency": "USD", "amount": 10}]}]
+          },
+          {
+            "conversion_value": 1,
+            "events": [{"event_name": "fb_mobile_complete_registration"}]
+          }
+        ]
+      }
+    ]
+  }
+  """
+  let eventsJSON = """
+  [
+    {"event_name": "fb_mobile_complete_registration"},
+    {"event_name": "fb_mobile_purchase", "currency": "usd", "value": 5},
+    {"event_name": "fb_mobile_purchase", "currency": "USD", "value": 20},
+    {"event_name": "fb_mobile_search"},
+    {"event_name": "custom_event"},
+    {"event_name": "Donate"},
+    {"event_name": "fb_mobile_purchase", "currency": "USD", "value": 200}
+  ]
+  """
+  lazy var simulator = SKAdNetworkConversionSimulator(configurationJSON: configurationJSON)
+
+  override func tearDown() {
+    TestConversionValueUpdating.reset()
+
+    super.tearDown()
+  }
+
+  func testReplayingEventStream() throws {
+    guard #available(iOS 14.0, *) else { return }
+
+    let simulator = try XCTUnwrap(self.simulator)
+    let events = SKAdNetworkConversionSimulator.events(fromJSON: eventsJSON)
+
+    let report = simulator.run(events: events)
+
+    XCTAssertEqual(events.count, 7, "Should decode every event of the stream")
+    XCTAssertEqual(report.conversionValue, 3, "Should report the final conversion value")
+    XCTAssertEqual(
+      report.ruleEvaluations,
+      [3, 2, 2, 1, 0, 1, 1],
+      "Should report the rules the matcher evaluated for each event"
+    )
+    XCTAssertEqual(
+      report.userDefaultsWrites,
+      [2, 1, 2, 1, 0, 1, 2],
+      "Should report the user defaults writes of each event"
+    )
+    XCTAssertGreaterThan(report.bytesWritten, 0, "Should report the bytes written to the user defaults")
+    XCTAssertEqual(report.latencies.count, events.count, "Should report the latency of each event")
+  }
+
+  func testReplayingUnreportedEvents() throws {
+    let simulator = try XCTUnwrap(self.simulator)
+    let events = SKAdNetworkConversionSimulator.events(fromJSON: #"[{"event_name": "custom_event"}]"#)
+
+    let report = simulator.run(events: events)
+
+    XCTAssertEqual(report.totalRuleEvaluations, 0, "Should not evaluate rules for events the rules do not use")
+    XCTAssertEqual(report.totalUserDefaultsWrites, 0, "Should not write report data for events the rules do not use")
+    XCTAssertNil(report.conversionValue, "Should not update the conversion value")
+  }
+
+  // MARK: - Benchmarks
+
+  func testPerformanceReplayingEventStream() throws {
+    guard #available(iOS 14.0, *) else { return }
+
+    let simulator = try XCTUnwrap(self.simulator)
+    let stream = SKAdNetworkConversionSimulator.events(fromJSON: eventsJSON)
+    let events = (0 ..< 200).flatMap { _ in stream }
+
+    let metric = SKAdNetworkReplayMetric()
+    measure(metrics: [XCTClockMetric(), XCTCPUMetric(), metric]) {
+      metric.report = simulator.run(events: events)
+    }
+  }
+}
+
+/// Reports the rule evaluations, latency and user defaults writes per event of the replay in a measured block.
+@available(iOS 13.0, *)
+final class SKAdNetworkReplayMetric: NSObject, XCTMetric {
+  var report = SKAdNetworkConversionSimulator.Report()
+
+  func copy(with zone: NSZone? = nil) -> Any {
+    self
+  }
+
+  func reportMeasurements(
+    from startTime: XCTPerformanceMeasurementTimestamp,
+    to endTime: XCTPerformanceMeasurementTimestamp
+  ) throws -> [XCTPerformanceMeasurement] {
+    let eventCount = Double(max(report.latencies.count, 1))
+    let latencies = report.latencies.sorted()
+    return [
+      XCTPerformanceMeasurement(
+        identifier: "com.facebook.sdk.skadnetwork.rule_evaluations",
+        displayName: "Rule Evaluations per Event",
+        doubleValue: Double(report.totalRuleEvaluations) / eventCount,
+        unitSymbol: "rules"
+      ),
+      XCTPerformanceMeasurement(
+        identifier: "com.facebook.sdk.skadnetwork.latency",
+        displayName: "Median Event Latency",
+        doubleValue: (latencies.isEmpty ? 0 : latencies[latencies.count / 2]) * 1_000_000,
+        unitSymbol: "µs"
+      ),
+      XCTPerformanceMeasurement(
+        identifier: "com.facebook.sdk.skadnetwork.user_defaults_writes",
+        displayName: "User Defaults Writes per Event",
+        doubleValue: Double(report.totalUserDefaultsWrites) / eventCount,
+        unitSymbol: "writes"
+      ),
+      XCTPerformanceMeasurement(
+        identifier: "com.facebook.sdk.skadnetwork.bytes_written",
+        displayName: "User Defaults Bytes per Event",
+        doubleValue: Double(report.bytesWritten) / eventCount,
+        unitSymbol: "B"
+      ),
+    ]
+  }
+}
+
+#endif
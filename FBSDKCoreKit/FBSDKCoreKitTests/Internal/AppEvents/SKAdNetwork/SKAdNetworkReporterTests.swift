@@ -328,6 +328,54 @@ class SKAdNetworkReporterTests: XCTestCase {
     }
   }
 
+  func testCoalescingReportDataWritesUnderLoad() {
+    let config = SKAdNetworkConversionConfiguration(json: SampleSKAdNetworkConversionConfiguration.configJson)
+    skAdNetworkReporter.setConfiguration(config!) // swiftlint:disable:this force_unwrapping
+    skAdNetworkReporter.serialQueue = DispatchQueue(label: name)
+
+    for index in 0 ..< 1000 {
+      skAdNetworkReporter._recordAndUpdateEvent("fb_mobile_purchase", currency: "USD", value: NSNumber(value: index))
+    }
+
+    XCTAssertTrue(skAdNetworkReporter.isReportDataSaveScheduled, "Should schedule saving the report data")
+    XCTAssertEqual(reportDataWriteCount, 0, "Should not save the report data for each event")
+
+    skAdNetworkReporter.applicationDidEnterBackground(nil)
+    skAdNetworkReporter.applicationDidEnterBackground(nil)
+
+    XCTAssertEqual(reportDataWriteCount, 1, "Should save the changed report data once when backgrounding")
+    XCTAssertEqual(
+      skAdNetworkReporter.recordedValues["fb_mobile_purchase"] as? [String: Int],
+      ["USD": 499500],
+      "Should keep recording the values while the save is deferred"
+    )
+  }
+
+  func testSavingReportDataBeforeReturningWhenBackgrounding() {
+    let config = SKAdNetworkConversionConfiguration(json: SampleSKAdNetworkConversionConfiguration.configJson)
+    skAdNetworkReporter.setConfiguration(config!) // swiftlint:disable:this force_unwrapping
+    skAdNetworkReporter.serialQueue = DispatchQueue(label: name)
+    skAdNetworkReporter._recordAndUpdateEvent("fb_mobile_purchase", currency: "USD", value: 100)
+    // The designated queue label makes the reporter asynchronous
+    skAdNetworkReporter.serialQueue = DispatchQueue(label: "com.facebook.appevents.SKAdNetwork.FBSDKSKAdNetworkReporter")
+
+    skAdNetworkReporter.applicationDidEnterBackground(nil)
+
+    XCTAssertEqual(
+      reportDataWriteCount,
+      1,
+      "Should save the report data before the app can be suspended"
+    )
+  }
+
+  func testNotSavingUnchangedReportDataWhenBackgrounding() {
+    skAdNetworkReporter.serialQueue = DispatchQueue(label: name)
+
+    skAdNetworkReporter.applicationDidEnterBackground(nil)
+
+    XCTAssertEqual(reportDataWriteCount, 0, "Should not save report data that did not change")
+  }
+
   func testInitializeWithDependencies() {
     let graphRequestFactory = GraphRequestFactory()
     let store = UserDefaultsSpy()
@@ -353,6 +401,10 @@ class SKAdNetworkReporterTests: XCTestCase {
     )
   }
 
+  var reportDataWriteCount: Int {
+    userDefaultsSpy.capturedSetObjectKeys.filter { $0 == "com.facebook.sdk:FBSDKSKAdNetworkReporter" }.count
+  }
+
   func saveEvents(
     events: NSMutableSet,
     values: NSMutableDictionary,
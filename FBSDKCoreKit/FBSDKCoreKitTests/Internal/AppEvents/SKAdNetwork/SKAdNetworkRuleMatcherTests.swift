@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#if !os(tvOS)
+
+class SKAdNetworkRuleMatcherTests: XCTestCase {
+  lazy var rules = [
+    rule(conversionValue: 4, events: [
+      event("fb_mobile_purchase", values: ["USD": 100, "JPY": 10000]),
+      event("Donate"),
+    ]),
+    rule(conversionValue: 3, events: [event("Donate"), event("fb_mobile_purchase", values: ["USD": 10])]),
+    rule(conversionValue: 2, events: [event("fb_activate_app"), event("fb_test_event")]),
+    rule(conversionValue: 1, events: [event("fb_activate_app")]),
+  ]
+
+  func testInterningEventsAndCurrencies() throws {
+    let matcher = try XCTUnwrap(SKAdNetworkRuleMatcher(rules: rules))
+
+    XCTAssertEqual(Set(matcher.eventIDs.values.map { $0.intValue }), Set(0 ..< 4))
+    XCTAssertEqual(Set(matcher.currencyIDs.values.map { $0.intValue }), Set(0 ..< 2))
+  }
+
+  func testMatchingRulesLikeTheRules() throws {
+    let matcher = try XCTUnwrap(SKAdNetworkRuleMatcher(rules: rules))
+    let recordedEventSets: [Set<String>] = [
+      [],
+      ["fb_activate_app"],
+      ["fb_activate_app", "fb_test_event"],
+      ["fb_mobile_purchase"],
+      ["fb_mobile_purchase", "Donate"],
+      ["fb_mobile_purchase", "Donate", "fb_activate_app", "unknown_event"],
+    ]
+    let recordedValueSets: [[String: [String: Any]]] = [
+      [:],
+      ["fb_mobile_purchase": ["USD": 10]],
+      ["fb_mobile_purchase": ["USD": 11]],
+      ["fb_mobile_purchase": ["USD": 101]],
+      ["fb_mobile_purchase": ["JPY": 20000]],
+      ["fb_mobile_purchase": ["EUR": 1000]],
+    ]
+    for recordedEvents in recordedEventSets {
+      for recordedValues in recordedValueSets {
+        for conversionValue in [0, 2, 4, 5] {
+          XCTAssertEqual(
+            matcher.ruleMatched(
+              withRecordedEvents: recordedEvents,
+              recordedValues: recordedValues,
+              minimumConversionValue: conversionValue
+            )?.conversionValue,
+            firstMatchedRule(
+              recordedEvents: recordedEvents,
+              recordedValues: recordedValues,
+              conversionValue: conversionValue
+            )?.conversionValue,
+            "Should match the same rule as the rules for \(recordedEvents), \(recordedValues)"
+          )
+        }
+      }
+    }
+  }
+
+  func testNotCheckingEventsAfterTheFirstEventWithValues() throws {
+    let matcher = try XCTUnwrap(
+      SKAdNetworkRuleMatcher(rules: [
+        rule(conversionValue: 1, events: [event("fb_mobile_purchase", values: ["USD": 10]), event("Donate")]),
+      ])
+    )
+
+    XCTAssertEqual(
+      matcher.ruleMatched(
+        withRecordedEvents: ["fb_mobile_purchase"],
+        recordedValues: ["fb_mobile_purchase": ["USD": 100]],
+        minimumConversionValue: 0
+      )?.conversionValue,
+      1,
+      "Should match like the rule, which does not check the events after the first one with values"
+    )
+  }
+
+  func testCompilingTooManyEvents() {
+    let events = (0 ... SKAdNetworkRuleMatcher.maximumEventCount).map { event("event_\($0)") }
+
+    XCTAssertNil(SKAdNetworkRuleMatcher(rules: [rule(conversionValue: 1, events: events)]))
+  }
+
+  func testConfigurationCompilesRules() throws {
+    let config = try XCTUnwrap(
+      SKAdNetworkConversionConfiguration(json: [
+        "data": [
+          [
+            "timer_buckets": 1,
+            "timer_interval": 1000,
+            "default_currency": "usd",
+            "cutoff_time": 2,
+            "conversion_value_rules": [
+              ["conversion_value": 2, "events": [event("fb_mobile_purchase")]],
+              ["conversion_value": 1, "events": [event("fb_activate_app")]],
+            ],
+          ],
+        ],
+      ])
+    )
+
+    XCTAssertEqual(config.conversionRuleMatcher?.rules.count, 2)
+  }
+
+  // MARK: - Helpers
+
+  func firstMatchedRule(
+    recordedEvents: Set<String>,
+    recordedValues: [String: [String: Any]],
+    conversionValue: Int
+  ) -> SKAdNetworkRule? {
+    for rule in rules {
+      if rule.conversionValue < conversionValue {
+        break
+      }
+      if rule.isMatched(withRecordedEvents: recordedEvents, recordedValues: recordedValues) {
+        return rule
+      }
+    }
+    return nil
+  }
+
+  func rule(conversionValue: Int, events: [[String: Any]]) -> SKAdNetworkRule {
+    SKAdNetworkRule(json: [
+      "conversion_value": conversionValue,
+      "events": events,
+    ])! // swiftlint:disable:this force_unwrapping
+  }
+
+  func event(_ name: String, values: [String: Double]? = nil) -> [String: Any] {
+    var event: [String: Any] = ["event_name": name]
+    event["values"] = values?.map { ["currency": $0.key, "amount": $0.value] }
+    return event
+  }
+}
+
+#endif
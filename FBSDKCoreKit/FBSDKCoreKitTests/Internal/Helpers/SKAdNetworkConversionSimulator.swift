@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#if !os(tvOS)
+
+import Foundation
+import TestTools
+
+/// Replays a stream of app events through `SKAdNetworkReporter` with a stubbed store, synchronously,
+/// and reports what the reporter did with them.
+class SKAdNetworkConversionSimulator {
+
+  struct Event {
+    let name: String
+    let currency: String?
+    let value: NSNumber?
+
+    init(name: String, currency: String? = nil, value: NSNumber? = nil) {
+      self.name = name
+      self.currency = currency
+      self.value = value
+    }
+  }
+
+  struct Report {
+    /// The last conversion value passed to SKAdNetwork
+    var conversionValue: Int?
+    /// The conversion value rules the rule matcher compared with the recorded events, for each event
+    var ruleEvaluations = [Int]()
+    /// The user defaults writes of each event
+    var userDefaultsWrites = [Int]()
+    /// The bytes of the values written to the user defaults
+    var bytesWritten = 0
+    /// The time `_recordAndUpdateEvent` took for each event
+    var latencies = [TimeInterval]()
+
+    var totalRuleEvaluations: Int {
+      ruleEvaluations.reduce(0, +)
+    }
+
+    var totalUserDefaultsWrites: Int {
+      userDefaultsWrites.reduce(0, +)
+    }
+  }
+
+  let configuration: SKAdNetworkConversionConfiguration
+  private(set) var store = UserDefaultsSpy()
+
+  /// - Parameter configuration: A response of the SKAdNetwork conversion configuration endpoint
+  init?(configuration: [String: Any]) {
+    guard let configuration = SKAdNetworkConversionConfiguration(json: configuration) else {
+      return nil
+    }
+    self.configuration = configuration
+  }
+
+  /// - Parameter configurationJSON: The JSON of a response of the SKAdNetwork conversion configuration endpoint
+  convenience init?(configurationJSON: String) {
+    guard
+      let data = configurationJSON.data(using: .utf8),
+      let configuration = try? JSONSerialization.jsonObject(with: data) as? [String: Any]
+    else {
+      return nil
+    }
+    self.init(configuration: configuration)
+  }
+
+  /// Decodes a recorded event stream, a JSON array of `event_name`, `currency` and `value` objects
+  static func events(fromJSON json: String) -> [Event] {
+    guard
+      let data = json.data(using: .utf8),
+      let events = try? JSONSerialization.jsonObject(with: data) as? [[String: Any]]
+    else {
+      return []
+    }
+    return events.compactMap { event in
+      guard let name = event["event_name"] as? String else {
+        return nil
+      }
+      return Event(
+        name: name,
+        currency: event["currency"] as? String,
+        value: event["value"] as? NSNumber
+      )
+    }
+  }
+
+  func run(events: [Event]) -> Report {
+    let reporter = makeReporter()
+
+    var report = Report()
+    for event in events {
+      SKAdNetworkRuleMatcher.evaluatedRuleCount = 0
+      let writeCount = store.capturedSetObjectKeys.count
+      let bytesWritten = store.capturedSetObjectByteCount
+
+      let start = DispatchTime.now().uptimeNanoseconds
+      reporter._recordAndUpdateEvent(event.name, currency: event.currency, value: event.value)
+      report.latencies.append(TimeInterval(DispatchTime.now().uptimeNanoseconds - start) / TimeInterval(NSEC_PER_SEC))
+
+      report.ruleEvaluations.append(Int(SKAdNetworkRuleMatcher.evaluatedRuleCount))
+      report.userDefaultsWrites.append(store.capturedSetObjectKeys.count - writeCount)
+      report.bytesWritten += store.capturedSetObjectByteCount - bytesWritten
+    }
+    report.conversionValue = TestConversionValueUpdating.capturedConversionValue
+    return report
+  }
+
+  // MARK: - Helpers
+
+  /// Without a serial queue the reporter saves its report data as soon as it changes
+  func makeReporter() -> SKAdNetworkReporter {
+    store = UserDefaultsSpy()
+    TestConversionValueUpdating.reset()
+    let reporter = SKAdNetworkReporter(
+      graphRequestFactory: TestGraphRequestFactory(),
+      store: store,
+      conversionValueUpdatable: TestConversionValueUpdating.self
+    )
+    reporter.setConfiguration(configuration)
+    reporter.isSKAdNetworkReportEnabled = true
+    reporter.conversionValue = 0
+    reporter.recordedEvents = NSMutableSet()
+    reporter.recordedValues = NSMutableDictionary()
+    return reporter
+  }
+}
+
+#endif
@@ -42,6 +42,7 @@ class TestAppEvents: TestEventLogger,
   var capturedConfigureAppEventsConfigurationProvider: AppEventsConfigurationProviding.Type?
   var capturedConfigureServerConfigurationProvider: ServerConfigurationProviding?
   var capturedConfigureGraphRequestFactory: GraphRequestFactoryProtocol?
+  var capturedConfigureGraphRequestConnectionFactory: GraphRequestConnectionFactoryProtocol?
   var capturedConfigureFeatureChecker: FeatureChecking?
   var capturedConfigureStore: DataPersisting?
   var capturedConfigureLogger: Logging.Type?
@@ -66,6 +67,7 @@ class TestAppEvents: TestEventLogger,
     appEventsConfigurationProvider: AppEventsConfigurationProviding.Type,
     serverConfigurationProvider: ServerConfigurationProviding,
     graphRequestFactory: GraphRequestFactoryProtocol,
+    graphRequestConnectionFactory: GraphRequestConnectionFactoryProtocol,
     featureChecker: FeatureChecking,
     store: DataPersisting,
     logger: Logging.Type,
@@ -85,6 +87,7 @@ class TestAppEvents: TestEventLogger,
     capturedConfigureAppEventsConfigurationProvider = appEventsConfigurationProvider
     capturedConfigureServerConfigurationProvider = serverConfigurationProvider
     capturedConfigureGraphRequestFactory = graphRequestFactory
+    capturedConfigureGraphRequestConnectionFactory = graphRequestConnectionFactory
     capturedConfigureFeatureChecker = featureChecker
     capturedConfigureStore = store
     capturedConfigureLogger = logger
@@ -13,12 +13,15 @@ import XCTest
 class TestConversionValueUpdating: NSObject, ConversionValueUpdating {
 
   static var wasUpdateVersionValueCalled = false
+  static var capturedConversionValue: Int?
 
   static func updateConversionValue(_ conversionValue: Int) {
     wasUpdateVersionValueCalled = true
+    capturedConversionValue = conversionValue
   }
 
   static func reset() {
     wasUpdateVersionValueCalled = false
+    capturedConversionValue = nil
   }
 }
@@ -0,0 +1,18 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+import FBSDKCoreKit
+
+@objcMembers
+class TestGraphRequestConnectionMetricsSink: NSObject, GraphRequestConnectionMetricsSink {
+  var capturedMetrics = [GraphRequestConnectionMetrics]()
+
+  func record(_ metrics: GraphRequestConnectionMetrics) {
+    capturedMetrics.append(metrics)
+  }
+}
@@ -11,12 +11,17 @@ import FBSDKCoreKit
 @objcMembers
 class TestGraphRequestPiggybackManager: NSObject, GraphRequestPiggybackManaging {
   static var capturedConnection: GraphRequestConnecting?
+  static var stubbedPiggybackRequests = [GraphRequestProtocol]()
 
   static func addPiggybackRequests(_ connection: GraphRequestConnecting) {
     capturedConnection = connection
+    stubbedPiggybackRequests.forEach { request in
+      connection.add(request) { _, _, _ in }
+    }
   }
 
   static func reset() {
     capturedConnection = nil
+    stubbedPiggybackRequests = []
   }
 }
@@ -13,6 +13,8 @@ class UserDefaultsSpy: UserDefaults {
   var capturedObjectRetrievalKey: String?
   var capturedSetObjectKey: String?
   var capturedValues = [String: Any]()
+  /// The size of every value set, as a binary property list
+  var capturedSetObjectByteCount = 0
 
   var stringForKeyCallback: ((String) -> String)? = { $0 }
 
@@ -30,5 +32,19 @@ class UserDefaultsSpy: UserDefaults {
     capturedValues[defaultName] = value
     capturedSetObjectKeys.append(defaultName)
     capturedSetObjectKey = defaultName
+    capturedSetObjectByteCount += byteCount(of: value)
+  }
+
+  func byteCount(of value: Any?) -> Int {
+    if let data = value as? Data {
+      return data.count
+    }
+    guard
+      let value = value,
+      let data = try? PropertyListSerialization.data(fromPropertyList: value, format: .binary, options: 0)
+    else {
+      return 0
+    }
+    return data.count
   }
 }
@@ -231,6 +231,25 @@ class ErrorReporterTests: XCTestCase {
       .post,
       "Should use the correct http method"
     )
+    XCTAssertEqual(
+      factory.capturedFlags,
+      .backgroundPriority,
+      "Should not compete with the requests the user is waiting for"
+    )
+  }
+
+  func testUploadingWithCurrentAccessToken() {
+    AccessToken.current = SampleAccessTokens.validToken
+    defer { AccessToken.current = nil }
+    seedErrorReportData()
+
+    reporter.uploadErrors()
+
+    XCTAssertEqual(
+      factory.capturedTokenString,
+      SampleAccessTokens.validToken.tokenString,
+      "Should upload the reports with the current access token"
+    )
   }
 
   func testCompletingUploadWithoutResultWithoutError() {
@@ -73,4 +73,137 @@ class GraphRequestBodyTests: XCTestCase {
     XCTAssertTrue(decodedData.contains("filename=\"test_filename\""))
     XCTAssertTrue(decodedData.contains("Content-Type: test_content_type"))
   }
+
+  // MARK: - Streaming
+
+  func testMultipartDataLengthMatchesData() {
+    let body = GraphRequestBody()
+    body.append(withKey: "form_key", formValue: "form_value", logger: nil)
+    body.append(withKey: "data_key", dataValue: Data(repeating: 1, count: 1000), logger: nil)
+
+    XCTAssertEqual(
+      body.multipartDataLength,
+      UInt64(body.data.count),
+      "Should know the size of the body without building it"
+    )
+  }
+
+  func testSmallBodyDoesNotPreferStreaming() {
+    let body = GraphRequestBody()
+    body.append(withKey: "data_key", dataValue: Data(repeating: 1, count: 1000), logger: nil)
+
+    XCTAssertFalse(body.prefersStreaming, "Small bodies should be sent in memory")
+  }
+
+  func testLargeBodyPrefersStreaming() {
+    let body = GraphRequestBody()
+    body.append(withKey: "data_key", dataValue: Data(repeating: 1, count: 2 * 1024 * 1024), logger: nil)
+
+    XCTAssertTrue(body.prefersStreaming, "Large bodies should be streamed")
+  }
+
+  func testJSONBodyHasNoStream() {
+    let body = GraphRequestBody()
+    body.append(withKey: "form_key", formValue: "form_value", logger: nil)
+
+    XCTAssertFalse(body.prefersStreaming)
+    XCTAssertNil(body.multipartDataStream(), "JSON bodies should not be streamed")
+  }
+
+  func testStreamMatchesData() throws {
+    let body = GraphRequestBody()
+    body.append(withKey: "form_key", formValue: "form_value", logger: nil)
+    body.append(withKey: "data_key", dataValue: Data(repeating: 2, count: 200_000), logger: nil)
+    body.append(withKey: "other_form_key", formValue: "other_form_value", logger: nil)
+
+    let stream = try XCTUnwrap(body.multipartDataStream())
+
+    XCTAssertEqual(readAll(stream), body.data, "The stream should produce the same bytes as the in memory body")
+  }
+
+  func testFileAttachment() throws {
+    let contents = Data(repeating: 3, count: 300_000)
+    let fileURL = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString)
+    try contents.write(to: fileURL)
+    defer { try? FileManager.default.removeItem(at: fileURL) }
+
+    let attachment = GraphRequestDataAttachment(
+      fileURL: fileURL,
+      filename: "video.mp4",
+      contentType: "video/mp4"
+    )
+    let body = GraphRequestBody()
+    body.append(withKey: "source", dataAttachmentValue: attachment, logger: nil)
+
+    let stream = try XCTUnwrap(body.multipartDataStream())
+    let streamed = readAll(stream)
+
+    XCTAssertTrue(body.prefersStreaming, "File attachments should always be streamed")
+    XCTAssertEqual(UInt64(streamed.count), body.multipartDataLength)
+    XCTAssertNotNil(streamed.range(of: contents), "Should stream the contents of the file")
+    XCTAssertEqual(streamed, body.data)
+  }
+
+  func testReadingStreamInSmallChunks() throws {
+    let body = GraphRequestBody()
+    body.append(withKey: "form_key", formValue: "form_value", logger: nil)
+    body.append(withKey: "data_key", dataValue: Data(repeating: 4, count: 1000), logger: nil)
+
+    let stream = try XCTUnwrap(body.multipartDataStream())
+
+    XCTAssertEqual(
+      readAll(stream, bufferSize: 7),
+      body.data,
+      "Should read across the boundaries between parts"
+    )
+    XCTAssertEqual(stream.streamStatus, .atEnd)
+  }
+
+  func testStreamingMissingFile() throws {
+    let fileURL = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString)
+    let attachment = GraphRequestDataAttachment(fileURL: fileURL, filename: "video.mp4", contentType: "video/mp4")
+    let body = GraphRequestBody()
+    body.append(withKey: "source", dataAttachmentValue: attachment, logger: nil)
+
+    let stream = try XCTUnwrap(body.multipartDataStream())
+    var buffer = [UInt8](repeating: 0, count: 1024 * 1024)
+    stream.open()
+    defer { stream.close() }
+
+    var count = 0
+    repeat {
+      count = stream.read(&buffer, maxLength: buffer.count)
+    } while count > 0
+
+    XCTAssertEqual(count, -1, "Should fail instead of sending a truncated body")
+    XCTAssertEqual(stream.streamStatus, .error)
+    XCTAssertNotNil(stream.streamError)
+  }
+
+  func testFileAttachmentData() throws {
+    let contents = Data("file contents".utf8)
+    let fileURL = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString)
+    try contents.write(to: fileURL)
+    defer { try? FileManager.default.removeItem(at: fileURL) }
+
+    let attachment = GraphRequestDataAttachment(fileURL: fileURL, filename: "file", contentType: "text/plain")
+
+    XCTAssertEqual(attachment.fileURL, fileURL)
+    XCTAssertEqual(attachment.data, contents, "Should read the file when its data is requested")
+  }
+
+  func readAll(_ stream: InputStream, bufferSize: Int = 4096) -> Data {
+    var data = Data()
+    var buffer = [UInt8](repeating: 0, count: bufferSize)
+    stream.open()
+    defer { stream.close() }
+    while true {
+      let count = stream.read(&buffer, maxLength: buffer.count)
+      if count <= 0 {
+        break
+      }
+      data.append(buffer, count: count)
+    }
+    return data
+  }
 }
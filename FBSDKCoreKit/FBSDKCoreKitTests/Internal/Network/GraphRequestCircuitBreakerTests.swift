@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+import XCTest
+
+class GraphRequestCircuitBreakerTests: XCTestCase {
+
+  let notificationCenter = NotificationCenter()
+  var date = Date(timeIntervalSince1970: 1_000)
+  var delayedBlocks = [(delay: TimeInterval, block: () -> Void)]()
+  var notifiedStates = [CircuitBreakerState]()
+  lazy var circuitBreaker = GraphRequestCircuitBreaker(
+    failureThreshold: 3,
+    cooldown: 30,
+    maxCooldown: 100,
+    rateLimiter: TokenBucket(capacity: 100, tokensPerSecond: 100),
+    notificationCenter: notificationCenter,
+    dateProvider: { [unowned self] in self.date },
+    delayedBlockPerformer: { [unowned self] delay, block in self.delayedBlocks.append((delay, block)) }
+  )
+
+  override func setUp() {
+    super.setUp()
+
+    notificationCenter.addObserver(
+      forName: .GraphRequestCircuitBreakerStateDidChange,
+      object: nil,
+      queue: nil
+    ) { [unowned self] notification in
+      if let circuitBreaker = notification.object as? GraphRequestCircuitBreaker {
+        self.notifiedStates.append(circuitBreaker.state)
+      }
+    }
+  }
+
+  func admit() -> Bool? {
+    var result: Bool?
+    circuitBreaker.admitRequest { result = $0 }
+    return result
+  }
+
+  func openCircuit() {
+    for _ in 0 ..< 3 {
+      circuitBreaker.recordFailure()
+    }
+  }
+
+  func testAdmittingWhileClosed() {
+    XCTAssertEqual(admit(), true)
+    XCTAssertEqual(circuitBreaker.state, .closed)
+  }
+
+  func testOpeningAfterConsecutiveFailures() {
+    circuitBreaker.recordFailure()
+    circuitBreaker.recordFailure()
+    circuitBreaker.recordSuccess()
+    circuitBreaker.recordFailure()
+    circuitBreaker.recordFailure()
+
+    XCTAssertEqual(circuitBreaker.state, .closed, "Should only count consecutive failures")
+
+    circuitBreaker.recordFailure()
+
+    XCTAssertEqual(circuitBreaker.state, .open)
+    XCTAssertEqual(notifiedStates, [.open], "Should notify observers when the circuit opens")
+  }
+
+  func testRejectingWhileOpen() {
+    openCircuit()
+
+    XCTAssertEqual(admit(), false, "Should fail requests right away while open")
+  }
+
+  func testHalfOpeningAfterCooldown() {
+    openCircuit()
+
+    XCTAssertEqual(delayedBlocks.first?.delay, 30)
+    delayedBlocks.first?.block()
+
+    XCTAssertEqual(circuitBreaker.state, .halfOpen, "Should let observers know a probe can go out")
+    XCTAssertEqual(notifiedStates, [.open, .halfOpen])
+  }
+
+  func testHalfOpeningOnRequestAfterCooldown() {
+    openCircuit()
+    date.addTimeInterval(30)
+
+    XCTAssertEqual(admit(), true, "Should let a probe through once the cool down elapsed")
+    XCTAssertEqual(circuitBreaker.state, .halfOpen)
+    XCTAssertEqual(admit(), false, "Should only let a single probe through")
+  }
+
+  func testClosingAfterSuccessfulProbe() {
+    openCircuit()
+    date.addTimeInterval(30)
+    _ = admit()
+
+    circuitBreaker.recordSuccess()
+
+    XCTAssertEqual(circuitBreaker.state, .closed)
+    XCTAssertEqual(admit(), true)
+    XCTAssertEqual(notifiedStates, [.open, .halfOpen, .closed])
+  }
+
+  func testReopeningAfterFailedProbe() {
+    openCircuit()
+    date.addTimeInterval(30)
+    _ = admit()
+
+    circuitBreaker.recordFailure()
+
+    XCTAssertEqual(circuitBreaker.state, .open)
+    XCTAssertEqual(circuitBreaker.cooldown, 60, "Should double the cool down after a failed probe")
+
+    date.addTimeInterval(60)
+    _ = admit()
+    circuitBreaker.recordFailure()
+
+    XCTAssertEqual(circuitBreaker.cooldown, 100, "Should cap the cool down")
+  }
+
+  func testStaleCooldownEnd() {
+    openCircuit()
+    let firstCooldownEnd = delayedBlocks[0].block
+    date.addTimeInterval(30)
+    _ = admit()
+    circuitBreaker.recordFailure()
+
+    firstCooldownEnd()
+
+    XCTAssertEqual(circuitBreaker.state, .open, "Should ignore the end of a previous cool down")
+  }
+
+  func testRetryingLostProbe() {
+    openCircuit()
+    date.addTimeInterval(30)
+    _ = admit()
+    date.addTimeInterval(60)
+
+    XCTAssertEqual(admit(), true, "Should send another probe when the previous one never reported back")
+  }
+
+  func testRateLimiting() {
+    let circuitBreaker = GraphRequestCircuitBreaker(
+      failureThreshold: 3,
+      cooldown: 30,
+      maxCooldown: 100,
+      rateLimiter: TokenBucket(capacity: 1, tokensPerSecond: 1),
+      notificationCenter: notificationCenter,
+      dateProvider: { [unowned self] in self.date },
+      delayedBlockPerformer: { [unowned self] delay, block in self.delayedBlocks.append((delay, block)) }
+    )
+    var admissions = [Bool]()
+    circuitBreaker.admitRequest { admissions.append($0) }
+    circuitBreaker.admitRequest { admissions.append($0) }
+
+    XCTAssertEqual(admissions, [true], "Should hold requests over the rate limit")
+    XCTAssertEqual(delayedBlocks.first?.delay, 1)
+
+    delayedBlocks.first?.block()
+
+    XCTAssertEqual(admissions, [true, true])
+  }
+
+  func testPausingAppEventsFlushes() {
+    let policy = AppEventsFlushPolicy(baseInterval: 15, eventThreshold: 100, coalescingWindow: 1)
+    let observer = notificationCenter.addObserver(
+      forName: .GraphRequestCircuitBreakerStateDidChange,
+      object: circuitBreaker,
+      queue: nil
+    ) { [unowned self] _ in
+      policy.isPaused = self.circuitBreaker.state == .open
+    }
+    defer { notificationCenter.removeObserver(observer) }
+
+    openCircuit()
+
+    XCTAssertTrue(policy.isPaused)
+
+    delayedBlocks.first?.block()
+
+    XCTAssertFalse(policy.isPaused, "Should resume flushing so that a flush can probe the server")
+  }
+}
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+import TestTools
+import XCTest
+
+class GraphRequestCoalescerTests: XCTestCase {
+
+  class Delegate: NSObject, GraphRequestConnectionDelegate {}
+
+  let settings = TestSettings()
+  let connection = TestGraphRequestConnection()
+  lazy var factory = TestGraphRequestConnectionFactory.create(withStubbedConnection: connection)
+  lazy var coalescer = GraphRequestCoalescer(settings: settings)
+
+  override func setUp() {
+    super.setUp()
+
+    settings.appID = "abc123"
+    coalescer.window = 0.01
+  }
+
+  func testDefaults() {
+    let coalescer = GraphRequestCoalescer(settings: settings)
+
+    XCTAssertEqual(coalescer.window, 0)
+    XCTAssertFalse(coalescer.isEnabled, "Coalescing should be opt-in")
+  }
+
+  func testStartingRequestDefersConnection() {
+    _ = coalescer.startRequest(TestGraphRequest(), connectionFactory: factory, completion: nil)
+
+    XCTAssertEqual(coalescer.pendingRequestCount, 1)
+    XCTAssertEqual(connection.startCallCount, 0, "Requests should wait for the window to elapse")
+  }
+
+  func testFlushingBatchesPendingRequests() {
+    let request1 = TestGraphRequest(graphPath: "me", HTTPMethod: .get)
+    let request2 = TestGraphRequest(graphPath: "app", HTTPMethod: .get)
+    _ = coalescer.startRequest(request1, connectionFactory: factory, completion: nil)
+    _ = coalescer.startRequest(request2, connectionFactory: factory, completion: nil)
+
+    coalescer.flush()
+
+    XCTAssertEqual(coalescer.pendingRequestCount, 0)
+    XCTAssertEqual(connection.startCallCount, 1, "Pending requests should be sent in a single connection")
+    XCTAssertTrue(connection.capturedRequests.first === request1)
+    XCTAssertTrue(connection.capturedRequests.last === request2)
+  }
+
+  func testFanningOutResponses() {
+    var results = [String]()
+    var connections = [GraphRequestConnecting?]()
+    let coalesced1 = coalescer.startRequest(TestGraphRequest(), connectionFactory: factory) { connection, result, _ in
+      connections.append(connection)
+      results.append(result as? String ?? "")
+    }
+    let coalesced2 = coalescer.startRequest(TestGraphRequest(), connectionFactory: factory) { connection, result, _ in
+      connections.append(connection)
+      results.append(result as? String ?? "")
+    }
+    coalescer.flush()
+
+    connection.capturedCompletions.last?(connection, "second" as NSString, nil)
+    connection.capturedCompletions.first?(connection, "first" as NSString, nil)
+
+    XCTAssertEqual(results, ["second", "first"], "Each request should get its own result")
+    XCTAssertTrue(connections.first as AnyObject === coalesced2 as AnyObject)
+    XCTAssertTrue(
+      connections.last as AnyObject === coalesced1 as AnyObject,
+      "Completions should receive the connection returned when the request was started"
+    )
+  }
+
+  func testCancellingPendingRequest() {
+    var completionWasCalled = false
+    let coalesced = coalescer.startRequest(TestGraphRequest(), connectionFactory: factory) { _, _, _ in
+      completionWasCalled = true
+    }
+
+    coalesced.cancel()
+    coalescer.flush()
+
+    XCTAssertEqual(connection.startCallCount, 0, "Cancelled requests should not be sent")
+    XCTAssertFalse(completionWasCalled)
+  }
+
+  func testCancellingSentRequest() {
+    var completionWasCalled = false
+    let coalesced = coalescer.startRequest(TestGraphRequest(), connectionFactory: factory) { _, _, _ in
+      completionWasCalled = true
+    }
+    coalescer.flush()
+
+    coalesced.cancel()
+    connection.capturedCompletion?(connection, nil, nil)
+
+    XCTAssertFalse(completionWasCalled, "Cancelled requests should not call their completion")
+  }
+
+  func testFlushingWithoutAppID() {
+    settings.appID = nil
+    _ = coalescer.startRequest(TestGraphRequest(), connectionFactory: factory, completion: nil)
+    _ = coalescer.startRequest(TestGraphRequest(), connectionFactory: factory, completion: nil)
+
+    coalescer.flush()
+
+    XCTAssertEqual(connection.startCallCount, 2, "Requests should not be batched without an app ID")
+  }
+
+  func testFlushingRequestsFromDifferentFactories() {
+    let otherConnection = TestGraphRequestConnection()
+    let otherFactory = TestGraphRequestConnectionFactory.create(withStubbedConnection: otherConnection)
+    _ = coalescer.startRequest(TestGraphRequest(), connectionFactory: factory, completion: nil)
+    _ = coalescer.startRequest(TestGraphRequest(), connectionFactory: otherFactory, completion: nil)
+
+    coalescer.flush()
+
+    XCTAssertEqual(connection.startCallCount, 1)
+    XCTAssertEqual(otherConnection.startCallCount, 1, "Requests from different factories should not share a batch")
+  }
+
+  func testStartingRequestWhenDisabled() {
+    coalescer.window = 0
+    let request = TestGraphRequest()
+
+    let started = coalescer.startRequest(request, connectionFactory: factory, timeout: 4, completion: nil)
+
+    XCTAssertTrue(started === connection, "Requests should get their own connection when coalescing is disabled")
+    XCTAssertTrue(connection.capturedRequest === request)
+    XCTAssertEqual(connection.timeout, 4, "Should set the timeout of the connection")
+    XCTAssertEqual(connection.startCallCount, 1)
+    XCTAssertEqual(coalescer.pendingRequestCount, 0)
+  }
+
+  func testFlushingUsesLargestTimeout() {
+    _ = coalescer.startRequest(TestGraphRequest(), connectionFactory: factory, timeout: 4, completion: nil)
+    _ = coalescer.startRequest(TestGraphRequest(), connectionFactory: factory, timeout: 10, completion: nil)
+    _ = coalescer.startRequest(TestGraphRequest(), connectionFactory: factory, timeout: 2, completion: nil)
+
+    coalescer.flush()
+
+    XCTAssertEqual(connection.timeout, 10, "A batch should use the largest timeout of its requests")
+  }
+
+  func testFlushingKeepsDefaultTimeoutWhenLarger() {
+    connection.timeout = 60
+    _ = coalescer.startRequest(TestGraphRequest(), connectionFactory: factory, timeout: 4, completion: nil)
+    _ = coalescer.startRequest(TestGraphRequest(), connectionFactory: factory, completion: nil)
+
+    coalescer.flush()
+
+    XCTAssertEqual(
+      connection.timeout,
+      60,
+      "A batch should keep the default timeout for the requests that did not set one"
+    )
+  }
+
+  func testFlushingRequestWithDelegate() {
+    let delegate = Delegate()
+    let coalesced = coalescer.startRequest(TestGraphRequest(), connectionFactory: factory, completion: nil)
+    coalesced.delegate = delegate
+    _ = coalescer.startRequest(TestGraphRequest(), connectionFactory: factory, completion: nil)
+
+    coalescer.flush()
+
+    XCTAssertEqual(connection.startCallCount, 2, "Requests with a delegate should not share a batch")
+    XCTAssertEqual(connection.capturedRequests.count, 2)
+  }
+
+  func testFlushingAfterWindow() {
+    _ = coalescer.startRequest(TestGraphRequest(), connectionFactory: factory, completion: nil)
+
+    let expectation = expectation(description: name)
+    DispatchQueue.main.asyncAfter(deadline: .now() + 0.1) {
+      XCTAssertEqual(self.connection.startCallCount, 1, "Pending requests should be sent once the window elapses")
+      expectation.fulfill()
+    }
+    wait(for: [expectation], timeout: 1)
+  }
+}
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+import XCTest
+
+class GraphRequestRetryPolicyTests: XCTestCase {
+
+  // swiftlint:disable:next force_unwrapping
+  let url = URL(string: "https://graph.facebook.com/v12.0/123/activities")!
+  var randomNumber = 0.5
+  lazy var policy = makePolicy()
+
+  func makePolicy(maxAttempts: UInt = 4, retryBudget: Double = 10) -> GraphRequestRetryPolicy {
+    GraphRequestRetryPolicy(
+      maxAttempts: maxAttempts,
+      baseDelay: 1,
+      maxDelay: 30,
+      retryBudget: retryBudget,
+      randomNumberGenerator: { [unowned self] in self.randomNumber },
+      delayedBlockPerformer: { _, block in block() }
+    )
+  }
+
+  func response(statusCode: Int, headers: [String: String] = [:]) -> HTTPURLResponse? {
+    HTTPURLResponse(url: url, statusCode: statusCode, httpVersion: nil, headerFields: headers)
+  }
+
+  func urlError(_ code: URLError.Code) -> NSError {
+    NSError(domain: NSURLErrorDomain, code: code.rawValue, userInfo: nil)
+  }
+
+  // MARK: - Transient failures
+
+  func testTransientStatusCodes() {
+    for statusCode in [429, 500, 502, 503, 504] {
+      XCTAssertTrue(
+        GraphRequestRetryPolicy.isTransientFailure(with: response(statusCode: statusCode), error: nil),
+        "\(statusCode) should be retried"
+      )
+    }
+    for statusCode in [200, 304, 400, 401, 404, 501] {
+      XCTAssertFalse(
+        GraphRequestRetryPolicy.isTransientFailure(with: response(statusCode: statusCode), error: nil),
+        "\(statusCode) should not be retried"
+      )
+    }
+  }
+
+  func testTransientErrors() {
+    XCTAssertTrue(GraphRequestRetryPolicy.isTransientFailure(with: nil, error: urlError(.timedOut)))
+    XCTAssertTrue(GraphRequestRetryPolicy.isTransientFailure(with: nil, error: urlError(.networkConnectionLost)))
+    XCTAssertFalse(
+      GraphRequestRetryPolicy.isTransientFailure(with: nil, error: urlError(.cancelled)),
+      "Cancelled requests should not be retried"
+    )
+    XCTAssertFalse(
+      GraphRequestRetryPolicy.isTransientFailure(with: nil, error: NSError(domain: "other", code: -1001)),
+      "Only URL loading errors should be retried"
+    )
+  }
+
+  func testConnectivityErrors() {
+    XCTAssertTrue(GraphRequestRetryPolicy.isConnectivityFailure(with: urlError(.notConnectedToInternet)))
+    XCTAssertTrue(GraphRequestRetryPolicy.isConnectivityFailure(with: urlError(.timedOut)))
+    XCTAssertFalse(
+      GraphRequestRetryPolicy.isConnectivityFailure(with: urlError(.networkConnectionLost)),
+      "A dropped connection may be the server's doing"
+    )
+    XCTAssertFalse(GraphRequestRetryPolicy.isConnectivityFailure(with: nil))
+  }
+
+  // MARK: - Delays
+
+  func testExponentialBackoffWithJitter() {
+    let delays = (1 ... 3).map {
+      policy.delayBeforeRetryingAttempt(UInt($0), response: response(statusCode: 503), error: nil)
+    }
+
+    XCTAssertEqual(delays, [0.5, 1, 2], "Should scale the exponential back off by the jitter")
+  }
+
+  func testBackoffIsCappedByMaxDelay() {
+    randomNumber = 0.999
+    let policy = makePolicy(maxAttempts: 10)
+
+    XCTAssertLessThanOrEqual(policy.delayBeforeRetryingAttempt(9, response: response(statusCode: 503), error: nil), 30)
+  }
+
+  func testMaxAttempts() {
+    XCTAssertLessThan(
+      policy.delayBeforeRetryingAttempt(4, response: response(statusCode: 503), error: nil),
+      0,
+      "Should not retry once the maximum number of attempts is reached"
+    )
+  }
+
+  func testNotRetryingPermanentFailures() {
+    XCTAssertLessThan(policy.delayBeforeRetryingAttempt(1, response: response(statusCode: 400), error: nil), 0)
+    XCTAssertEqual(policy.availableRetryBudget, 10, "Should not consume the budget when not retrying")
+  }
+
+  func testRetryAfterSeconds() {
+    let delay = policy.delayBeforeRetryingAttempt(
+      1,
+      response: response(statusCode: 429, headers: ["Retry-After": "12"]),
+      error: nil
+    )
+
+    XCTAssertEqual(delay, 12, "Should wait as long as the server asks")
+  }
+
+  func testRetryAfterDate() {
+    let date = Date(timeIntervalSince1970: 1_600_000_000)
+    let delay = GraphRequestRetryPolicy.retryAfterDelay(
+      for: response(statusCode: 503, headers: ["Retry-After": "Sun, 13 Sep 2020 12:27:00 GMT"]),
+      date: date
+    )
+
+    XCTAssertEqual(delay, 20, accuracy: 0.001)
+  }
+
+  func testRetryAfterOverMaxDelay() {
+    XCTAssertLessThan(
+      policy.delayBeforeRetryingAttempt(
+        1,
+        response: response(statusCode: 503, headers: ["Retry-After": "3600"]),
+        error: nil
+      ),
+      0,
+      "Should give up rather than hold the request for longer than the max delay"
+    )
+  }
+
+  func testInvalidRetryAfter() {
+    let invalid = response(statusCode: 503, headers: ["Retry-After": "soon"])
+
+    XCTAssertLessThan(GraphRequestRetryPolicy.retryAfterDelay(for: invalid, date: Date()), 0)
+  }
+
+  // MARK: - Budget
+
+  func testRetryBudget() {
+    let policy = makePolicy(retryBudget: 2)
+
+    XCTAssertGreaterThanOrEqual(policy.delayBeforeRetryingAttempt(1, response: nil, error: urlError(.timedOut)), 0)
+    XCTAssertGreaterThanOrEqual(policy.delayBeforeRetryingAttempt(1, response: nil, error: urlError(.timedOut)), 0)
+    XCTAssertLessThan(
+      policy.delayBeforeRetryingAttempt(1, response: nil, error: urlError(.timedOut)),
+      0,
+      "Should stop retrying once the budget is spent"
+    )
+
+    for _ in 0 ..< 10 {
+      policy.recordSuccess()
+    }
+
+    XCTAssertGreaterThanOrEqual(
+      policy.delayBeforeRetryingAttempt(1, response: nil, error: urlError(.timedOut)),
+      0,
+      "Successful requests should refill the budget"
+    )
+  }
+
+  func testBudgetIsCapped() {
+    for _ in 0 ..< 1000 {
+      policy.recordSuccess()
+    }
+
+    XCTAssertEqual(policy.availableRetryBudget, 10)
+  }
+}
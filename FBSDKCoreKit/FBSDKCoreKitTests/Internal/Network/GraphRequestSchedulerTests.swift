@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+import XCTest
+
+class GraphRequestSchedulerTests: XCTestCase {
+
+  let scheduler = GraphRequestScheduler(
+    maxConcurrentRequests: 2,
+    maxConcurrentBackgroundRequests: 1,
+    maxDeferral: 60
+  )
+  var started = [String]()
+  var finishes = [String: GraphRequestSchedulerCompletion]()
+
+  func schedule(_ name: String, priority: GraphRequestPriority = .default) {
+    scheduler.scheduleTask(with: priority) { finish in
+      self.started.append(name)
+      self.finishes[name] = finish
+    }
+  }
+
+  func testStartingWithinLimit() {
+    schedule("a")
+    schedule("b")
+
+    XCTAssertEqual(started, ["a", "b"], "Should start tasks synchronously while slots are available")
+    XCTAssertEqual(scheduler.metrics(for: .default).deferredCount, 0)
+  }
+
+  func testQueueingOverLimit() {
+    schedule("a")
+    schedule("b")
+    schedule("c")
+    schedule("d")
+
+    XCTAssertEqual(started, ["a", "b"])
+    XCTAssertEqual(scheduler.metrics(for: .default).pendingCount, 2)
+
+    finishes["b"]?()
+
+    XCTAssertEqual(started, ["a", "b", "c"], "Should start waiting tasks in order as slots free up")
+    XCTAssertEqual(scheduler.metrics(for: .default).inFlightCount, 2)
+  }
+
+  func testFinishingTwice() {
+    schedule("a")
+    schedule("b")
+    schedule("c")
+    schedule("d")
+
+    finishes["a"]?()
+    finishes["a"]?()
+
+    XCTAssertEqual(started, ["a", "b", "c"], "Should only free a slot once per task")
+  }
+
+  func testDeferringBackgroundTasks() {
+    schedule("a")
+    schedule("telemetry", priority: .background)
+
+    XCTAssertEqual(started, ["a"], "Should hold back background tasks while default tasks are in flight")
+
+    finishes["a"]?()
+
+    XCTAssertEqual(started, ["a", "telemetry"])
+    let metrics = scheduler.metrics(for: .background)
+    XCTAssertEqual(metrics.startedCount, 1)
+    XCTAssertEqual(metrics.deferredCount, 1)
+    XCTAssertGreaterThanOrEqual(metrics.maxQueueingDelay, 0)
+  }
+
+  func testBackgroundLimit() {
+    schedule("first", priority: .background)
+    schedule("second", priority: .background)
+
+    XCTAssertEqual(started, ["first"])
+
+    finishes["first"]?()
+
+    XCTAssertEqual(started, ["first", "second"])
+  }
+
+  func testDefaultTasksAreNotHeldBackByBackgroundTasks() {
+    schedule("telemetry", priority: .background)
+    schedule("a")
+
+    XCTAssertEqual(started, ["telemetry", "a"])
+  }
+
+  func testBackgroundTasksAreNotStarved() {
+    let scheduler = GraphRequestScheduler(
+      maxConcurrentRequests: 1,
+      maxConcurrentBackgroundRequests: 1,
+      maxDeferral: 0
+    )
+    var startedNames = [String]()
+    scheduler.scheduleTask(with: .default) { _ in startedNames.append("a") }
+    scheduler.scheduleTask(with: .background) { _ in startedNames.append("telemetry") }
+
+    XCTAssertEqual(startedNames, ["a", "telemetry"], "Should start background tasks that waited long enough")
+  }
+
+  func testDeferredBackgroundTasksStartAfterMaxDeferral() {
+    let scheduler = GraphRequestScheduler(
+      maxConcurrentRequests: 1,
+      maxConcurrentBackgroundRequests: 1,
+      maxDeferral: 0.1
+    )
+    let backgroundStarted = expectation(description: name)
+    scheduler.scheduleTask(with: .default) { _ in }
+    scheduler.scheduleTask(with: .background) { _ in backgroundStarted.fulfill() }
+
+    wait(for: [backgroundStarted], timeout: 2)
+    XCTAssertGreaterThanOrEqual(scheduler.metrics(for: .background).maxQueueingDelay, 0.1)
+  }
+
+  func testResettingMetrics() {
+    schedule("a")
+    schedule("b")
+    schedule("c")
+    finishes["a"]?()
+
+    scheduler.resetMetrics()
+
+    let metrics = scheduler.metrics(for: .default)
+    XCTAssertEqual(metrics.startedCount, 0)
+    XCTAssertEqual(metrics.averageQueueingDelay, 0)
+    XCTAssertEqual(metrics.inFlightCount, 2, "Should keep tracking the tasks in flight")
+  }
+}
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+import XCTest
+
+class GraphResponseCacheTests: XCTestCase {
+
+  let cache = GraphResponseCache(directoryURL: nil)
+  // swiftlint:disable:next force_unwrapping
+  let url = URL(string: "https://graph.facebook.com/v12.0/123/app_gatekeepers")!
+  let data = Data(#"{"data":[]}"#.utf8)
+  let date = Date(timeIntervalSince1970: 1_000_000)
+  lazy var key = GraphResponseCache.key(for: url)! // swiftlint:disable:this force_unwrapping
+
+  func response(headers: [String: String], statusCode: Int = 200) -> HTTPURLResponse {
+    // swiftlint:disable:next force_unwrapping
+    HTTPURLResponse(url: url, statusCode: statusCode, httpVersion: "HTTP/1.1", headerFields: headers)!
+  }
+
+  func testKeyDoesNotContainTheURL() {
+    let tokenURL = URL(string: "https://graph.facebook.com/me?access_token=secret")
+
+    XCTAssertFalse(
+      GraphResponseCache.key(for: tokenURL)?.contains("secret") ?? true,
+      "Keys should not leak the tokens in the URL"
+    )
+    XCTAssertNil(GraphResponseCache.key(for: nil))
+  }
+
+  func testStoringWithMaxAge() {
+    let entry = cache.store(
+      response(headers: ["Cache-Control": "max-age=60"]),
+      data: data,
+      object: ["data": []],
+      forKey: key,
+      date: date
+    )
+
+    XCTAssertNotNil(entry)
+    XCTAssertTrue(cache.entry(forKey: key)?.isFresh(at: date.addingTimeInterval(59)) ?? false)
+    XCTAssertFalse(
+      cache.entry(forKey: key)?.isFresh(at: date.addingTimeInterval(61)) ?? true,
+      "Entries should expire after their max age"
+    )
+  }
+
+  func testStoringWithETagOnly() {
+    cache.store(response(headers: ["ETag": "\"abc\""]), data: data, object: nil, forKey: key, date: date)
+
+    let entry = cache.entry(forKey: key)
+    XCTAssertEqual(entry?.eTag, "\"abc\"")
+    XCTAssertFalse(entry?.isFresh(at: date) ?? true, "Entries without a max age should always be revalidated")
+  }
+
+  func testStoringWithoutValidators() {
+    XCTAssertNil(
+      cache.store(response(headers: [:]), data: data, object: nil, forKey: key, date: date),
+      "Should not keep responses that can neither be reused nor revalidated"
+    )
+  }
+
+  func testNoStoreRemovesTheEntry() {
+    cache.store(response(headers: ["ETag": "\"abc\""]), data: data, object: nil, forKey: key, date: date)
+
+    let entry = cache.store(
+      response(headers: ["ETag": "\"abc\"", "Cache-Control": "no-store"]),
+      data: data,
+      object: nil,
+      forKey: key,
+      date: date
+    )
+
+    XCTAssertNil(entry)
+    XCTAssertNil(cache.entry(forKey: key), "A no-store response should evict the previous entry")
+  }
+
+  func testNoCacheIsRevalidated() {
+    cache.store(
+      response(headers: ["ETag": "\"abc\"", "Cache-Control": "no-cache, max-age=60"]),
+      data: data,
+      object: nil,
+      forKey: key,
+      date: date
+    )
+
+    XCTAssertFalse(cache.entry(forKey: key)?.isFresh(at: date) ?? true)
+  }
+
+  func testParsingTheBodyLazily() {
+    cache.store(response(headers: ["ETag": "\"abc\""]), data: data, object: nil, forKey: key, date: date)
+
+    let entry = cache.entry(forKey: key)
+    XCTAssertEqual((entry?.object as? [String: Any])?.keys.first, "data")
+    XCTAssertTrue(entry?.object as AnyObject === entry?.object as AnyObject, "Should parse the body once")
+  }
+
+  func testRefreshingKeepsTheParsedObject() throws {
+    let object = NSDictionary(dictionary: ["data": []])
+    let entry = try XCTUnwrap(
+      cache.store(response(headers: ["ETag": "\"abc\""]), data: data, object: object, forKey: key, date: date)
+    )
+
+    let refreshed = cache.refreshEntry(
+      entry,
+      with: response(headers: ["ETag": "\"abc\"", "Cache-Control": "max-age=60"], statusCode: 304),
+      forKey: key,
+      date: date
+    )
+
+    XCTAssertTrue(refreshed?.object as AnyObject === object, "A revalidation should not parse the body again")
+    XCTAssertTrue(refreshed?.isFresh(at: date.addingTimeInterval(30)) ?? false)
+  }
+
+  func testRemovingEntries() {
+    cache.store(response(headers: ["ETag": "\"abc\""]), data: data, object: nil, forKey: key, date: date)
+
+    cache.removeAllEntries()
+
+    XCTAssertNil(cache.entry(forKey: key))
+  }
+
+  func testRememberingMisses() {
+    XCTAssertNil(cache.entry(forKey: key))
+
+    XCTAssertEqual(cache.entryCount, 1, "Should remember that the key has no entry")
+    XCTAssertNil(cache.entry(forKey: key))
+  }
+
+  func testStoringAfterMiss() {
+    _ = cache.entry(forKey: key)
+
+    cache.store(response(headers: ["ETag": "\"abc\""]), data: data, object: nil, forKey: key, date: date)
+
+    XCTAssertEqual(cache.entry(forKey: key)?.eTag, "\"abc\"", "A stored response should replace a remembered miss")
+  }
+
+  func testEvictingLeastRecentlyUsedEntries() {
+    let cache = GraphResponseCache(directoryURL: nil, countLimit: 2, notificationCenter: nil)
+    for key in ["first", "second"] {
+      cache.store(response(headers: ["ETag": "\"\(key)\""]), data: data, object: nil, forKey: key, date: date)
+    }
+    _ = cache.entry(forKey: "first")
+
+    cache.store(response(headers: ["ETag": "\"third\""]), data: data, object: nil, forKey: "third", date: date)
+
+    XCTAssertEqual(cache.entryCount, 2, "Should not keep more entries than the limit")
+    XCTAssertNotNil(cache.entry(forKey: "first"))
+    XCTAssertNil(cache.entry(forKey: "second"), "Should evict the least recently used entry")
+  }
+
+  func testObservingAccessTokenChanges() {
+    let notificationCenter = TestNotificationCenter()
+    let cache = GraphResponseCache(directoryURL: nil, countLimit: 10, notificationCenter: notificationCenter)
+
+    XCTAssertEqual(
+      notificationCenter.capturedAddObserverInvocations,
+      [
+        TestNotificationCenter.ObserverEvidence(
+          observer: cache,
+          name: .AccessTokenDidChange,
+          selector: #selector(cache._accessTokenDidChange(_:)),
+          object: nil
+        ),
+      ],
+      "Should observe access token changes"
+    )
+  }
+
+  func testEmptyingOnAccessTokenChange() {
+    cache.store(response(headers: ["ETag": "\"abc\""]), data: data, object: nil, forKey: key, date: date)
+
+    cache._accessTokenDidChange(Notification(name: .AccessTokenDidChange))
+
+    XCTAssertNil(cache.entry(forKey: key), "Should not keep the responses of the previous access token")
+  }
+
+  func testPersistence() throws {
+    let directory = FileManager.default.temporaryDirectory
+      .appendingPathComponent("GraphResponseCacheTests-\(UUID().uuidString)")
+    defer { try? FileManager.default.removeItem(at: directory) }
+
+    let writingCache = GraphResponseCache(directoryURL: directory)
+    writingCache.store(
+      response(headers: ["ETag": "\"abc\"", "Cache-Control": "max-age=60"]),
+      data: data,
+      object: nil,
+      forKey: key,
+      date: date
+    )
+    // Reading a missing entry waits for the pending writes.
+    _ = writingCache.entry(forKey: "missing")
+
+    let entry = GraphResponseCache(directoryURL: directory).entry(forKey: key)
+
+    XCTAssertEqual(entry?.eTag, "\"abc\"")
+    XCTAssertEqual(entry?.data, data)
+    XCTAssertTrue(entry?.isFresh(at: date) ?? false, "Should persist the expiration date")
+  }
+}
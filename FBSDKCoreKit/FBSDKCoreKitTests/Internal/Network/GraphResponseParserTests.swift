@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+import XCTest
+
+class GraphResponseParserTests: XCTestCase {
+
+  func testParsingJSON() {
+    let result = GraphResponseParser.object(with: Data(#"{"id":"123"}"#.utf8))
+
+    XCTAssertEqual(result as? [String: String], ["id": "123"])
+  }
+
+  func testParsingFragment() {
+    let result = GraphResponseParser.object(with: Data("true".utf8))
+
+    XCTAssertEqual(result as? Bool, true, "Should accept the JSON fragments returned by some endpoints")
+  }
+
+  func testParsingNonJSON() {
+    let result = GraphResponseParser.object(with: Data("foo=bar".utf8))
+
+    XCTAssertEqual(
+      result as? [String: String],
+      [NonJSONResponseProperty: "foo=bar"],
+      "Should wrap responses that are not JSON"
+    )
+  }
+
+  func testParsingEmptyData() {
+    let result = GraphResponseParser.object(with: Data())
+
+    XCTAssertEqual(result as? [String: String], [NonJSONResponseProperty: ""])
+  }
+
+  func testParsingInvalidUTF8() {
+    XCTAssertNil(GraphResponseParser.object(with: Data([0x0F, 0xB7])), "Should not parse invalid UTF-8")
+  }
+
+  func testLazyBatchResults() throws {
+    let response: [Any] = [
+      ["code": 200, "body": #"{"id":"1"}"#],
+      ["code": 200, "body": "foo=bar"],
+      ["code": 200],
+      "unexpected",
+    ]
+
+    let results = GraphResponseParser.lazyResults(forBatchResponse: response)
+    XCTAssertEqual(results.count, 4)
+
+    let first = try XCTUnwrap(GraphResponseParser.resolvedResult(results[0]) as? [String: Any])
+    XCTAssertEqual(first["code"] as? Int, 200)
+    XCTAssertEqual(first["body"] as? [String: String], ["id": "1"], "Should decode the body when resolved")
+
+    let second = try XCTUnwrap(GraphResponseParser.resolvedResult(results[1]) as? [String: Any])
+    XCTAssertEqual(second["body"] as? [String: String], [NonJSONResponseProperty: "foo=bar"])
+
+    let third = try XCTUnwrap(GraphResponseParser.resolvedResult(results[2]) as? [String: Any])
+    XCTAssertEqual(third["code"] as? Int, 200, "Should keep entries without a body as is")
+    XCTAssertEqual(GraphResponseParser.resolvedResult(results[3]) as? String, "unexpected")
+  }
+
+  func testResolvingTwiceReusesTheParsedBody() throws {
+    let results = GraphResponseParser.lazyResults(forBatchResponse: [["code": 200, "body": #"{"id":"1"}"#]])
+
+    let first = try XCTUnwrap(GraphResponseParser.resolvedResult(results[0]) as? NSDictionary)
+    let second = try XCTUnwrap(GraphResponseParser.resolvedResult(results[0]) as? NSDictionary)
+
+    XCTAssertTrue(first === second, "Should only parse a body once")
+  }
+
+  func testKeepingNonStringBodies() throws {
+    let results = GraphResponseParser.lazyResults(forBatchResponse: [["code": 200, "body": ["id": "1"]]])
+
+    let result = try XCTUnwrap(GraphResponseParser.resolvedResult(results[0]) as? [String: Any])
+    XCTAssertEqual(result["body"] as? [String: String], ["id": "1"])
+  }
+}
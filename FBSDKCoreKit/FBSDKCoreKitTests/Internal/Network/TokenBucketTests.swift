@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+import XCTest
+
+class TokenBucketTests: XCTestCase {
+
+  let start = Date(timeIntervalSince1970: 1_000)
+  let bucket = TokenBucket(capacity: 3, tokensPerSecond: 2)
+
+  func testBurst() {
+    let delays = (0 ..< 3).map { _ in bucket.reserveToken(at: start) }
+
+    XCTAssertEqual(delays, [0, 0, 0], "Should let a full bucket of requests through at once")
+  }
+
+  func testWaitingForTokens() {
+    for _ in 0 ..< 3 {
+      bucket.reserveToken(at: start)
+    }
+
+    XCTAssertEqual(bucket.reserveToken(at: start), 0.5, accuracy: 0.001)
+    XCTAssertEqual(
+      bucket.reserveToken(at: start),
+      1,
+      accuracy: 0.001,
+      "Should queue reservations behind the ones already waiting"
+    )
+  }
+
+  func testRefilling() {
+    for _ in 0 ..< 3 {
+      bucket.reserveToken(at: start)
+    }
+
+    XCTAssertEqual(bucket.availableTokens(at: start.addingTimeInterval(1)), 2, accuracy: 0.001)
+    XCTAssertEqual(
+      bucket.availableTokens(at: start.addingTimeInterval(60)),
+      3,
+      accuracy: 0.001,
+      "Should not refill over the capacity"
+    )
+  }
+
+  func testIgnoringClockGoingBackwards() {
+    bucket.reserveToken(at: start)
+
+    XCTAssertEqual(bucket.availableTokens(at: start.addingTimeInterval(-10)), 2, accuracy: 0.001)
+  }
+}
@@ -37,4 +37,40 @@ class URLSessionProxyFactoryTests: XCTestCase, URLSessionDataDelegate {
       "Session proxies should be unique"
     )
   }
+
+  func testCreatingSessionProxyWithoutQueue() {
+    guard let proxy = factory.createSessionProxy(with: self, queue: nil) as? PooledURLSession else {
+      return XCTFail("Session proxies without a delegate queue should use the pooled session")
+    }
+
+    XCTAssertTrue(
+      proxy.pool === URLSessionPool.shared,
+      "The provided proxy should use the shared session pool"
+    )
+    XCTAssertTrue(
+      proxy.delegate === self,
+      "The provided proxy should use the delegate it was created with"
+    )
+  }
+
+  func testPooledSessionProxiesShareTheSession() {
+    let proxy = factory.createSessionProxy(with: self, queue: nil) as? PooledURLSession
+    let proxy2 = factory.createSessionProxy(with: self, queue: nil) as? PooledURLSession
+
+    XCTAssertFalse(proxy === proxy2, "Session proxies should be unique")
+    XCTAssertTrue(
+      proxy?.pool.session === proxy2?.pool.session,
+      "Pooled session proxies should share the underlying session"
+    )
+  }
+
+  func testInvalidatingPooledSessionProxyKeepsTheSessionValid() {
+    let pool = URLSessionPool(configuration: .ephemeral)
+    let proxy = PooledURLSession(pool: pool, delegate: self, delegateQueue: nil)
+    let session = pool.session
+
+    proxy.invalidateAndCancel()
+
+    XCTAssertTrue(pool.session === session, "Invalidating a proxy should not invalidate the pooled session")
+  }
 }
@@ -6,6 +6,7 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+import TestTools
 import XCTest
 
 class FBSDKServerConfigurationManagerTests: XCTestCase {
@@ -17,6 +18,28 @@ class FBSDKServerConfigurationManagerTests: XCTestCase {
       ServerConfigurationManager.shared.graphRequestFactory,
       "Should not have a graph request factory by default"
     )
+    XCTAssertNil(
+      ServerConfigurationManager.shared.graphRequestConnectionFactory,
+      "Should not have a graph request connection factory by default"
+    )
+  }
+
+  func testRequestToLoadServerConfiguration() {
+    let graphRequestFactory = TestGraphRequestFactory()
+    ServerConfigurationManager.shared.reset()
+    ServerConfigurationManager.shared.configure(
+      graphRequestFactory: graphRequestFactory,
+      graphRequestConnectionFactory: TestGraphRequestConnectionFactory()
+    )
+    defer { ServerConfigurationManager.shared.reset() }
+
+    _ = ServerConfigurationManager.shared.request(toLoadServerConfiguration: name)
+
+    XCTAssertEqual(
+      graphRequestFactory.capturedFlags,
+      [.skipClientToken, .disableErrorRecovery, .useResponseCache, .retryTransientFailures, .usesCircuitBreaker],
+      "Should be held back by the circuit breaker while the server is failing"
+    )
   }
 
   func testParsingResponses() {
@@ -280,7 +280,7 @@ class GateKeeperManagerTests: XCTestCase {
     )
     XCTAssertEqual(
       graphRequestFactory.capturedFlags,
-      [GraphRequestFlags.skipClientToken, GraphRequestFlags.disableErrorRecovery],
+      [.skipClientToken, .disableErrorRecovery, .useResponseCache, .retryTransientFailures, .usesCircuitBreaker],
       "Should provide the expected graph request flags"
     )
   }
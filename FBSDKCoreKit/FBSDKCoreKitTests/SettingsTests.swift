@@ -260,4 +260,11 @@ class SettingsTests: XCTestCase {
       "isGraphErrorRecoveryEnabled should be enabled by default"
     )
   }
+
+  func testDefaultGraphRequestCircuitBreakerEnabled() {
+    XCTAssertTrue(
+      Settings.shared.isGraphRequestCircuitBreakerEnabled,
+      "isGraphRequestCircuitBreakerEnabled should be enabled by default"
+    )
+  }
 }
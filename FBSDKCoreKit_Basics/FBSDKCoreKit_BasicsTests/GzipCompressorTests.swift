@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+import FBSDKCoreKit_Basics
+import XCTest
+
+class GzipCompressorTests: XCTestCase {
+
+  var customEvents = Data()
+
+  override func setUpWithError() throws {
+    try super.setUpWithError()
+
+    customEvents = try Self.customEventsFixture()
+  }
+
+  func testInvalidLevel() {
+    XCTAssertNil(GzipCompressor(level: 10, strategy: .default), "Should not create a compressor with an invalid level")
+  }
+
+  func testOnePass() throws {
+    let compressed = try XCTUnwrap(gzip(customEvents))
+
+    XCTAssertEqual(try decompress(compressed), customEvents)
+    XCTAssertLessThan(compressed.count, customEvents.count / 4, "Event JSON should compress well")
+  }
+
+  func testEmptyDataIsNotCompressed() {
+    XCTAssertNil(gzip(Data()))
+    XCTAssertNil(BasicUtility.gzip(Data()))
+  }
+
+  func testBasicUtilityMatchesOnePass() {
+    XCTAssertEqual(BasicUtility.gzip(customEvents), gzip(customEvents))
+  }
+
+  func testIncrementalMatchesOnePass() throws {
+    let compressor = try XCTUnwrap(GzipCompressor(level: GzipCompressionLevelDefault, strategy: .default))
+    var compressed = Data()
+    var offset = 0
+    while offset < customEvents.count {
+      let end = min(offset + 10_000, customEvents.count)
+      compressed.append(try XCTUnwrap(compressor.update(with: customEvents.subdata(in: offset ..< end))))
+      offset = end
+    }
+    compressed.append(try XCTUnwrap(compressor.finish()))
+
+    XCTAssertEqual(compressed, gzip(customEvents))
+    XCTAssertEqual(compressor.totalBytesIn, UInt64(customEvents.count))
+    XCTAssertEqual(compressor.totalBytesOut, UInt64(compressed.count))
+  }
+
+  func testFinishingTwice() throws {
+    let compressor = try XCTUnwrap(GzipCompressor(level: 1, strategy: .default))
+    XCTAssertNotNil(compressor.finish())
+
+    XCTAssertNil(compressor.finish(), "Should not finish twice")
+    XCTAssertNil(compressor.update(with: customEvents), "Should not accept input once finished")
+  }
+
+  func testStrategies() throws {
+    let strategies: [GzipStrategy] = [.default, .filtered, .huffmanOnly, .RLE, .fixed]
+    for strategy in strategies {
+      let compressed = try XCTUnwrap(GzipCompressor.gzip(customEvents, level: 6, strategy: strategy))
+      XCTAssertEqual(
+        try decompress(compressed),
+        customEvents,
+        "Should round trip with strategy \(strategy.rawValue)"
+      )
+    }
+  }
+
+  func testParallel() throws {
+    let compressed = try XCTUnwrap(parallelGzip(customEvents, chunkSize: 32 * 1024))
+
+    XCTAssertEqual(try decompress(compressed), customEvents)
+  }
+
+  func testParallelWithSmallDataUsesOnePass() {
+    let data = Data(#"{"event":"fb_mobile_activate_app"}"#.utf8)
+
+    XCTAssertEqual(parallelGzip(data, chunkSize: 32 * 1024), gzip(data))
+  }
+
+  func testHigherLevelsCompressBetter() throws {
+    let sizes = try [1, 6, 9].map { level -> Int in
+      let compressed = try XCTUnwrap(GzipCompressor.gzip(customEvents, level: level, strategy: .default))
+      XCTAssertEqual(try decompress(compressed), customEvents, "Should round trip with level \(level)")
+      return compressed.count
+    }
+
+    XCTAssertLessThanOrEqual(sizes[1], sizes[0], "The default level should compress at least as well as level 1")
+    XCTAssertLessThanOrEqual(sizes[2], sizes[1], "Level 9 should compress at least as well as the default level")
+  }
+
+  // MARK: - Benchmarks
+
+  func testPerformanceLevel1() throws {
+    try measureGzip { GzipCompressor.gzip($0, level: 1, strategy: .default) }
+  }
+
+  func testPerformanceLevel9() throws {
+    try measureGzip { GzipCompressor.gzip($0, level: 9, strategy: .default) }
+  }
+
+  func testPerformanceOnePass() throws {
+    try measureGzip { gzip($0) }
+  }
+
+  func testPerformanceParallel() throws {
+    try measureGzip { parallelGzip($0, chunkSize: 32 * 1024) }
+  }
+
+  /// Measures the time, throughput and compression ratio of compressing the fixture a few times per iteration.
+  func measureGzip(_ compress: (Data) -> Data?) throws {
+    guard #available(iOS 13.0, tvOS 13.0, *) else { throw XCTSkip("Requires custom performance metrics") }
+
+    let events = customEvents
+    let repetitions = 10
+    let metric = GzipMetric(inputSize: events.count * repetitions)
+    measure(metrics: [XCTClockMetric(), metric]) {
+      metric.outputSize = (0 ..< repetitions).reduce(0) { size, _ in size + (compress(events)?.count ?? 0) }
+    }
+  }
+
+  // MARK: - Helpers
+
+  func gzip(_ data: Data) -> Data? {
+    GzipCompressor.gzip(data, level: GzipCompressionLevelDefault, strategy: .default)
+  }
+
+  func parallelGzip(_ data: Data, chunkSize: UInt) -> Data? {
+    GzipCompressor.parallelGzip(data, level: GzipCompressionLevelDefault, strategy: .default, chunkSize: chunkSize)
+  }
+
+  /// Decompresses gzip data by inflating its raw deflate payload and checking the size in the trailer.
+  func decompress(_ data: Data) throws -> Data {
+    guard #available(iOS 13.0, tvOS 13.0, *) else { throw XCTSkip("Requires the Compression framework") }
+
+    XCTAssertEqual(Array(data.prefix(3)), [0x1F, 0x8B, 0x08], "Should start with a gzip header")
+    let deflated = data.subdata(in: 10 ..< data.count - 8)
+    let inflated = try (deflated as NSData).decompressed(using: .zlib) as Data
+    let trailer = Array(data.suffix(4))
+    let size = trailer.enumerated().reduce(UInt32(0)) { $0 | UInt32($1.element) << (8 * UInt32($1.offset)) }
+    XCTAssertEqual(size, UInt32(truncatingIfNeeded: inflated.count), "The trailer should hold the input size")
+    return inflated
+  }
+
+  /// A `custom_events` payload of 1000 app events, as sent when flushing.
+  static func customEventsFixture() throws -> Data {
+    let url = try XCTUnwrap(Bundle(for: GzipCompressorTests.self).url(forResource: "custom_events", withExtension: "json"))
+    return try Data(contentsOf: url, options: .mappedIfSafe)
+  }
+}
+
+/// Reports the throughput and compression ratio of the gzip calls made in a measured block.
+@available(iOS 13.0, tvOS 13.0, *)
+final class GzipMetric: NSObject, XCTMetric {
+  let inputSize: Int
+  var outputSize = 0
+
+  init(inputSize: Int) {
+    self.inputSize = inputSize
+  }
+
+  func copy(with zone: NSZone? = nil) -> Any {
+    self
+  }
+
+  func reportMeasurements(
+    from startTime: XCTPerformanceMeasurementTimestamp,
+    to endTime: XCTPerformanceMeasurementTimestamp
+  ) throws -> [XCTPerformanceMeasurement] {
+    let seconds = Double(endTime.absoluteTimeNanoSeconds - startTime.absoluteTimeNanoSeconds) / Double(NSEC_PER_SEC)
+    return [
+      XCTPerformanceMeasurement(
+        identifier: "com.facebook.sdk.gzip.throughput",
+        displayName: "Throughput",
+        doubleValue: Double(inputSize) / max(seconds, .leastNonzeroMagnitude) / 1_000_000,
+        unitSymbol: "MB/s"
+      ),
+      XCTPerformanceMeasurement(
+        identifier: "com.facebook.sdk.gzip.ratio",
+        displayName: "Compression Ratio",
+        doubleValue: Double(inputSize) / Double(max(outputSize, 1)),
+        unitSymbol: "x"
+      ),
+    ]
+  }
+}
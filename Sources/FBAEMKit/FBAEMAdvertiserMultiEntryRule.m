@@ -35,14 +35,15 @@ static NSString *const RULES_KEY = @"rules";
     BOOL isMatched = _operator == FBAEMAdvertiserRuleOperatorOr ? NO : YES;
     for (id<FBAEMAdvertiserRuleMatching> rule in _rules) {
       BOOL doesSubruleMatch = [rule isMatchedEventParameters:eventParams];
-      if (_operator == FBAEMAdvertiserRuleOperatorAnd) {
-        isMatched = isMatched & doesSubruleMatch;
+      // Stop as soon as the remaining subrules cannot change the result.
+      if (_operator == FBAEMAdvertiserRuleOperatorAnd && !doesSubruleMatch) {
+        return NO;
       }
-      if (_operator == FBAEMAdvertiserRuleOperatorOr) {
-        isMatched = isMatched | doesSubruleMatch;
+      if (_operator == FBAEMAdvertiserRuleOperatorOr && doesSubruleMatch) {
+        return YES;
       }
-      if (_operator == FBAEMAdvertiserRuleOperatorNot) {
-        isMatched = isMatched & !doesSubruleMatch;
+      if (_operator == FBAEMAdvertiserRuleOperatorNot && doesSubruleMatch) {
+        return NO;
       }
     }
     return isMatched;
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import "TargetConditionals.h"
+
+#if !TARGET_OS_TV
+
+ #import <Foundation/Foundation.h>
+
+#import "FBAEMAdvertiserRuleOperator.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ The condition of a single entry advertiser rule, prepared for matching.
+
+ The parameter path is split, case insensitive conditions lowercased, `is_any` lists hashed and regular
+ expressions built once, when the condition is created, rather than for every event matched.
+ */
+NS_SWIFT_NAME(AEMAdvertiserRuleCondition)
+@interface FBAEMAdvertiserRuleCondition : NSObject
+
+@property (nonatomic, readonly) FBAEMAdvertiserRuleOperator operator;
+
+/// Whether the condition has a parameter path, a known operator and the value that operator compares with.
+/// Invalid conditions never match.
+@property (nonatomic, readonly) BOOL isValid;
+
+- (instancetype)init NS_UNAVAILABLE;
++ (instancetype)new NS_UNAVAILABLE;
+
+- (instancetype)initWithOperator:(FBAEMAdvertiserRuleOperator)op
+                        paramKey:(nullable NSString *)paramKey
+             linguisticCondition:(nullable NSString *)linguisticCondition
+              numericalCondition:(nullable NSNumber *)numericalCondition
+                  arrayCondition:(nullable NSArray *)arrayCondition;
+
+/// Whether the value at the parameter path of the event parameters matches the condition.
+- (BOOL)matchesParameters:(nullable id)parameters;
+
+/// Whether a parameter value matches the condition.
+- (BOOL)matchesValue:(nullable id)value;
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+#endif
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#if !TARGET_OS_TV
+
+#import "FBAEMAdvertiserRuleCondition.h"
+
+#import "FBCoreKitBasicsImportForAEMKit.h"
+
+static NSString *const PARAM_DELIMETER = @".";
+static NSString *const ASTERISK_DELIMETER = @"[*]";
+
+@interface FBAEMAdvertiserRuleCondition ()
+
+@property (nonatomic, readonly) NSArray<NSString *> *keys;
+// Whether the key at each index of the path refers to an array whose items are all tried.
+@property (nonatomic, readonly) NSData *fanOut;
+@property (nullable, nonatomic, readonly) NSString *linguisticCondition;
+@property (nullable, nonatomic, readonly) NSNumber *numericalCondition;
+@property (nullable, nonatomic, readonly) NSSet<NSString *> *setCondition;
+@property (nullable, nonatomic, readonly) NSRegularExpression *regex;
+@property (nonatomic, readonly) BOOL comparesNumbers;
+@property (nonatomic, readonly) BOOL ignoresCase;
+
+@end
+
+@implementation FBAEMAdvertiserRuleCondition
+
+- (instancetype)initWithOperator:(FBAEMAdvertiserRuleOperator)op
+                        paramKey:(nullable NSString *)paramKey
+             linguisticCondition:(nullable NSString *)linguisticCondition
+              numericalCondition:(nullable NSNumber *)numericalCondition
+                  arrayCondition:(nullable NSArray *)arrayCondition
+{
+  if ((self = [super init])) {
+    _operator = op;
+    _keys = @[];
+    _fanOut = [NSData data];
+    _isValid = [self prepareWithParamKey:[FBSDKTypeUtility stringValueOrNil:paramKey]
+                   linguisticCondition:linguisticCondition
+                    numericalCondition:numericalCondition
+                        arrayCondition:arrayCondition];
+  }
+  return self;
+}
+
+- (BOOL)prepareWithParamKey:(nullable NSString *)paramKey
+        linguisticCondition:(nullable NSString *)linguisticCondition
+         numericalCondition:(nullable NSNumber *)numericalCondition
+             arrayCondition:(nullable NSArray *)arrayCondition
+{
+  if (!paramKey) {
+    return NO;
+  }
+  NSMutableArray<NSString *> *keys = [NSMutableArray new];
+  NSMutableData *fanOut = [NSMutableData new];
+  for (NSString *component in [paramKey componentsSeparatedByString:PARAM_DELIMETER]) {
+    BOOL isFanOut = [component hasSuffix:ASTERISK_DELIMETER];
+    NSString *key = isFanOut ? [component substringToIndex:component.length - ASTERISK_DELIMETER.length] : component;
+    [FBSDKTypeUtility array:keys addObject:key];
+    [fanOut appendBytes:&isFanOut length:sizeof(BOOL)];
+  }
+  _keys = [keys copy];
+  _fanOut = [fanOut copy];
+  _ignoresCase = _operator == FBAEMAdvertiserRuleOperatorI_Contains
+  || _operator == FBAEMAdvertiserRuleOperatorI_NotContains
+  || _operator == FBAEMAdvertiserRuleOperatorI_StartsWith
+  || _operator == FBAEMAdvertiserRuleOperatorI_IsAny
+  || _operator == FBAEMAdvertiserRuleOperatorI_IsNotAny;
+
+  switch (_operator) {
+    case FBAEMAdvertiserRuleOperatorContains:
+    case FBAEMAdvertiserRuleOperatorNotContains:
+    case FBAEMAdvertiserRuleOperatorStartsWith:
+    case FBAEMAdvertiserRuleOperatorI_Contains:
+    case FBAEMAdvertiserRuleOperatorI_NotContains:
+    case FBAEMAdvertiserRuleOperatorI_StartsWith:
+    case FBAEMAdvertiserRuleOperatorEqual:
+    case FBAEMAdvertiserRuleOperatorNotEqual:
+      _linguisticCondition = _ignoresCase ? linguisticCondition.lowercaseString : linguisticCondition;
+      return _linguisticCondition != nil;
+    case FBAEMAdvertiserRuleOperatorRegexMatch:
+      if (linguisticCondition.length) {
+        _regex = [NSRegularExpression regularExpressionWithPattern:linguisticCondition options:0 error:nil];
+      }
+      // A missing or invalid pattern never matches.
+      return YES;
+    case FBAEMAdvertiserRuleOperatorLessThan:
+    case FBAEMAdvertiserRuleOperatorLessThanOrEqual:
+    case FBAEMAdvertiserRuleOperatorGreaterThan:
+    case FBAEMAdvertiserRuleOperatorGreaterThanOrEqual:
+      _comparesNumbers = YES;
+      _numericalCondition = numericalCondition;
+      return _numericalCondition != nil;
+    case FBAEMAdvertiserRuleOperatorI_IsAny:
+    case FBAEMAdvertiserRuleOperatorI_IsNotAny:
+    case FBAEMAdvertiserRuleOperatorIsAny:
+    case FBAEMAdvertiserRuleOperatorIsNotAny: {
+      NSMutableSet<NSString *> *set = [NSMutableSet new];
+      for (id item in arrayCondition) {
+        NSString *string = [FBSDKTypeUtility stringValueOrNil:item];
+        if (string) {
+          [set addObject:_ignoresCase ? string.lowercaseString : string];
+        }
+      }
+      _setCondition = [set copy];
+      return YES;
+    }
+    default:
+      return NO;
+  }
+}
+
+#pragma mark - Matching
+
+- (BOOL)matchesParameters:(nullable id)parameters
+{
+  if (!self.isValid) {
+    return NO;
+  }
+  return [self matchesParameters:parameters atIndex:0 fanOut:self.fanOut.bytes];
+}
+
+- (BOOL)matchesParameters:(nullable id)parameters
+                  atIndex:(NSUInteger)index
+                   fanOut:(const BOOL *)fanOut
+{
+  NSDictionary<NSString *, id> *dictionary = [FBSDKTypeUtility dictionaryValue:parameters];
+  NSArray<NSString *> *keys = self.keys;
+  if (!dictionary || index >= keys.count) {
+    return NO;
+  }
+  NSString *key = keys[index];
+  BOOL isLast = index + 1 == keys.count;
+  if (fanOut[index]) {
+    NSArray *items = [FBSDKTypeUtility dictionary:dictionary objectForKey:key ofType:NSArray.class];
+    if (!items.count || isLast) {
+      return NO;
+    }
+    for (id item in items) {
+      if ([self matchesParameters:item atIndex:index + 1 fanOut:fanOut]) {
+        return YES;
+      }
+    }
+    return NO;
+  }
+  id value = dictionary[key];
+  if (!value) {
+    return NO;
+  }
+  if (isLast) {
+    return [self matchesValue:value];
+  }
+  return [self matchesParameters:value atIndex:index + 1 fanOut:fanOut];
+}
+
+- (BOOL)matchesValue:(nullable id)value
+{
+  if (!self.isValid) {
+    return NO;
+  }
+  if (self.comparesNumbers) {
+    NSNumber *number = [value isKindOfClass:NSNumber.class] ? value : nil;
+    if (number == nil) {
+      return NO;
+    }
+    NSComparisonResult result = [number compare:self.numericalCondition];
+    switch (self.operator) {
+      case FBAEMAdvertiserRuleOperatorLessThan: return result == NSOrderedAscending;
+      case FBAEMAdvertiserRuleOperatorLessThanOrEqual: return result != NSOrderedDescending;
+      case FBAEMAdvertiserRuleOperatorGreaterThan: return result == NSOrderedDescending;
+      case FBAEMAdvertiserRuleOperatorGreaterThanOrEqual: return result != NSOrderedAscending;
+      default: return NO;
+    }
+  }
+
+  NSString *string = [value isKindOfClass:NSString.class] ? value : nil;
+  if (string && self.ignoresCase) {
+    string = string.lowercaseString;
+  }
+  switch (self.operator) {
+    case FBAEMAdvertiserRuleOperatorContains:
+    case FBAEMAdvertiserRuleOperatorI_Contains:
+      return string && [string containsString:self.linguisticCondition];
+    case FBAEMAdvertiserRuleOperatorNotContains:
+    case FBAEMAdvertiserRuleOperatorI_NotContains:
+      return !(string && [string containsString:self.linguisticCondition]);
+    case FBAEMAdvertiserRuleOperatorStartsWith:
+    case FBAEMAdvertiserRuleOperatorI_StartsWith:
+      return string && [string hasPrefix:self.linguisticCondition];
+    case FBAEMAdvertiserRuleOperatorRegexMatch:
+      return string && self.regex
+      && [self.regex firstMatchInString:string options:0 range:NSMakeRange(0, string.length)] != nil;
+    case FBAEMAdvertiserRuleOperatorEqual:
+      return string && [string isEqualToString:self.linguisticCondition];
+    case FBAEMAdvertiserRuleOperatorNotEqual:
+      return !(string && [string isEqualToString:self.linguisticCondition]);
+    case FBAEMAdvertiserRuleOperatorIsAny:
+    case FBAEMAdvertiserRuleOperatorI_IsAny:
+      return string && [self.setCondition containsObject:string];
+    case FBAEMAdvertiserRuleOperatorIsNotAny:
+    case FBAEMAdvertiserRuleOperatorI_IsNotAny:
+      return !(string && [self.setCondition containsObject:string]);
+    default:
+      return NO;
+  }
+}
+
+@end
+
+#endif
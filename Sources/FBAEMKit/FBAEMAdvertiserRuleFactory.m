@@ -11,6 +11,7 @@
 #import "FBAEMAdvertiserRuleFactory.h"
 
 #import "FBAEMAdvertiserMultiEntryRule.h"
+#import "FBAEMAdvertiserRuleProgram.h"
 #import "FBAEMAdvertiserSingleEntryRule.h"
 #import "FBCoreKitBasicsImportForAEMKit.h"
 
@@ -23,8 +24,10 @@
     if (!json) {
       return nil;
     }
-    NSDictionary<NSString *, id> *rule = [FBSDKBasicUtility objectForJSONString:json error:nil];
-    return [self createRuleWithDict:rule];
+    NSDictionary<NSString *, id> *dict = [FBSDKBasicUtility objectForJSONString:json error:nil];
+    id<FBAEMAdvertiserRuleMatching> rule = [self createRuleWithDict:dict];
+    // Compile the tree once here rather than walking it for every event.
+    return [FBAEMAdvertiserRuleProgram programWithRule:rule] ?: rule;
   } @catch (NSException *exception) {
     NSLog(@"Fail to parse Advertiser Rules with JSON");
   }
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import "TargetConditionals.h"
+
+#if !TARGET_OS_TV
+
+ #import <Foundation/Foundation.h>
+
+#import "FBAEMAdvertiserRuleMatching.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ An advertiser rule tree compiled into a flat list of instructions.
+
+ The instructions test the conditions the single entry rules prepared when they were created.
+ AND, OR and NOT short circuit with jumps, so matching an event is a single pass over the
+ instructions that stops as soon as the result is known.
+
+ Archiving a program archives the rule tree it was compiled from.
+ */
+NS_SWIFT_NAME(AEMAdvertiserRuleProgram)
+@interface FBAEMAdvertiserRuleProgram : NSObject <FBAEMAdvertiserRuleMatching, NSCopying>
+
+/// The rule tree the program was compiled from.
+@property (nonatomic, readonly) id<FBAEMAdvertiserRuleMatching> rule;
+
+@property (nonatomic, readonly) NSUInteger instructionCount;
+
+- (instancetype)init NS_UNAVAILABLE;
++ (instancetype)new NS_UNAVAILABLE;
+
+/**
+ Compiles a tree of `FBAEMAdvertiserSingleEntryRule` and `FBAEMAdvertiserMultiEntryRule`.
+ Returns nil when the tree contains other kinds of rules, or rules missing their operator or condition;
+ such trees should be matched as they are.
+ */
++ (nullable instancetype)programWithRule:(nullable id<FBAEMAdvertiserRuleMatching>)rule;
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+#endif
@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#if !TARGET_OS_TV
+
+#import "FBAEMAdvertiserRuleProgram.h"
+
+#import "FBAEMAdvertiserMultiEntryRule.h"
+#import "FBAEMAdvertiserRuleCondition.h"
+#import "FBAEMAdvertiserSingleEntryRule.h"
+#import "FBCoreKitBasicsImportForAEMKit.h"
+
+typedef NS_ENUM(uint8_t, FBAEMAdvertiserRuleOpcode) {
+  // Sets the result to whether the condition at `operand` matches.
+  FBAEMAdvertiserRuleOpcodeTest,
+  // Continues at `operand` when the result is NO.
+  FBAEMAdvertiserRuleOpcodeJumpIfFalse,
+  // Continues at `operand` when the result is YES.
+  FBAEMAdvertiserRuleOpcodeJumpIfTrue,
+  FBAEMAdvertiserRuleOpcodeNegate,
+};
+
+typedef struct {
+  FBAEMAdvertiserRuleOpcode opcode;
+  NSUInteger operand;
+} FBAEMAdvertiserRuleInstruction;
+
+@interface FBAEMAdvertiserRuleProgram ()
+
+@property (nonatomic, readonly) NSArray<FBAEMAdvertiserRuleCondition *> *conditions;
+@property (nonatomic, readonly) NSData *instructions;
+
+@end
+
+@implementation FBAEMAdvertiserRuleProgram
+
++ (nullable instancetype)programWithRule:(nullable id<FBAEMAdvertiserRuleMatching>)rule
+{
+  if (!rule) {
+    return nil;
+  }
+  if ([(NSObject *)rule isKindOfClass:FBAEMAdvertiserRuleProgram.class]) {
+    return (FBAEMAdvertiserRuleProgram *)rule;
+  }
+  NSMutableData *instructions = [NSMutableData new];
+  NSMutableArray<FBAEMAdvertiserRuleCondition *> *conditions = [NSMutableArray new];
+  @try {
+    if (![self compileRule:rule instructions:instructions conditions:conditions]) {
+      return nil;
+    }
+  } @catch (NSException *exception) {
+    return nil;
+  }
+  return [[self alloc] initWithRule:rule instructions:instructions conditions:conditions];
+}
+
+- (instancetype)initWithRule:(id<FBAEMAdvertiserRuleMatching>)rule
+                instructions:(NSData *)instructions
+                  conditions:(NSArray<FBAEMAdvertiserRuleCondition *> *)conditions
+{
+  if ((self = [super init])) {
+    _rule = rule;
+    _instructions = [instructions copy];
+    _conditions = [conditions copy];
+  }
+  return self;
+}
+
+- (NSUInteger)instructionCount
+{
+  return self.instructions.length / sizeof(FBAEMAdvertiserRuleInstruction);
+}
+
+#pragma mark - Compiling
+
++ (void)appendOpcode:(FBAEMAdvertiserRuleOpcode)opcode
+             operand:(NSUInteger)operand
+      toInstructions:(NSMutableData *)instructions
+{
+  FBAEMAdvertiserRuleInstruction instruction = {opcode, operand};
+  [instructions appendBytes:&instruction length:sizeof(instruction)];
+}
+
++ (BOOL)compileRule:(id<FBAEMAdvertiserRuleMatching>)rule
+       instructions:(NSMutableData *)instructions
+         conditions:(NSMutableArray<FBAEMAdvertiserRuleCondition *> *)conditions
+{
+  if ([(NSObject *)rule isKindOfClass:FBAEMAdvertiserSingleEntryRule.class]) {
+    // The program shares the condition the rule prepared when it was created.
+    FBAEMAdvertiserRuleCondition *condition = ((FBAEMAdvertiserSingleEntryRule *)rule).condition;
+    if (!condition.isValid) {
+      return NO;
+    }
+    [self appendOpcode:FBAEMAdvertiserRuleOpcodeTest operand:conditions.count toInstructions:instructions];
+    [FBSDKTypeUtility array:conditions addObject:condition];
+    return YES;
+  }
+  if (![(NSObject *)rule isKindOfClass:FBAEMAdvertiserMultiEntryRule.class]) {
+    return NO;
+  }
+  FBAEMAdvertiserMultiEntryRule *multiEntryRule = (FBAEMAdvertiserMultiEntryRule *)rule;
+  NSArray<id<FBAEMAdvertiserRuleMatching>> *subrules = multiEntryRule.rules;
+  if (!subrules.count) {
+    return NO;
+  }
+  // AND stops at the first subrule that does not match, OR and NOT at the first one that does.
+  FBAEMAdvertiserRuleOpcode jump;
+  switch (multiEntryRule.operator) {
+    case FBAEMAdvertiserRuleOperatorAnd: jump = FBAEMAdvertiserRuleOpcodeJumpIfFalse; break;
+    case FBAEMAdvertiserRuleOperatorOr:
+    case FBAEMAdvertiserRuleOperatorNot: jump = FBAEMAdvertiserRuleOpcodeJumpIfTrue; break;
+    default: return NO;
+  }
+  NSMutableArray<NSNumber *> *jumpIndexes = [NSMutableArray new];
+  for (NSUInteger i = 0; i < subrules.count; i++) {
+    if (![self compileRule:subrules[i] instructions:instructions conditions:conditions]) {
+      return NO;
+    }
+    if (i + 1 < subrules.count) {
+      [FBSDKTypeUtility array:jumpIndexes addObject:@(instructions.length / sizeof(FBAEMAdvertiserRuleInstruction))];
+      [self appendOpcode:jump operand:0 toInstructions:instructions];
+    }
+  }
+  // Every jump lands after the last subrule, where the result is the one that ended the walk.
+  NSUInteger end = instructions.length / sizeof(FBAEMAdvertiserRuleInstruction);
+  FBAEMAdvertiserRuleInstruction *code = instructions.mutableBytes;
+  for (NSNumber *index in jumpIndexes) {
+    code[index.unsignedIntegerValue].operand = end;
+  }
+  if (multiEntryRule.operator == FBAEMAdvertiserRuleOperatorNot) {
+    // NOT matches when none of its subrules match.
+    [self appendOpcode:FBAEMAdvertiserRuleOpcodeNegate operand:0 toInstructions:instructions];
+  }
+  return YES;
+}
+
+#pragma mark - FBAEMAdvertiserRuleMatching
+
+- (BOOL)isMatchedEventParameters:(nullable NSDictionary<NSString *, id> *)eventParams
+{
+  @try {
+    const FBAEMAdvertiserRuleInstruction *code = self.instructions.bytes;
+    NSUInteger count = self.instructionCount;
+    NSArray<FBAEMAdvertiserRuleCondition *> *conditions = self.conditions;
+    BOOL result = NO;
+    NSUInteger pc = 0;
+    while (pc < count) {
+      FBAEMAdvertiserRuleInstruction instruction = code[pc++];
+      switch (instruction.opcode) {
+        case FBAEMAdvertiserRuleOpcodeTest:
+          result = [conditions[instruction.operand] matchesParameters:eventParams]; break;
+        case FBAEMAdvertiserRuleOpcodeJumpIfFalse:
+          if (!result) {
+            pc = instruction.operand;
+          }
+          break;
+        case FBAEMAdvertiserRuleOpcodeJumpIfTrue:
+          if (result) {
+            pc = instruction.operand;
+          }
+          break;
+        case FBAEMAdvertiserRuleOpcodeNegate:
+          result = !result; break;
+      }
+    }
+    return result;
+  } @catch (NSException *exception) {
+  #if DEBUG
+  #if FBTEST
+    @throw exception;
+  #endif
+  #endif
+    return NO;
+  }
+}
+
+#pragma mark - NSCoding
+
+- (id)replacementObjectForCoder:(NSCoder *)coder
+{
+  // Archives keep the rule tree so that they stay readable by every version of the SDK.
+  return self.rule;
+}
+
+#pragma mark - NSCopying
+
+- (instancetype)copyWithZone:(NSZone *)zone
+{
+  return self;
+}
+
+@end
+
+#endif
@@ -12,6 +12,7 @@
 
  #import <Foundation/Foundation.h>
 
+#import "FBAEMAdvertiserRuleCondition.h"
 #import "FBAEMAdvertiserRuleMatching.h"
 #import "FBAEMAdvertiserRuleOperator.h"
 
@@ -25,6 +26,8 @@ NS_SWIFT_NAME(AEMAdvertiserSingleEntryRule)
 @property (nullable, nonatomic, readonly) NSString *linguisticCondition;
 @property (nullable, nonatomic, readonly) NSNumber *numericalCondition;
 @property (nullable, nonatomic, readonly) NSArray *arrayCondition;
+/// The conditions prepared for matching, shared with the programs the rule is compiled into.
+@property (nonatomic, readonly) FBAEMAdvertiserRuleCondition *condition;
 
 - (instancetype)init NS_UNAVAILABLE;
 + (instancetype)new NS_UNAVAILABLE;
@@ -10,15 +10,11 @@
 
 #import "FBAEMAdvertiserSingleEntryRule.h"
 
-#import "FBCoreKitBasicsImportForAEMKit.h"
-
 static NSString *const OPERATOR_KEY = @"operator";
 static NSString *const PARAMKEY_KEY = @"param_key";
 static NSString *const STRING_VALUE_KEY = @"string_value";
 static NSString *const NUMBER_VALUE_KEY = @"number_value";
 static NSString *const ARRAY_VALUE_KEY = @"array_value";
-static NSString *const PARAM_DELIMETER = @".";
-static NSString *const ASTERISK_DELIMETER = @"[*]";
 
 @implementation FBAEMAdvertiserSingleEntryRule
 
@@ -34,17 +30,26 @@ static NSString *const ASTERISK_DELIMETER = @"[*]";
     _linguisticCondition = linguisticCondition;
     _numericalCondition = numericalCondition;
     _arrayCondition = arrayCondition;
+    _condition = [self conditionWithOperator:op];
   }
   return self;
 }
 
+- (FBAEMAdvertiserRuleCondition *)conditionWithOperator:(FBAEMAdvertiserRuleOperator)op
+{
+  return [[FBAEMAdvertiserRuleCondition alloc] initWithOperator:op
+                                                       paramKey:_paramKey
+                                            linguisticCondition:_linguisticCondition
+                                             numericalCondition:_numericalCondition
+                                                 arrayCondition:_arrayCondition];
+}
+
 #pragma mark - FBAEMAdvertiserRuleMatching
 
 - (BOOL)isMatchedEventParameters:(nullable NSDictionary<NSString *, id> *)eventParams
 {
   @try {
-    NSArray<NSString *> *paramPath = [_paramKey componentsSeparatedByString:PARAM_DELIMETER];
-    return [self isMatchedEventParameters:eventParams paramPath:paramPath];
+    return [_condition matchesParameters:eventParams];
   } @catch (NSException *exception) {
   #if DEBUG
   #if FBTEST
@@ -55,153 +60,6 @@ static NSString *const ASTERISK_DELIMETER = @"[*]";
   }
 }
 
-- (BOOL)isMatchedEventParameters:(nullable NSDictionary<NSString *, id> *)eventParams
-                       paramPath:(NSArray<NSString *> *)paramPath
-{
-  eventParams = [FBSDKTypeUtility dictionaryValue:eventParams];
-  if (!eventParams || !paramPath.count) {
-    return NO;
-  }
-  NSString *param = [FBSDKTypeUtility stringValueOrNil:paramPath.firstObject];
-  if ([param hasSuffix:ASTERISK_DELIMETER]) {
-    return [self isMatchedWithAsteriskParam:param eventParameters:eventParams paramPath:paramPath];
-  }
-  // if data does not contain the key, we should return false directly.
-  if (!param || ![[eventParams allKeys] containsObject:param]) {
-    return NO;
-  }
-  // Apply operator rule if the last param is reached
-  if (paramPath.count == 1) {
-    NSString *stringValue = nil;
-    NSNumber *numericalValue = nil;
-    switch (_operator) {
-      case FBAEMAdvertiserRuleOperatorContains:
-      case FBAEMAdvertiserRuleOperatorNotContains:
-      case FBAEMAdvertiserRuleOperatorStartsWith:
-      case FBAEMAdvertiserRuleOperatorI_Contains:
-      case FBAEMAdvertiserRuleOperatorI_NotContains:
-      case FBAEMAdvertiserRuleOperatorI_StartsWith:
-      case FBAEMAdvertiserRuleOperatorRegexMatch:
-      case FBAEMAdvertiserRuleOperatorEqual:
-      case FBAEMAdvertiserRuleOperatorNotEqual:
-      case FBAEMAdvertiserRuleOperatorI_IsAny:
-      case FBAEMAdvertiserRuleOperatorI_IsNotAny:
-      case FBAEMAdvertiserRuleOperatorIsAny:
-      case FBAEMAdvertiserRuleOperatorIsNotAny:
-        stringValue = [FBSDKTypeUtility dictionary:eventParams objectForKey:param ofType:NSString.class]; break;
-      case FBAEMAdvertiserRuleOperatorLessThan:
-      case FBAEMAdvertiserRuleOperatorLessThanOrEqual:
-      case FBAEMAdvertiserRuleOperatorGreaterThan:
-      case FBAEMAdvertiserRuleOperatorGreaterThanOrEqual:
-        numericalValue = [FBSDKTypeUtility dictionary:eventParams objectForKey:param ofType:NSNumber.class]; break;
-      default: break;
-    }
-    return [self isMatchedWithStringValue:stringValue numericalValue:numericalValue];
-  }
-  NSDictionary<NSString *, id> *subParams = [FBSDKTypeUtility dictionary:eventParams objectForKey:param ofType:NSDictionary.class];
-  NSRange range = NSMakeRange(1, paramPath.count - 1);
-  NSArray *subParamPath = [paramPath subarrayWithRange:range];
-  return [self isMatchedEventParameters:subParams paramPath:subParamPath];
-}
-
-- (BOOL)isMatchedWithAsteriskParam:(NSString *)param
-                   eventParameters:(NSDictionary<NSString *, id> *)eventParams
-                         paramPath:(NSArray<NSString *> *)paramPath
-{
-  param = [param substringToIndex:param.length - ASTERISK_DELIMETER.length];
-  NSArray<NSDictionary<NSString *, id> *> *items = [FBSDKTypeUtility dictionary:eventParams objectForKey:param ofType:NSArray.class];
-  if (!items.count || paramPath.count < 2) {
-    return NO;
-  }
-  BOOL isMatched = NO;
-  NSRange range = NSMakeRange(1, paramPath.count - 1);
-  NSArray *subParamPath = [paramPath subarrayWithRange:range];
-  for (NSDictionary<NSString *, id> *item in items) {
-    isMatched |= [self isMatchedEventParameters:item paramPath:subParamPath];
-    if (isMatched) {
-      break;
-    }
-  }
-  return isMatched;
-}
-
-- (BOOL)isMatchedWithStringValue:(nullable NSString *)stringValue
-                  numericalValue:(nullable NSNumber *)numericalValue
-{
-  BOOL isMatched = NO;
-  switch (_operator) {
-    case FBAEMAdvertiserRuleOperatorContains:
-      isMatched = stringValue && [stringValue containsString:_linguisticCondition]; break;
-    case FBAEMAdvertiserRuleOperatorNotContains:
-      isMatched = !(stringValue && [stringValue containsString:_linguisticCondition]); break;
-    case FBAEMAdvertiserRuleOperatorStartsWith:
-      isMatched = stringValue && [stringValue hasPrefix:_linguisticCondition]; break;
-    case FBAEMAdvertiserRuleOperatorI_Contains:
-      isMatched = stringValue && [stringValue.lowercaseString containsString:_linguisticCondition.lowercaseString]; break;
-    case FBAEMAdvertiserRuleOperatorI_NotContains:
-      isMatched = !(stringValue && [stringValue.lowercaseString containsString:_linguisticCondition.lowercaseString]); break;
-    case FBAEMAdvertiserRuleOperatorI_StartsWith:
-      isMatched = stringValue && [stringValue.lowercaseString hasPrefix:_linguisticCondition.lowercaseString]; break;
-    case FBAEMAdvertiserRuleOperatorRegexMatch:
-      isMatched = stringValue && [self isRegexMatch:stringValue]; break;
-    case FBAEMAdvertiserRuleOperatorEqual:
-      isMatched = stringValue && [stringValue isEqualToString:_linguisticCondition]; break;
-    case FBAEMAdvertiserRuleOperatorNotEqual:
-      isMatched = !(stringValue && [stringValue isEqualToString:_linguisticCondition]); break;
-    case FBAEMAdvertiserRuleOperatorI_IsAny:
-      isMatched = stringValue && [self isAnyOf:_arrayCondition stringValue:stringValue ignoreCase:YES]; break;
-    case FBAEMAdvertiserRuleOperatorI_IsNotAny:
-      isMatched = !(stringValue && [self isAnyOf:_arrayCondition stringValue:stringValue ignoreCase:YES]); break;
-    case FBAEMAdvertiserRuleOperatorIsAny:
-      isMatched = stringValue && [self isAnyOf:_arrayCondition stringValue:stringValue ignoreCase:NO]; break;
-    case FBAEMAdvertiserRuleOperatorIsNotAny:
-      isMatched = !(stringValue && [self isAnyOf:_arrayCondition stringValue:stringValue ignoreCase:NO]); break;
-    case FBAEMAdvertiserRuleOperatorLessThan:
-      isMatched = (numericalValue != nil) && ([numericalValue compare:_numericalCondition] == NSOrderedAscending); break;
-    case FBAEMAdvertiserRuleOperatorLessThanOrEqual:
-      isMatched = (numericalValue != nil) && ([numericalValue compare:_numericalCondition] != NSOrderedDescending); break;
-    case FBAEMAdvertiserRuleOperatorGreaterThan:
-      isMatched = (numericalValue != nil) && ([numericalValue compare:_numericalCondition] == NSOrderedDescending); break;
-    case FBAEMAdvertiserRuleOperatorGreaterThanOrEqual:
-      isMatched = (numericalValue != nil) && ([numericalValue compare:_numericalCondition] != NSOrderedAscending); break;
-    default: break;
-  }
-  return isMatched;
-}
-
-- (BOOL)isRegexMatch:(NSString *)stringValue
-{
-  if (!_linguisticCondition.length) {
-    return NO;
-  }
-  NSError *error = nil;
-  NSRegularExpression *regex = [NSRegularExpression regularExpressionWithPattern:_linguisticCondition options:0 error:&error];
-  if (!regex || error) {
-    return NO;
-  }
-  NSRange searchedRange = NSMakeRange(0, stringValue.length);
-  NSArray *matches = [regex matchesInString:stringValue options:0 range:searchedRange];
-  return matches.count > 0;
-}
-
-- (BOOL)isAnyOf:(NSArray<NSString *> *)arrayCondition
-    stringValue:(NSString *)stringValue
-     ignoreCase:(BOOL)ignoreCase
-{
-  NSMutableSet<NSString *> *set = [NSMutableSet new];
-  for (NSString *item in arrayCondition) {
-    if (ignoreCase) {
-      [set addObject:item.lowercaseString];
-    } else {
-      [set addObject:item];
-    }
-  }
-  if (ignoreCase) {
-    stringValue = stringValue.lowercaseString;
-  }
-  return [set containsObject:stringValue];
-}
-
 #pragma mark - NSCoding
 
 + (BOOL)supportsSecureCoding
@@ -244,6 +102,42 @@ static NSString *const ASTERISK_DELIMETER = @"[*]";
 - (void)setOperator:(FBAEMAdvertiserRuleOperator)operator
 {
   _operator = operator;
+  _condition = [self conditionWithOperator:operator];
+}
+
+- (BOOL)isMatchedWithStringValue:(nullable NSString *)stringValue
+                  numericalValue:(nullable NSNumber *)numericalValue
+{
+  return [_condition matchesValue:stringValue ?: numericalValue];
+}
+
+- (BOOL)isMatchedWithAsteriskParam:(NSString *)param
+                   eventParameters:(NSDictionary<NSString *, id> *)eventParams
+                         paramPath:(NSArray<NSString *> *)paramPath
+{
+  FBAEMAdvertiserRuleCondition *condition = [[FBAEMAdvertiserRuleCondition alloc] initWithOperator:_operator
+                                                                                          paramKey:[paramPath componentsJoinedByString:@"."]
+                                                                               linguisticCondition:_linguisticCondition
+                                                                                numericalCondition:_numericalCondition
+                                                                                    arrayCondition:_arrayCondition];
+  return [condition matchesParameters:eventParams];
+}
+
+- (BOOL)isRegexMatch:(NSString *)stringValue
+{
+  return [[self conditionWithOperator:FBAEMAdvertiserRuleOperatorRegexMatch] matchesValue:stringValue];
+}
+
+- (BOOL)isAnyOf:(NSArray<NSString *> *)arrayCondition
+    stringValue:(NSString *)stringValue
+     ignoreCase:(BOOL)ignoreCase
+{
+  FBAEMAdvertiserRuleCondition *condition = [[FBAEMAdvertiserRuleCondition alloc] initWithOperator:ignoreCase ? FBAEMAdvertiserRuleOperatorI_IsAny : FBAEMAdvertiserRuleOperatorIsAny
+                                                                                          paramKey:_paramKey
+                                                                               linguisticCondition:nil
+                                                                                numericalCondition:nil
+                                                                                    arrayCondition:arrayCondition];
+  return [condition matchesValue:stringValue];
 }
 
 #endif
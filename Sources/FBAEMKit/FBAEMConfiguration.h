@@ -12,6 +12,7 @@
 
  #import <Foundation/Foundation.h>
 
+ #import "FBAEMConversionRuleMatcher.h"
  #import "FBAEMRule.h"
  #import "FBAEMAdvertiserRuleMatching.h"
  #import "FBAEMAdvertiserRuleProviding.h"
@@ -33,6 +34,9 @@ NS_SWIFT_NAME(AEMConfiguration)
 @property (nonatomic, readonly) NSSet<NSString *> *eventSet;
 @property (nonatomic, readonly) NSSet<NSString *> *currencySet;
 
+/** The conversion value rules compiled for matching, nil when they reference too many event names */
+@property (nullable, nonatomic, readonly) FBAEMConversionRuleMatcher *conversionRuleMatcher;
+
 + (instancetype)new NS_UNAVAILABLE;
 - (instancetype)init NS_UNAVAILABLE;
 
@@ -11,6 +11,7 @@
 #import "FBAEMConfiguration.h"
 
 #import "FBAEMAdvertiserMultiEntryRule.h"
+#import "FBAEMAdvertiserRuleProgram.h"
 #import "FBAEMAdvertiserSingleEntryRule.h"
 #import "FBCoreKitBasicsImportForAEMKit.h"
 
@@ -71,6 +72,7 @@ static id<FBAEMAdvertiserRuleProviding> _ruleProvider;
       _conversionValueRules = rules;
       _eventSet = [FBAEMConfiguration getEventSetFromRules:_conversionValueRules];
       _currencySet = [FBAEMConfiguration getCurrencySetFromRules:_conversionValueRules];
+      _conversionRuleMatcher = [[FBAEMConversionRuleMatcher alloc] initWithRules:_conversionValueRules];
     } @catch (NSException *exception) {
       return nil;
     }
@@ -96,6 +98,7 @@ static id<FBAEMAdvertiserRuleProviding> _ruleProvider;
     _conversionValueRules = conversionValueRules;
     _eventSet = [FBAEMConfiguration getEventSetFromRules:_conversionValueRules];
     _currencySet = [FBAEMConfiguration getCurrencySetFromRules:_conversionValueRules];
+    _conversionRuleMatcher = [[FBAEMConversionRuleMatcher alloc] initWithRules:_conversionValueRules];
   }
   return self;
 }
@@ -186,6 +189,8 @@ static id<FBAEMAdvertiserRuleProviding> _ruleProvider;
   NSString *businessID = [decoder decodeObjectOfClass:NSString.class forKey:BUSINESS_ID_KEY];
   NSSet<Class> *matchingRuleClasses = [NSSet setWithArray:@[NSArray.class, FBAEMAdvertiserMultiEntryRule.class, FBAEMAdvertiserSingleEntryRule.class]];
   id<FBAEMAdvertiserRuleMatching> matchingRule = [decoder decodeObjectOfClasses:matchingRuleClasses forKey:PARAM_RULE_KEY];
+  // Rules are archived as trees; compile them again like the rules of fetched configurations.
+  matchingRule = [FBAEMAdvertiserRuleProgram programWithRule:matchingRule] ?: matchingRule;
   NSArray<FBAEMRule *> *rules = [decoder decodeObjectOfClasses:[NSSet setWithArray:@[NSArray.class, FBAEMRule.class, FBAEMEvent.class]] forKey:CONVERSION_RULES_KEY];
   return [self initWithDefaultCurrency:defaultCurrency
                             cutoffTime:cutoffTime
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import "TargetConditionals.h"
+
+#if !TARGET_OS_TV
+
+ #import <Foundation/Foundation.h>
+
+ #import "FBAEMConfiguration.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ The configs of each config mode grouped by business ID and sorted by `validFrom`, so that finding the
+ config of an invocation is a hash lookup followed by a binary search.
+ */
+NS_SWIFT_NAME(AEMConfigurationIndex)
+@interface FBAEMConfigurationIndex : NSObject
+
+/// The configs the index was built from.
+@property (nullable, nonatomic, readonly) NSDictionary<NSString *, NSArray<FBAEMConfiguration *> *> *configs;
+
+- (instancetype)init NS_UNAVAILABLE;
++ (instancetype)new NS_UNAVAILABLE;
+
+- (instancetype)initWithConfigs:(nullable NSDictionary<NSString *, NSArray<FBAEMConfiguration *> *> *)configs;
+
+/**
+ Returns the index of `configs`, reusing the last one built when it was built from the same dictionary and
+ `invalidateCachedIndex` has not been called since.
+ */
++ (instancetype)indexForConfigs:(nullable NSDictionary<NSString *, NSArray<FBAEMConfiguration *> *> *)configs;
+
+/// Must be called whenever a dictionary of configs that may have been indexed is changed in place.
++ (void)invalidateCachedIndex;
+
+/// The first config with exactly this `validFrom`.
+- (nullable FBAEMConfiguration *)configWithMode:(NSString *)configMode
+                                     businessID:(nullable NSString *)businessID
+                                      validFrom:(NSInteger)validFrom;
+
+/// The most recent config that was valid at `timestamp`.
+- (nullable FBAEMConfiguration *)configWithMode:(NSString *)configMode
+                                     businessID:(nullable NSString *)businessID
+                                    validBefore:(NSTimeInterval)timestamp;
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+#endif
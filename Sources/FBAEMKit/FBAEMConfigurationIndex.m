@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#if !TARGET_OS_TV
+
+#import "FBAEMConfigurationIndex.h"
+
+#import "FBCoreKitBasicsImportForAEMKit.h"
+
+static FBAEMConfigurationIndex *g_cachedIndex;
+
+@implementation FBAEMConfigurationIndex
+{
+  // Config mode, then business ID or NSNull, to the configs sorted by validFrom
+  NSDictionary<NSString *, NSDictionary<id, NSArray<FBAEMConfiguration *> *> *> *_sortedConfigs;
+}
+
+- (instancetype)initWithConfigs:(nullable NSDictionary<NSString *, NSArray<FBAEMConfiguration *> *> *)configs
+{
+  if ((self = [super init])) {
+    _configs = configs;
+    NSMutableDictionary<NSString *, NSDictionary<id, NSArray<FBAEMConfiguration *> *> *> *sortedConfigs = [NSMutableDictionary new];
+    for (NSString *configMode in configs) {
+      NSArray<FBAEMConfiguration *> *configList = [FBSDKTypeUtility dictionary:configs objectForKey:configMode ofType:NSArray.class];
+      NSMutableDictionary<id, NSMutableArray<FBAEMConfiguration *> *> *configsByBusinessID = [NSMutableDictionary new];
+      for (FBAEMConfiguration *config in configList) {
+        id key = config.businessID ?: NSNull.null;
+        NSMutableArray<FBAEMConfiguration *> *group = configsByBusinessID[key];
+        if (!group) {
+          group = [NSMutableArray new];
+          [FBSDKTypeUtility dictionary:configsByBusinessID setObject:group forKey:key];
+        }
+        [FBSDKTypeUtility array:group addObject:config];
+      }
+      NSMutableDictionary<id, NSArray<FBAEMConfiguration *> *> *sortedGroups = [NSMutableDictionary new];
+      for (id key in configsByBusinessID) {
+        // A stable sort keeps configs sharing a validFrom in the order they were given
+        NSArray<FBAEMConfiguration *> *sorted = [configsByBusinessID[key] sortedArrayWithOptions:NSSortStable usingComparator:^NSComparisonResult (FBAEMConfiguration *obj1, FBAEMConfiguration *obj2) {
+          if (obj1.validFrom > obj2.validFrom) {
+            return NSOrderedDescending;
+          }
+          if (obj1.validFrom < obj2.validFrom) {
+            return NSOrderedAscending;
+          }
+          return NSOrderedSame;
+        }];
+        [FBSDKTypeUtility dictionary:sortedGroups setObject:sorted forKey:key];
+      }
+      [FBSDKTypeUtility dictionary:sortedConfigs setObject:sortedGroups forKey:configMode];
+    }
+    _sortedConfigs = [sortedConfigs copy];
+  }
+  return self;
+}
+
++ (instancetype)indexForConfigs:(nullable NSDictionary<NSString *, NSArray<FBAEMConfiguration *> *> *)configs
+{
+  @synchronized(self) {
+    // The cached index keeps its configs alive, so another dictionary cannot take their address
+    if (!g_cachedIndex || g_cachedIndex.configs != configs) {
+      g_cachedIndex = [[self alloc] initWithConfigs:configs];
+    }
+    return g_cachedIndex;
+  }
+}
+
++ (void)invalidateCachedIndex
+{
+  @synchronized(self) {
+    g_cachedIndex = nil;
+  }
+}
+
+- (nullable NSArray<FBAEMConfiguration *> *)configsWithMode:(NSString *)configMode
+                                                 businessID:(nullable NSString *)businessID
+{
+  return _sortedConfigs[configMode][businessID ?: NSNull.null];
+}
+
+- (nullable FBAEMConfiguration *)configWithMode:(NSString *)configMode
+                                     businessID:(nullable NSString *)businessID
+                                      validFrom:(NSInteger)validFrom
+{
+  NSArray<FBAEMConfiguration *> *configs = [self configsWithMode:configMode businessID:businessID];
+  // The first config whose validFrom is not below the one looked for
+  NSUInteger low = 0;
+  NSUInteger high = configs.count;
+  while (low < high) {
+    NSUInteger mid = low + (high - low) / 2;
+    if (configs[mid].validFrom < validFrom) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  if (low < configs.count && configs[low].validFrom == validFrom) {
+    return configs[low];
+  }
+  return nil;
+}
+
+- (nullable FBAEMConfiguration *)configWithMode:(NSString *)configMode
+                                     businessID:(nullable NSString *)businessID
+                                    validBefore:(NSTimeInterval)timestamp
+{
+  NSArray<FBAEMConfiguration *> *configs = [self configsWithMode:configMode businessID:businessID];
+  // The first config that is not valid yet; the one before it is the most recent valid one
+  NSUInteger low = 0;
+  NSUInteger high = configs.count;
+  while (low < high) {
+    NSUInteger mid = low + (high - low) / 2;
+    if (configs[mid].validFrom <= timestamp) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return low > 0 ? configs[low - 1] : nil;
+}
+
+@end
+
+#endif
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import "TargetConditionals.h"
+
+#if !TARGET_OS_TV
+
+ #import <Foundation/Foundation.h>
+
+ #import "FBAEMRule.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ The conversion value rules of a configuration, compiled for matching.
+
+ The event names and currencies the rules reference are interned to small integer IDs. Recorded events
+ become a bitset of event IDs and recorded values a dense array indexed by event and currency ID, so that
+ matching a rule is a subset test of its required events followed by numeric comparisons.
+ Matches `-[FBAEMRule isMatchedWithRecordedEvents:recordedValues:]` exactly.
+ */
+NS_SWIFT_NAME(AEMConversionRuleMatcher)
+@interface FBAEMConversionRuleMatcher : NSObject
+
+/// The largest number of distinct event names the rules can reference.
+@property (class, nonatomic, readonly, assign) NSUInteger maximumEventCount;
+
+@property (nonatomic, readonly, copy) NSArray<FBAEMRule *> *rules;
+
+/// The IDs of the event names referenced by the rules, from 0.
+@property (nonatomic, readonly, copy) NSDictionary<NSString *, NSNumber *> *eventIDs;
+
+/// The IDs of the currencies referenced by the rules, from 0.
+@property (nonatomic, readonly, copy) NSDictionary<NSString *, NSNumber *> *currencyIDs;
+
+- (instancetype)init NS_UNAVAILABLE;
++ (instancetype)new NS_UNAVAILABLE;
+
+/**
+ Compiles rules sorted in descending priority order.
+ Returns nil when the rules reference more than `maximumEventCount` event names.
+ */
+- (nullable instancetype)initWithRules:(NSArray<FBAEMRule *> *)rules;
+
+/**
+ Returns the first rule matched by the recorded events and values, among the rules of a priority higher
+ than `priority`, or nil when there is none.
+ */
+- (nullable FBAEMRule *)ruleMatchedWithRecordedEvents:(nullable NSSet<NSString *> *)recordedEvents
+                                       recordedValues:(nullable NSDictionary<NSString *, NSDictionary<NSString *, id> *> *)recordedValues
+                                        abovePriority:(NSInteger)priority;
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+#endif
@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#if !TARGET_OS_TV
+
+#import "FBAEMConversionRuleMatcher.h"
+
+#import "FBCoreKitBasicsImportForAEMKit.h"
+
+static const NSUInteger FBAEMConversionRuleMatcherMaximumEventCount = 64;
+
+#if DEBUG && FBTEST
+// The rules compared with recorded events, by every matcher
+static NSUInteger g_evaluatedRuleCount = 0;
+#endif
+
+typedef struct {
+  NSInteger priority;
+  // The IDs of the events the rule requires, as a bitset
+  uint64_t eventMask;
+  BOOL isMatchable;
+  NSUInteger firstValueGroup;
+  NSUInteger valueGroupCount;
+} FBAEMCompiledRule;
+
+// The values one event of a rule requires; any one of its conditions is enough
+typedef struct {
+  NSUInteger firstCondition;
+  NSUInteger conditionCount;
+} FBAEMValueGroup;
+
+typedef struct {
+  NSUInteger valueIndex;
+  double threshold;
+} FBAEMValueCondition;
+
+@implementation FBAEMConversionRuleMatcher
+{
+  NSData *_compiledRules;
+  NSData *_valueGroups;
+  NSData *_valueConditions;
+  NSUInteger _minimumRequiredEventCount;
+}
+
++ (NSUInteger)maximumEventCount
+{
+  return FBAEMConversionRuleMatcherMaximumEventCount;
+}
+
+- (nullable instancetype)initWithRules:(NSArray<FBAEMRule *> *)rules
+{
+  if ((self = [super init])) {
+    NSMutableDictionary<NSString *, NSNumber *> *eventIDs = [NSMutableDictionary new];
+    NSMutableDictionary<NSString *, NSNumber *> *currencyIDs = [NSMutableDictionary new];
+    for (FBAEMRule *rule in rules) {
+      for (FBAEMEvent *event in rule.events) {
+        if ([event.eventName isKindOfClass:NSString.class] && !eventIDs[event.eventName]) {
+          if (eventIDs.count == FBAEMConversionRuleMatcherMaximumEventCount) {
+            return nil;
+          }
+          [FBSDKTypeUtility dictionary:eventIDs setObject:@(eventIDs.count) forKey:event.eventName];
+        }
+        for (NSString *currency in event.values) {
+          if ([currency isKindOfClass:NSString.class] && !currencyIDs[currency]) {
+            [FBSDKTypeUtility dictionary:currencyIDs setObject:@(currencyIDs.count) forKey:currency];
+          }
+        }
+      }
+    }
+    _rules = [rules copy];
+    _eventIDs = [eventIDs copy];
+    _currencyIDs = [currencyIDs copy];
+    [self _compileRules];
+  }
+  return self;
+}
+
+- (void)_compileRules
+{
+  NSMutableData *compiledRules = [NSMutableData dataWithLength:_rules.count * sizeof(FBAEMCompiledRule)];
+  NSMutableData *valueGroups = [NSMutableData new];
+  NSMutableData *valueConditions = [NSMutableData new];
+  FBAEMCompiledRule *compiledRule = compiledRules.mutableBytes;
+  _minimumRequiredEventCount = FBAEMConversionRuleMatcherMaximumEventCount + 1;
+  for (FBAEMRule *rule in _rules) {
+    compiledRule->priority = rule.priority;
+    compiledRule->isMatchable = YES;
+    compiledRule->firstValueGroup = valueGroups.length / sizeof(FBAEMValueGroup);
+    for (FBAEMEvent *event in rule.events) {
+      NSNumber *eventID = [FBSDKTypeUtility dictionary:_eventIDs objectForKey:event.eventName ofType:NSNumber.class];
+      if (eventID == nil) {
+        compiledRule->isMatchable = NO;
+        continue;
+      }
+      compiledRule->eventMask |= 1ULL << eventID.unsignedIntegerValue;
+      if (!event.values) {
+        continue;
+      }
+      FBAEMValueGroup group = {valueConditions.length / sizeof(FBAEMValueCondition), 0};
+      for (NSString *currency in event.values) {
+        NSNumber *currencyID = [FBSDKTypeUtility dictionary:_currencyIDs objectForKey:currency ofType:NSNumber.class];
+        if (currencyID == nil) {
+          continue;
+        }
+        NSNumber *valueInMapping = [FBSDKTypeUtility dictionary:event.values objectForKey:currency ofType:NSNumber.class];
+        FBAEMValueCondition condition = {
+          eventID.unsignedIntegerValue * _currencyIDs.count + currencyID.unsignedIntegerValue,
+          valueInMapping.doubleValue,
+        };
+        [valueConditions appendBytes:&condition length:sizeof(condition)];
+        group.conditionCount++;
+      }
+      [valueGroups appendBytes:&group length:sizeof(group)];
+      compiledRule->valueGroupCount++;
+    }
+    if (compiledRule->isMatchable) {
+      _minimumRequiredEventCount = MIN(_minimumRequiredEventCount, (NSUInteger)__builtin_popcountll(compiledRule->eventMask));
+    }
+    compiledRule++;
+  }
+  _compiledRules = compiledRules;
+  _valueGroups = valueGroups;
+  _valueConditions = valueConditions;
+}
+
+- (nullable FBAEMRule *)ruleMatchedWithRecordedEvents:(nullable NSSet<NSString *> *)recordedEvents
+                                       recordedValues:(nullable NSDictionary<NSString *, NSDictionary<NSString *, id> *> *)recordedValues
+                                        abovePriority:(NSInteger)priority
+{
+  const FBAEMCompiledRule *compiledRules = _compiledRules.bytes;
+  // The rules are sorted in descending priority order
+  if (0 == _rules.count || compiledRules[0].priority <= priority) {
+    return nil;
+  }
+  uint64_t recordedEventMask = [self _eventMaskWithRecordedEvents:recordedEvents];
+  // No rule can match before as many events were recorded as the rule requiring the fewest
+  if ((NSUInteger)__builtin_popcountll(recordedEventMask) < _minimumRequiredEventCount) {
+    return nil;
+  }
+  NSData *values = nil;
+  for (NSUInteger i = 0; i < _rules.count; i++) {
+    const FBAEMCompiledRule *compiledRule = &compiledRules[i];
+    if (compiledRule->priority <= priority) {
+      break;
+    }
+  #if DEBUG && FBTEST
+    g_evaluatedRuleCount++;
+  #endif
+    if (!compiledRule->isMatchable || (compiledRule->eventMask & ~recordedEventMask) != 0) {
+      continue;
+    }
+    if (compiledRule->valueGroupCount > 0 && !values) {
+      values = [self _valuesWithRecordedValues:recordedValues];
+    }
+    if ([self _isMatchedWithRule:compiledRule values:values.bytes]) {
+      return [FBSDKTypeUtility array:_rules objectAtIndex:i];
+    }
+  }
+  return nil;
+}
+
+#pragma mark - Helpers
+
+- (uint64_t)_eventMaskWithRecordedEvents:(nullable NSSet<NSString *> *)recordedEvents
+{
+  uint64_t eventMask = 0;
+  for (NSString *event in recordedEvents) {
+    NSNumber *eventID = [FBSDKTypeUtility dictionary:_eventIDs objectForKey:event ofType:NSNumber.class];
+    if (eventID != nil) {
+      eventMask |= 1ULL << eventID.unsignedIntegerValue;
+    }
+  }
+  return eventMask;
+}
+
+// Values that were not recorded are 0, like the missing values of the rules
+- (NSData *)_valuesWithRecordedValues:(nullable NSDictionary<NSString *, NSDictionary<NSString *, id> *> *)recordedValues
+{
+  NSMutableData *data = [NSMutableData dataWithLength:_eventIDs.count * _currencyIDs.count * sizeof(double)];
+  double *values = data.mutableBytes;
+  recordedValues = [FBSDKTypeUtility dictionaryValue:recordedValues];
+  for (NSString *event in recordedValues) {
+    NSNumber *eventID = [FBSDKTypeUtility dictionary:_eventIDs objectForKey:event ofType:NSNumber.class];
+    if (eventID == nil) {
+      continue;
+    }
+    NSDictionary<NSString *, id> *recordedEventValues = [FBSDKTypeUtility dictionary:recordedValues objectForKey:event ofType:NSDictionary.class];
+    for (NSString *currency in recordedEventValues) {
+      NSNumber *currencyID = [FBSDKTypeUtility dictionary:_currencyIDs objectForKey:currency ofType:NSNumber.class];
+      NSNumber *value = [FBSDKTypeUtility dictionary:recordedEventValues objectForKey:currency ofType:NSNumber.class];
+      if (currencyID != nil && value != nil) {
+        values[eventID.unsignedIntegerValue * _currencyIDs.count + currencyID.unsignedIntegerValue] = value.doubleValue;
+      }
+    }
+  }
+  return data;
+}
+
+- (BOOL)_isMatchedWithRule:(const FBAEMCompiledRule *)compiledRule
+                    values:(const double *)values
+{
+  const FBAEMValueGroup *valueGroups = _valueGroups.bytes;
+  const FBAEMValueCondition *valueConditions = _valueConditions.bytes;
+  for (NSUInteger i = 0; i < compiledRule->valueGroupCount; i++) {
+    const FBAEMValueGroup *group = &valueGroups[compiledRule->firstValueGroup + i];
+    BOOL isMatched = NO;
+    for (NSUInteger j = 0; j < group->conditionCount && !isMatched; j++) {
+      const FBAEMValueCondition *condition = &valueConditions[group->firstCondition + j];
+      isMatched = values[condition->valueIndex] >= condition->threshold;
+    }
+    if (!isMatched) {
+      return NO;
+    }
+  }
+  return YES;
+}
+
+#if DEBUG && FBTEST
+
++ (NSUInteger)evaluatedRuleCount
+{
+  return g_evaluatedRuleCount;
+}
+
++ (void)setEvaluatedRuleCount:(NSUInteger)count
+{
+  g_evaluatedRuleCount = count;
+}
+
+#endif
+
+@end
+
+#endif
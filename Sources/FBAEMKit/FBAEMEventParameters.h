@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import "TargetConditionals.h"
+
+#if !TARGET_OS_TV
+
+ #import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ The parameters of one app event, as advertiser rules match them.
+
+ `fb_content` arrives as a JSON string; it is decoded the first time `processedParameters` is read and the
+ result is kept, so every invocation and rule tried for the event shares a single decode.
+ */
+NS_SWIFT_NAME(AEMEventParameters)
+@interface FBAEMEventParameters : NSObject
+
+/// The parameters the event was logged with.
+@property (nullable, nonatomic, readonly, copy) NSDictionary<NSString *, id> *parameters;
+
+/// The parameters with `fb_content` decoded, or left as it is when it is not valid JSON.
+@property (nullable, nonatomic, readonly) NSDictionary<NSString *, id> *processedParameters;
+
+- (instancetype)init NS_UNAVAILABLE;
++ (instancetype)new NS_UNAVAILABLE;
+
+- (instancetype)initWithParameters:(nullable NSDictionary<NSString *, id> *)parameters;
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+#endif
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#if !TARGET_OS_TV
+
+#import "FBAEMEventParameters.h"
+
+#import "FBCoreKitBasicsImportForAEMKit.h"
+
+static NSString *const FB_CONTENT = @"fb_content";
+
+@implementation FBAEMEventParameters
+{
+  NSDictionary<NSString *, id> *_processedParameters;
+  BOOL _isProcessed;
+}
+
+- (instancetype)initWithParameters:(nullable NSDictionary<NSString *, id> *)parameters
+{
+  if ((self = [super init])) {
+    _parameters = [parameters copy];
+  }
+  return self;
+}
+
+- (nullable NSDictionary<NSString *, id> *)processedParameters
+{
+  if (!_isProcessed) {
+    _processedParameters = [self.class processParameters:_parameters];
+    _isProcessed = YES;
+  }
+  return _processedParameters;
+}
+
++ (nullable NSDictionary<NSString *, id> *)processParameters:(nullable NSDictionary<NSString *, id> *)parameters
+{
+  if (!parameters) {
+    return parameters;
+  }
+  @try {
+    NSString *content = [FBSDKTypeUtility dictionary:parameters objectForKey:FB_CONTENT ofType:NSString.class];
+    if (!content) {
+      return parameters;
+    }
+    NSMutableDictionary<NSString *, id> *result = [NSMutableDictionary dictionaryWithDictionary:parameters];
+    [FBSDKTypeUtility dictionary:result
+                       setObject:[FBSDKTypeUtility JSONObjectWithData:[content dataUsingEncoding:NSUTF8StringEncoding]
+                                                              options:0
+                                                                error:nil]
+                          forKey:FB_CONTENT];
+    return [result copy];
+  } @catch (NSException *exception) {
+    return parameters;
+  }
+}
+
+@end
+
+#endif
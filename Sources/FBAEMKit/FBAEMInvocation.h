@@ -13,6 +13,7 @@
  #import <Foundation/Foundation.h>
 
  #import "FBAEMConfiguration.h"
+ #import "FBAEMEventParameters.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -52,6 +53,15 @@ NS_SWIFT_NAME(AEMInvocation)
 
 @property (nonatomic, assign) BOOL isAggregated;
 
+/**
+ The report sent for the conversion value, kept until it is acknowledged so that a retry sends it unchanged.
+
+ Delivery is at least once: if the app dies after the server received the report but before the response was
+ handled, the same report is sent again on a later launch. The server can discard it as a duplicate because
+ its delay and HMAC are unchanged.
+ */
+@property (nullable, nonatomic, copy) NSDictionary<NSString *, id> *aggregationParameters;
+
 + (instancetype)new NS_UNAVAILABLE;
 - (instancetype)init NS_UNAVAILABLE;
 
@@ -63,6 +73,13 @@ NS_SWIFT_NAME(AEMInvocation)
             parameters:(nullable NSDictionary<NSString *, id> *)parameters
                configs:(nullable NSDictionary<NSString *, NSArray<FBAEMConfiguration *> *> *)configs;
 
+/// Same as `attributeEvent:currency:value:parameters:configs:`, with parameters shared by every invocation tried for the event.
+- (BOOL)attributeEvent:(NSString *)event
+              currency:(nullable NSString *)currency
+                 value:(nullable NSNumber *)value
+       eventParameters:(FBAEMEventParameters *)eventParameters
+               configs:(nullable NSDictionary<NSString *, NSArray<FBAEMConfiguration *> *> *)configs;
+
 - (BOOL)updateConversionValueWithConfigs:(nullable NSDictionary<NSString *, NSArray<FBAEMConfiguration *> *> *)configs;
 
 - (BOOL)isOutOfWindowWithConfigs:(nullable NSDictionary<NSString *, NSArray<FBAEMConfiguration *> *> *)configs;
@@ -12,6 +12,7 @@
 
 #import <CommonCrypto/CommonHMAC.h>
 
+#import "FBAEMConfigurationIndex.h"
 #import "FBCoreKitBasicsImportForAEMKit.h"
 
 #define SEC_IN_DAY 86400
@@ -32,8 +33,7 @@ static NSString *const PRIORITY_KEY = @"priority";
 static NSString *const CONVERSION_TIMESTAMP_KEY = @"conversion_timestamp";
 static NSString *const IS_AGGREGATED_KEY = @"is_aggregated";
 static NSString *const HAS_SKAN_KEY = @"has_skan";
-
-static NSString *const FB_CONTENT = @"fb_content";
+static NSString *const AGGREGATION_PARAMETERS_KEY = @"aggregation_parameters";
 
 typedef NSString *const FBAEMInvocationConfigMode;
 
@@ -41,6 +41,11 @@ FBAEMInvocationConfigMode FBAEMInvocationConfigDefaultMode = @"DEFAULT";
 FBAEMInvocationConfigMode FBAEMInvocationConfigBrandMode = @"BRAND";
 
 @implementation FBAEMInvocation
+{
+  // The config found by the last lookup, valid as long as lookups use the same index
+  FBAEMConfigurationIndex *_resolvedConfigIndex;
+  FBAEMConfiguration *_resolvedConfig;
+}
 
 + (nullable instancetype)invocationWithAppLinkData:(nullable NSDictionary<id, id> *)applinkData
 {
@@ -153,13 +158,26 @@ FBAEMInvocationConfigMode FBAEMInvocationConfigBrandMode = @"BRAND";
                  value:(nullable NSNumber *)value
             parameters:(nullable NSDictionary<NSString *, id> *)parameters
                configs:(nullable NSDictionary<NSString *, NSArray<FBAEMConfiguration *> *> *)configs
+{
+  return [self attributeEvent:event
+                     currency:currency
+                        value:value
+              eventParameters:[[FBAEMEventParameters alloc] initWithParameters:parameters]
+                      configs:configs];
+}
+
+- (BOOL)attributeEvent:(NSString *)event
+              currency:(nullable NSString *)currency
+                 value:(nullable NSNumber *)value
+       eventParameters:(FBAEMEventParameters *)eventParameters
+               configs:(nullable NSDictionary<NSString *, NSArray<FBAEMConfiguration *> *> *)configs
 {
   FBAEMConfiguration *config = [self _findConfig:configs];
   if ([self _isOutOfWindowWithConfig:config] || ![config.eventSet containsObject:event]) {
     return NO;
   }
   // Check advertiser rule matching
-  if (config.matchingRule && ![config.matchingRule isMatchedEventParameters:[self processedParameters:parameters]]) {
+  if (config.matchingRule && ![config.matchingRule isMatchedEventParameters:eventParameters.processedParameters]) {
     return NO;
   }
   BOOL isAttributed = NO;
@@ -192,19 +210,34 @@ FBAEMInvocationConfigMode FBAEMInvocationConfigBrandMode = @"BRAND";
     return NO;
   }
   // Update conversion value if a rule is matched
+  FBAEMRule *rule = [self _matchedRuleWithConfig:config];
+  if (!rule) {
+    return NO;
+  }
+  _conversionValue = rule.conversionValue;
+  _priority = rule.priority;
+  _conversionTimestamp = [NSDate date];
+  _isAggregated = NO;
+  _aggregationParameters = nil;
+  return YES;
+}
+
+- (nullable FBAEMRule *)_matchedRuleWithConfig:(FBAEMConfiguration *)config
+{
+  if (config.conversionRuleMatcher) {
+    return [config.conversionRuleMatcher ruleMatchedWithRecordedEvents:_recordedEvents
+                                                        recordedValues:_recordedValues
+                                                         abovePriority:_priority];
+  }
   for (FBAEMRule *rule in config.conversionValueRules) {
     if (rule.priority <= _priority) {
       break;
     }
     if ([rule isMatchedWithRecordedEvents:_recordedEvents recordedValues:_recordedValues]) {
-      _conversionValue = rule.conversionValue;
-      _priority = rule.priority;
-      _conversionTimestamp = [NSDate date];
-      _isAggregated = NO;
-      return YES;
+      return rule;
     }
   }
-  return NO;
+  return nil;
 }
 
 - (BOOL)isOutOfWindowWithConfigs:(nullable NSDictionary<NSString *, NSArray<FBAEMConfiguration *> *> *)configs
@@ -256,23 +289,7 @@ FBAEMInvocationConfigMode FBAEMInvocationConfigBrandMode = @"BRAND";
 
 - (nullable NSDictionary<NSString *, id> *)processedParameters:(nullable NSDictionary<NSString *, id> *)parameters
 {
-  if (!parameters) {
-    return parameters;
-  }
-  @try {
-    NSMutableDictionary<NSString *, id> *result = [NSMutableDictionary dictionaryWithDictionary:parameters];
-    NSString *content = [FBSDKTypeUtility dictionary:result objectForKey:FB_CONTENT ofType:NSString.class];
-    if (content) {
-      [FBSDKTypeUtility dictionary:result
-                         setObject:[FBSDKTypeUtility JSONObjectWithData:[content dataUsingEncoding:NSUTF8StringEncoding]
-                                                                options:0
-                                                                  error:nil]
-                            forKey:FB_CONTENT];
-    }
-    return [result copy];
-  } @catch (NSException *exception) {
-    return parameters;
-  }
+  return [[FBAEMEventParameters alloc] initWithParameters:parameters].processedParameters;
 }
 
 - (BOOL)_isOutOfWindowWithConfig:(nullable FBAEMConfiguration *)config
@@ -287,38 +304,36 @@ FBAEMInvocationConfigMode FBAEMInvocationConfigBrandMode = @"BRAND";
 
 - (nullable FBAEMConfiguration *)_findConfig:(nullable NSDictionary<NSString *, NSArray<FBAEMConfiguration *> *> *)configs
 {
-  NSString *configMode = _businessID ? FBAEMInvocationConfigBrandMode : FBAEMInvocationConfigDefaultMode;
-  NSArray<FBAEMConfiguration *> *configList = [FBSDKTypeUtility dictionary:configs objectForKey:configMode ofType:NSArray.class];
-  if (0 == configList.count) {
-    return nil;
+  FBAEMConfigurationIndex *configIndex = [FBAEMConfigurationIndex indexForConfigs:configs];
+  if (configIndex == _resolvedConfigIndex) {
+    return _resolvedConfig;
   }
+  NSString *configMode = _businessID ? FBAEMInvocationConfigBrandMode : FBAEMInvocationConfigDefaultMode;
+  FBAEMConfiguration *config = nil;
   if (_configID > 0) {
-    for (FBAEMConfiguration *config in configList) {
-      if ([config isSameValidFrom:_configID businessID:_businessID]) {
-        return config;
-      }
-    }
-    return nil;
+    config = [configIndex configWithMode:configMode businessID:_businessID validFrom:_configID];
   } else {
-    FBAEMConfiguration *config = nil;
-    for (FBAEMConfiguration *c in [configList reverseObjectEnumerator]) {
-      if (c.validFrom <= _timestamp.timeIntervalSince1970 && [c isSameBusinessID:_businessID]) {
-        config = c;
-        break;
-      }
-    }
-    if (!config) {
-      return nil;
+    config = [configIndex configWithMode:configMode businessID:_businessID validBefore:_timestamp.timeIntervalSince1970];
+    if (config) {
+      [self _setConfig:config];
     }
-    [self _setConfig:config];
-    return config;
   }
+  _resolvedConfigIndex = configIndex;
+  _resolvedConfig = config;
+  return config;
+}
+
+- (void)_invalidateResolvedConfig
+{
+  _resolvedConfigIndex = nil;
+  _resolvedConfig = nil;
 }
 
 - (void)_setConfig:(FBAEMConfiguration *)config
 {
   _configID = config.validFrom;
   _configMode = config.configMode;
+  [self _invalidateResolvedConfig];
 }
 
 #pragma mark - NSCoding
@@ -345,7 +360,9 @@ FBAEMInvocationConfigMode FBAEMInvocationConfigBrandMode = @"BRAND";
   NSDate *conversionTimestamp = [decoder decodeObjectOfClass:NSDate.class forKey:CONVERSION_TIMESTAMP_KEY];
   BOOL isAggregated = [decoder decodeBoolForKey:IS_AGGREGATED_KEY];
   BOOL hasSKAN = [decoder decodeBoolForKey:HAS_SKAN_KEY];
-  return [self initWithCampaignID:campaignID
+  NSSet<Class> *aggregationParametersClasses = [NSSet setWithArray:@[NSDictionary.class, NSString.class, NSNumber.class]];
+  NSDictionary<NSString *, id> *aggregationParameters = [decoder decodeObjectOfClasses:aggregationParametersClasses forKey:AGGREGATION_PARAMETERS_KEY];
+  self = [self initWithCampaignID:campaignID
                          ACSToken:ACSToken
                   ACSSharedSecret:ACSSharedSecret
                       ACSConfigID:ACSConfigID
@@ -361,6 +378,10 @@ FBAEMInvocationConfigMode FBAEMInvocationConfigBrandMode = @"BRAND";
                      isAggregated:isAggregated
                        isTestMode:NO
                           hasSKAN:hasSKAN];
+  if (self) {
+    _aggregationParameters = [FBSDKTypeUtility dictionaryValue:aggregationParameters];
+  }
+  return self;
 }
 
 - (void)encodeWithCoder:(NSCoder *)encoder
@@ -380,6 +401,7 @@ FBAEMInvocationConfigMode FBAEMInvocationConfigBrandMode = @"BRAND";
   [encoder encodeObject:_conversionTimestamp forKey:CONVERSION_TIMESTAMP_KEY];
   [encoder encodeBool:_isAggregated forKey:IS_AGGREGATED_KEY];
   [encoder encodeBool:_hasSKAN forKey:HAS_SKAN_KEY];
+  [encoder encodeObject:_aggregationParameters forKey:AGGREGATION_PARAMETERS_KEY];
 }
 
 #pragma mark - NSCopying
@@ -409,11 +431,13 @@ FBAEMInvocationConfigMode FBAEMInvocationConfigBrandMode = @"BRAND";
 - (void)setConfigID:(NSInteger)configID
 {
   _configID = configID;
+  [self _invalidateResolvedConfig];
 }
 
 - (void)setBusinessID:(NSString *_Nullable)businessID
 {
   _businessID = businessID;
+  [self _invalidateResolvedConfig];
 }
 
 - (void)setConversionTimestamp:(NSDate *_Nonnull)conversionTimestamp
@@ -453,7 +477,9 @@ FBAEMInvocationConfigMode FBAEMInvocationConfigBrandMode = @"BRAND";
   _priority = -1;
   _conversionTimestamp = [NSDate date];
   _isAggregated = YES;
+  _aggregationParameters = nil;
   _hasSKAN = NO;
+  [self _invalidateResolvedConfig];
 }
 
 #endif
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import "TargetConditionals.h"
+
+#if !TARGET_OS_TV
+
+ #import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ An append-only file of archived objects.
+
+ Saving an object appends a record holding only that object, and removing one appends a record holding only
+ its key, so the cost of a change does not grow with the number of objects stored. Loading replays the
+ records in order. Once enough records have been appended the store is compacted: the file is rewritten,
+ atomically, with one record per object.
+
+ Objects are tracked by identity. Changes made to an object in memory are persisted by saving it again.
+ A store that has not loaded or written its file, or that found a damaged record while loading, writes a
+ full snapshot on its next change. The store is not thread safe.
+ */
+NS_SWIFT_NAME(AEMRecordStore)
+@interface FBAEMRecordStore : NSObject
+
+@property (nonatomic, readonly, copy) NSString *filePath;
+
+/// The number of records appended since the file was last compacted.
+@property (nonatomic, readonly, assign) NSUInteger appendedRecordCount;
+
+/// The number of bytes appended or rewritten since the store was created.
+@property (nonatomic, readonly, assign) NSUInteger writtenByteCount;
+
+/// The minimum number of appended records before the file is compacted. Defaults to 32.
+@property (nonatomic, assign) NSUInteger compactionThreshold;
+
+- (instancetype)init NS_UNAVAILABLE;
++ (instancetype)new NS_UNAVAILABLE;
+
+- (instancetype)initWithFilePath:(NSString *)filePath
+                   objectClasses:(NSSet<Class> *)objectClasses;
+
+/**
+ Replays the file and returns the objects in the order they were first saved.
+ Returns an empty array when there is no file, and nil when the file was not written by a record store.
+ */
+- (nullable NSArray<id> *)loadObjects;
+
+/**
+ Persists the changes to `objects`, which holds every object the caller keeps, after the changes.
+ The changed and removed objects are appended when possible, and `objects` is written in full otherwise.
+ */
+- (void)saveObjects:(NSArray<id<NSSecureCoding>> *)changedObjects
+    removingObjects:(NSArray<id<NSSecureCoding>> *)removedObjects
+          inObjects:(NSArray<id<NSSecureCoding>> *)objects
+  NS_SWIFT_NAME(save(_:removingObjects:inObjects:));
+
+- (void)saveObject:(id<NSSecureCoding>)object
+         inObjects:(NSArray<id<NSSecureCoding>> *)objects
+  NS_SWIFT_NAME(save(_:inObjects:));
+
+/// Rewrites the file with exactly `objects`.
+- (void)compactWithObjects:(NSArray<id<NSSecureCoding>> *)objects
+  NS_SWIFT_NAME(compact(withObjects:));
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+#endif
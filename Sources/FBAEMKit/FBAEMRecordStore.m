@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#if !TARGET_OS_TV
+
+#import "FBAEMRecordStore.h"
+
+#import "FBCoreKitBasicsImportForAEMKit.h"
+
+static const char FBAEMRecordStoreMagic[8] = {'F', 'B', 'A', 'E', 'M', 'R', 'S', '1'};
+static const NSUInteger FBAEMRecordStoreDefaultCompactionThreshold = 32;
+
+typedef NS_ENUM(uint8_t, FBAEMRecordType) {
+  FBAEMRecordTypeSave = 1,
+  FBAEMRecordTypeRemove = 2,
+};
+
+// A record is a little endian header, {payload length, type, key}, followed by its payload:
+// the archived object when saving, nothing when removing.
+typedef struct __attribute__((packed)) {
+  uint32_t length;
+  uint8_t type;
+  uint64_t key;
+} FBAEMRecordHeader;
+
+@implementation FBAEMRecordStore
+{
+  NSSet<Class> *_objectClasses;
+  NSMapTable<id, NSNumber *> *_keys;
+  uint64_t _nextKey;
+  BOOL _isSynchronized;
+}
+
+- (instancetype)initWithFilePath:(NSString *)filePath
+                   objectClasses:(NSSet<Class> *)objectClasses
+{
+  if ((self = [super init])) {
+    _filePath = [filePath copy];
+    _objectClasses = [objectClasses copy];
+    _keys = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality
+                                  valueOptions:NSPointerFunctionsStrongMemory];
+    _compactionThreshold = FBAEMRecordStoreDefaultCompactionThreshold;
+  }
+  return self;
+}
+
+#pragma mark - Loading
+
+- (nullable NSArray<id> *)loadObjects
+{
+  [_keys removeAllObjects];
+  _nextKey = 0;
+  _appendedRecordCount = 0;
+  _isSynchronized = NO;
+
+  NSData *data = [NSData dataWithContentsOfFile:_filePath options:NSDataReadingMappedIfSafe error:nil];
+  if (!data) {
+    return @[];
+  }
+  if (data.length < sizeof(FBAEMRecordStoreMagic)
+      || memcmp(data.bytes, FBAEMRecordStoreMagic, sizeof(FBAEMRecordStoreMagic)) != 0) {
+    return nil;
+  }
+
+  NSMutableDictionary<NSNumber *, id> *objectsByKey = [NSMutableDictionary new];
+  NSMutableArray<NSNumber *> *orderedKeys = [NSMutableArray new];
+  NSUInteger recordCount = 0;
+  NSUInteger offset = sizeof(FBAEMRecordStoreMagic);
+  BOOL isDamaged = NO;
+  while (offset < data.length) {
+    FBAEMRecordHeader header;
+    if (offset + sizeof(header) > data.length) {
+      isDamaged = YES;
+      break;
+    }
+    [data getBytes:&header range:NSMakeRange(offset, sizeof(header))];
+    NSUInteger length = CFSwapInt32LittleToHost(header.length);
+    NSNumber *key = @(CFSwapInt64LittleToHost(header.key));
+    offset += sizeof(header);
+    // A record cut short by an interrupted write, and anything after it, is ignored.
+    if (offset + length > data.length) {
+      isDamaged = YES;
+      break;
+    }
+    if (header.type == FBAEMRecordTypeSave) {
+      id object = [self unarchiveObject:[data subdataWithRange:NSMakeRange(offset, length)]];
+      if (!object) {
+        isDamaged = YES;
+        break;
+      }
+      if (!objectsByKey[key]) {
+        [FBSDKTypeUtility array:orderedKeys addObject:key];
+      }
+      [FBSDKTypeUtility dictionary:objectsByKey setObject:object forKey:key];
+    } else if (header.type == FBAEMRecordTypeRemove) {
+      [objectsByKey removeObjectForKey:key];
+      [orderedKeys removeObject:key];
+    } else {
+      isDamaged = YES;
+      break;
+    }
+    offset += length;
+    recordCount++;
+    _nextKey = MAX(_nextKey, key.unsignedLongLongValue + 1);
+  }
+
+  NSMutableArray<id> *objects = [NSMutableArray new];
+  for (NSNumber *key in orderedKeys) {
+    id object = objectsByKey[key];
+    [FBSDKTypeUtility array:objects addObject:object];
+    [_keys setObject:key forKey:object];
+  }
+  _appendedRecordCount = recordCount > objects.count ? recordCount - objects.count : 0;
+  _isSynchronized = !isDamaged;
+  return [objects copy];
+}
+
+#pragma mark - Saving
+
+- (void)saveObject:(id<NSSecureCoding>)object
+         inObjects:(NSArray<id<NSSecureCoding>> *)objects
+{
+  [self saveObjects:@[object] removingObjects:@[] inObjects:objects];
+}
+
+- (void)saveObjects:(NSArray<id<NSSecureCoding>> *)changedObjects
+    removingObjects:(NSArray<id<NSSecureCoding>> *)removedObjects
+          inObjects:(NSArray<id<NSSecureCoding>> *)objects
+{
+  NSUInteger changeCount = changedObjects.count + removedObjects.count;
+  if (0 == changeCount) {
+    return;
+  }
+  // Compacting once the appended records outnumber the objects keeps the file within a constant factor
+  // of a snapshot, so each change costs constant amortized bytes written.
+  NSUInteger threshold = MAX(self.compactionThreshold, 2 * objects.count);
+  if (!_isSynchronized || self.appendedRecordCount + changeCount > threshold) {
+    [self compactWithObjects:objects];
+    return;
+  }
+  NSMutableData *records = [NSMutableData new];
+  for (id<NSSecureCoding> object in removedObjects) {
+    NSNumber *key = [_keys objectForKey:object];
+    if (!key) {
+      continue;
+    }
+    [self appendRecordOfType:FBAEMRecordTypeRemove key:key payload:nil toData:records];
+    [_keys removeObjectForKey:object];
+  }
+  for (id<NSSecureCoding> object in changedObjects) {
+    NSData *payload = [self archiveObject:object];
+    if (!payload) {
+      [self compactWithObjects:objects];
+      return;
+    }
+    NSNumber *key = [_keys objectForKey:object];
+    if (!key) {
+      key = @(_nextKey++);
+      [_keys setObject:key forKey:object];
+    }
+    [self appendRecordOfType:FBAEMRecordTypeSave key:key payload:payload toData:records];
+  }
+  if (0 == records.length) {
+    return;
+  }
+  if (![self appendData:records]) {
+    [self compactWithObjects:objects];
+    return;
+  }
+  _appendedRecordCount += changeCount;
+}
+
+- (void)compactWithObjects:(NSArray<id<NSSecureCoding>> *)objects
+{
+  [_keys removeAllObjects];
+  _nextKey = 0;
+  _appendedRecordCount = 0;
+
+  NSMutableData *data = [NSMutableData dataWithBytes:FBAEMRecordStoreMagic length:sizeof(FBAEMRecordStoreMagic)];
+  for (id<NSSecureCoding> object in objects) {
+    NSData *payload = [self archiveObject:object];
+    if (!payload) {
+      continue;
+    }
+    NSNumber *key = @(_nextKey++);
+    [_keys setObject:key forKey:object];
+    [self appendRecordOfType:FBAEMRecordTypeSave key:key payload:payload toData:data];
+  }
+  _isSynchronized = [data writeToFile:_filePath atomically:YES];
+  if (_isSynchronized) {
+    _writtenByteCount += data.length;
+  }
+}
+
+#pragma mark - Helpers
+
+- (void)appendRecordOfType:(FBAEMRecordType)type
+                       key:(NSNumber *)key
+                   payload:(nullable NSData *)payload
+                    toData:(NSMutableData *)data
+{
+  FBAEMRecordHeader header = {
+    CFSwapInt32HostToLittle((uint32_t)payload.length),
+    type,
+    CFSwapInt64HostToLittle(key.unsignedLongLongValue),
+  };
+  [data appendBytes:&header length:sizeof(header)];
+  if (payload) {
+    [data appendData:payload];
+  }
+}
+
+- (BOOL)appendData:(NSData *)data
+{
+  @try {
+    NSFileHandle *fileHandle = [NSFileHandle fileHandleForWritingAtPath:_filePath];
+    if (!fileHandle) {
+      return NO;
+    }
+    [fileHandle seekToEndOfFile];
+    [fileHandle writeData:data];
+    [fileHandle closeFile];
+    _writtenByteCount += data.length;
+    return YES;
+  } @catch (NSException *exception) {
+    return NO;
+  }
+}
+
+- (nullable NSData *)archiveObject:(id<NSSecureCoding>)object
+{
+  if (@available(iOS 11.0, *)) {
+    return [NSKeyedArchiver archivedDataWithRootObject:object requiringSecureCoding:NO error:nil];
+  }
+  return nil;
+}
+
+- (nullable id)unarchiveObject:(NSData *)data
+{
+  if (@available(iOS 11.0, *)) {
+    return [NSKeyedUnarchiver unarchivedObjectOfClasses:_objectClasses fromData:data error:nil];
+  }
+  return nil;
+}
+
+@end
+
+#endif
@@ -14,8 +14,10 @@
 
 #import "FBAEMAdvertiserRuleFactory.h"
 #import "FBAEMConfiguration.h"
+#import "FBAEMConfigurationIndex.h"
 #import "FBAEMInvocation.h"
 #import "FBAEMNetworker.h"
+#import "FBAEMRecordStore.h"
 #import "FBCoreKitBasicsImportForAEMKit.h"
 
 #define FB_AEM_CONFIG_TIME_OUT 86400
@@ -39,16 +41,36 @@ static NSString *const FBAEMReporterFileName = @"FBSDKAEMReportData.report";
 static NSString *const FBAEMConfigFileName = @"FBSDKAEMReportData.config";
 static NSString *const FBAEMHTTPMethodGET = @"GET";
 static NSString *const FBAEMHTTPMethodPOST = @"POST";
+// The value of FBSDKGraphRequestErrorHTTPStatusCodeKey in the errors of the networker
+static NSString *const FBAEMHTTPStatusCodeKey = @"com.facebook.sdk:FBSDKGraphRequestErrorHTTPStatusCodeKey";
+
+// Conversions of a campaign are sent once the campaign had no update for the debounce interval
+static const NSTimeInterval FBAEMAggregationDebounceInterval = 5;
+static const NSTimeInterval FBAEMAggregationMinimumRequestInterval = 30;
+// Failed requests are retried with a jittered exponential back off, starting from the retry interval
+static const NSTimeInterval FBAEMAggregationRetryInterval = 30;
+static const NSTimeInterval FBAEMAggregationMaximumRetryInterval = 60 * 60;
 
 static BOOL g_isAEMReportEnabled = NO;
 static BOOL g_isLoadingConfiguration = NO;
 static dispatch_queue_t g_serialQueue;
 static NSString *g_reportFile;
 static NSString *g_configFile;
+static FBAEMRecordStore *g_reportStore;
+static FBAEMRecordStore *g_configStore;
 static NSMutableDictionary<NSString *, NSMutableArray<FBAEMConfiguration *> *> *g_configs;
 static NSMutableArray<FBAEMInvocation *> *g_invocations;
 static NSDate *g_configRefreshTimestamp;
 static NSMutableArray<FBAEMReporterBlock> *g_completionBlocks;
+static NSTimeInterval g_aggregationDebounceInterval = FBAEMAggregationDebounceInterval;
+static NSTimeInterval g_minimumAggregationRequestInterval = FBAEMAggregationMinimumRequestInterval;
+static NSMutableDictionary<NSString *, NSDate *> *g_aggregationDeadlines;
+static NSMutableSet<FBAEMInvocation *> *g_aggregatingInvocations;
+static NSDate *g_aggregationRequestTimestamp;
+static BOOL g_isAggregationRequestScheduled = NO;
+static NSTimeInterval g_aggregationRetryInterval = FBAEMAggregationRetryInterval;
+static NSUInteger g_aggregationFailureCount = 0;
+static NSDate *g_aggregationRetryDate;
 static _Nullable id<FBAEMNetworking> _networker = nil;
 static _Nullable id<FBSKAdNetworkReporting> _reporter = nil;
 static NSString *_appId;
@@ -179,9 +201,9 @@ static char *const dispatchQueueLabel = "com.facebook.appevents.AEM.FBAEMReporte
       FBAEMInvocation *attributedInvocation = [self _attributedInvocation:g_invocations Event:event currency:currency value:value parameters:parameters configs:g_configs];
       if (attributedInvocation) {
         if ([attributedInvocation updateConversionValueWithConfigs:g_configs]) {
-          [self _sendAggregationRequest];
+          [self _scheduleAggregationRequestForInvocation:attributedInvocation];
         }
-        [self _saveReportData];
+        [self _saveInvocations:@[attributedInvocation]];
       }
     }];
   }
@@ -196,6 +218,8 @@ static char *const dispatchQueueLabel = "com.facebook.appevents.AEM.FBAEMReporte
 {
   BOOL isGeneralInvocationVisited = NO;
   FBAEMInvocation *attributedInvocation = nil;
+  // Decodes fb_content at most once for the event, however many invocations are tried.
+  FBAEMEventParameters *eventParameters = [[FBAEMEventParameters alloc] initWithParameters:parameters];
   for (FBAEMInvocation *invocation in [invocations reverseObjectEnumerator]) {
     if ([self _isDoubleCounting:invocation event:event]) {
       break;
@@ -204,7 +228,7 @@ static char *const dispatchQueueLabel = "com.facebook.appevents.AEM.FBAEMReporte
       continue;
     }
 
-    if ([invocation attributeEvent:event currency:currency value:value parameters:parameters configs:configs]) {
+    if ([invocation attributeEvent:event currency:currency value:value eventParameters:eventParameters configs:configs]) {
       attributedInvocation = invocation;
       break;
     }
@@ -231,7 +255,7 @@ static char *const dispatchQueueLabel = "com.facebook.appevents.AEM.FBAEMReporte
 {
   [self dispatchOnQueue:g_serialQueue block:^() {
     [FBSDKTypeUtility array:g_invocations addObject:invocation];
-    [self _saveReportData];
+    [self _saveInvocations:@[invocation]];
   }];
 }
 
@@ -356,8 +380,41 @@ static char *const dispatchQueueLabel = "com.facebook.appevents.AEM.FBAEMReporte
 
 #pragma mark - Background methods
 
++ (nullable FBAEMRecordStore *)_configStore
+{
+  if (!g_configFile) {
+    return nil;
+  }
+  if (![g_configStore.filePath isEqualToString:g_configFile]) {
+    g_configStore = [[FBAEMRecordStore alloc] initWithFilePath:g_configFile
+                                                 objectClasses:[NSSet setWithArray:@[FBAEMConfiguration.class, FBAEMRule.class, FBAEMEvent.class]]];
+  }
+  return g_configStore;
+}
+
++ (nullable FBAEMRecordStore *)_reportStore
+{
+  if (!g_reportFile) {
+    return nil;
+  }
+  if (![g_reportStore.filePath isEqualToString:g_reportFile]) {
+    g_reportStore = [[FBAEMRecordStore alloc] initWithFilePath:g_reportFile
+                                                 objectClasses:[NSSet setWithArray:@[FBAEMInvocation.class]]];
+  }
+  return g_reportStore;
+}
+
 + (NSMutableDictionary<NSString *, NSMutableArray<FBAEMConfiguration *> *> *)_loadConfigs
 {
+  NSArray<FBAEMConfiguration *> *configs = [[self _configStore] loadObjects];
+  if (configs) {
+    NSMutableDictionary<NSString *, NSMutableArray<FBAEMConfiguration *> *> *res = [NSMutableDictionary new];
+    for (FBAEMConfiguration *config in configs) {
+      [self _addConfig:config toConfigs:res];
+    }
+    return res;
+  }
+  // Caches written before the record store are a single archive of all the configs
   if (@available(iOS 11.0, *)) {
     NSData *cachedConfig = [NSData dataWithContentsOfFile:g_configFile options:NSDataReadingMappedIfSafe error:nil];
     if ([cachedConfig isKindOfClass:NSData.class]) {
@@ -376,46 +433,69 @@ static char *const dispatchQueueLabel = "com.facebook.appevents.AEM.FBAEMReporte
   return [NSMutableDictionary new];
 }
 
++ (NSArray<FBAEMConfiguration *> *)_allConfigs
+{
+  NSMutableArray<FBAEMConfiguration *> *configs = [NSMutableArray new];
+  for (NSString *key in g_configs) {
+    [configs addObjectsFromArray:[FBSDKTypeUtility dictionary:g_configs objectForKey:key ofType:NSArray.class] ?: @[]];
+  }
+  return configs;
+}
+
 + (void)_saveConfigs
 {
   if (!g_configs) {
     return;
   }
-  if (@available(iOS 11.0, *)) {
-    NSData *cache = [NSKeyedArchiver archivedDataWithRootObject:g_configs requiringSecureCoding:NO error:nil];
-    if (cache && g_configFile) {
-      [cache writeToFile:g_configFile atomically:YES];
-    }
-  }
+  [[self _configStore] compactWithObjects:[self _allConfigs]];
 }
 
 + (void)_addConfigs:(nullable NSArray<NSDictionary<NSString *, id> *> *)configs
 {
-  if (0 == configs.count) {
+  if (0 == configs.count || !g_configs) {
     return;
   }
-  for (NSDictionary<NSString *, id> *config in configs) {
-    [self _addConfig:[[FBAEMConfiguration alloc] initWithJSON:config]];
+  NSMutableArray<FBAEMConfiguration *> *addedConfigs = [NSMutableArray new];
+  NSMutableArray<FBAEMConfiguration *> *replacedConfigs = [NSMutableArray new];
+  for (NSDictionary<NSString *, id> *json in configs) {
+    FBAEMConfiguration *config = [[FBAEMConfiguration alloc] initWithJSON:json];
+    if (!config.configMode) {
+      continue;
+    }
+    for (FBAEMConfiguration *replacedConfig in [self _addConfig:config toConfigs:g_configs]) {
+      if ([addedConfigs indexOfObjectIdenticalTo:replacedConfig] != NSNotFound) {
+        [addedConfigs removeObjectIdenticalTo:replacedConfig];
+      } else {
+        [FBSDKTypeUtility array:replacedConfigs addObject:replacedConfig];
+      }
+    }
+    [FBSDKTypeUtility array:addedConfigs addObject:config];
   }
-  [self _saveConfigs];
+  // g_configs was changed in place, so invocations must look their configs up again
+  [FBAEMConfigurationIndex invalidateCachedIndex];
+  // Only the added configs, and the keys of the ones they replace, are appended to the cache
+  [[self _configStore] saveObjects:addedConfigs removingObjects:replacedConfigs inObjects:[self _allConfigs]];
 }
 
-+ (void)_addConfig:(nullable FBAEMConfiguration *)config
++ (NSArray<FBAEMConfiguration *> *)_addConfig:(nullable FBAEMConfiguration *)config
+                                    toConfigs:(NSMutableDictionary<NSString *, NSMutableArray<FBAEMConfiguration *> *> *)allConfigs
 {
   if (!config.configMode) {
-    return;
+    return @[];
   }
-  NSMutableArray<FBAEMConfiguration *> *configs = [FBSDKTypeUtility dictionary:g_configs objectForKey:config.configMode ofType:NSMutableArray.class];
+  NSMutableArray<FBAEMConfiguration *> *configs = [FBSDKTypeUtility dictionary:allConfigs objectForKey:config.configMode ofType:NSMutableArray.class];
   // Remove the config in the array that has the same "validFrom" and "businessID" as the added config
   NSMutableArray<FBAEMConfiguration *> *res = [NSMutableArray new];
+  NSMutableArray<FBAEMConfiguration *> *replacedConfigs = [NSMutableArray new];
   for (FBAEMConfiguration *c in configs) {
     if ([config isSameValidFrom:c.validFrom businessID:c.businessID]) {
+      [FBSDKTypeUtility array:replacedConfigs addObject:c];
       continue;
     }
     [FBSDKTypeUtility array:res addObject:c];
   }
   [FBSDKTypeUtility array:res addObject:config];
-  [FBSDKTypeUtility dictionary:g_configs setObject:res forKey:config.configMode];
+  [FBSDKTypeUtility dictionary:allConfigs setObject:res forKey:config.configMode];
   // Sort the configs via "validFrom"
   [res sortUsingComparator:^NSComparisonResult (FBAEMConfiguration *obj1, FBAEMConfiguration *obj2) {
     if (obj1.validFrom > obj2.validFrom) {
@@ -426,10 +506,16 @@ static char *const dispatchQueueLabel = "com.facebook.appevents.AEM.FBAEMReporte
     }
     return NSOrderedSame;
   }];
+  return replacedConfigs;
 }
 
 + (NSMutableArray<FBAEMInvocation *> *)_loadReportData
 {
+  NSArray<FBAEMInvocation *> *invocations = [[self _reportStore] loadObjects];
+  if (invocations) {
+    return [invocations mutableCopy];
+  }
+  // Caches written before the record store are a single archive of all the invocations
   if (@available(iOS 11.0, *)) {
     NSData *cachedReportData = [NSData dataWithContentsOfFile:g_reportFile options:NSDataReadingMappedIfSafe error:nil];
     if ([cachedReportData isKindOfClass:NSData.class]) {
@@ -444,46 +530,192 @@ static char *const dispatchQueueLabel = "com.facebook.appevents.AEM.FBAEMReporte
 
 + (void)_saveReportData
 {
-  if (@available(iOS 11.0, *)) {
-    NSData *cache = [NSKeyedArchiver archivedDataWithRootObject:g_invocations requiringSecureCoding:NO error:nil];
-    if (cache && g_reportFile) {
-      [cache writeToFile:g_reportFile atomically:YES];
+  [[self _reportStore] compactWithObjects:g_invocations ?: @[]];
+}
+
++ (void)_saveInvocations:(NSArray<FBAEMInvocation *> *)invocations
+{
+  // Only the changed invocations are appended to the cache
+  [[self _reportStore] saveObjects:invocations removingObjects:@[] inObjects:g_invocations ?: @[]];
+}
+
++ (void)_scheduleAggregationRequestForInvocation:(FBAEMInvocation *)invocation
+{
+  // Every update of the campaign restarts its debounce interval
+  [FBSDKTypeUtility dictionary:[self _aggregationDeadlines]
+                     setObject:[NSDate dateWithTimeIntervalSinceNow:g_aggregationDebounceInterval]
+                        forKey:invocation.campaignID];
+  [self _scheduleAggregationRequest];
+}
+
++ (void)_scheduleAggregationRequest
+{
+  if (g_isAggregationRequestScheduled) {
+    return;
+  }
+  NSDate *requestDate = [self _nextAggregationRequestDate];
+  if (!requestDate) {
+    return;
+  }
+  NSTimeInterval delay = [requestDate timeIntervalSinceNow];
+  if (delay <= 0) {
+    [self _sendAggregationRequest];
+    return;
+  }
+  if (!g_serialQueue) {
+    return;
+  }
+  g_isAggregationRequestScheduled = YES;
+  dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), g_serialQueue, ^{
+    g_isAggregationRequestScheduled = NO;
+    [self _sendAggregationRequest];
+  });
+}
+
+// The date when the next pending invocation can be sent, if any
++ (nullable NSDate *)_nextAggregationRequestDate
+{
+  NSDate *requestDate = nil;
+  for (FBAEMInvocation *invocation in g_invocations) {
+    if (![self _isPendingAggregation:invocation]) {
+      continue;
     }
+    NSDate *deadline = [FBSDKTypeUtility dictionary:g_aggregationDeadlines objectForKey:invocation.campaignID ofType:NSDate.class] ?: [NSDate date];
+    requestDate = requestDate ? [requestDate earlierDate:deadline] : deadline;
   }
+  NSDate *earliestRequestDate = [self _earliestAggregationRequestDate];
+  if (requestDate && earliestRequestDate) {
+    requestDate = [requestDate laterDate:earliestRequestDate];
+  }
+  return requestDate;
+}
+
+// The date before which no request can be sent, because of the rate limit or the back off after failures
++ (nullable NSDate *)_earliestAggregationRequestDate
+{
+  NSDate *date = [g_aggregationRequestTimestamp dateByAddingTimeInterval:g_minimumAggregationRequestInterval];
+  if (g_aggregationRetryDate) {
+    date = date ? [date laterDate:g_aggregationRetryDate] : g_aggregationRetryDate;
+  }
+  return date;
+}
+
++ (void)_recordAggregationFailure:(NSError *)error
+{
+  if (![self _isTransientAggregationError:error]) {
+    // Rejected reports are only sent again along with the next conversion
+    return;
+  }
+  g_aggregationFailureCount++;
+  NSTimeInterval backoff = MIN(
+    g_aggregationRetryInterval * pow(2, MIN(g_aggregationFailureCount - 1, 16)),
+    FBAEMAggregationMaximumRetryInterval
+  );
+  // Jitter keeps devices that failed together from retrying together
+  NSTimeInterval delay = backoff / 2 + backoff / 2 * arc4random_uniform(1000) / 1000.0;
+  g_aggregationRetryDate = [NSDate dateWithTimeIntervalSinceNow:delay];
+  [self _scheduleAggregationRequest];
+}
+
++ (void)_recordAggregationSuccess
+{
+  g_aggregationFailureCount = 0;
+  g_aggregationRetryDate = nil;
+}
+
+// Network errors, rate limiting and server errors may go away; other failures will not
++ (BOOL)_isTransientAggregationError:(NSError *)error
+{
+  if ([error.domain isEqualToString:NSURLErrorDomain]) {
+    return error.code != NSURLErrorCancelled;
+  }
+  NSNumber *statusCode = [FBSDKTypeUtility dictionary:error.userInfo objectForKey:FBAEMHTTPStatusCodeKey ofType:NSNumber.class];
+  if (!statusCode) {
+    return YES;
+  }
+  return statusCode.integerValue == 429 || statusCode.integerValue >= 500;
+}
+
++ (BOOL)_isPendingAggregation:(FBAEMInvocation *)invocation
+{
+  return !invocation.isAggregated && ![g_aggregatingInvocations containsObject:invocation];
+}
+
++ (NSMutableDictionary<NSString *, NSDate *> *)_aggregationDeadlines
+{
+  if (!g_aggregationDeadlines) {
+    g_aggregationDeadlines = [NSMutableDictionary new];
+  }
+  return g_aggregationDeadlines;
 }
 
 + (void)_sendAggregationRequest
 {
+  NSDate *now = [NSDate date];
+  // Calls that are not scheduled, such as the one after loading the configuration, are rate limited too
+  if ([[self _earliestAggregationRequestDate] compare:now] == NSOrderedDescending) {
+    [self _scheduleAggregationRequest];
+    return;
+  }
   NSMutableArray<NSDictionary<NSString *, id> *> *params = [NSMutableArray new];
   NSMutableArray<FBAEMInvocation *> *aggregatedInvocations = [NSMutableArray new];
   for (FBAEMInvocation *invocation in g_invocations) {
-    if (!invocation.isAggregated) {
-      [FBSDKTypeUtility array:params addObject:[self _aggregationRequestParameters:invocation]];
-      [FBSDKTypeUtility array:aggregatedInvocations addObject:invocation];
+    NSDate *deadline = [FBSDKTypeUtility dictionary:g_aggregationDeadlines objectForKey:invocation.campaignID ofType:NSDate.class];
+    if (![self _isPendingAggregation:invocation] || [deadline compare:now] == NSOrderedDescending) {
+      continue;
+    }
+    // A report that was sent without being acknowledged is sent again unchanged
+    if (!invocation.aggregationParameters) {
+      invocation.aggregationParameters = [self _aggregationRequestParameters:invocation];
     }
+    [FBSDKTypeUtility array:params addObject:invocation.aggregationParameters];
+    [FBSDKTypeUtility array:aggregatedInvocations addObject:invocation];
   }
   if (0 == params.count) {
+    // The deadlines may have moved later since the request was scheduled
+    [self _scheduleAggregationRequest];
     return;
   }
   @try {
     NSData *jsonData = [FBSDKTypeUtility dataWithJSONObject:params options:0 error:nil];
     if (jsonData) {
       NSString *reports = [[NSString alloc] initWithData:jsonData encoding:NSUTF8StringEncoding];
+      NSArray<NSDictionary<NSString *, id> *> *sentParams = [params copy];
+
+      for (FBAEMInvocation *invocation in aggregatedInvocations) {
+        [g_aggregationDeadlines removeObjectForKey:invocation.campaignID];
+      }
+      if (!g_aggregatingInvocations) {
+        g_aggregatingInvocations = [NSMutableSet new];
+      }
+      [g_aggregatingInvocations addObjectsFromArray:aggregatedInvocations];
+      g_aggregationRequestTimestamp = now;
+      // The reports in flight are saved first, so that they are neither lost nor changed by a crash
+      [self _saveInvocations:aggregatedInvocations];
 
       [self.networker startGraphRequestWithGraphPath:[NSString stringWithFormat:@"%@/aem_conversions", _appId]
                                           parameters:@{@"aem_conversions" : reports}
                                          tokenString:nil
                                           HTTPMethod:FBAEMHTTPMethodPOST
                                           completion:^(id _Nullable result, NSError *_Nullable error) {
-                                            if (error) {
-                                              return;
-                                            }
-
                                             [self dispatchOnQueue:g_serialQueue block:^() {
                                               for (FBAEMInvocation *invocation in aggregatedInvocations) {
-                                                invocation.isAggregated = YES;
+                                                [g_aggregatingInvocations removeObject:invocation];
+                                              }
+                                              if (error) {
+                                                [self _recordAggregationFailure:error];
+                                                return;
                                               }
-                                              [self _saveReportData];
+                                              [self _recordAggregationSuccess];
+                                              [aggregatedInvocations enumerateObjectsUsingBlock:^(FBAEMInvocation *invocation, NSUInteger idx, BOOL *stop) {
+                                                // An invocation updated while its report was in flight is reported again
+                                                if ([invocation.aggregationParameters isEqualToDictionary:[FBSDKTypeUtility array:sentParams objectAtIndex:idx]]) {
+                                                  invocation.isAggregated = YES;
+                                                  invocation.aggregationParameters = nil;
+                                                }
+                                              }];
+                                              [self _saveInvocations:aggregatedInvocations];
+                                              [self _scheduleAggregationRequest];
                                             }];
                                           }];
     }
@@ -553,6 +785,7 @@ static char *const dispatchQueueLabel = "com.facebook.appevents.AEM.FBAEMReporte
       [FBSDKTypeUtility dictionary:configs setObject:newConfigurations forKey:key];
     }
     g_configs = configs;
+    [FBAEMConfigurationIndex invalidateCachedIndex];
   }
   if (shouldSaveCache) {
     [self _saveConfigs];
@@ -601,11 +834,19 @@ static char *const dispatchQueueLabel = "com.facebook.appevents.AEM.FBAEMReporte
 + (void)setConfigs:(NSMutableDictionary<NSString *, NSMutableArray<FBAEMConfiguration *> *> *)configs
 {
   g_configs = configs;
+  // The cache no longer matches the configs, so it is rewritten on the next change
+  g_configStore = nil;
 }
 
 + (void)setInvocations:(NSMutableArray<FBAEMInvocation *> *)invocations
 {
   g_invocations = invocations;
+  g_reportStore = nil;
+  g_aggregationDeadlines = nil;
+  g_aggregatingInvocations = nil;
+  g_aggregationRequestTimestamp = nil;
+  g_aggregationFailureCount = 0;
+  g_aggregationRetryDate = nil;
 }
 
 + (NSMutableArray<FBAEMInvocation *> *)invocations
@@ -613,6 +854,56 @@ static char *const dispatchQueueLabel = "com.facebook.appevents.AEM.FBAEMReporte
   return g_invocations;
 }
 
++ (NSTimeInterval)aggregationDebounceInterval
+{
+  return g_aggregationDebounceInterval;
+}
+
++ (void)setAggregationDebounceInterval:(NSTimeInterval)interval
+{
+  g_aggregationDebounceInterval = interval;
+}
+
++ (NSTimeInterval)minimumAggregationRequestInterval
+{
+  return g_minimumAggregationRequestInterval;
+}
+
++ (void)setMinimumAggregationRequestInterval:(NSTimeInterval)interval
+{
+  g_minimumAggregationRequestInterval = interval;
+}
+
++ (NSTimeInterval)aggregationRetryInterval
+{
+  return g_aggregationRetryInterval;
+}
+
++ (void)setAggregationRetryInterval:(NSTimeInterval)interval
+{
+  g_aggregationRetryInterval = interval;
+}
+
++ (nullable NSDate *)aggregationRetryDate
+{
+  return g_aggregationRetryDate;
+}
+
++ (void)setAggregationRetryDate:(nullable NSDate *)date
+{
+  g_aggregationRetryDate = date;
+}
+
++ (BOOL)isAggregationRequestScheduled
+{
+  return g_isAggregationRequestScheduled;
+}
+
++ (void)setIsAggregationRequestScheduled:(BOOL)scheduled
+{
+  g_isAggregationRequestScheduled = scheduled;
+}
+
 + (void)setIsEnabled:(BOOL)enabled
 {
   g_isAEMReportEnabled = enabled;
@@ -653,6 +944,16 @@ static char *const dispatchQueueLabel = "com.facebook.appevents.AEM.FBAEMReporte
   g_reportFile = path;
 }
 
++ (nullable NSString *)configFilePath
+{
+  return g_configFile;
+}
+
++ (void)setConfigFilePath:(nullable NSString *)path
+{
+  g_configFile = path;
+}
+
 #endif
 
 @end
@@ -9,12 +9,10 @@
 #import "FBSDKBasicUtility.h"
 
 #import <CommonCrypto/CommonCrypto.h>
-#import <zlib.h>
 
+#import "FBSDKGzipCompressor.h"
 #import "FBSDKTypeUtility.h"
 
-#define kChunkSize 1024
-
 static NSString *const FBSDK_BASICUTILITY_ANONYMOUSIDFILENAME = @"com-facebook-sdk-PersistedAnonymousID.json";
 static NSString *const FBSDK_BASICUTILITY_ANONYMOUSID_KEY = @"anon_id";
 
@@ -245,49 +243,7 @@ void fb_dispatch_on_default_thread(dispatch_block_t block)
 
 + (nullable NSData *)gzip:(NSData *)data
 {
-  const void *bytes = data.bytes;
-  const NSUInteger length = data.length;
-
-  if (!bytes || !length) {
-    return nil;
-  }
-
-#if defined(__LP64__) && __LP64__
-  if (length > UINT_MAX) {
-    return nil;
-  }
-#endif
-
-  // initialze stream
-  z_stream stream;
-  bzero(&stream, sizeof(z_stream));
-
-  if (deflateInit2(&stream, -1, Z_DEFLATED, 31, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
-    return nil;
-  }
-  stream.avail_in = (uint)length;
-  stream.next_in = (Bytef *)bytes;
-
-  int retCode;
-  NSMutableData *result = [NSMutableData dataWithCapacity:(length / 4)];
-  unsigned char output[kChunkSize];
-  do {
-    stream.avail_out = kChunkSize;
-    stream.next_out = output;
-    retCode = deflate(&stream, Z_FINISH);
-    if (retCode != Z_OK && retCode != Z_STREAM_END) {
-      deflateEnd(&stream);
-      return nil;
-    }
-    unsigned size = kChunkSize - stream.avail_out;
-    if (size > 0) {
-      [result appendBytes:output length:size];
-    }
-  } while (retCode == Z_OK);
-
-  deflateEnd(&stream);
-
-  return result;
+  return [FBSDKGzipCompressor gzip:data level:FBSDKGzipCompressionLevelDefault strategy:FBSDKGzipStrategyDefault];
 }
 
 + (NSString *)anonymousID
@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import "FBSDKGzipCompressor.h"
+
+#import <zlib.h>
+
+const NSInteger FBSDKGzipCompressionLevelDefault = Z_DEFAULT_COMPRESSION;
+
+// The size of the buffer deflate writes into before the output is appended.
+static const NSUInteger FBSDKGzipOutputBufferSize = 16 * 1024;
+// The deflate window, which is also the dictionary primed into parallel chunks.
+static const NSUInteger FBSDKGzipWindowSize = 32 * 1024;
+// zlib counts available input in 32 bits, so larger inputs are fed in slices.
+static const NSUInteger FBSDKGzipMaxInputSlice = 1 << 30;
+// Selects the gzip wrapper with the largest window.
+static const int FBSDKGzipWindowBits = 31;
+// Selects raw deflate output, which can be concatenated.
+static const int FBSDKGzipRawWindowBits = -15;
+static const int FBSDKGzipMemoryLevel = 8;
+
+static BOOL FBSDKGzipIsValidLevel(NSInteger level)
+{
+  return level == Z_DEFAULT_COMPRESSION || (level >= Z_NO_COMPRESSION && level <= Z_BEST_COMPRESSION);
+}
+
+static int FBSDKGzipZlibStrategy(FBSDKGzipStrategy strategy)
+{
+  switch (strategy) {
+    case FBSDKGzipStrategyFiltered: return Z_FILTERED;
+    case FBSDKGzipStrategyHuffmanOnly: return Z_HUFFMAN_ONLY;
+    case FBSDKGzipStrategyRLE: return Z_RLE;
+    case FBSDKGzipStrategyFixed: return Z_FIXED;
+    case FBSDKGzipStrategyDefault:
+    default: return Z_DEFAULT_STRATEGY;
+  }
+}
+
+// Runs deflate over the input, appending everything it produces to the output.
+static BOOL FBSDKGzipDeflate(z_stream *stream,
+                             const uint8_t *bytes,
+                             NSUInteger length,
+                             int flush,
+                             NSMutableData *output)
+{
+  uint8_t buffer[FBSDKGzipOutputBufferSize];
+  NSUInteger offset = 0;
+  int retCode = Z_OK;
+  do {
+    NSUInteger slice = MIN(length - offset, FBSDKGzipMaxInputSlice);
+    stream->next_in = (Bytef *)(bytes + offset);
+    stream->avail_in = (uInt)slice;
+    int sliceFlush = (offset + slice == length) ? flush : Z_NO_FLUSH;
+    do {
+      stream->next_out = buffer;
+      stream->avail_out = (uInt)sizeof(buffer);
+      retCode = deflate(stream, sliceFlush);
+      if (retCode == Z_STREAM_ERROR) {
+        return NO;
+      }
+      [output appendBytes:buffer length:sizeof(buffer) - stream->avail_out];
+    } while (stream->avail_out == 0);
+    offset += slice;
+  } while (offset < length);
+
+  return flush != Z_FINISH || retCode == Z_STREAM_END;
+}
+
+// Deflates one chunk of a parallel compression into raw deflate data.
+static NSData *_Nullable FBSDKGzipDeflateChunk(const uint8_t *bytes,
+                                               NSUInteger offset,
+                                               NSUInteger length,
+                                               BOOL isLast,
+                                               int level,
+                                               int strategy)
+{
+  z_stream stream;
+  bzero(&stream, sizeof(z_stream));
+  if (deflateInit2(&stream, level, Z_DEFLATED, FBSDKGzipRawWindowBits, FBSDKGzipMemoryLevel, strategy) != Z_OK) {
+    return nil;
+  }
+  if (offset > 0) {
+    // Lets matches reach back into the previous chunk as they would in a single pass.
+    NSUInteger dictionaryLength = MIN(offset, FBSDKGzipWindowSize);
+    deflateSetDictionary(&stream, bytes + offset - dictionaryLength, (uInt)dictionaryLength);
+  }
+  NSMutableData *output = [NSMutableData dataWithCapacity:deflateBound(&stream, (uLong)length)];
+  // A sync flush ends every chunk but the last on a byte boundary without ending the deflate stream.
+  BOOL success = FBSDKGzipDeflate(&stream, bytes + offset, length, isLast ? Z_FINISH : Z_SYNC_FLUSH, output);
+  deflateEnd(&stream);
+  return success ? output : nil;
+}
+
+static void FBSDKGzipAppendUInt32LE(NSMutableData *data, uint32_t value)
+{
+  uint8_t bytes[4] = {
+    (uint8_t)(value & 0xff),
+    (uint8_t)((value >> 8) & 0xff),
+    (uint8_t)((value >> 16) & 0xff),
+    (uint8_t)((value >> 24) & 0xff),
+  };
+  [data appendBytes:bytes length:sizeof(bytes)];
+}
+
+@implementation FBSDKGzipCompressor
+{
+  z_stream _stream;
+  BOOL _initialized;
+  BOOL _finished;
+}
+
+- (nullable instancetype)initWithLevel:(NSInteger)level
+                              strategy:(FBSDKGzipStrategy)strategy
+{
+  if (!FBSDKGzipIsValidLevel(level)) {
+    return nil;
+  }
+  if ((self = [super init])) {
+    bzero(&_stream, sizeof(z_stream));
+    if (deflateInit2(&_stream, (int)level, Z_DEFLATED, FBSDKGzipWindowBits, FBSDKGzipMemoryLevel, FBSDKGzipZlibStrategy(strategy)) != Z_OK) {
+      return nil;
+    }
+    _initialized = YES;
+  }
+  return self;
+}
+
+- (void)dealloc
+{
+  if (_initialized) {
+    deflateEnd(&_stream);
+  }
+}
+
+- (nullable NSData *)updateWithData:(NSData *)data
+{
+  NSMutableData *output = [NSMutableData data];
+  return [self _deflateBytes:data.bytes length:data.length flush:Z_NO_FLUSH output:output] ? output : nil;
+}
+
+- (nullable NSData *)finish
+{
+  NSMutableData *output = [NSMutableData data];
+  return [self _deflateBytes:NULL length:0 flush:Z_FINISH output:output] ? output : nil;
+}
+
+- (BOOL)_deflateBytes:(const uint8_t *)bytes
+               length:(NSUInteger)length
+                flush:(int)flush
+               output:(NSMutableData *)output
+{
+  if (_finished) {
+    return NO;
+  }
+  NSUInteger initialLength = output.length;
+  BOOL success = FBSDKGzipDeflate(&_stream, bytes, length, flush, output);
+  if (!success || flush == Z_FINISH) {
+    _finished = YES;
+  }
+  _totalBytesIn += length;
+  _totalBytesOut += output.length - initialLength;
+  return success;
+}
+
+#pragma mark - One pass
+
++ (nullable NSData *)gzip:(NSData *)data
+                    level:(NSInteger)level
+                 strategy:(FBSDKGzipStrategy)strategy
+{
+  if (!data.bytes || !data.length) {
+    return nil;
+  }
+  FBSDKGzipCompressor *compressor = [[self alloc] initWithLevel:level strategy:strategy];
+  if (!compressor) {
+    return nil;
+  }
+  // Reserve the worst case once rather than growing the output by reallocation.
+  NSMutableData *output = [NSMutableData dataWithCapacity:deflateBound(&compressor->_stream, (uLong)data.length)];
+  BOOL success = [compressor _deflateBytes:data.bytes length:data.length flush:Z_FINISH output:output];
+  return success ? output : nil;
+}
+
++ (nullable NSData *)parallelGzip:(NSData *)data
+                            level:(NSInteger)level
+                         strategy:(FBSDKGzipStrategy)strategy
+                        chunkSize:(NSUInteger)chunkSize
+{
+  const NSUInteger length = data.length;
+  chunkSize = MIN(MAX(chunkSize, FBSDKGzipWindowSize), FBSDKGzipMaxInputSlice);
+  if (length <= chunkSize * 2) {
+    return [self gzip:data level:level strategy:strategy];
+  }
+  if (!FBSDKGzipIsValidLevel(level)) {
+    return nil;
+  }
+
+  const uint8_t *bytes = data.bytes;
+  const NSUInteger chunkCount = (length + chunkSize - 1) / chunkSize;
+  const int zlibStrategy = FBSDKGzipZlibStrategy(strategy);
+  NSMutableArray<id> *chunks = [NSMutableArray arrayWithCapacity:chunkCount];
+  for (NSUInteger i = 0; i < chunkCount; i++) {
+    [chunks addObject:NSNull.null];
+  }
+  uLong *checksums = calloc(chunkCount, sizeof(uLong));
+  if (!checksums) {
+    return nil;
+  }
+
+  dispatch_apply(chunkCount, dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^(size_t index) {
+    NSUInteger offset = index * chunkSize;
+    NSUInteger chunkLength = MIN(chunkSize, length - offset);
+    checksums[index] = crc32(crc32(0L, Z_NULL, 0), bytes + offset, (uInt)chunkLength);
+    NSData *chunk = FBSDKGzipDeflateChunk(bytes, offset, chunkLength, index == chunkCount - 1, (int)level, zlibStrategy);
+    if (chunk) {
+      @synchronized(chunks) {
+        chunks[index] = chunk;
+      }
+    }
+  });
+
+  // The gzip header: magic, deflate, no flags, no modification time, no extra flags, Unix.
+  static const uint8_t header[10] = {0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03};
+  NSMutableData *output = [NSMutableData dataWithBytes:header length:sizeof(header)];
+  uLong checksum = crc32(0L, Z_NULL, 0);
+  for (NSUInteger index = 0; index < chunkCount; index++) {
+    id chunk = chunks[index];
+    if (![chunk isKindOfClass:NSData.class]) {
+      free(checksums);
+      return nil;
+    }
+    [output appendData:chunk];
+    NSUInteger chunkLength = MIN(chunkSize, length - index * chunkSize);
+    checksum = crc32_combine(checksum, checksums[index], (z_off_t)chunkLength);
+  }
+  free(checksums);
+
+  FBSDKGzipAppendUInt32LE(output, (uint32_t)checksum);
+  FBSDKGzipAppendUInt32LE(output, (uint32_t)(length & 0xffffffff));
+  return output;
+}
+
+@end
@@ -14,6 +14,7 @@
 #import "FBSDKCrashObserving.h"
 #import "FBSDKFileDataExtracting.h"
 #import "FBSDKFileManaging.h"
+#import "FBSDKGzipCompressor.h"
 #import "FBSDKInfoDictionaryProviding.h"
 #import "FBSDKJSONValue.h"
 #import "FBSDKLibAnalyzer.h"
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ * All rights reserved.
+ *
+ * This source code is licensed under the license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// The zlib compression level that balances speed and size.
+FOUNDATION_EXPORT const NSInteger FBSDKGzipCompressionLevelDefault
+NS_SWIFT_NAME(GzipCompressionLevelDefault);
+
+/**
+ The deflate strategies supported by `FBSDKGzipCompressor`, matching the zlib strategies.
+ */
+typedef NS_ENUM(NSInteger, FBSDKGzipStrategy) {
+  FBSDKGzipStrategyDefault = 0,
+  FBSDKGzipStrategyFiltered,
+  FBSDKGzipStrategyHuffmanOnly,
+  FBSDKGzipStrategyRLE,
+  FBSDKGzipStrategyFixed,
+} NS_SWIFT_NAME(GzipStrategy);
+
+/**
+ Compresses data into the gzip format incrementally.
+
+ Feed the input with `updateWithData:` as it becomes available and call `finish` once at the end.
+ The compressed output produced by each call should be concatenated in order.
+ Instances are not thread safe.
+ */
+NS_SWIFT_NAME(GzipCompressor)
+@interface FBSDKGzipCompressor : NSObject
+
+/// The number of input bytes consumed so far.
+@property (nonatomic, readonly) unsigned long long totalBytesIn;
+
+/// The number of compressed bytes produced so far.
+@property (nonatomic, readonly) unsigned long long totalBytesOut;
+
+- (instancetype)init NS_UNAVAILABLE;
++ (instancetype)new NS_UNAVAILABLE;
+
+/**
+ Creates a compressor.
+ @param level The compression level from 0 to 9, or `FBSDKGzipCompressionLevelDefault`.
+ @param strategy The deflate strategy.
+ @return nil if the level is invalid or zlib cannot be initialized.
+ */
+- (nullable instancetype)initWithLevel:(NSInteger)level
+                              strategy:(FBSDKGzipStrategy)strategy
+  NS_DESIGNATED_INITIALIZER;
+
+/**
+ Compresses more input.
+ @param data The next input bytes.
+ @return The compressed bytes ready so far, possibly empty, or nil on error or after `finish`.
+ */
+- (nullable NSData *)updateWithData:(NSData *)data;
+
+/**
+ Flushes the remaining compressed bytes and the gzip trailer.
+ @return The last compressed bytes, or nil on error or if already finished.
+ */
+- (nullable NSData *)finish;
+
+/**
+ Compresses data in one pass.
+ @return nil if the data is empty or cannot be compressed.
+ */
++ (nullable NSData *)gzip:(NSData *)data
+                    level:(NSInteger)level
+                 strategy:(FBSDKGzipStrategy)strategy;
+
+/**
+ Compresses large data on several threads by deflating fixed size chunks independently, like pigz.
+ Each chunk is primed with the end of the previous one so the ratio stays close to a single pass.
+ Data no larger than two chunks is compressed in a single pass.
+ @param chunkSize The size of the input chunks, at least 32 kB.
+ @return nil if the data is empty or cannot be compressed.
+ */
++ (nullable NSData *)parallelGzip:(NSData *)data
+                            level:(NSInteger)level
+                         strategy:(FBSDKGzipStrategy)strategy
+                        chunkSize:(NSUInteger)chunkSize;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -34,6 +34,7 @@ public class TestSettings: NSObject, SettingsProtocol, SettingsLogging {
   public var stubbedLimitEventAndDataUsage = false
   public var shouldUseTokenOptimizations = true
   public var isGraphErrorRecoveryEnabled = false
+  public var isGraphRequestCircuitBreakerEnabled = true
   public var graphAPIDebugParamValue: String?
   public var isAdvertiserTrackingEnabled = false
   public var loggingBehaviors = Set<LoggingBehavior>()